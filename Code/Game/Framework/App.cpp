@@ -5,7 +5,24 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Framework/App.hpp"
 //----------------------------------------------------------------------------------------------------
+#include "Game/Framework/AssetPack.hpp"
+#include "Game/Framework/AssetStreamer.hpp"
+#include "Game/Framework/BinaryLog.hpp"
+#include "Game/Framework/CommandScript.hpp"
+#include "Game/Framework/DrawList2D.hpp"
+#include "Game/Framework/EventDispatcher.hpp"
+#include "Game/Framework/FlatProperties.hpp"
+#include "Game/Framework/FontGlyphTable.hpp"
+#include "Game/Framework/FrameArena.hpp"
+#include "Game/Framework/FrameProfiler.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/GlyphWidthScan.hpp"
+#include "Game/Framework/LogArchive.hpp"
+#include "Game/Framework/SDFBaker.hpp"
+#include "Game/Framework/ScriptRunner.hpp"
+#include "Game/Framework/ShaderCompilerD3D.hpp"
+#include "Game/Framework/TextBenchmark.hpp"
+#include "Game/Framework/VertexBuilder2D.hpp"
 #include "Game/Gameplay/Game.hpp"
 //----------------------------------------------------------------------------------------------------
 #include "Engine/Audio/AudioSystem.hpp"
@@ -14,12 +31,13 @@
 #include "Engine/Core/Engine.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/HashedCaseInsensitiveString.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
 #include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/Time.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/XmlUtils.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Math/Vec2.hpp"
-#include "Engine/Core/Clock.hpp"
 #include "Engine/Platform/Window.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
@@ -27,8 +45,11 @@
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/Shader.hpp"
+#include "Engine/Renderer/Texture.hpp"
 #include "Engine/Renderer/Vertex_Font.hpp"
 #include "Engine/Resource/ResourceSubsystem.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cmath>
 
 //----------------------------------------------------------------------------------------------------
 #if defined ERROR
@@ -36,20 +57,38 @@
 #endif
 
 //----------------------------------------------------------------------------------------------------
-App*  g_app  = nullptr;     // Created and owned by Main_Windows.cpp
-Game* g_game = nullptr;     // Created and owned by the App
+App*             g_app             = nullptr;     // Created and owned by Main_Windows.cpp
+AssetPack*       g_assetPack       = nullptr;     // Created and owned by the App
+AssetStreamer*   g_assetStreamer   = nullptr;     // Created and owned by the App
+BinaryLog*       g_binaryLog       = nullptr;     // Created and owned by the App
+DrawList2D*      g_drawList        = nullptr;     // Created and owned by the App
+EventDispatcher* g_eventDispatcher = nullptr;     // Created and owned by the App
+FrameArena*      g_frameArena      = nullptr;     // Created and owned by the App
+FrameProfiler*   g_profiler        = nullptr;     // Created and owned by the App
+Game*            g_game            = nullptr;     // Created and owned by the App
+JobScheduler*    g_ioScheduler     = nullptr;     // Created and owned by the App
+JobScheduler*    g_jobScheduler    = nullptr;     // Created and owned by the App
+ScriptRunner*    g_scriptRunner    = nullptr;     // Created and owned by the App
+ShaderCache*     g_shaderCache     = nullptr;     // Created and owned by the App
+TextLayoutCache* g_textCache       = nullptr;     // Created and owned by the App
 
 //----------------------------------------------------------------------------------------------------
 STATIC bool App::m_isQuitting = false;
 
 // SD4-A3c: Font demo state
-STATIC int         App::s_currentFontTier  = 0;
-STATIC float       App::s_effectIntensity  = 1.f;
-STATIC BitmapFont* App::s_tier1Font        = nullptr;
-STATIC BitmapFont* App::s_tier3Font        = nullptr;
-STATIC BitmapFont* App::s_sdfFont          = nullptr;
-STATIC Shader*     App::s_sdfShader        = nullptr;
-STATIC Shader*     App::s_fontShader       = nullptr;
+STATIC int             App::s_currentFontTier = 0;
+STATIC float           App::s_effectIntensity = 1.f;
+STATIC BitmapFont*     App::s_tier1Font       = nullptr;
+STATIC BitmapFont*     App::s_tier3Font       = nullptr;
+STATIC BitmapFont*     App::s_sdfFont         = nullptr;
+STATIC Shader*         App::s_sdfShader       = nullptr;
+STATIC Shader*         App::s_fontShader      = nullptr;
+STATIC BitmapFont*     App::s_bakedSdfFont    = nullptr;
+STATIC Texture*        App::s_bakedSdfTexture = nullptr;
+STATIC GlyphWidthScan* App::s_autoWidthScan   = nullptr;
+STATIC FontGlyphTable* App::s_autoWidthTable  = nullptr;
+STATIC FontGlyphTable* App::s_tier3GlyphTable = nullptr;
+STATIC FontGlyphTable* App::s_sdfGlyphTable   = nullptr;
 
 //----------------------------------------------------------------------------------------------------
 App::App()
@@ -70,6 +109,52 @@ void App::Startup()
 {
     GEngine::Get().Startup();
 
+    // Before anything reads Data/: with no Data.gpak next to the executable, every file loads loose
+    g_assetPack = new AssetPack();
+    g_assetPack->Open("Data.gpak");
+
+    LoadGameConfig();
+
+    // File loads mostly wait on the disk: one thread per NUMA node, so reads land near their readers
+    if (m_ioSchedulerConfig.m_threads.m_threadCount <= 0)
+    {
+        m_ioSchedulerConfig.m_threads.m_threadCount = GetCpuTopology().m_numaNodeCount;
+    }
+
+    // A ring for the main thread, every pool thread, the logging thread and archive compressor, and a
+    // few short-lived threads; rings of exited threads are reused
+    m_binaryLogConfig.m_threadCount = 1 + JobScheduler::ResolveWorkerCount(m_jobSchedulerConfig) + m_ioSchedulerConfig.m_threads.m_threadCount + 2 + 4;
+
+    // GAME_LOG calls made before this, from AssetPack::Open and LoadGameConfig, were kept for it
+    g_binaryLog       = new BinaryLog(m_binaryLogConfig);     // First, so every game system can GAME_LOG
+    g_profiler        = new FrameProfiler(m_frameProfilerConfig);
+    g_eventDispatcher = new EventDispatcher(m_eventDispatcherConfig);
+    g_drawList   = new DrawList2D(g_renderer);     // Null renderer in headless mode: batches are counted, not drawn
+    g_frameArena = new FrameArena(m_frameArenaConfig);
+    g_textCache  = new TextLayoutCache(m_textLayoutCacheConfig);
+
+    g_jobScheduler = new JobScheduler(m_jobSchedulerConfig);     // Before any command that may ParallelFor
+    g_ioScheduler  = new JobScheduler(m_ioSchedulerConfig);      // File loads, so they never hold a compute worker
+    g_scriptRunner = new ScriptRunner(m_scriptRunnerConfig);
+    g_shaderCache  = new ShaderCache(m_shaderCacheConfig, GetD3DShaderCompiler());
+
+    g_assetStreamer = new AssetStreamer(m_assetStreamerConfig);
+
+    m_threadUsage.AddSource(g_jobScheduler->GetConfig().m_threads.m_name, &g_jobScheduler->GetUsage());
+    m_threadUsage.AddSource(g_ioScheduler->GetConfig().m_threads.m_name, &g_ioScheduler->GetUsage());
+    m_threadUsage.AddSource(m_binaryLogConfig.m_thread.m_name, &g_binaryLog->GetUsage());
+
+    if (g_binaryLog->GetArchive() != nullptr)
+    {
+        m_threadUsage.AddSource(m_binaryLogConfig.m_thread.m_name, &g_binaryLog->GetArchive()->GetUsage());
+    }
+
+    g_eventDispatcher->Subscribe(g_eventDispatcher->Intern("ScriptCompleted"), OnScriptFinished);
+    g_eventDispatcher->Subscribe(g_eventDispatcher->Intern("ScriptCancelled"), OnScriptFinished);
+
+    // Removing 'Window' and 'Renderer' from core.subsystems in EngineSubsystems.json ("headless_mode") leaves both null.
+    m_isHeadless = g_window == nullptr || g_renderer == nullptr;
+
     g_eventSystem->SubscribeEventCallbackFunction("OnCloseButtonClicked", OnCloseButtonClicked);
     g_eventSystem->SubscribeEventCallbackFunction("quit", OnCloseButtonClicked);
 
@@ -80,6 +165,7 @@ void App::Startup()
     g_eventSystem->SubscribeEventCallbackFunction("ChangeMap", Command_ChangeMap);
     g_eventSystem->SubscribeEventCallbackFunction("SpawnActor", Command_SpawnActor);
     g_eventSystem->SubscribeEventCallbackFunction("RunScript", Command_RunScript);
+    g_eventSystem->SubscribeEventCallbackFunction("CancelScript", Command_CancelScript);
     g_eventSystem->SubscribeEventCallbackFunction("TestTrigger", Command_TestTrigger);
 
     // SD4-A3a: Subscribe member function event handler
@@ -88,15 +174,45 @@ void App::Startup()
     // SD4-A3c: Register font demo commands
     g_eventSystem->SubscribeEventCallbackFunction("TestFont", Command_TestFont);
     g_eventSystem->SubscribeEventCallbackFunction("FontEffect", Command_FontEffect);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchText", Command_BenchText);
+    g_eventSystem->SubscribeEventCallbackFunction("BakeSDF", Command_BakeSDF);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchAutoWidth", Command_BenchAutoWidth);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchEvents", Command_BenchEvents);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchProperties", Command_BenchProperties);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchScripts", Command_BenchScripts);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchLog", Command_BenchLog);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchJobs", Command_BenchJobs);
+    g_eventSystem->SubscribeEventCallbackFunction("LogQuery", Command_LogQuery);
+    g_eventSystem->SubscribeEventCallbackFunction("LogArchive", Command_LogArchive);
+    g_eventSystem->SubscribeEventCallbackFunction("FramePacing", Command_FramePacing);
+    g_eventSystem->SubscribeEventCallbackFunction("Profiler", Command_Profiler);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchVerts", Command_BenchVerts);
+    g_eventSystem->SubscribeEventCallbackFunction("FrameArena", Command_FrameArena);
+    g_eventSystem->SubscribeEventCallbackFunction("Threads", Command_Threads);
+    g_eventSystem->SubscribeEventCallbackFunction("Assets", Command_Assets);
+    g_eventSystem->SubscribeEventCallbackFunction("AssetPack", Command_AssetPack);
+    g_eventSystem->SubscribeEventCallbackFunction("ShaderCache", Command_ShaderCache);
+
+    if (m_isHeadless)
+    {
+        DAEMON_LOG(LogGame, eLogVerbosity::Display, Stringf("(App)(headless) fixedTimeStepHz=%.1f frameCount=%d realTime=%s",
+                   m_frameLoopConfig.m_fixedTimeStepHz, m_frameLoopConfig.m_headlessFrameCount, m_frameLoopConfig.m_isHeadlessRealTime ? "true" : "false"));
+
+        m_simulationClock = new FixedStepClock();
+        g_game            = new Game();
+        return;
+    }
 
-    // SD4-A3c: Load fonts at different tiers
-    s_tier1Font  = g_resourceSubsystem->CreateOrGetBitmapFontFromFile("Data/Fonts/SquirrelFixedFont"); // Tier 1 (no .fnt)
-    s_tier3Font  = g_resourceSubsystem->CreateOrGetBitmapFontFromFile("Data/Fonts/DaemonFont");        // Tier 3 (has .fnt)
-    s_sdfFont    = g_resourceSubsystem->CreateOrGetBitmapFontFromFile("Data/Fonts/SDFDaemonFont");     // Tier 4 (SDF .fnt)
+    // SD4-A3c: Fonts at different tiers and their shaders stream in over the first frames
+    s_tier3GlyphTable = new FontGlyphTable();
+    s_sdfGlyphTable   = new FontGlyphTable();
+    RequestFontDemoAssets(eJobPriority::BACKGROUND);
 
-    // SD4-A3c: Load shaders
-    s_sdfShader  = g_resourceSubsystem->CreateOrGetShaderFromFile("Data/Shaders/SDF");
-    s_fontShader = g_resourceSubsystem->CreateOrGetShaderFromFile("Data/Shaders/Font", eVertexType::VERTEX_FONT);
+    s_autoWidthScan  = new GlyphWidthScan();
+    s_autoWidthTable = new FontGlyphTable();
+    g_eventDispatcher->Subscribe(g_eventDispatcher->Intern("AutoWidthsReady"), OnAutoWidthsReady);
+
+    m_framePacer = new FramePacer(m_framePacingConfig);
 
     g_game = new Game();
 }
@@ -107,20 +223,70 @@ void App::Startup()
 void App::Shutdown()
 {
     GAME_SAFE_RELEASE(g_game);
-
+    GAME_SAFE_RELEASE(m_simulationClock);
+    GAME_SAFE_RELEASE(s_bakedSdfTexture);
+    GAME_SAFE_RELEASE(m_framePacer);
+    GAME_SAFE_RELEASE(s_autoWidthTable);
+    GAME_SAFE_RELEASE(s_autoWidthScan);         // Waits for a scan still running on g_ioScheduler
+    GAME_SAFE_RELEASE(s_sdfGlyphTable);
+    GAME_SAFE_RELEASE(s_tier3GlyphTable);
+    g_eventDispatcher->Unsubscribe(g_eventDispatcher->Intern("AutoWidthsReady"), OnAutoWidthsReady);
+    g_eventDispatcher->Unsubscribe(g_eventDispatcher->Intern("ScriptCancelled"), OnScriptFinished);
+    g_eventDispatcher->Unsubscribe(g_eventDispatcher->Intern("ScriptCompleted"), OnScriptFinished);
+    GAME_SAFE_RELEASE(g_scriptRunner);
+    GAME_SAFE_RELEASE(g_assetStreamer);         // Waits for its jobs on g_ioScheduler, releases its textures
+    GAME_SAFE_RELEASE(g_shaderCache);
+    GAME_SAFE_RELEASE(g_ioScheduler);           // Its jobs may ParallelFor on g_jobScheduler
+    GAME_SAFE_RELEASE(g_jobScheduler);
+    GAME_SAFE_RELEASE(g_textCache);
+    GAME_SAFE_RELEASE(g_frameArena);
+    GAME_SAFE_RELEASE(g_drawList);
+    GAME_SAFE_RELEASE(g_eventDispatcher);
+
+    g_eventSystem->UnsubscribeEventCallbackFunction("LogArchive", Command_LogArchive);
+    g_eventSystem->UnsubscribeEventCallbackFunction("LogQuery", Command_LogQuery);
+    g_eventSystem->UnsubscribeEventCallbackFunction("BenchJobs", Command_BenchJobs);
+    g_eventSystem->UnsubscribeEventCallbackFunction("BenchLog", Command_BenchLog);
+    g_eventSystem->UnsubscribeEventCallbackFunction("BenchScripts", Command_BenchScripts);
+    g_eventSystem->UnsubscribeEventCallbackFunction("BenchProperties", Command_BenchProperties);
+    g_eventSystem->UnsubscribeEventCallbackFunction("BenchEvents", Command_BenchEvents);
+    g_eventSystem->UnsubscribeEventCallbackFunction("BenchAutoWidth", Command_BenchAutoWidth);
+    g_eventSystem->UnsubscribeEventCallbackFunction("BakeSDF", Command_BakeSDF);
+    g_eventSystem->UnsubscribeEventCallbackFunction("BenchText", Command_BenchText);
+    g_eventSystem->UnsubscribeEventCallbackFunction("ShaderCache", Command_ShaderCache);
+    g_eventSystem->UnsubscribeEventCallbackFunction("AssetPack", Command_AssetPack);
+    g_eventSystem->UnsubscribeEventCallbackFunction("Assets", Command_Assets);
+    g_eventSystem->UnsubscribeEventCallbackFunction("Threads", Command_Threads);
+    g_eventSystem->UnsubscribeEventCallbackFunction("FrameArena", Command_FrameArena);
+    g_eventSystem->UnsubscribeEventCallbackFunction("BenchVerts", Command_BenchVerts);
+    g_eventSystem->UnsubscribeEventCallbackFunction("Profiler", Command_Profiler);
+    g_eventSystem->UnsubscribeEventCallbackFunction("FramePacing", Command_FramePacing);
+    g_eventSystem->UnsubscribeEventCallbackFunction("CancelScript", Command_CancelScript);
     g_eventSystem->UnsubscribeEventCallbackFunction("quit", OnCloseButtonClicked);
     g_eventSystem->UnsubscribeEventCallbackFunction("OnCloseButtonClicked", OnCloseButtonClicked);
 
+    // Last game system out, while the Engine's LogSubsystem can still take the forwarded lines
+    GAME_SAFE_RELEASE(g_binaryLog);
+    GAME_SAFE_RELEASE(g_assetPack);
+
     GEngine::Get().Shutdown();
+
+    // After the engine has joined its worker threads, so no PROFILE_SCOPE can still be running
+    GAME_SAFE_RELEASE(g_profiler);
 }
 
 //----------------------------------------------------------------------------------------------------
 void App::RunMainLoop()
 {
+    if (m_isHeadless)
+    {
+        RunHeadlessLoop();
+        return;
+    }
+
     // Program main loop; keep running frames until it's time to quit
     while (!m_isQuitting)
     {
-        // Sleep(16); // Temporary code to "slow down" our app to ~60Hz until we have proper frame timing in
         RunFrame();
     }
 }
@@ -130,10 +296,292 @@ void App::RunMainLoop()
 //
 void App::RunFrame()
 {
+    g_profiler->BeginFrame();   // Collect last frame's zones from every thread
+
     BeginFrame();   // Engine pre-frame stuff
     Update();       // Game updates / moves / spawns / hurts / kills stuff
     Render();       // Game draws current state of things
     EndFrame();     // Engine post-frame stuff
+
+    // Sleep-then-spin until the frame budget is used; throttles further while the window is in the background
+    PROFILE_SCOPE("FramePacer::WaitForNextFrame");
+    m_framePacer->WaitForNextFrame(m_doesWindowHaveFocus);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Headless main loop; runs until quit, or until m_headlessFrameCount simulation steps have been taken (0 = unlimited).
+void App::RunHeadlessLoop()
+{
+    int const frameCount = m_frameLoopConfig.m_headlessFrameCount;
+
+    m_headlessStartSeconds = GetCurrentTimeSeconds();
+    m_lastHeadlessSeconds  = m_headlessStartSeconds;
+
+    while (!m_isQuitting && (frameCount <= 0 || m_simulatedFrameCount < frameCount))
+    {
+        RunHeadlessFrame();
+    }
+
+    DAEMON_LOG(LogGame, eLogVerbosity::Display, Stringf("(App)(headless) simulated %d frames in %.3f seconds",
+               m_simulatedFrameCount, GetCurrentTimeSeconds() - m_headlessStartSeconds));
+
+    // The game clock must have seen exactly one fixed step per simulated frame, whatever the wall time
+    Clock const& gameClock       = g_game->GetClock();
+    double const expectedSeconds = static_cast<double>(m_simulatedFrameCount) / static_cast<double>(m_frameLoopConfig.m_fixedTimeStepHz);
+    bool const   isTimeExact     = std::abs(gameClock.GetTotalSeconds() - expectedSeconds) <= 1.0e-9 * (expectedSeconds + 1.0);
+    bool const   isCountExact    = gameClock.GetFrameCount() == m_simulatedFrameCount;
+
+    DAEMON_LOG(LogGame, isTimeExact && isCountExact ? eLogVerbosity::Display : eLogVerbosity::Error,
+               Stringf("(App)(headless) game clock %s: %.6f seconds over %d frames, expected %.6f over %d",
+                       isTimeExact && isCountExact ? "is fixed-step" : "DRIFTED from the fixed step",
+                       gameClock.GetTotalSeconds(), gameClock.GetFrameCount(), expectedSeconds, m_simulatedFrameCount));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// One headless frame: no Window/Renderer/ImGui/DevConsole work, and Game::Update stepped on a fixed-timestep accumulator.
+///
+/// Each simulation step advances m_simulationClock, the game clock's parent, by exactly one fixed step, so the game
+/// and its scripts see the same deltas whatever the wall time. The system clock is not ticked here: every clock is
+/// its descendant, so ticking it would add wall time to the game clock too. In real-time mode the accumulator is fed
+/// with the wall time since the last frame, so the steps keep wall-clock pace; otherwise every frame takes exactly
+/// one step and the loop runs as fast as the CPU allows. Game time is then the same on every run; anything else that
+/// reads wall time (streaming, job timing) is not.
+void App::RunHeadlessFrame()
+{
+    g_profiler->BeginFrame();
+
+    PROFILE_SCOPE("App::RunHeadlessFrame");
+
+    g_eventSystem->BeginFrame();
+    g_eventDispatcher->DrainPostedEvents();
+    if (g_input != nullptr) g_input->BeginFrame();
+    if (g_audio != nullptr) g_audio->BeginFrame();
+
+    g_assetStreamer->Update();
+
+    double const fixedDeltaSeconds = 1.0 / static_cast<double>(m_frameLoopConfig.m_fixedTimeStepHz);
+    double const nowSeconds        = GetCurrentTimeSeconds();
+
+    if (m_frameLoopConfig.m_isHeadlessRealTime)
+    {
+        m_accumulatedSeconds += nowSeconds - m_lastHeadlessSeconds;
+    }
+    else
+    {
+        m_accumulatedSeconds += fixedDeltaSeconds;
+    }
+
+    m_lastHeadlessSeconds = nowSeconds;
+
+    while (m_accumulatedSeconds >= fixedDeltaSeconds && !m_isQuitting)
+    {
+        m_simulationClock->Step(fixedDeltaSeconds);
+        g_game->Update();
+        g_scriptRunner->Update(g_game->GetClock());
+        m_accumulatedSeconds -= fixedDeltaSeconds;
+        ++m_simulatedFrameCount;
+    }
+
+    g_eventSystem->EndFrame();
+    if (g_input != nullptr) g_input->EndFrame();
+    if (g_audio != nullptr) g_audio->EndFrame();
+
+    ResetFrameArena();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool App::IsHeadless() const
+{
+    return m_isHeadless;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Parent for the game clock: stepped by the headless loop, nullptr when windowed (the system clock drives it).
+Clock* App::GetSimulationClock() const
+{
+    return m_simulationClock;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Per-pool thread utilization for the debug HUD; empty when hidden.
+String const& App::GetThreadUsageSummary() const
+{
+    static String const s_hidden;
+
+    return m_isThreadUsageShown ? m_threadUsage.GetSummary() : s_hidden;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Read Data/GameConfig.xml; missing file or attributes keep the defaults in sFrameLoopConfig.
+void App::LoadGameConfig()
+{
+    XmlDocument    document;
+    sAssetFileData file;
+
+    if (!ReadAssetFile("Data/GameConfig.xml", file) || document.Parse(file.GetText().data(), file.GetText().size()) != tinyxml2::XML_SUCCESS)
+    {
+        DAEMON_LOG(LogGame, eLogVerbosity::Warning, "(App)(LoadGameConfig) Data/GameConfig.xml not found, using defaults");
+        return;
+    }
+
+    XmlElement const* rootElement = document.RootElement();
+    if (rootElement == nullptr) return;
+
+    XmlElement const* frameLoopElement = rootElement->FirstChildElement("FrameLoop");
+
+    XmlElement const* framePacingElement = rootElement->FirstChildElement("FramePacing");
+    XmlElement const* profilerElement    = rootElement->FirstChildElement("Profiler");
+    XmlElement const* frameArenaElement  = rootElement->FirstChildElement("FrameArena");
+    XmlElement const* textCacheElement   = rootElement->FirstChildElement("TextLayoutCache");
+    XmlElement const* jobsElement        = rootElement->FirstChildElement("JobScheduler");
+    XmlElement const* threadingElement   = rootElement->FirstChildElement("Threading");
+    XmlElement const* streamingElement   = rootElement->FirstChildElement("AssetStreaming");
+    XmlElement const* shaderCacheElement = rootElement->FirstChildElement("ShaderCache");
+    XmlElement const* eventQueueElement  = rootElement->FirstChildElement("EventQueue");
+    XmlElement const* scriptsElement     = rootElement->FirstChildElement("ScriptRunner");
+    XmlElement const* logElement         = rootElement->FirstChildElement("Log");
+    XmlElement const* logArchiveElement  = rootElement->FirstChildElement("LogArchive");
+
+    if (frameLoopElement != nullptr)
+    {
+        m_frameLoopConfig.m_fixedTimeStepHz    = ParseXmlAttribute(*frameLoopElement, "fixedTimeStepHz", m_frameLoopConfig.m_fixedTimeStepHz);
+        m_frameLoopConfig.m_headlessFrameCount = ParseXmlAttribute(*frameLoopElement, "headlessFrameCount", m_frameLoopConfig.m_headlessFrameCount);
+        m_frameLoopConfig.m_isHeadlessRealTime = ParseXmlAttribute(*frameLoopElement, "headlessRealTime", m_frameLoopConfig.m_isHeadlessRealTime);
+    }
+
+    if (framePacingElement != nullptr)
+    {
+        m_framePacingConfig.m_targetHz         = ParseXmlAttribute(*framePacingElement, "targetHz", m_framePacingConfig.m_targetHz);
+        m_framePacingConfig.m_unfocusedHz      = ParseXmlAttribute(*framePacingElement, "unfocusedHz", m_framePacingConfig.m_unfocusedHz);
+        m_framePacingConfig.m_minSpinSeconds   = ParseXmlAttribute(*framePacingElement, "minSpinMs", m_framePacingConfig.m_minSpinSeconds * 1000.f) / 1000.f;
+        m_framePacingConfig.m_isHistogramShown = ParseXmlAttribute(*framePacingElement, "showHistogram", m_framePacingConfig.m_isHistogramShown);
+    }
+
+    if (profilerElement != nullptr)
+    {
+        m_frameProfilerConfig.m_isEnabled        = ParseXmlAttribute(*profilerElement, "enabled", m_frameProfilerConfig.m_isEnabled);
+        m_frameProfilerConfig.m_isOverlayShown   = ParseXmlAttribute(*profilerElement, "showOverlay", m_frameProfilerConfig.m_isOverlayShown);
+        m_frameProfilerConfig.m_recordsPerThread = ParseXmlAttribute(*profilerElement, "recordsPerThread", m_frameProfilerConfig.m_recordsPerThread);
+    }
+
+    if (frameArenaElement != nullptr)
+    {
+        m_frameArenaConfig.m_blockKiB = ParseXmlAttribute(*frameArenaElement, "blockKiB", m_frameArenaConfig.m_blockKiB);
+    }
+
+    if (textCacheElement != nullptr)
+    {
+        m_textLayoutCacheConfig.m_capacity = ParseXmlAttribute(*textCacheElement, "capacity", m_textLayoutCacheConfig.m_capacity);
+    }
+
+    if (jobsElement != nullptr)
+    {
+        m_jobSchedulerConfig.m_dequeCapacity = ParseXmlAttribute(*jobsElement, "dequeCapacity", m_jobSchedulerConfig.m_dequeCapacity);
+    }
+
+    if (threadingElement != nullptr)
+    {
+        m_isThreadUsageShown = ParseXmlAttribute(*threadingElement, "showUtilization", m_isThreadUsageShown);
+
+        // Each <Pool> is matched to a pool by name
+        sThreadPoolConfig* const pools[] = { &m_jobSchedulerConfig.m_threads, &m_ioSchedulerConfig.m_threads, &m_binaryLogConfig.m_thread };
+
+        for (XmlElement const* poolElement = threadingElement->FirstChildElement("Pool"); poolElement != nullptr; poolElement = poolElement->NextSiblingElement("Pool"))
+        {
+            String const name = ParseXmlAttribute(*poolElement, "name", String());
+
+            for (sThreadPoolConfig* pool : pools)
+            {
+                if (pool->m_name != name) continue;
+
+                pool->m_threadCount      = ParseXmlAttribute(*poolElement, "threads", pool->m_threadCount);
+                pool->m_affinity         = ParseXmlAttribute(*poolElement, "affinity", pool->m_affinity);
+                pool->m_firstCore        = ParseXmlAttribute(*poolElement, "firstCore", pool->m_firstCore);
+                pool->m_stackKiB         = ParseXmlAttribute(*poolElement, "stackKiB", pool->m_stackKiB);
+                pool->m_spinMicroseconds = ParseXmlAttribute(*poolElement, "spinMicroseconds", pool->m_spinMicroseconds);
+            }
+        }
+    }
+
+    if (streamingElement != nullptr)
+    {
+        m_assetStreamerConfig.m_uploadBudgetSeconds = ParseXmlAttribute(*streamingElement, "uploadBudgetMs", m_assetStreamerConfig.m_uploadBudgetSeconds * 1000.f) / 1000.f;
+    }
+
+    if (shaderCacheElement != nullptr)
+    {
+        m_shaderCacheConfig.m_directory = ParseXmlAttribute(*shaderCacheElement, "directory", m_shaderCacheConfig.m_directory);
+
+        // Each <Shader> adds its vertex and pixel stage; defines="NAME=VALUE;NAME"
+        for (XmlElement const* shaderElement = shaderCacheElement->FirstChildElement("Shader"); shaderElement != nullptr; shaderElement = shaderElement->NextSiblingElement("Shader"))
+        {
+            String const path           = ParseXmlAttribute(*shaderElement, "path", String());
+            String const vertexTypeName = ParseXmlAttribute(*shaderElement, "vertexType", String("PCU"));
+            String const defineList     = ParseXmlAttribute(*shaderElement, "defines", String());
+
+            if (path.empty()) continue;
+
+            eVertexType vertexType = eVertexType::VERTEX_PCU;
+
+            if (vertexTypeName == "PCUTBN") vertexType = eVertexType::VERTEX_PCUTBN;
+            if (vertexTypeName == "Font") vertexType = eVertexType::VERTEX_FONT;
+
+            std::vector<String> defines;
+
+            for (size_t start = 0; start < defineList.size();)
+            {
+                size_t const end = std::min(defineList.find(';', start), defineList.size());
+
+                if (end > start) defines.push_back(defineList.substr(start, end - start));
+
+                start = end + 1;
+            }
+
+            AddShaderStages(m_shaderCacheConfig.m_variants, path, vertexType, defines);
+        }
+    }
+
+    if (eventQueueElement != nullptr)
+    {
+        m_eventDispatcherConfig.m_postCapacity = ParseXmlAttribute(*eventQueueElement, "postCapacity", m_eventDispatcherConfig.m_postCapacity);
+    }
+
+    if (scriptsElement != nullptr)
+    {
+        m_scriptRunnerConfig.m_budgetSeconds = ParseXmlAttribute(*scriptsElement, "budgetMs", m_scriptRunnerConfig.m_budgetSeconds * 1000.f) / 1000.f;
+    }
+
+    if (logElement != nullptr)
+    {
+        m_binaryLogConfig.m_maxEntries          = ParseXmlAttribute(*logElement, "maxEntries", m_binaryLogConfig.m_maxEntries);
+        m_binaryLogConfig.m_recordsPerThread    = ParseXmlAttribute(*logElement, "recordsPerThread", m_binaryLogConfig.m_recordsPerThread);
+        m_binaryLogConfig.m_batchSize           = ParseXmlAttribute(*logElement, "batchSize", m_binaryLogConfig.m_batchSize);
+        m_binaryLogConfig.m_pollSeconds         = ParseXmlAttribute(*logElement, "pollMs", m_binaryLogConfig.m_pollSeconds * 1000.f) / 1000.f;
+        m_binaryLogConfig.m_filePath            = ParseXmlAttribute(*logElement, "file", m_binaryLogConfig.m_filePath);
+        m_binaryLogConfig.m_isForwardedToEngine = ParseXmlAttribute(*logElement, "forwardToEngine", m_binaryLogConfig.m_isForwardedToEngine);
+    }
+
+    if (logArchiveElement != nullptr)
+    {
+        sLogArchiveConfig& archiveConfig = m_binaryLogConfig.m_archive;
+
+        archiveConfig.m_archiveDirectory = ParseXmlAttribute(*logArchiveElement, "directory", archiveConfig.m_archiveDirectory);
+        archiveConfig.m_segmentMiB       = ParseXmlAttribute(*logArchiveElement, "segmentMiB", archiveConfig.m_segmentMiB);
+        archiveConfig.m_segmentMinutes   = ParseXmlAttribute(*logArchiveElement, "segmentMinutes", archiveConfig.m_segmentMinutes);
+        archiveConfig.m_blockKiB         = ParseXmlAttribute(*logArchiveElement, "blockKiB", archiveConfig.m_blockKiB);
+        archiveConfig.m_maxArchives      = ParseXmlAttribute(*logArchiveElement, "maxArchives", archiveConfig.m_maxArchives);
+        archiveConfig.m_maxArchiveMiB    = ParseXmlAttribute(*logArchiveElement, "maxArchiveMiB", archiveConfig.m_maxArchiveMiB);
+    }
+
+    if (m_frameLoopConfig.m_fixedTimeStepHz <= 0.f)
+    {
+        m_frameLoopConfig.m_fixedTimeStepHz = 60.f;
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -155,21 +603,50 @@ STATIC void App::RequestQuit()
 //----------------------------------------------------------------------------------------------------
 void App::BeginFrame() const
 {
-    g_eventSystem->BeginFrame();
-    g_window->BeginFrame();
-    g_renderer->BeginFrame();
-    DebugRenderBeginFrame();
-    g_devConsole->BeginFrame();
-    g_input->BeginFrame();
-    g_audio->BeginFrame();
+    PROFILE_SCOPE("App::BeginFrame");
+
+    {
+        PROFILE_SCOPE("EventSystem::BeginFrame");
+        g_eventSystem->BeginFrame();
+        g_eventDispatcher->DrainPostedEvents();     // Events posted from any thread since last frame
+    }
+    {
+        PROFILE_SCOPE("Window::BeginFrame");
+        g_window->BeginFrame();
+    }
+    {
+        PROFILE_SCOPE("Renderer::BeginFrame");
+        g_renderer->BeginFrame();
+    }
+    {
+        PROFILE_SCOPE("DebugRenderBeginFrame");
+        DebugRenderBeginFrame();
+    }
+    {
+        PROFILE_SCOPE("DevConsole::BeginFrame");
+        g_devConsole->BeginFrame();
+    }
+    {
+        PROFILE_SCOPE("InputSystem::BeginFrame");
+        g_input->BeginFrame();
+    }
+    {
+        PROFILE_SCOPE("AudioSystem::BeginFrame");
+        g_audio->BeginFrame();
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
 void App::Update()
 {
+    PROFILE_SCOPE("App::Update");
+
     Clock::TickSystemClock();
+    m_threadUsage.Update(GetCurrentTimeSeconds());
+    g_assetStreamer->Update();      // Uploads within its budget; OnDone callbacks see them before the game does
     UpdateCursorMode();
     g_game->Update();
+    g_scriptRunner->Update(g_game->GetClock());     // Script commands see this frame's game state
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -181,6 +658,8 @@ void App::Update()
 //
 void App::Render() const
 {
+    PROFILE_SCOPE("App::Render");
+
     Rgba8 const clearColor = Rgba8::GREY;
 
     g_renderer->ClearScreen(clearColor);
@@ -192,6 +671,16 @@ void App::Render() const
         RenderFontDemo();
     }
 
+    if (m_framePacer->GetConfig().m_isHistogramShown)
+    {
+        RenderFramePacingHistogram();
+    }
+
+    if (g_profiler->GetConfig().m_isOverlayShown)
+    {
+        RenderProfilerOverlay();
+    }
+
     AABB2 const box = AABB2(Vec2::ZERO, Vec2(1600.f, 30.f));
 
     g_devConsole->Render(box);
@@ -200,13 +689,66 @@ void App::Render() const
 //----------------------------------------------------------------------------------------------------
 void App::EndFrame() const
 {
-    g_eventSystem->EndFrame();
-    g_window->EndFrame();
-    g_renderer->EndFrame();
-    DebugRenderEndFrame();
-    g_devConsole->EndFrame();
-    g_input->EndFrame();
-    g_audio->EndFrame();
+    PROFILE_SCOPE("App::EndFrame");
+
+    {
+        PROFILE_SCOPE("EventSystem::EndFrame");
+        g_eventSystem->EndFrame();
+    }
+    {
+        PROFILE_SCOPE("Window::EndFrame");
+        g_window->EndFrame();
+    }
+    {
+        PROFILE_SCOPE("Renderer::EndFrame");
+        g_renderer->EndFrame();
+    }
+    {
+        PROFILE_SCOPE("DebugRenderEndFrame");
+        DebugRenderEndFrame();
+    }
+    {
+        PROFILE_SCOPE("DevConsole::EndFrame");
+        g_devConsole->EndFrame();
+    }
+    {
+        PROFILE_SCOPE("InputSystem::EndFrame");
+        g_input->EndFrame();
+    }
+    {
+        PROFILE_SCOPE("AudioSystem::EndFrame");
+        g_audio->EndFrame();
+    }
+
+    ResetFrameArena();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Everything acquired from g_frameArena this frame is released here; also reports a finished
+/// FrameArena check=N run.
+void App::ResetFrameArena() const
+{
+    g_frameArena->Reset();
+
+    sFrameArenaCheck check;
+
+    if (g_frameArena->ConsumeCheckResult(check))
+    {
+        bool const   isClean = check.m_allocatingFrames == 0;
+        String const result  = Stringf("[FrameArena] %d frames: %d allocated (%llu heap allocations, max %llu in one frame)",
+                                       check.m_frameCount,
+                                       check.m_allocatingFrames,
+                                       static_cast<unsigned long long>(check.m_totalAllocations),
+                                       static_cast<unsigned long long>(check.m_maxFrameAllocations));
+
+        DAEMON_LOG(LogGame, isClean ? eLogVerbosity::Display : eLogVerbosity::Warning, result);
+
+        if (g_devConsole != nullptr)
+        {
+            g_devConsole->AddLine(isClean ? DevConsole::INFO_MAJOR : DevConsole::ERROR, result);
+        }
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -218,6 +760,8 @@ void App::UpdateCursorMode()
     eCursorMode const mode                 = shouldUsePointerMode ? eCursorMode::POINTER : eCursorMode::FPS;
 
     g_input->SetCursorMode(mode);
+
+    m_doesWindowHaveFocus = doesWindowHasFocus;
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -384,16 +928,82 @@ STATIC bool App::Command_SpawnActor(EventArgs& args)
 //----------------------------------------------------------------------------------------------------
 STATIC bool App::Command_RunScript(EventArgs& args)
 {
-    std::string file = args.GetValue("file", "");
+    std::string file       = args.GetValue("file", "");
+    bool const  isCompiled = args.GetValue("compiled", true);
+    bool const  isSliced   = args.GetValue("sliced", true);
 
     if (file.empty())
     {
-        g_devConsole->AddLine(DevConsole::ERROR, "RunScript: missing 'file' argument. Usage: RunScript file=\"path/to/script.xml\"");
+        g_devConsole->AddLine(DevConsole::ERROR, "RunScript: missing 'file' argument. Usage: RunScript file=\"path/to/script.xml\" compiled=true sliced=true");
         return false;
     }
 
     g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[RunScript] Executing: %s", file.c_str()));
-    g_devConsole->ExecuteXmlCommandScriptFile(file);
+
+    if (!isCompiled)
+    {
+        g_devConsole->ExecuteXmlCommandScriptFile(file);
+        return false;
+    }
+
+    CommandScript script;
+
+    if (!script.Load(file))
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, Stringf("[RunScript] Could not load %s", file.c_str()));
+        return false;
+    }
+
+    sCommandScriptStats const& stats = script.GetStats();
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("[RunScript] %d commands %s in %.3f ms", stats.m_commandCount,
+                                                          stats.m_wasLoadedFromBlob ? "read from .cmdc" : "compiled", stats.m_loadSeconds * 1000.0));
+
+    if (!isSliced)
+    {
+        script.Execute();
+        return false;
+    }
+
+    int const runId = g_scriptRunner->Start(std::move(script), file);
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("[RunScript] Running as script %d, %.2f ms per frame (CancelScript run=%d)", runId,
+                                                          g_scriptRunner->GetConfig().m_budgetSeconds * 1000.f, runId));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// CancelScript: stop a script started by RunScript, or every one of them
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_CancelScript(EventArgs& args)
+{
+    int const runId = args.GetValue("run", 0);
+
+    if (runId == 0)
+    {
+        int const cancelledCount = g_scriptRunner->CancelAll();
+        g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("[CancelScript] Cancelled %d scripts", cancelledCount));
+        return false;
+    }
+
+    if (!g_scriptRunner->Cancel(runId))
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, Stringf("[CancelScript] No running script %d. Usage: CancelScript run=<id> (0 = all)", runId));
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Subscribed to both ScriptCompleted and ScriptCancelled on g_eventDispatcher
+//
+STATIC bool App::OnScriptFinished(FlatProperties& args)
+{
+    int const runId        = args.GetValue("run"_hcis, 0);
+    int const cursor       = args.GetValue("command"_hcis, 0);
+    int const commandCount = args.GetValue("count"_hcis, 0);
+
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("[RunScript] Script %d (%s) %s after %d of %d commands", runId, args.GetText("script"_hcis, ""),
+                                                          cursor == commandCount ? "finished" : "cancelled", cursor, commandCount));
 
     return false;
 }
@@ -407,26 +1017,52 @@ STATIC bool App::Command_TestTrigger(EventArgs& args)
 
     g_devConsole->AddLine(DevConsole::INFO_MAJOR, "[TestTrigger] Executing embedded XML trigger block...");
 
-    // Simulate an embedded trigger block like <Trigger type="died">
-    char const* triggerXml =
-        "<Trigger type=\"died\">"
-        "    <ChangeMap map=\"VictoryScreen\" startPos=\"5,5\"/>"
-        "    <SpawnActor type=\"TreasureChest\" pos=\"10,10\" name=\"Reward\" faction=\"neutral\"/>"
-        "</Trigger>";
-
-    XmlDocument doc;
-    doc.Parse(triggerXml);
-
-    XmlElement const* triggerElement = doc.RootElement();
+    // Simulate an embedded trigger block like <Trigger type="died">, compiled on first use and
+    // replayed from then on
+    static CommandScript s_trigger;
 
-    if (triggerElement)
+    if (s_trigger.GetCommandCount() == 0)
     {
-        g_devConsole->ExecuteXmlCommandScriptNode(*triggerElement);
+        s_trigger.CompileXmlText(
+            "<Trigger type=\"died\">"
+            "    <ChangeMap map=\"VictoryScreen\" startPos=\"5,5\"/>"
+            "    <SpawnActor type=\"TreasureChest\" pos=\"10,10\" name=\"Reward\" faction=\"neutral\"/>"
+            "</Trigger>");
     }
 
+    s_trigger.Execute();
+
     return false;
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Request the font demo's fonts and shaders; each static is set as its asset arrives. Asking again
+/// with a more urgent priority moves the ones not yet created up the queue, and isWaiting finishes
+/// them all before returning, for commands that cannot go on without them.
+STATIC void App::RequestFontDemoAssets(eJobPriority const priority, bool const isWaiting)
+{
+    AssetFuture<BitmapFont> const tier1Font  = g_assetStreamer->RequestFontAsync("Data/Fonts/SquirrelFixedFont", priority);     // Tier 1 (no .fnt)
+    AssetFuture<BitmapFont> const tier3Font  = g_assetStreamer->RequestFontAsync("Data/Fonts/DaemonFont", priority);            // Tier 3 (has .fnt)
+    AssetFuture<BitmapFont> const sdfFont    = g_assetStreamer->RequestFontAsync("Data/Fonts/SDFDaemonFont", priority);         // Tier 4 (SDF .fnt)
+    AssetFuture<Shader> const     sdfShader  = g_assetStreamer->RequestShaderAsync("Data/Shaders/SDF", eVertexType::VERTEX_PCU, priority);
+    AssetFuture<Shader> const     fontShader = g_assetStreamer->RequestShaderAsync("Data/Shaders/Font", eVertexType::VERTEX_FONT, priority);
+
+    g_assetStreamer->OnDone(tier1Font, [](BitmapFont* font) { s_tier1Font = font; });
+    g_assetStreamer->OnDone(tier3Font, [](BitmapFont* font) { s_tier3Font = font; UseGlyphTable(font, s_tier3GlyphTable, "Data/Fonts/DaemonFont.fnt"); });
+    g_assetStreamer->OnDone(sdfFont, [](BitmapFont* font) { s_sdfFont = font; UseGlyphTable(font, s_sdfGlyphTable, "Data/Fonts/SDFDaemonFont.fnt"); });
+    g_assetStreamer->OnDone(sdfShader, [](Shader* shader) { s_sdfShader = shader; });
+    g_assetStreamer->OnDone(fontShader, [](Shader* shader) { s_fontShader = shader; });
+
+    if (!isWaiting) return;
+
+    g_assetStreamer->Wait(tier1Font);
+    g_assetStreamer->Wait(tier3Font);
+    g_assetStreamer->Wait(sdfFont);
+    g_assetStreamer->Wait(sdfShader);
+    g_assetStreamer->Wait(fontShader);
+}
+
 //----------------------------------------------------------------------------------------------------
 // SD4-A3c Demo: TestFont command
 //----------------------------------------------------------------------------------------------------
@@ -434,9 +1070,9 @@ STATIC bool App::Command_TestFont(EventArgs& args)
 {
     int const tier = args.GetValue("tier", 0);
 
-    if (tier < 0 || tier > 5)
+    if (tier < 0 || tier > 6)
     {
-        g_devConsole->AddLine(DevConsole::ERROR, "TestFont: tier must be 0-5. Usage: TestFont tier=3");
+        g_devConsole->AddLine(DevConsole::ERROR, "TestFont: tier must be 0-6. Usage: TestFont tier=3");
         return false;
     }
 
@@ -448,46 +1084,1467 @@ STATIC bool App::Command_TestFont(EventArgs& args)
     }
     else
     {
-        char const* tierNames[] = {"", "Tier 1 (Fixed-Width)", "Tier 2 (Auto-Width)", "Tier 3 (BMFont+Kerning)", "Tier 4 (SDF Threshold)", "Tier 5 (VertexFont+Effects)"};
+        char const* tierNames[] = {"", "Tier 1 (Fixed-Width)", "Tier 2 (Auto-Width)", "Tier 3 (BMFont+Kerning)", "Tier 4 (SDF Threshold)", "Tier 5 (VertexFont+Effects)", "Tier 6 (Baked SDF)"};
         g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[TestFont] Showing %s", tierNames[tier]));
 
-        // Tier 2: on-demand auto-width scanning (mutates font in-place for demo)
-        if (tier == 2 && s_tier1Font && s_tier1Font->GetFontTier() < eFontTier::TIER_2)
+        // Whatever is still streaming in is needed now: ahead of other uploads, but no waiting
+        RequestFontDemoAssets(eJobPriority::FRAME_CRITICAL);
+
+        BitmapFont const* const tierFonts[] = { nullptr, s_tier1Font, s_tier1Font, s_tier3Font, s_sdfFont, s_sdfFont, s_bakedSdfFont };
+
+        if (tier <= 5 && tierFonts[tier] == nullptr)
+            g_devConsole->AddLine(DevConsole::INFO_MINOR, "  Font still loading; it shows up as soon as it is ready");
+
+        // Tier 2: auto-width scan runs on g_ioScheduler; OnAutoWidthsReady picks up the result
+        if (tier == 2 && s_autoWidthScan != nullptr && !s_autoWidthTable->IsLoaded() && !s_autoWidthScan->IsBusy())
         {
-            Image fontImage("Data/Fonts/SquirrelFixedFont.png");
-            if (fontImage.GetDimensions().x > 0)
-            {
-                s_tier1Font->ComputeAutoWidths(fontImage);
-                g_devConsole->AddLine(DevConsole::INFO_MINOR, "  Auto-width scanning applied to SquirrelFixedFont");
-            }
+            s_autoWidthScan->Start("Data/Fonts/SquirrelFixedFont.png", sGlyphScanSettings(), g_eventDispatcher->Intern("AutoWidthsReady"));
+            g_devConsole->AddLine(DevConsole::INFO_MINOR, "  Scanning SquirrelFixedFont glyph widths in the background");
         }
 
         if (tier == 1 && s_tier1Font)
             g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Font tier: %d", static_cast<int>(s_tier1Font->GetFontTier())));
-        if (tier == 2 && s_tier1Font)
-            g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Font tier: %d (auto-width)", static_cast<int>(s_tier1Font->GetFontTier())));
+        if (tier == 2 && s_autoWidthTable != nullptr && s_autoWidthTable->IsLoaded())
+            g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Auto-width glyphs: %d", s_autoWidthTable->GetStats().m_glyphCount));
         if ((tier == 3) && s_tier3Font)
             g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Font tier: %d, glyphs loaded via BMFont .fnt", static_cast<int>(s_tier3Font->GetFontTier())));
         if ((tier == 4 || tier == 5) && s_sdfFont)
             g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Font tier: %d, SDF: %s", static_cast<int>(s_sdfFont->GetFontTier()), s_sdfFont->IsSDF() ? "true" : "false"));
+        if (tier == 6 && s_bakedSdfTexture == nullptr)
+            g_devConsole->AddLine(DevConsole::ERROR, "  No baked SDF atlas yet. Run: BakeSDF font=DaemonFont");
+
+        g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Text layout cache: %d layouts, %d hits, %d misses", g_textCache->GetSize(), g_textCache->GetHitCount(), g_textCache->GetMissCount()));
     }
 
     return false;
 }
 
+//----------------------------------------------------------------------------------------------------
+// BakeSDF: turns a plain bitmap font atlas into a signed distance field atlas (cached next to the
+// .png) and shows it with TestFont tier=6. Usage: BakeSDF font=DaemonFont spread=4
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_BakeSDF(EventArgs& args)
+{
+    String const fontName = args.GetValue("font", String("DaemonFont"));
+
+    sSDFBakeSettings settings;
+    settings.m_spreadTexels = args.GetValue("spread", settings.m_spreadTexels);
+
+    if (settings.m_spreadTexels <= 0.f)
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "BakeSDF: spread must be > 0. Usage: BakeSDF font=DaemonFont spread=4");
+        return false;
+    }
+
+    String const fontPath  = Stringf("Data/Fonts/%s", fontName.c_str());
+    String const imagePath = fontPath + ".png";
+
+    // Decoded on g_ioScheduler while the font is created; the bake needs both before it can go on
+    AssetFuture<Image> const      imageRequest = g_assetStreamer->RequestImageAsync(imagePath, eJobPriority::FRAME_CRITICAL);
+    AssetFuture<BitmapFont> const fontRequest  = g_assetStreamer->RequestFontAsync(fontPath, eJobPriority::FRAME_CRITICAL);
+    Image const*                  fontImage    = g_assetStreamer->Wait(imageRequest);
+
+    if (fontImage == nullptr)
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, Stringf("BakeSDF: could not load %s", imagePath.c_str()));
+        return false;
+    }
+
+    IntVec2 const dimensions = fontImage->GetDimensions();
+
+    std::vector<uint8_t> distances;
+    sSDFBakeStats        stats;
+
+    if (!BakeSDFAtlasCached(static_cast<Rgba8 const*>(fontImage->GetRawData()), dimensions, settings, imagePath + ".sdf", distances, stats))
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, Stringf("BakeSDF: could not bake %s", imagePath.c_str()));
+        return false;
+    }
+
+    // White texels with the distance in alpha, which is what Data/Shaders/SDF reads
+    Image sdfImage(dimensions, Rgba8::WHITE);
+
+    for (int y = 0; y < dimensions.y; ++y)
+    {
+        for (int x = 0; x < dimensions.x; ++x)
+        {
+            sdfImage.SetTexelColor(IntVec2(x, y), Rgba8(255, 255, 255, distances[static_cast<size_t>(y) * dimensions.x + x]));
+        }
+    }
+
+    GAME_SAFE_RELEASE(s_bakedSdfTexture);
+    s_bakedSdfTexture = g_renderer->CreateTextureFromImage(sdfImage);
+    s_bakedSdfFont    = g_assetStreamer->Wait(fontRequest);
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[BakeSDF] %s %dx%d spread=%.1f: %s in %.2f ms (%d workers)",
+                                                          fontName.c_str(), dimensions.x, dimensions.y, settings.m_spreadTexels,
+                                                          stats.m_wasCached ? "loaded from cache" : "baked", stats.m_seconds * 1000.0,
+                                                          g_jobScheduler->GetWorkerCount()));
+
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, "  Show it with: TestFont tier=6");
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Load table from the font's .fnt, once, and have g_textCache lay the font's PCU text out with it.
+/// The .glyphs blob makes later runs skip parsing; a table that fails to load leaves the font's own
+/// layout in place.
+STATIC void App::UseGlyphTable(BitmapFont const* font, FontGlyphTable* table, char const* fntPath)
+{
+    if (font == nullptr || table == nullptr || g_textCache == nullptr) return;
+
+    if (!table->IsLoaded() && !table->Load(fntPath))
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, Stringf("[TestFont] Could not load glyph table %s", fntPath));
+        return;
+    }
+
+    g_textCache->SetGlyphTable(*font, table);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Posted by s_autoWidthScan's job once the tier 2 scan has finished; delivered at the next BeginFrame
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::OnAutoWidthsReady(FlatProperties& args)
+{
+    String const image = args.GetValue("image"_hcis, String());
+
+    if (!args.GetValue("success"_hcis, false))
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, Stringf("[TestFont] Auto-width scan could not load %s", image.c_str()));
+        return false;
+    }
+
+    s_autoWidthTable->BuildFromColumnExtents(s_autoWidthScan->GetAtlasDimensions(), s_autoWidthScan->GetCellCounts(), s_autoWidthScan->GetExtents());
+
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("[TestFont] Auto-widths for %d glyphs of %s ready in %.2f ms",
+                                                          args.GetValue("glyphs"_hcis, 0), image.c_str(), args.GetValue("ms"_hcis, 0.f)));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchAutoWidth: scans a synthetic 16x16-glyph atlas for column extents with the scalar and SIMD
+// paths, serially and on g_jobScheduler, and checks they agree. Usage: BenchAutoWidth size=4096 repeats=5
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_BenchAutoWidth(EventArgs& args)
+{
+    int const size    = args.GetValue("size", 4096);
+    int const repeats = args.GetValue("repeats", 5);
+
+    if (size < 16 || repeats <= 0)
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "[BenchAutoWidth] size must be >= 16 and repeats positive");
+        return false;
+    }
+
+    // One deterministic pseudo-random box of ink per cell; every 17th cell stays empty, like a space
+    int const          cellSize = size / 16;
+    std::vector<Rgba8> texels(static_cast<size_t>(size) * static_cast<size_t>(size), Rgba8(255, 255, 255, 0));
+    unsigned int       seed = 12345u;
+
+    auto nextInt = [&seed](int const maxValue)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<int>((seed >> 8) % static_cast<unsigned int>(maxValue));
+    };
+
+    for (int cellIndex = 0; cellIndex < 256; ++cellIndex)
+    {
+        if (cellIndex % 17 == 0) continue;
+
+        int const minX = nextInt(cellSize / 2 + 1);
+        int const maxX = minX + nextInt(cellSize / 2);
+        int const minY = nextInt(cellSize / 2 + 1);
+        int const maxY = minY + nextInt(cellSize / 2);
+
+        for (int y = minY; y <= maxY; ++y)
+        {
+            Rgba8* row = texels.data() + static_cast<size_t>((cellIndex / 16) * cellSize + y) * size + (cellIndex % 16) * cellSize;
+
+            for (int x = minX; x <= maxX; ++x)
+            {
+                row[x].a = static_cast<unsigned char>(1 + nextInt(255));
+            }
+        }
+    }
+
+    IntVec2 const                    dimensions(size, size);
+    std::vector<sGlyphColumnExtents> reference;
+    std::vector<sGlyphColumnExtents> extents;
+
+    // Best seconds over the repeats for one path; the first call warms the scratch buffers
+    auto measure = [&](eGlyphScanPath const path, bool const isParallel, std::vector<sGlyphColumnExtents>& outExtents)
+    {
+        sGlyphScanSettings settings;
+        settings.m_path       = path;
+        settings.m_isParallel = isParallel;
+
+        double bestSeconds = 1.0e30;
+
+        for (int repeat = 0; repeat <= repeats; ++repeat)
+        {
+            double const start = GetCurrentTimeSeconds();
+            ScanGlyphColumnExtents(texels.data(), dimensions, settings, outExtents);
+            double const seconds = GetCurrentTimeSeconds() - start;
+
+            if (repeat > 0 && seconds < bestSeconds) bestSeconds = seconds;
+        }
+
+        return bestSeconds;
+    };
+
+    auto matchesReference = [&]()
+    {
+        for (size_t index = 0; index < reference.size(); ++index)
+        {
+            if (extents[index].m_firstColumn != reference[index].m_firstColumn || extents[index].m_lastColumn != reference[index].m_lastColumn) return false;
+        }
+
+        return extents.size() == reference.size();
+    };
+
+    double const scalarSeconds   = measure(eGlyphScanPath::SCALAR, false, reference);
+    double const simdSeconds     = measure(eGlyphScanPath::SIMD, false, extents);
+    bool const   isSimdMatch     = matchesReference();
+    double const parallelSeconds = measure(eGlyphScanPath::SIMD, true, extents);
+    bool const   isParallelMatch = matchesReference();
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[BenchAutoWidth] %dx%d atlas, best of %d, SIMD=%s, %d workers",
+                                                          size, size, repeats, GetGlyphScanSIMDName(), g_jobScheduler->GetWorkerCount()));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  scalar          %8.2f ms", scalarSeconds * 1000.0));
+    g_devConsole->AddLine(isSimdMatch ? DevConsole::INFO_MINOR : DevConsole::ERROR,
+                          Stringf("  SIMD            %8.2f ms  x%.2f%s", simdSeconds * 1000.0, scalarSeconds / simdSeconds, isSimdMatch ? "" : "  MISMATCH"));
+    g_devConsole->AddLine(isParallelMatch ? DevConsole::INFO_MINOR : DevConsole::ERROR,
+                          Stringf("  SIMD + parallel %8.2f ms  x%.2f%s", parallelSeconds * 1000.0, scalarSeconds / parallelSeconds, isParallelMatch ? "" : "  MISMATCH"));
+
+    return false;
+}
+
 //----------------------------------------------------------------------------------------------------
 // SD4-A3c Demo: FontEffect command
 //----------------------------------------------------------------------------------------------------
-STATIC bool App::Command_FontEffect(EventArgs& args)
+STATIC bool App::Command_FontEffect(EventArgs& args)
+{
+    float const intensity = args.GetValue("intensity", s_effectIntensity);
+    s_effectIntensity = intensity;
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[FontEffect] intensity=%.2f", s_effectIntensity));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchText: lays out TextBenchmark's corpus with every loaded font and checks it against the golden
+// file. Usage: BenchText passes=20 autoWidth=false record=false
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_BenchText(EventArgs& args)
+{
+    int const  passes      = args.GetValue("passes", 20);
+    bool const isAutoWidth = args.GetValue("autoWidth", false);
+    bool const isRecording = args.GetValue("record", false);
+
+    String const goldenPath = "Data/Fonts/TextLayoutGolden.xml";
+
+    // Every font is measured, so the ones still streaming in are finished now
+    RequestFontDemoAssets(eJobPriority::FRAME_CRITICAL, true);
+
+    // Same one-way switch as TestFont tier=2: tier 1 becomes tier 2 for the rest of the session
+    if (isAutoWidth && s_tier1Font != nullptr && s_tier1Font->GetFontTier() < eFontTier::TIER_2)
+    {
+        Image const* fontImage = g_assetStreamer->Wait(g_assetStreamer->RequestImageAsync("Data/Fonts/SquirrelFixedFont.png", eJobPriority::FRAME_CRITICAL));
+
+        if (fontImage != nullptr)
+        {
+            s_tier1Font->ComputeAutoWidths(*fontImage);
+            g_textCache->Clear();
+        }
+    }
+
+    // Game-side flat tables for the .fnt fonts; the first run parses and writes the .glyphs blob
+    FontGlyphTable daemonTable;
+    FontGlyphTable sdfDaemonTable;
+    daemonTable.Load("Data/Fonts/DaemonFont.fnt");
+    sdfDaemonTable.Load("Data/Fonts/SDFDaemonFont.fnt");
+
+    TextBenchmark benchmark;
+    benchmark.AddFont("SquirrelFixedFont", s_tier1Font);
+    benchmark.AddFont("DaemonFont", s_tier3Font);
+    benchmark.AddFont("SDFDaemonFont", s_sdfFont);
+    benchmark.AddGlyphTable("DaemonFont.glyphs", &daemonTable);
+    benchmark.AddGlyphTable("SDFDaemonFont.glyphs", &sdfDaemonTable);
+    benchmark.Run(passes);
+
+    if (benchmark.GetResults().empty())
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "[BenchText] No fonts loaded");
+        return false;
+    }
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[BenchText] %d strings per font, best of %d passes", benchmark.GetResults().front().m_stringCount, passes));
+
+    for (FontGlyphTable const* table : { &daemonTable, &sdfDaemonTable })
+    {
+        sFontGlyphTableStats const& stats = table->GetStats();
+
+        if (table->IsLoaded())
+        {
+            g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Glyph table: %d glyphs, %d kerning pairs, loaded from %s in %.3f ms",
+                                                                  stats.m_glyphCount, stats.m_kerningCount, stats.m_wasLoadedFromBlob ? "blob" : ".fnt", stats.m_loadSeconds * 1000.0));
+        }
+    }
+
+    for (sTextBenchmarkResult const& result : benchmark.GetResults())
+    {
+        g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %-20s tier %d  PCU %6.2f M glyphs/s (%.1f allocs/string)  Font %6.2f M glyphs/s (%.1f allocs/string)",
+                                                              result.m_name.c_str(),
+                                                              result.m_fontTier,
+                                                              result.m_pcuGlyphsPerSecond * 1.0e-6,
+                                                              result.m_pcuAllocationsPerString,
+                                                              result.m_fontGlyphsPerSecond * 1.0e-6,
+                                                              result.m_fontAllocationsPerString));
+    }
+
+    if (isRecording)
+    {
+        bool const isWritten = benchmark.WriteGolden(goldenPath);
+        g_devConsole->AddLine(isWritten ? DevConsole::INFO_MAJOR : DevConsole::ERROR, Stringf("[BenchText] %s %s", isWritten ? "Recorded" : "Cannot write", goldenPath.c_str()));
+        return false;
+    }
+
+    std::vector<String> report;
+    int const           mismatchCount = benchmark.CompareWithGolden(goldenPath, report);
+
+    for (String const& line : report)
+    {
+        g_devConsole->AddLine(mismatchCount == 0 ? DevConsole::INFO_MINOR : DevConsole::ERROR, Stringf("  %s", line.c_str()));
+    }
+
+    // A missing golden file fails too; the check must never pass without comparing anything
+    if (mismatchCount != 0)
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, mismatchCount < 0 ? Stringf("[BenchText] FAILED: cannot read %s", goldenPath.c_str())
+                                                                   : Stringf("[BenchText] FAILED: %d font(s) differ from %s", mismatchCount, goldenPath.c_str()));
+    }
+    else
+    {
+        g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[BenchText] Passed: every font matches %s", goldenPath.c_str()));
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Frame pacing: FramePacing targetHz=60 unfocusedHz=15 histogram=true
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_FramePacing(EventArgs& args)
+{
+    if (g_app->m_framePacer == nullptr) return false;
+
+    sFramePacingConfig config = g_app->m_framePacer->GetConfig();
+
+    config.m_targetHz         = args.GetValue("targetHz", config.m_targetHz);
+    config.m_unfocusedHz      = args.GetValue("unfocusedHz", config.m_unfocusedHz);
+    config.m_isHistogramShown = args.GetValue("histogram", config.m_isHistogramShown);
+
+    g_app->m_framePacer->SetConfig(config);
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[FramePacing] targetHz=%.1f unfocusedHz=%.1f histogram=%s",
+        config.m_targetHz, config.m_unfocusedHz, config.m_isHistogramShown ? "true" : "false"));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Frame pacing: 1 ms frame-time buckets over the last FramePacer::HISTORY_SIZE frames, bottom-right of the screen
+//----------------------------------------------------------------------------------------------------
+void App::RenderFramePacingHistogram() const
+{
+    int buckets[FramePacer::BUCKET_COUNT];
+    m_framePacer->GetHistogram(buckets);
+
+    int const historyCount = m_framePacer->GetHistoryCount();
+    if (historyCount == 0) return;
+
+    Camera screenCam;
+    Vec2 const screenTopRight = Window::s_mainWindow->GetClientDimensions();
+    screenCam.SetOrthoGraphicView(Vec2::ZERO, screenTopRight);
+    screenCam.SetNormalizedViewport(AABB2::ZERO_TO_ONE);
+
+    g_renderer->BeginCamera(screenCam);
+
+    float const barWidth     = 8.f;
+    float const maxBarHeight = 120.f;
+    float const graphWidth   = barWidth * static_cast<float>(FramePacer::BUCKET_COUNT);
+    Vec2 const  graphMins    = Vec2(screenTopRight.x - graphWidth - 20.f, 50.f);
+    float const targetHz     = m_framePacer->GetConfig().m_targetHz;
+    int const   targetBucket = targetHz > 0.f ? static_cast<int>(1000.f / targetHz) : 0;
+
+    VertexList_PCU& verts = g_frameArena->AcquireVertsPCU();
+    AddVertsForAABB2D(verts, AABB2(graphMins - Vec2(4.f, 4.f), graphMins + Vec2(graphWidth + 4.f, maxBarHeight + 4.f)), Rgba8(0, 0, 0, 160));
+
+    for (int bucketIndex = 0; bucketIndex < FramePacer::BUCKET_COUNT; ++bucketIndex)
+    {
+        if (buckets[bucketIndex] == 0) continue;
+
+        float const barHeight = maxBarHeight * static_cast<float>(buckets[bucketIndex]) / static_cast<float>(historyCount);
+        Vec2 const  barMins   = graphMins + Vec2(barWidth * static_cast<float>(bucketIndex), 0.f);
+        Rgba8 const barColor  = bucketIndex <= targetBucket ? Rgba8::GREEN : Rgba8(255, 64, 64);
+
+        AddVertsForAABB2D(verts, AABB2(barMins, barMins + Vec2(barWidth - 1.f, barHeight)), barColor);
+    }
+
+    g_drawList->AddVerts(sDrawState2D(), verts);
+
+    if (s_tier3Font != nullptr)
+    {
+        VertexList_PCU& textVerts = g_frameArena->AcquireVertsPCU();
+        s_tier3Font->AddVertsForText2D(textVerts,
+                                       Stringf("Frame %.2f ms  Jitter %.3f ms  (%d frames)", m_framePacer->GetAverageFrameSeconds() * 1000.0, m_framePacer->GetJitterSeconds() * 1000.0, historyCount),
+                                       graphMins + Vec2(0.f, maxBarHeight + 10.f), 12.f, Rgba8::WHITE);
+
+        sDrawState2D textState;
+        textState.m_texture = &s_tier3Font->GetTexture();
+        textState.m_layer   = 1;
+        g_drawList->AddVerts(textState, textVerts);
+    }
+
+    g_drawList->Flush();
+    g_renderer->EndCamera(screenCam);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Profiler: Profiler overlay=true capture=120 file="Logs/FrameTrace.json"
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_Profiler(EventArgs& args)
+{
+    bool const isOverlayShown = args.GetValue("overlay", g_profiler->GetConfig().m_isOverlayShown);
+    g_profiler->SetOverlayShown(isOverlayShown);
+
+    int const captureFrames = args.GetValue("capture", 0);
+
+    if (captureFrames > 0)
+    {
+        std::string const file = args.GetValue("file", "Logs/FrameTrace.json");
+        g_profiler->StartCapture(captureFrames, file);
+        g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[Profiler] Capturing %d frames to %s", captureFrames, file.c_str()));
+    }
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[Profiler] overlay=%s threads=%d", isOverlayShown ? "true" : "false", g_profiler->GetThreadCount()));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchVerts: builds the same lines, rings, discs and boxes with the scalar and SIMD vertex builders
+// and reports vertices per second for each. Usage: BenchVerts count=10000 repeats=20 sides=32
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_BenchVerts(EventArgs& args)
+{
+    int const count   = args.GetValue("count", 10000);
+    int const repeats = args.GetValue("repeats", 20);
+    int const sides   = GetVertexBuilderSides(args.GetValue("sides", 32));
+
+    if (count <= 0 || repeats <= 0)
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "[BenchVerts] count and repeats must be positive");
+        return false;
+    }
+
+    // Deterministic pseudo-random inputs spread over a 1600x800 screen
+    std::vector<float> ax(count), ay(count), bx(count), by(count), size(count);
+    std::vector<Rgba8> colors(count);
+    unsigned int       seed = 12345u;
+
+    auto nextFloat = [&seed](float const maxValue)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return maxValue * static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+    };
+
+    for (int index = 0; index < count; ++index)
+    {
+        ax[index]     = nextFloat(1600.f);
+        ay[index]     = nextFloat(800.f);
+        bx[index]     = ax[index] + nextFloat(40.f) + 1.f;
+        by[index]     = ay[index] + nextFloat(40.f) + 1.f;
+        size[index]   = nextFloat(8.f) + 1.f;
+        colors[index] = Rgba8(static_cast<unsigned char>(index), 200, 100);
+    }
+
+    sLineSegmentsSoA2D const lines{ ax.data(), ay.data(), bx.data(), by.data(), size.data(), colors.data(), count };
+    sCirclesSoA2D const      circles{ ax.data(), ay.data(), bx.data(), size.data(), colors.data(), count };
+    sAABBsSoA2D const        boxes{ ax.data(), ay.data(), bx.data(), by.data(), colors.data(), count };
+
+    VertexList_PCU verts;
+
+    // Seconds per repeat for one shape on one path; the first call warms the list and the tables
+    auto measure = [&](int const shape, eVertexBuilderPath const path)
+    {
+        double bestSeconds = 1.0e30;
+
+        for (int repeat = 0; repeat <= repeats; ++repeat)
+        {
+            verts.clear();
+            double const start = GetCurrentTimeSeconds();
+
+            switch (shape)
+            {
+            case 0: AddVertsForLineSegments2D(verts, lines, path); break;
+            case 1: AddVertsForRings2D(verts, circles, sides, path); break;
+            case 2: AddVertsForDiscs2D(verts, circles, sides, path); break;
+            default: AddVertsForAABBs2D(verts, boxes, path); break;
+            }
+
+            double const seconds = GetCurrentTimeSeconds() - start;
+            if (repeat > 0 && seconds < bestSeconds) bestSeconds = seconds;
+        }
+
+        return bestSeconds;
+    };
+
+    static char const* const s_shapeNames[] = { "lines", "rings", "discs", "boxes" };
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[BenchVerts] %d of each, %d sides, best of %d, SIMD=%s", count, sides, repeats, GetVertexBuilderSIMDName()));
+
+    for (int shape = 0; shape < 4; ++shape)
+    {
+        double const scalarSeconds = measure(shape, eVertexBuilderPath::SCALAR);
+        double const simdSeconds   = measure(shape, eVertexBuilderPath::SIMD);
+        double const vertexCount   = static_cast<double>(verts.size());
+
+        g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %-5s %9.0f verts  scalar %7.1f M/s  SIMD %7.1f M/s  x%.2f",
+                                                              s_shapeNames[shape],
+                                                              vertexCount,
+                                                              vertexCount / scalarSeconds * 1.0e-6,
+                                                              vertexCount / simdSeconds * 1.0e-6,
+                                                              scalarSeconds / simdSeconds));
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchEvents: fires one event with the same subscribers through EventSystem by name and through
+// g_eventDispatcher by name, by _hcis literal and by EventId, then posts it from every worker and
+// drains the queue.
+// Usage: BenchEvents fires=100000 subscribers=4
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_BenchEvents(EventArgs& args)
+{
+    int const fires       = args.GetValue("fires", 100000);
+    int const subscribers = args.GetValue("subscribers", 4);
+
+    if (fires <= 0 || subscribers < 1 || subscribers > 4)
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "[BenchEvents] fires must be positive and subscribers 1-4");
+        return false;
+    }
+
+    // Distinct functions, so neither system can fold repeated subscriptions of one callback
+    static int                         s_callCount             = 0;
+    static EventCallbackFunction const s_callbacks[]           = {
+        [](EventArgs&) { ++s_callCount; return false; },
+        [](EventArgs&) { ++s_callCount; return false; },
+        [](EventArgs&) { ++s_callCount; return false; },
+        [](EventArgs&) { ++s_callCount; return false; },
+    };
+    static GameEventCallback const     s_dispatcherCallbacks[] = {
+        [](FlatProperties&) { ++s_callCount; return false; },
+        [](FlatProperties&) { ++s_callCount; return false; },
+        [](FlatProperties&) { ++s_callCount; return false; },
+        [](FlatProperties&) { ++s_callCount; return false; },
+    };
+
+    String const  eventName = "BenchEventsTick";
+    EventId const eventId   = g_eventDispatcher->Intern(eventName);
+
+    for (int index = 0; index < subscribers; ++index)
+    {
+        g_eventSystem->SubscribeEventCallbackFunction(eventName, s_callbacks[index]);
+        g_eventDispatcher->Subscribe(eventId, s_dispatcherCallbacks[index]);
+    }
+
+    EventArgs        eventArgs;
+    FlatProperties   dispatcherArgs;
+    HashedName const literalName = "BenchEventsTick"_hcis;
+
+    auto measure = [&](int const path)
+    {
+        s_callCount        = 0;
+        double const start = GetCurrentTimeSeconds();
+
+        for (int fire = 0; fire < fires; ++fire)
+        {
+            switch (path)
+            {
+            case 0: g_eventSystem->FireEvent(eventName, eventArgs); break;
+            case 1: g_eventDispatcher->FireEvent(eventName, dispatcherArgs); break;
+            case 2: g_eventDispatcher->FireEvent(literalName, dispatcherArgs); break;
+            default: g_eventDispatcher->FireEvent(eventId, dispatcherArgs); break;
+            }
+        }
+
+        return GetCurrentTimeSeconds() - start;
+    };
+
+    double const stringSeconds  = measure(0);
+    int const    stringCalls    = s_callCount;
+    double const nameSeconds    = measure(1);
+    double const literalSeconds = measure(2);
+    double const idSeconds      = measure(3);
+    int const    idCalls        = s_callCount;
+
+    // Posts from every worker at once, up to the pool size, then one drain on this thread
+    g_eventDispatcher->DrainPostedEvents();     // Start from an empty queue
+
+    int const    posts      = fires < g_eventDispatcher->GetPostCapacity() ? fires : g_eventDispatcher->GetPostCapacity();
+    int const    chunkCount = g_jobScheduler->GetWorkerCount() + 1;
+    double const postStart  = GetCurrentTimeSeconds();
+
+    g_jobScheduler->ParallelFor(chunkCount, [&](int const chunk)
+    {
+        for (int post = chunk; post < posts; post += chunkCount)
+        {
+            g_eventDispatcher->Post(eventId, dispatcherArgs);
+        }
+    });
+
+    double const postSeconds = GetCurrentTimeSeconds() - postStart;
+
+    s_callCount = 0;
+    double const drainStart   = GetCurrentTimeSeconds();
+    g_eventDispatcher->DrainPostedEvents();
+    double const drainSeconds = GetCurrentTimeSeconds() - drainStart;
+
+    sEventQueueStats const queueStats = g_eventDispatcher->GetQueueStats();
+
+    for (int index = subscribers - 1; index >= 0; --index)
+    {
+        g_eventDispatcher->Unsubscribe(eventId, s_dispatcherCallbacks[index]);
+        g_eventSystem->UnsubscribeEventCallbackFunction(eventName, s_callbacks[index]);
+    }
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[BenchEvents] %d fires, %d subscribers", fires, subscribers));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  EventSystem by name       %8.1f ns/fire  (%d calls)", stringSeconds * 1.0e9 / fires, stringCalls));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  EventDispatcher by name   %8.1f ns/fire  x%.1f", nameSeconds * 1.0e9 / fires, stringSeconds / nameSeconds));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  EventDispatcher by _hcis  %8.1f ns/fire  x%.1f", literalSeconds * 1.0e9 / fires, stringSeconds / literalSeconds));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  EventDispatcher by id     %8.1f ns/fire  x%.1f  (%d calls)", idSeconds * 1.0e9 / fires, stringSeconds / idSeconds, idCalls));
+    g_devConsole->AddLine(queueStats.m_deliveredCount == posts ? DevConsole::INFO_MINOR : DevConsole::ERROR,
+                          Stringf("  Post from %d threads      %8.1f ns/post, drain %.1f ns/event  (%d of %d delivered, %d dropped)",
+                                  chunkCount, postSeconds * 1.0e9 / posts, drainSeconds * 1.0e9 / posts, queueStats.m_deliveredCount, posts, queueStats.m_droppedCount));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchProperties: builds and reads the same 4-key event payload with NamedProperties and with
+// FlatProperties, in time and heap allocations per payload, reads a string value as a float with
+// each, and looks up one key by String, by char const* and by _hcis literal.
+// Usage: BenchProperties count=100000
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_BenchProperties(EventArgs& args)
+{
+    int const count = args.GetValue("count", 100000);
+
+    if (count <= 0)
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "[BenchProperties] count must be positive");
+        return false;
+    }
+
+    static volatile float s_sink = 0.f;     // Keeps the reads from being optimized away
+
+    // The payload GlyphWidthScan posts: a path, a bool, an int and a float
+    uint64_t const namedAllocations = FrameArena::GetHeapAllocationCount();
+    double const   namedStart       = GetCurrentTimeSeconds();
+
+    for (int index = 0; index < count; ++index)
+    {
+        NamedProperties props;
+        props.SetValue("image", "Data/Fonts/Daemon.png");
+        props.SetValue("success", true);
+        props.SetValue("glyphs", index);
+        props.SetValue("ms", 1.5f);
+
+        s_sink = props.GetValue("ms", 0.f) + static_cast<float>(props.GetValue("glyphs", 0) + props.GetValue("success", false))
+                 + static_cast<float>(props.GetValue("image", String()).size());
+    }
+
+    double const   namedSeconds    = GetCurrentTimeSeconds() - namedStart;
+    uint64_t const namedAllocCount = FrameArena::GetHeapAllocationCount() - namedAllocations;
+    uint64_t const flatAllocations = FrameArena::GetHeapAllocationCount();
+    double const   flatStart       = GetCurrentTimeSeconds();
+
+    for (int index = 0; index < count; ++index)
+    {
+        FlatProperties props;
+        props.SetValue("image", "Data/Fonts/Daemon.png");
+        props.SetValue("success", true);
+        props.SetValue("glyphs", index);
+        props.SetValue("ms", 1.5f);
+
+        s_sink = props.GetValue("ms", 0.f) + static_cast<float>(props.GetValue("glyphs", 0) + props.GetValue("success", false))
+                 + static_cast<float>(std::strlen(props.GetText("image", "")));
+    }
+
+    double const   flatSeconds    = GetCurrentTimeSeconds() - flatStart;
+    uint64_t const flatAllocCount = FrameArena::GetHeapAllocationCount() - flatAllocations;
+
+    // "3.14" read back as a float: NamedProperties parses on every read, FlatProperties once
+    NamedProperties namedText;
+    FlatProperties  flatText;
+    namedText.SetValue("GPA", "3.14");
+    namedText.SetValue("glyphs", 256);
+    flatText.SetValue("GPA", "3.14");
+    flatText.SetValue("glyphs", 256);
+
+    double const namedParseStart = GetCurrentTimeSeconds();
+    for (int index = 0; index < count; ++index) s_sink = namedText.GetValue("GPA", 0.f);
+    double const namedParseSeconds = GetCurrentTimeSeconds() - namedParseStart;
+
+    double const flatParseStart = GetCurrentTimeSeconds();
+    for (int index = 0; index < count; ++index) s_sink = flatText.GetValue("GPA", 0.f);
+    double const flatParseSeconds = GetCurrentTimeSeconds() - flatParseStart;
+
+    // One key looked up with a String (what console args hand over), a char const* and a literal
+    String const   stringKey         = "glyphs";
+    uint64_t const lookupAllocations = FrameArena::GetHeapAllocationCount();
+    double         lookupSeconds[4]  = {};
+
+    for (int path = 0; path < 4; ++path)
+    {
+        double const lookupStart = GetCurrentTimeSeconds();
+
+        for (int index = 0; index < count; ++index)
+        {
+            switch (path)
+            {
+            case 0: s_sink = static_cast<float>(namedText.GetValue(stringKey, 0)); break;
+            case 1: s_sink = static_cast<float>(flatText.GetValue(stringKey, 0)); break;
+            case 2: s_sink = static_cast<float>(flatText.GetValue("glyphs", 0)); break;
+            default: s_sink = static_cast<float>(flatText.GetValue("glyphs"_hcis, 0)); break;
+            }
+        }
+
+        lookupSeconds[path] = GetCurrentTimeSeconds() - lookupStart;
+    }
+
+    uint64_t const lookupAllocCount = FrameArena::GetHeapAllocationCount() - lookupAllocations;
+
+    UNUSED(s_sink)
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[BenchProperties] %d payloads of 4 keys", count));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  NamedProperties  %8.1f ns/payload  %.2f allocations/payload",
+                                                          namedSeconds * 1.0e9 / count, static_cast<double>(namedAllocCount) / count));
+    g_devConsole->AddLine(flatAllocCount == 0 ? DevConsole::INFO_MINOR : DevConsole::ERROR,
+                          Stringf("  FlatProperties   %8.1f ns/payload  %.2f allocations/payload  x%.1f",
+                                  flatSeconds * 1.0e9 / count, static_cast<double>(flatAllocCount) / count, namedSeconds / flatSeconds));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  \"3.14\" as float  %8.1f ns/read named, %.1f ns/read flat (%.2f)",
+                                                          namedParseSeconds * 1.0e9 / count, flatParseSeconds * 1.0e9 / count, flatText.GetValue("GPA", 0.f)));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Key lookup       %8.1f ns named by String, flat %.1f ns by String, %.1f ns by char const*, %.1f ns by _hcis  (%llu allocations)",
+                                                          lookupSeconds[0] * 1.0e9 / count, lookupSeconds[1] * 1.0e9 / count, lookupSeconds[2] * 1.0e9 / count,
+                                                          lookupSeconds[3] * 1.0e9 / count, static_cast<unsigned long long>(lookupAllocCount)));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchScripts: runs a trigger of no-op commands through DevConsole's XML path (parse, build each
+// command line, tokenize it) and as a compiled CommandScript, first with the no-op subscribed to
+// g_eventSystem, as console commands are, then to g_eventDispatcher. Usage: BenchScripts commands=8 repeats=500
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_BenchScripts(EventArgs& args)
+{
+    int const commands = args.GetValue("commands", 8);
+    int const repeats  = args.GetValue("repeats", 500);
+
+    if (commands <= 0 || repeats <= 0)
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "[BenchScripts] commands and repeats must be positive");
+        return false;
+    }
+
+    static int s_callCount = 0;
+
+    EventCallbackFunction const noOp = [](EventArgs&) { ++s_callCount; return false; };
+
+    // Shaped like TestTrigger's block, with the commands swapped for one that does nothing
+    String triggerXml = "<Trigger type=\"died\">";
+
+    for (int index = 0; index < commands; ++index)
+    {
+        triggerXml += Stringf("<BenchScriptNoOp map=\"VictoryScreen\" startPos=\"5,5\" name=\"Reward %d\" faction=\"neutral\"/>", index);
+    }
+
+    triggerXml += "</Trigger>";
+
+    g_eventSystem->SubscribeEventCallbackFunction("BenchScriptNoOp", noOp);
+
+    s_callCount             = 0;
+    double const parseStart = GetCurrentTimeSeconds();
+
+    for (int repeat = 0; repeat < repeats; ++repeat)
+    {
+        XmlDocument document;
+        document.Parse(triggerXml.c_str());
+        g_devConsole->ExecuteXmlCommandScriptNode(*document.RootElement());
+    }
+
+    double const parseSeconds = GetCurrentTimeSeconds() - parseStart;
+    int const    parseCalls   = s_callCount;
+
+    CommandScript script;
+    double const  compileStart = GetCurrentTimeSeconds();
+    script.CompileXmlText(triggerXml.c_str());
+    double const compileSeconds = GetCurrentTimeSeconds() - compileStart;
+
+    s_callCount              = 0;
+    double const replayStart = GetCurrentTimeSeconds();
+
+    for (int repeat = 0; repeat < repeats; ++repeat)
+    {
+        script.Execute();
+    }
+
+    double const replaySeconds = GetCurrentTimeSeconds() - replayStart;
+    int const    replayCalls   = s_callCount;
+
+    g_eventSystem->UnsubscribeEventCallbackFunction("BenchScriptNoOp", noOp);
+
+    // Same script; with a dispatcher subscriber it replays by EventId with FlatProperties
+    GameEventCallback const flatNoOp = [](FlatProperties&) { ++s_callCount; return false; };
+    EventId const           noOpId   = g_eventDispatcher->Intern("BenchScriptNoOp");
+
+    g_eventDispatcher->Subscribe(noOpId, flatNoOp);
+
+    s_callCount                  = 0;
+    double const dispatcherStart = GetCurrentTimeSeconds();
+
+    for (int repeat = 0; repeat < repeats; ++repeat)
+    {
+        script.Execute();
+    }
+
+    double const dispatcherSeconds = GetCurrentTimeSeconds() - dispatcherStart;
+    int const    dispatcherCalls   = s_callCount;
+
+    g_eventDispatcher->Unsubscribe(noOpId, flatNoOp);
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[BenchScripts] %d commands x %d runs", commands, repeats));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  XML parse + tokenize  %8.2f us/run  (%d calls)", parseSeconds * 1.0e6 / repeats, parseCalls));
+    g_devConsole->AddLine(replayCalls == parseCalls ? DevConsole::INFO_MINOR : DevConsole::ERROR,
+                          Stringf("  CommandScript replay  %8.2f us/run  x%.1f  (%d calls, compiled once in %.3f ms)",
+                                  replaySeconds * 1.0e6 / repeats, parseSeconds / replaySeconds, replayCalls, compileSeconds * 1000.0));
+    g_devConsole->AddLine(dispatcherCalls == parseCalls ? DevConsole::INFO_MINOR : DevConsole::ERROR,
+                          Stringf("  ... via dispatcher    %8.2f us/run  x%.1f  (%d calls)",
+                                  dispatcherSeconds * 1.0e6 / repeats, parseSeconds / dispatcherSeconds, dispatcherCalls));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchLog: the caller-side cost of a log line formatted on the spot (Stringf, as every DAEMON_LOG
+// call site does) and recorded by GAME_LOG, then GAME_LOG from several threads at once, end to end
+// through the logging thread. The lines are formatted but not sent to the sinks.
+// Usage: BenchLog records=100000 threads=4
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_BenchLog(EventArgs& args)
+{
+    int const records = args.GetValue("records", 100000);
+    int const threads = args.GetValue("threads", g_jobScheduler->GetWorkerCount() + 1);
+
+    if (records <= 0 || threads <= 0)
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "[BenchLog] records and threads must be positive");
+        return false;
+    }
+
+    // Writes stop at each full ring and wait, untimed, for the logging thread to empty it
+    int const burst = g_binaryLog->GetConfig().m_recordsPerThread;
+
+    static volatile size_t s_sink = 0;
+
+    double const stringfStart = GetCurrentTimeSeconds();
+
+    for (int record = 0; record < records; ++record)
+    {
+        s_sink = s_sink + Stringf("BenchLog %d of %d: %.3f ms on %s", record, records, record * 0.5, "main").size();
+    }
+
+    double const stringfSeconds = GetCurrentTimeSeconds() - stringfStart;
+
+    g_binaryLog->Flush();
+    g_binaryLog->SetOutputEnabled(false);
+
+    sBinaryLogStats const before = g_binaryLog->GetStats();
+
+    auto const writeRecords = [burst](int const count, char const* threadName)
+    {
+        double writeSeconds = 0.0;
+
+        for (int record = 0; record < count;)
+        {
+            int const    burstEnd   = record + burst < count ? record + burst : count;
+            double const burstStart = GetCurrentTimeSeconds();
+
+            for (; record < burstEnd; ++record)
+            {
+                GAME_LOG(eLogVerbosity::Log, "BenchLog %d of %d: %.3f ms on %s", record, count, record * 0.5, threadName);
+            }
+
+            writeSeconds += GetCurrentTimeSeconds() - burstStart;
+            g_binaryLog->Flush();
+        }
+
+        return writeSeconds;
+    };
+
+    double const callerSeconds = writeRecords(records, "main");
+
+    std::atomic<int64_t> threadNanoseconds = 0;
+    int const            perThread         = records / threads;
+    double const         threadsStart      = GetCurrentTimeSeconds();
+
+    g_jobScheduler->ParallelFor(threads, [&](int const)
+    {
+        threadNanoseconds.fetch_add(static_cast<int64_t>(writeRecords(perThread, "worker") * 1.0e9), std::memory_order_relaxed);
+    });
+
+    g_binaryLog->Flush();
+    double const threadsSeconds = GetCurrentTimeSeconds() - threadsStart;
+
+    sBinaryLogStats const after = g_binaryLog->GetStats();
+    g_binaryLog->SetOutputEnabled(true);
+    UNUSED(s_sink)
+
+    uint64_t const recorded  = after.m_recordedCount - before.m_recordedCount;
+    uint64_t const formatted = after.m_formattedCount - before.m_formattedCount;
+    uint64_t const dropped   = after.m_droppedCount - before.m_droppedCount;
+    int const      expected  = records + perThread * threads;
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[BenchLog] %d records, then %d from each of %d threads", records, perThread, threads));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Stringf on the caller   %8.1f ns/record", stringfSeconds * 1.0e9 / records));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  GAME_LOG on the caller  %8.1f ns/record  x%.1f", callerSeconds * 1.0e9 / records, stringfSeconds / callerSeconds));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  GAME_LOG, %2d threads    %8.1f ns/record  %.2f M records/s formatted end to end",
+                                                          threads, static_cast<double>(threadNanoseconds.load()) / (perThread * threads), perThread * threads / threadsSeconds / 1.0e6));
+    g_devConsole->AddLine(recorded == static_cast<uint64_t>(expected) && formatted == recorded ? DevConsole::INFO_MINOR : DevConsole::ERROR,
+                          Stringf("  %llu of %d recorded, %llu formatted, %llu dropped, %d rings of %d records",
+                                  static_cast<unsigned long long>(recorded), expected, static_cast<unsigned long long>(formatted),
+                                  static_cast<unsigned long long>(dropped), after.m_ringCount, burst));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchJobs: scheduling overhead and scaling of g_jobScheduler. Empty jobs submitted from the main
+// thread (through the shared queue) and from inside a job (onto that worker's own deque), a chain of
+// continuations, a fan-out/fan-in graph, then ParallelFor over a fixed amount of arithmetic per index
+// against the same loop run serially.
+// Usage: BenchJobs jobs=100000 chain=1000 count=4096 work=2000
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_BenchJobs(EventArgs& args)
 {
-    float const intensity = args.GetValue("intensity", s_effectIntensity);
-    s_effectIntensity = intensity;
+    int const jobs  = args.GetValue("jobs", 100000);
+    int const chain = args.GetValue("chain", 1000);
+    int const count = args.GetValue("count", 4096);
+    int const work  = args.GetValue("work", 2000);
 
-    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[FontEffect] intensity=%.2f", s_effectIntensity));
+    if (jobs <= 0 || chain <= 0 || count <= 0 || work <= 0)
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "[BenchJobs] jobs, chain, count and work must be positive");
+        return false;
+    }
+
+    sJobSchedulerStats const before = g_jobScheduler->GetStats();
+    std::vector<JobHandle>   handles;
+    handles.reserve(static_cast<size_t>(jobs));
+
+    // Empty jobs from the main thread
+    double const mainStart = GetCurrentTimeSeconds();
+
+    for (int job = 0; job < jobs; ++job)
+    {
+        handles.push_back(g_jobScheduler->Submit([] {}));
+    }
+
+    for (JobHandle const& handle : handles)
+    {
+        g_jobScheduler->Wait(handle);
+    }
+
+    double const mainSeconds = GetCurrentTimeSeconds() - mainStart;
+
+    // Empty jobs from inside a job
+    handles.clear();
+    double const    nestedStart = GetCurrentTimeSeconds();
+    JobHandle const spawner     = g_jobScheduler->Submit([&handles, jobs]
+    {
+        for (int job = 0; job < jobs; ++job)
+        {
+            handles.push_back(g_jobScheduler->Submit([] {}));
+        }
+
+        for (JobHandle const& handle : handles)
+        {
+            g_jobScheduler->Wait(handle);
+        }
+    });
+
+    g_jobScheduler->Wait(spawner);
+    double const nestedSeconds = GetCurrentTimeSeconds() - nestedStart;
+    handles.clear();
+
+    // Chain: each link is a continuation of the previous one
+    double const chainStart = GetCurrentTimeSeconds();
+    JobHandle    link       = g_jobScheduler->Submit([] {});
+
+    for (int index = 1; index < chain; ++index)
+    {
+        link = g_jobScheduler->Then(link, [] {});
+    }
+
+    g_jobScheduler->Wait(link);
+    double const chainSeconds = GetCurrentTimeSeconds() - chainStart;
+
+    // Fan-out / fan-in: one root, jobs children, one frame-critical join depending on all of them
+    std::atomic<int> fanCount = 0;
+    double const     fanStart = GetCurrentTimeSeconds();
+    JobHandle const  root     = g_jobScheduler->Submit([] {});
+
+    for (int job = 0; job < jobs; ++job)
+    {
+        handles.push_back(g_jobScheduler->Then(root, [&fanCount] { fanCount.fetch_add(1, std::memory_order_relaxed); }));
+    }
+
+    JobHandle const join = g_jobScheduler->Submit([] {}, eJobPriority::FRAME_CRITICAL, handles);
+    g_jobScheduler->Wait(join);
+    double const fanSeconds = GetCurrentTimeSeconds() - fanStart;
+    handles.clear();
+
+    // ParallelFor scaling
+    std::vector<float> results(static_cast<size_t>(count));
+
+    auto const body = [&results, work](int const index)
+    {
+        float value = static_cast<float>(index);
+
+        for (int step = 0; step < work; ++step)
+        {
+            value = value * 0.9999f + 0.5f;
+        }
+
+        results[static_cast<size_t>(index)] = value;
+    };
+
+    double const serialStart = GetCurrentTimeSeconds();
+
+    for (int index = 0; index < count; ++index)
+    {
+        body(index);
+    }
+
+    double const serialSeconds   = GetCurrentTimeSeconds() - serialStart;
+    double const parallelStart   = GetCurrentTimeSeconds();
+    g_jobScheduler->ParallelFor(count, body);
+    double const parallelSeconds = GetCurrentTimeSeconds() - parallelStart;
+
+    sJobSchedulerStats const after   = g_jobScheduler->GetStats();
+    int const                threads = g_jobScheduler->GetWorkerCount() + 1;
+    double const             speedup = serialSeconds / parallelSeconds;
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[BenchJobs] %d workers plus the main thread", threads - 1));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Empty jobs from main    %8.1f ns/job", mainSeconds * 1.0e9 / jobs));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Empty jobs from a job   %8.1f ns/job", nestedSeconds * 1.0e9 / jobs));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Chain of %-6d         %8.1f ns/link", chain, chainSeconds * 1.0e9 / chain));
+    g_devConsole->AddLine(fanCount.load() == jobs ? DevConsole::INFO_MINOR : DevConsole::ERROR,
+                          Stringf("  Fan-out/in of %-6d    %8.1f ns/job", jobs, fanSeconds * 1.0e9 / jobs));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  ParallelFor %d x %d: serial %.2f ms, parallel %.2f ms, x%.2f on %d threads (%.0f%% efficiency)",
+                                                          count, work, serialSeconds * 1000.0, parallelSeconds * 1000.0, speedup, threads, speedup * 100.0 / threads));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %llu jobs run, %llu stolen, %llu from the shared queue",
+                                                          static_cast<unsigned long long>(after.m_executedCount - before.m_executedCount),
+                                                          static_cast<unsigned long long>(after.m_stolenCount - before.m_stolenCount),
+                                                          static_cast<unsigned long long>(after.m_sharedCount - before.m_sharedCount)));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// LogQuery: searches the compressed log archives, decompressing only the blocks whose index entry
+// can hold a match. Times are UTC, as in the log ("2026-10-16T12:34:56" or a prefix down to the
+// day); last= counts minutes back from now instead. verbosity= keeps lines at that eLogVerbosity
+// value or more severe. Lines still in the active segment are not archived yet (LogArchive rotate=true).
+// Usage: LogQuery from=2026-10-16T12:00 to=2026-10-16T13:00 last=30 verbosity=3 thread=2 category=LogGame text=dropped max=50
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_LogQuery(EventArgs& args)
+{
+    String const directory   = g_binaryLog->GetConfig().m_archive.m_archiveDirectory;
+    String const from        = args.GetValue("from", String());
+    String const to          = args.GetValue("to", String());
+    float const  lastMinutes = args.GetValue("last", 0.f);
+
+    sLogQuery query;
+    query.m_maxVerbosity = args.GetValue("verbosity", query.m_maxVerbosity);
+    query.m_threadIndex  = args.GetValue("thread", query.m_threadIndex);
+    query.m_category     = args.GetValue("category", query.m_category);
+    query.m_text         = args.GetValue("text", query.m_text);
+    query.m_maxLines     = args.GetValue("max", query.m_maxLines);
+
+    if ((!from.empty() && !ParseLogTimestamp(from, query.m_fromUnixSeconds)) || (!to.empty() && !ParseLogTimestamp(to, query.m_toUnixSeconds)))
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "[LogQuery] from and to take UTC times such as 2026-10-16T12:34:56");
+        return false;
+    }
+
+    if (lastMinutes > 0.f)
+    {
+        double const now = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+        query.m_fromUnixSeconds = now - lastMinutes * 60.0;
+    }
+
+    std::vector<String> lines;
+    sLogQueryStats      stats;
+
+    if (!LogArchive::Query(directory, query, lines, stats))
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, Stringf("[LogQuery] cannot read %s", directory.c_str()));
+        return false;
+    }
+
+    for (String const& line : lines)
+    {
+        g_devConsole->AddLine(DevConsole::INFO_MINOR, line);
+    }
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[LogQuery] %d lines in %.1f ms: %d of %d blocks decompressed, from %d of %d segments",
+                                                          stats.m_matchCount, stats.m_seconds * 1000.0, stats.m_blocksDecompressed, stats.m_blockCount,
+                                                          stats.m_segmentsOpened, stats.m_segmentCount));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// LogArchive: sizes of the compressed log archives against the text they hold. rotate=true first
+// archives the active segment and waits for it to be compressed.
+// Usage: LogArchive rotate=true
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_LogArchive(EventArgs& args)
+{
+    LogArchive* archive = g_binaryLog->GetArchive();
+
+    if (archive == nullptr)
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "[LogArchive] the log file is off (<Log file>)");
+        return false;
+    }
+
+    if (args.GetValue("rotate", false))
+    {
+        archive->RequestRotation();
+        g_binaryLog->Flush();
+        archive->WaitForCompression();
+    }
+
+    // Nothing matches max=0, so only the indices are read
+    sLogQuery query;
+    query.m_maxLines = 0;
+
+    std::vector<String> lines;
+    sLogQueryStats      stats;
+    LogArchive::Query(archive->GetConfig().m_archiveDirectory, query, lines, stats);
+
+    sLogArchiveConfig const& config = archive->GetConfig();
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[LogArchive] %d segments, %d blocks in %s", stats.m_segmentCount, stats.m_blockCount, config.m_archiveDirectory.c_str()));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %.2f MiB of text in %.2f MiB, x%.1f",
+                                                          stats.m_rawBytes / (1024.0 * 1024.0), stats.m_archiveBytes / (1024.0 * 1024.0),
+                                                          stats.m_archiveBytes > 0 ? static_cast<double>(stats.m_rawBytes) / static_cast<double>(stats.m_archiveBytes) : 0.0));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  rotating at %d MiB or %.0f minutes, keeping %d segments or %d MiB",
+                                                          config.m_segmentMiB, config.m_segmentMinutes, config.m_maxArchives, config.m_maxArchiveMiB));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// FrameArena: FrameArena check=120
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_FrameArena(EventArgs& args)
+{
+    int const checkFrames = args.GetValue("check", 0);
+
+    if (checkFrames > 0)
+    {
+        g_frameArena->CheckAllocations(checkFrames);
+        g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[FrameArena] Counting heap allocations over the next %d frames", checkFrames));
+    }
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[FrameArena] peak %zu KiB of %zu KiB, %d pooled lists, %llu heap allocations last frame",
+                                                          g_frameArena->GetPeakBytes() / 1024,
+                                                          g_frameArena->GetCapacityBytes() / 1024,
+                                                          g_frameArena->GetListCount(),
+                                                          static_cast<unsigned long long>(g_frameArena->GetLastFrameHeapAllocations())));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Threads: the detected CPU topology, how each game thread pool was placed, and its utilization
+// over the last half second. hud= shows or hides that utilization on the debug HUD.
+// Usage: Threads hud=true
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_Threads(EventArgs& args)
+{
+    g_app->m_isThreadUsageShown = args.GetValue("hud", g_app->m_isThreadUsageShown);
+
+    sCpuTopology const& topology = GetCpuTopology();
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[Threads] %d physical cores, %d logical processors, %d NUMA node(s)",
+                                                          topology.m_physicalCount, topology.m_logicalCount, topology.m_numaNodeCount));
+
+    sThreadPoolConfig pools[] = { g_jobScheduler->GetConfig().m_threads, g_ioScheduler->GetConfig().m_threads, g_binaryLog->GetConfig().m_thread };
+
+    pools[2].m_threadCount = g_binaryLog->GetArchive() != nullptr ? 2 : 1;     // Logging thread and archive compressor
+
+    for (sThreadPoolConfig const& pool : pools)
+    {
+        String const stack = pool.m_stackKiB > 0 ? Stringf("%d KiB", pool.m_stackKiB) : "default";
+
+        g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %-5s %3d threads  affinity=%s firstCore=%d  stack=%s  spin=%.0f us",
+                                                              pool.m_name.c_str(), pool.m_threadCount, pool.m_affinity.c_str(), pool.m_firstCore,
+                                                              stack.c_str(), pool.m_spinMicroseconds));
+    }
+
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %s", g_app->m_threadUsage.GetSummary().c_str()));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Assets: what g_assetStreamer has loaded and is loading, and what its main-thread stage cost.
+// budgetMs= changes the per-frame upload budget. Usage: Assets budgetMs=2
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_Assets(EventArgs& args)
+{
+    sAssetStreamerConfig config = g_assetStreamer->GetConfig();
+    config.m_uploadBudgetSeconds = args.GetValue("budgetMs", config.m_uploadBudgetSeconds * 1000.f) / 1000.f;
+
+    if (config.m_uploadBudgetSeconds < 0.f)
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "Assets: budgetMs must be >= 0. Usage: Assets budgetMs=2");
+        return false;
+    }
+
+    g_assetStreamer->SetConfig(config);
+
+    sAssetStreamerStats const stats = g_assetStreamer->GetStats();
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[Assets] %d requested (%d more deduplicated): %d ready, %d failed, %d loading, %d waiting to upload",
+                                                          stats.m_requestCount, stats.m_dedupedCount, stats.m_readyCount, stats.m_failedCount,
+                                                          stats.m_loadingCount, stats.m_pendingCount));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Upload budget %.2f ms/frame; last frame %d in %.3f ms, worst frame %.3f ms",
+                                                          config.m_uploadBudgetSeconds * 1000.f, stats.m_finishedLastFrame,
+                                                          stats.m_secondsLastFrame * 1000.0, stats.m_maxFrameSeconds * 1000.0));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Slowest request to ready: %.2f ms", stats.m_maxLatencySeconds * 1000.0));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// AssetPack: which pack g_assetPack has open and how reads went. build=true packs Data/ into
+// Data.gpak and reopens it (compress=, align=); enabled=false closes it, so everything loads loose.
+// Usage: AssetPack build=true compress=true align=64
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_AssetPack(EventArgs& args)
+{
+    if (args.GetValue("build", false))
+    {
+        sAssetPackBuildSettings settings;
+        settings.m_isCompressing = args.GetValue("compress", settings.m_isCompressing);
+        settings.m_alignment     = args.GetValue("align", settings.m_alignment);
+
+        if (settings.m_alignment <= 0 || (settings.m_alignment & (settings.m_alignment - 1)) != 0)
+        {
+            g_devConsole->AddLine(DevConsole::ERROR, "AssetPack: align must be a power of two. Usage: AssetPack build=true align=64");
+            return false;
+        }
+
+        // Views into the old mapping must not outlive it, and Windows will not replace a mapped file
+        String const packPath = g_assetPack->IsOpen() ? g_assetPack->GetPath() : String("Data.gpak");
+        g_assetPack->Close();
+
+        sAssetPackBuildStats buildStats;
+
+        if (!AssetPack::Build("Data", packPath, settings, buildStats))
+        {
+            g_devConsole->AddLine(DevConsole::ERROR, Stringf("AssetPack: could not build %s", packPath.c_str()));
+            return false;
+        }
+
+        g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[AssetPack] Built %s: %d files (%d compressed), %.1f KiB -> %.1f KiB in %.1f ms",
+                                                              packPath.c_str(), buildStats.m_fileCount, buildStats.m_compressedCount,
+                                                              static_cast<double>(buildStats.m_rawBytes) / 1024.0,
+                                                              static_cast<double>(buildStats.m_packBytes) / 1024.0, buildStats.m_seconds * 1000.0));
+
+        g_assetPack->Open(packPath);
+    }
+    else if (!args.GetValue("enabled", true))
+    {
+        g_assetPack->Close();
+    }
+    else if (!g_assetPack->IsOpen())
+    {
+        g_assetPack->Open("Data.gpak");
+    }
+
+    sAssetPackStats const stats = g_assetPack->GetStats();
+
+    if (!g_assetPack->IsOpen())
+    {
+        g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[AssetPack] No pack open: every data file loads loose (%llu so far)",
+                                                              static_cast<unsigned long long>(stats.m_looseReadCount)));
+        return false;
+    }
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[AssetPack] %s: %d entries, %.1f KiB", g_assetPack->GetPath().c_str(), stats.m_entryCount,
+                                                          static_cast<double>(stats.m_packBytes) / 1024.0));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %llu reads from the pack (%llu without a copy, %.1f KiB decompressed), %llu loose",
+                                                          static_cast<unsigned long long>(stats.m_readCount),
+                                                          static_cast<unsigned long long>(stats.m_zeroCopyCount),
+                                                          static_cast<double>(stats.m_decompressedBytes) / 1024.0,
+                                                          static_cast<unsigned long long>(stats.m_looseReadCount)));
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// ShaderCache: what g_shaderCache has found and compiled. prebake=true fetches or compiles every
+// <ShaderCache> variant in Data/GameConfig.xml on g_jobScheduler, leaving their .cso files ready to
+// ship; clear=true first forgets the bytecode held in memory. test=true checks the cache against a
+// counting fake compiler in a scratch directory, without D3D. Usage: ShaderCache prebake=true
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::Command_ShaderCache(EventArgs& args)
+{
+    if (args.GetValue("test", false))
+    {
+        std::vector<sShaderCacheCheck> checks;
+        int const                      failedCount = RunShaderCacheTest("Temp/ShaderCacheTest", checks);
+
+        for (sShaderCacheCheck const& check : checks)
+        {
+            g_devConsole->AddLine(check.m_isPassed ? DevConsole::INFO_MINOR : DevConsole::ERROR,
+                                  Stringf("  %s %-34s %d compile(s), expected %d", check.m_isPassed ? "PASS" : "FAIL", check.m_name.c_str(),
+                                          check.m_compileCount, check.m_expectedCompileCount));
+        }
+
+        g_devConsole->AddLine(failedCount > 0 ? DevConsole::ERROR : DevConsole::INFO_MAJOR,
+                              Stringf("[ShaderCache] Test: %d of %d checks passed", static_cast<int>(checks.size()) - failedCount, static_cast<int>(checks.size())));
+
+        return false;
+    }
+
+    if (args.GetValue("clear", false))
+    {
+        g_shaderCache->ClearMemory();
+    }
+
+    if (args.GetValue("prebake", false))
+    {
+        std::vector<sShaderVariant> const& variants = g_shaderCache->GetConfig().m_variants;
+
+        sShaderCacheStats const before       = g_shaderCache->GetStats();
+        double const            startSeconds = GetCurrentTimeSeconds();
+        int const               failedCount  = g_shaderCache->Precompile(variants);
+        double const            wallSeconds  = GetCurrentTimeSeconds() - startSeconds;
+        sShaderCacheStats const after        = g_shaderCache->GetStats();
+
+        g_devConsole->AddLine(failedCount > 0 ? DevConsole::ERROR : DevConsole::INFO_MAJOR,
+                              Stringf("[ShaderCache] Prebaked %d variants into %s in %.1f ms: %d compiled, %d cached, %d failed (see Logs/Game.log)",
+                                      static_cast<int>(variants.size()), g_shaderCache->GetConfig().m_directory.c_str(), wallSeconds * 1000.0,
+                                      after.m_compileCount - before.m_compileCount,
+                                      after.m_diskHitCount - before.m_diskHitCount + after.m_memoryHitCount - before.m_memoryHitCount, failedCount));
+    }
+
+    sShaderCacheStats const stats = g_shaderCache->GetStats();
+
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[ShaderCache] %d from memory, %d from disk, %d compiled, %d failed",
+                                                          stats.m_memoryHitCount, stats.m_diskHitCount, stats.m_compileCount, stats.m_failedCount));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Keying %.2f ms, compiling %.1f ms (summed over threads)",
+                                                          stats.m_keySeconds * 1000.0, stats.m_compileSeconds * 1000.0));
 
     return false;
 }
 
+//----------------------------------------------------------------------------------------------------
+// Profiler: flame graph of the last collected frame, one lane per thread, one row per nesting depth
+//----------------------------------------------------------------------------------------------------
+void App::RenderProfilerOverlay() const
+{
+    std::vector<sProfileZone> const& zones = g_profiler->GetLastFrameZones();
+    if (zones.empty()) return;
+
+    Camera screenCam;
+    Vec2 const screenTopRight = Window::s_mainWindow->GetClientDimensions();
+    screenCam.SetOrthoGraphicView(Vec2::ZERO, screenTopRight);
+    screenCam.SetNormalizedViewport(AABB2::ZERO_TO_ONE);
+
+    g_renderer->BeginCamera(screenCam);
+
+    double const frameStart    = g_profiler->GetLastFrameStartSeconds();
+    double const frameDuration = g_profiler->GetLastFrameEndSeconds() - frameStart;
+    float const  graphLeft     = 20.f;
+    float const  graphWidth    = screenTopRight.x - 2.f * graphLeft;
+    float const  graphTop      = screenTopRight.y - 60.f;
+    float const  rowHeight     = 14.f;
+    float const  laneHeight    = rowHeight * 8.f;
+
+    static Rgba8 const s_zoneColors[] = { Rgba8(230, 120, 40), Rgba8(220, 170, 40), Rgba8(200, 90, 60), Rgba8(240, 140, 90), Rgba8(190, 150, 50) };
+
+    VertexList_PCU& verts     = g_frameArena->AcquireVertsPCU();
+    VertexList_PCU& textVerts = g_frameArena->AcquireVertsPCU();
+
+    for (sProfileZone const& zone : zones)
+    {
+        float const startFraction = static_cast<float>((zone.m_startSeconds - frameStart) / frameDuration);
+        float const endFraction   = static_cast<float>((zone.m_endSeconds - frameStart) / frameDuration);
+
+        if (endFraction < 0.f || startFraction > 1.f) continue;
+
+        float const minX = graphLeft + graphWidth * (startFraction < 0.f ? 0.f : startFraction);
+        float const maxX = graphLeft + graphWidth * (endFraction > 1.f ? 1.f : endFraction);
+        float const maxY = graphTop - laneHeight * static_cast<float>(zone.m_threadIndex) - rowHeight * static_cast<float>(zone.m_depth);
+
+        // Same name pointer -> same colour from frame to frame
+        size_t const colorIndex = (reinterpret_cast<uintptr_t>(zone.m_name) >> 4) % (sizeof(s_zoneColors) / sizeof(s_zoneColors[0]));
+
+        AddVertsForAABB2D(verts, AABB2(Vec2(minX, maxY - rowHeight + 1.f), Vec2(maxX < minX + 1.f ? minX + 1.f : maxX, maxY)), s_zoneColors[colorIndex]);
+
+        if (s_tier3Font != nullptr && maxX - minX > 80.f)
+        {
+            s_tier3Font->AddVertsForText2D(textVerts, Stringf("%s %.2fms", zone.m_name, (zone.m_endSeconds - zone.m_startSeconds) * 1000.0), Vec2(minX + 2.f, maxY - rowHeight + 2.f), rowHeight - 4.f, Rgba8::WHITE);
+        }
+    }
+
+    if (s_tier3Font != nullptr)
+    {
+        s_tier3Font->AddVertsForText2D(textVerts, Stringf("Frame %.2f ms", frameDuration * 1000.0), Vec2(graphLeft, graphTop + 4.f), 12.f, Rgba8::WHITE);
+    }
+
+    g_drawList->AddVerts(sDrawState2D(), verts);
+
+    if (!textVerts.empty())
+    {
+        sDrawState2D textState;
+        textState.m_texture = &s_tier3Font->GetTexture();
+        textState.m_layer   = 1;
+        g_drawList->AddVerts(textState, textVerts);
+    }
+
+    g_drawList->Flush();
+    g_renderer->EndCamera(screenCam);
+}
+
 //----------------------------------------------------------------------------------------------------
 // SD4-A3c Demo: Render font demo overlay
 //----------------------------------------------------------------------------------------------------
@@ -512,12 +2569,24 @@ void App::RenderFontDemo() const
         BitmapFont* font = s_tier1Font;
         if (!font) { g_renderer->EndCamera(screenCam); return; }
 
-        VertexList_PCU verts;
-        font->AddVertsForText2D(verts, line1, Vec2(50.f, topY - 120.f), textH, Rgba8::WHITE);
-        font->AddVertsForText2D(verts, line2, Vec2(50.f, topY - 160.f), textH, Rgba8::YELLOW);
+        VertexList_PCU& verts       = g_frameArena->AcquireVertsPCU();
+        bool const      isAutoWidth = s_currentFontTier == 2 && s_autoWidthTable->IsLoaded();
+
+        if (isAutoWidth)
+        {
+            s_autoWidthTable->AddVertsForText2D(verts, line1, Vec2(50.f, topY - 120.f), textH, Rgba8::WHITE);
+            s_autoWidthTable->AddVertsForText2D(verts, line2, Vec2(50.f, topY - 160.f), textH, Rgba8::YELLOW);
+        }
+        else
+        {
+            g_textCache->AddVertsForText2D(verts, *font, line1, Vec2(50.f, topY - 120.f), textH, Rgba8::WHITE);
+            g_textCache->AddVertsForText2D(verts, *font, line2, Vec2(50.f, topY - 160.f), textH, Rgba8::YELLOW);
+        }
 
-        String label = (s_currentFontTier == 1) ? "Tier 1: Fixed-Width (SquirrelFixedFont)" : "Tier 2: Auto-Width (SquirrelFixedFont)";
-        font->AddVertsForText2D(verts, label, Vec2(50.f, topY - 80.f), 16.f, Rgba8::GREEN);
+        String label = (s_currentFontTier == 1) ? "Tier 1: Fixed-Width (SquirrelFixedFont)"
+                       : isAutoWidth            ? "Tier 2: Auto-Width (SquirrelFixedFont)"
+                                                : "Tier 2: scanning glyph widths...";
+        g_textCache->AddVertsForText2D(verts, *font, label, Vec2(50.f, topY - 80.f), 16.f, Rgba8::GREEN);
 
         g_renderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
         g_renderer->BindShader(nullptr);
@@ -530,10 +2599,10 @@ void App::RenderFontDemo() const
         BitmapFont* font = s_tier3Font;
         if (!font) { g_renderer->EndCamera(screenCam); return; }
 
-        VertexList_PCU verts;
-        font->AddVertsForText2D(verts, line1, Vec2(50.f, topY - 120.f), textH, Rgba8::WHITE);
-        font->AddVertsForText2D(verts, line2, Vec2(50.f, topY - 160.f), textH, Rgba8::YELLOW);
-        font->AddVertsForText2D(verts, "Tier 3: BMFont + Kerning (DaemonFont)", Vec2(50.f, topY - 80.f), 16.f, Rgba8::GREEN);
+        VertexList_PCU& verts = g_frameArena->AcquireVertsPCU();
+        g_textCache->AddVertsForText2D(verts, *font, line1, Vec2(50.f, topY - 120.f), textH, Rgba8::WHITE);
+        g_textCache->AddVertsForText2D(verts, *font, line2, Vec2(50.f, topY - 160.f), textH, Rgba8::YELLOW);
+        g_textCache->AddVertsForText2D(verts, *font, "Tier 3: BMFont + Kerning (DaemonFont)", Vec2(50.f, topY - 80.f), 16.f, Rgba8::GREEN);
 
         g_renderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
         g_renderer->BindShader(nullptr);
@@ -544,15 +2613,15 @@ void App::RenderFontDemo() const
     {
         // Tier 4: SDF font with threshold shader
         BitmapFont* font = s_sdfFont;
-        if (!font) { g_renderer->EndCamera(screenCam); return; }
+        if (!font || !s_sdfShader) { g_renderer->EndCamera(screenCam); return; }
 
-        VertexList_PCU verts;
-        font->AddVertsForText2D(verts, line1, Vec2(50.f, topY - 120.f), textH, Rgba8::WHITE);
-        font->AddVertsForText2D(verts, line2, Vec2(50.f, topY - 160.f), textH, Rgba8::YELLOW);
-        font->AddVertsForText2D(verts, "Tier 4: SDF Threshold (SDFDaemonFont)", Vec2(50.f, topY - 80.f), 16.f, Rgba8::GREEN);
+        VertexList_PCU& verts = g_frameArena->AcquireVertsPCU();
+        g_textCache->AddVertsForText2D(verts, *font, line1, Vec2(50.f, topY - 120.f), textH, Rgba8::WHITE);
+        g_textCache->AddVertsForText2D(verts, *font, line2, Vec2(50.f, topY - 160.f), textH, Rgba8::YELLOW);
+        g_textCache->AddVertsForText2D(verts, *font, "Tier 4: SDF Threshold (SDFDaemonFont)", Vec2(50.f, topY - 80.f), 16.f, Rgba8::GREEN);
 
         // Large text to show SDF crisp scaling
-        font->AddVertsForText2D(verts, "BIG SDF", Vec2(50.f, topY - 320.f), 80.f, Rgba8::CYAN);
+        g_textCache->AddVertsForText2D(verts, *font, "BIG SDF", Vec2(50.f, topY - 320.f), 80.f, Rgba8::CYAN);
 
         g_renderer->SetSamplerMode(eSamplerMode::BILINEAR_CLAMP);
         g_renderer->BindShader(s_sdfShader);
@@ -563,15 +2632,15 @@ void App::RenderFontDemo() const
     {
         // Tier 5: VertexFont with effects shader
         BitmapFont* font = s_sdfFont;
-        if (!font) { g_renderer->EndCamera(screenCam); return; }
+        if (!font || !s_fontShader) { g_renderer->EndCamera(screenCam); return; }
 
-        VertexList_Font verts;
-        font->AddVertsForText2D(verts, line1, Vec2(50.f, topY - 120.f), textH, Rgba8::WHITE);
-        font->AddVertsForText2D(verts, line2, Vec2(50.f, topY - 160.f), textH, Rgba8::YELLOW);
-        font->AddVertsForText2D(verts, "Tier 5: Wave + Rainbow Effects", Vec2(50.f, topY - 80.f), 16.f, Rgba8::GREEN);
+        VertexList_Font& verts = g_frameArena->AcquireVertsFont();
+        g_textCache->AddVertsForText2D(verts, *font, line1, Vec2(50.f, topY - 120.f), textH, Rgba8::WHITE);
+        g_textCache->AddVertsForText2D(verts, *font, line2, Vec2(50.f, topY - 160.f), textH, Rgba8::YELLOW);
+        g_textCache->AddVertsForText2D(verts, *font, "Tier 5: Wave + Rainbow Effects", Vec2(50.f, topY - 80.f), 16.f, Rgba8::GREEN);
 
         // Large text for dramatic effect
-        font->AddVertsForText2D(verts, "FANCY FONTS!", Vec2(50.f, topY - 320.f), 60.f, Rgba8::WHITE);
+        g_textCache->AddVertsForText2D(verts, *font, "FANCY FONTS!", Vec2(50.f, topY - 320.f), 60.f, Rgba8::WHITE);
 
         g_renderer->SetPerFrameConstants(static_cast<float>(Clock::GetSystemClock().GetTotalSeconds()));
         g_renderer->SetSamplerMode(eSamplerMode::BILINEAR_CLAMP);
@@ -581,6 +2650,24 @@ void App::RenderFontDemo() const
         g_renderer->DrawVertexArray(verts);
     }
 
+    else if (s_currentFontTier == 6)
+    {
+        // Tier 6: a plain bitmap font drawn through the SDF shader with the atlas BakeSDF produced
+        BitmapFont* font = s_bakedSdfFont;
+        if (!font || !s_bakedSdfTexture || !s_sdfShader) { g_renderer->EndCamera(screenCam); return; }
+
+        VertexList_PCU& verts = g_frameArena->AcquireVertsPCU();
+        g_textCache->AddVertsForText2D(verts, *font, line1, Vec2(50.f, topY - 120.f), textH, Rgba8::WHITE);
+        g_textCache->AddVertsForText2D(verts, *font, line2, Vec2(50.f, topY - 160.f), textH, Rgba8::YELLOW);
+        g_textCache->AddVertsForText2D(verts, *font, "Tier 6: Baked SDF (BakeSDF)", Vec2(50.f, topY - 80.f), 16.f, Rgba8::GREEN);
+        g_textCache->AddVertsForText2D(verts, *font, "BIG SDF", Vec2(50.f, topY - 320.f), 80.f, Rgba8::CYAN);
+
+        g_renderer->SetSamplerMode(eSamplerMode::BILINEAR_CLAMP);
+        g_renderer->BindShader(s_sdfShader);
+        g_renderer->BindTexture(s_bakedSdfTexture);
+        g_renderer->DrawVertexArray(verts);
+    }
+
     // Reset to default state
     g_renderer->BindShader(nullptr);
     g_renderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
@@ -5,13 +5,39 @@
 //----------------------------------------------------------------------------------------------------
 #pragma once
 //----------------------------------------------------------------------------------------------------
+#include "Game/Framework/AssetStreamer.hpp"
+#include "Game/Framework/BinaryLog.hpp"
+#include "Game/Framework/EventDispatcher.hpp"
+#include "Game/Framework/FixedStepClock.hpp"
+#include "Game/Framework/FrameArena.hpp"
+#include "Game/Framework/FramePacer.hpp"
+#include "Game/Framework/FrameProfiler.hpp"
+#include "Game/Framework/JobScheduler.hpp"
+#include "Game/Framework/ScriptRunner.hpp"
+#include "Game/Framework/ShaderCache.hpp"
+#include "Game/Framework/TextLayout.hpp"
+#include "Game/Framework/ThreadTopology.hpp"
+//----------------------------------------------------------------------------------------------------
 #include "Engine/Core/EventRecipient.hpp"
 #include "Engine/Core/EventSystem.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
 class BitmapFont;
 class Camera;
+class FontGlyphTable;
+class GlyphWidthScan;
 class Shader;
+class Texture;
+
+//----------------------------------------------------------------------------------------------------
+// Loaded from the <FrameLoop> element of Data/GameConfig.xml.
+//
+struct sFrameLoopConfig
+{
+    float m_fixedTimeStepHz    = 60.f;     // Simulation rate of the headless fixed-step accumulator; each step advances the game clock 1/Hz
+    int   m_headlessFrameCount = 0;        // Simulation steps to run before quitting in headless mode; 0 = until quit
+    bool  m_isHeadlessRealTime = false;    // true: feed the accumulator with wall-clock time; false: one fixed step per frame
+};
 
 //----------------------------------------------------------------------------------------------------
 class App : public EventRecipient
@@ -25,6 +51,10 @@ public:
 
     void RunMainLoop();
     void RunFrame();
+    bool   IsHeadless() const;
+    Clock* GetSimulationClock() const;
+
+    String const& GetThreadUsageSummary() const;
 
     static bool OnCloseButtonClicked(EventArgs& args);
     static void RequestQuit();
@@ -41,11 +71,62 @@ public:
     static bool Command_ChangeMap(EventArgs& args);
     static bool Command_SpawnActor(EventArgs& args);
     static bool Command_RunScript(EventArgs& args);
+    static bool Command_CancelScript(EventArgs& args);
+    static bool OnScriptFinished(FlatProperties& args);
     static bool Command_TestTrigger(EventArgs& args);
 
     // SD4-A3c: Font demo command handlers
     static bool Command_TestFont(EventArgs& args);
     static bool Command_FontEffect(EventArgs& args);
+    static bool Command_BenchText(EventArgs& args);
+    static bool Command_BakeSDF(EventArgs& args);
+    static bool Command_BenchAutoWidth(EventArgs& args);
+    static bool OnAutoWidthsReady(FlatProperties& args);
+    static void RequestFontDemoAssets(eJobPriority priority, bool isWaiting = false);
+    static void UseGlyphTable(BitmapFont const* font, FontGlyphTable* table, char const* fntPath);
+
+    // Frame pacing command handler
+    static bool Command_FramePacing(EventArgs& args);
+
+    // Profiler command handler
+    static bool Command_Profiler(EventArgs& args);
+
+    // Vertex builder benchmark command handler
+    static bool Command_BenchVerts(EventArgs& args);
+
+    // Event dispatch benchmark command handler
+    static bool Command_BenchEvents(EventArgs& args);
+
+    // Property storage benchmark command handler
+    static bool Command_BenchProperties(EventArgs& args);
+
+    // Compiled command script benchmark command handler
+    static bool Command_BenchScripts(EventArgs& args);
+
+    // Binary log benchmark command handler
+    static bool Command_BenchLog(EventArgs& args);
+
+    // Job scheduler benchmark command handler
+    static bool Command_BenchJobs(EventArgs& args);
+
+    // Log archive command handlers
+    static bool Command_LogQuery(EventArgs& args);
+    static bool Command_LogArchive(EventArgs& args);
+
+    // Frame arena command handler
+    static bool Command_FrameArena(EventArgs& args);
+
+    // Thread topology command handler
+    static bool Command_Threads(EventArgs& args);
+
+    // Asset streaming command handler
+    static bool Command_Assets(EventArgs& args);
+
+    // Asset pack command handler
+    static bool Command_AssetPack(EventArgs& args);
+
+    // Shader cache command handler
+    static bool Command_ShaderCache(EventArgs& args);
 
 private:
     void BeginFrame() const;
@@ -54,16 +135,75 @@ private:
     void EndFrame() const;
 
     void RenderFontDemo() const;
+    void RenderFramePacingHistogram() const;
+    void RenderProfilerOverlay() const;
     void UpdateCursorMode();
 
+    void LoadGameConfig();
+    void RunHeadlessLoop();
+    void RunHeadlessFrame();
+    void ResetFrameArena() const;
+
     int m_testMemberCallCount = 0;
 
+    // Headless fixed-step frame loop
+    sFrameLoopConfig m_frameLoopConfig;
+    bool             m_isHeadless           = false;
+    double           m_accumulatedSeconds   = 0.0;
+    int              m_simulatedFrameCount  = 0;
+    double           m_headlessStartSeconds = 0.0;         // Wall time; the system clock is not ticked headless
+    double           m_lastHeadlessSeconds  = 0.0;
+    FixedStepClock*  m_simulationClock      = nullptr;     // Headless only: the game clock's parent, stepped once per simulation step
+
+    // Frame pacing
+    sFramePacingConfig m_framePacingConfig;
+    FramePacer*        m_framePacer          = nullptr;
+    bool               m_doesWindowHaveFocus = true;
+
+    // Profiler
+    sFrameProfilerConfig m_frameProfilerConfig;
+
+    // Frame arena
+    sFrameArenaConfig m_frameArenaConfig;
+
+    // Text layout cache
+    sTextLayoutCacheConfig m_textLayoutCacheConfig;
+
+    // Job scheduler
+    sJobSchedulerConfig m_jobSchedulerConfig;
+    sJobSchedulerConfig m_ioSchedulerConfig = { .m_threads = { .m_name = "IO" } };
+
+    // Asynchronous asset loads
+    sAssetStreamerConfig m_assetStreamerConfig;
+
+    // Shader bytecode cache and the variants it prebakes
+    sShaderCacheConfig m_shaderCacheConfig;
+
+    // Thread pool utilization on the debug HUD
+    ThreadUsageMonitor m_threadUsage;
+    bool               m_isThreadUsageShown = true;
+
+    // Posted event queue
+    sEventDispatcherConfig m_eventDispatcherConfig;
+
+    // Time-sliced command scripts
+    sScriptRunnerConfig m_scriptRunnerConfig;
+
+    // GAME_LOG backend
+    sBinaryLogConfig m_binaryLogConfig;
+
     // SD4-A3c: Font demo state
-    static int         s_currentFontTier;
-    static float       s_effectIntensity;
-    static BitmapFont* s_tier1Font;
-    static BitmapFont* s_tier3Font;
-    static BitmapFont* s_sdfFont;
-    static Shader*     s_sdfShader;
-    static Shader*     s_fontShader;
+    static int             s_currentFontTier;
+    static float           s_effectIntensity;
+    static BitmapFont*     s_tier1Font;
+    static BitmapFont*     s_tier3Font;
+    static BitmapFont*     s_sdfFont;
+    static Shader*         s_sdfShader;
+    static Shader*         s_fontShader;
+    static BitmapFont*     s_bakedSdfFont;        // Source font of s_bakedSdfTexture; its UVs index the baked atlas
+    static Texture*        s_bakedSdfTexture;     // Created by BakeSDF, owned by the App
+    static GlyphWidthScan* s_autoWidthScan;       // Tier 2 column scan, run in the background on request
+    static FontGlyphTable* s_autoWidthTable;      // Tier 2 metrics, filled when the scan completes
+    static FontGlyphTable* s_tier3GlyphTable;     // Lays out s_tier3Font's PCU text in g_textCache
+    static FontGlyphTable* s_sdfGlyphTable;       // Lays out s_sdfFont's PCU text in g_textCache
 };
@@ -0,0 +1,621 @@
+//----------------------------------------------------------------------------------------------------
+// AssetPack.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/AssetPack.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/BinaryLog.hpp"
+#include "Game/Framework/BlockCodec.hpp"
+#include "Game/Framework/FrameProfiler.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/HashedName.hpp"
+#include "Game/Framework/JobScheduler.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+//----------------------------------------------------------------------------------------------------
+struct AssetPack::sHeader
+{
+    uint32_t m_magic         = 0;
+    uint32_t m_version       = 0;
+    uint32_t m_entryCount    = 0;
+    uint32_t m_slotCount     = 0;       // A power of two, at least twice m_entryCount
+    uint32_t m_blockCount    = 0;
+    uint32_t m_alignment     = 0;
+    uint64_t m_slotsOffset   = 0;
+    uint64_t m_entriesOffset = 0;
+    uint64_t m_blocksOffset  = 0;
+    uint64_t m_namesOffset   = 0;
+    uint64_t m_namesBytes    = 0;
+    uint64_t m_fileBytes     = 0;
+};
+
+struct AssetPack::sSlot
+{
+    uint32_t m_hash       = 0;          // GetCaseInsensitiveHash of the path
+    uint32_t m_entryIndex = 0;          // Plus one; 0 is an empty slot
+};
+
+struct AssetPack::sEntry
+{
+    uint64_t m_dataOffset  = 0;
+    uint64_t m_rawBytes    = 0;
+    uint64_t m_storedBytes = 0;
+    int64_t  m_writeTime   = 0;
+    uint32_t m_nameOffset  = 0;
+    uint32_t m_nameLength  = 0;
+    uint32_t m_firstBlock  = 0;
+    uint32_t m_blockCount  = 0;         // 0 = stored as is
+};
+
+struct AssetPack::sBlock
+{
+    uint64_t m_offset          = 0;     // From the entry's m_dataOffset
+    uint32_t m_encoding        = 0;     // eBlockEncoding
+    uint32_t m_rawBytes        = 0;
+    uint32_t m_sequenceBytes   = 0;
+    uint32_t m_compressedBytes = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    uint32_t constexpr PACK_MAGIC   = 0x4B415047u;     // "GPAK"
+    uint32_t constexpr PACK_VERSION = 1;
+
+    // Written next to their sources at runtime; packing them would only pin stale copies
+    char const* const EXCLUDED_EXTENSIONS[] = { ".cmdc", ".glyphs", ".sdf", ".gpak", ".tmp" };
+
+    std::atomic<uint64_t> s_looseReadCount{0};
+
+    //------------------------------------------------------------------------------------------------
+    // "./Data\Fonts\X.fnt" and "Data/Fonts/X.fnt" name the same entry; case is handled by the hash
+    // and the comparison.
+    std::string_view NormalizePath(std::string_view path, String& scratch)
+    {
+        while (path.size() >= 2 && path[0] == '.' && (path[1] == '/' || path[1] == '\\'))
+        {
+            path.remove_prefix(2);
+        }
+
+        if (path.find('\\') == std::string_view::npos) return path;
+
+        scratch.assign(path.begin(), path.end());
+        std::replace(scratch.begin(), scratch.end(), '\\', '/');
+
+        return scratch;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    uint64_t AlignUp(uint64_t const value, uint64_t const alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    bool ReadLooseFile(String const& path, std::vector<uint8_t>& out)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return false;
+
+        std::streamsize const size = file.tellg();
+        if (size < 0) return false;
+
+        out.resize(static_cast<size_t>(size));
+        file.seekg(0);
+
+        return size == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(out.data()), size));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+std::string_view sAssetFileData::GetText() const
+{
+    return std::string_view(reinterpret_cast<char const*>(m_bytes.data()), m_bytes.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Maps packPath and checks that its table of contents, and everything the table points at, lies
+/// inside the file, so later lookups and reads can trust it.
+bool AssetPack::Open(String const& packPath)
+{
+    std::unique_lock lock(m_mutex);
+
+    CloseMapping();
+
+    if (!m_file.OpenForRead(packPath)) return false;
+
+    uint8_t const* const data = m_file.GetData();
+    uint64_t const       size = m_file.GetSize();
+
+    if (size < sizeof(sHeader))
+    {
+        GAME_LOG(eLogVerbosity::Warning, "(AssetPack) %s is too short to be a pack, loading loose files", packPath.c_str());
+        CloseMapping();
+        return false;
+    }
+
+    sHeader const* header = reinterpret_cast<sHeader const*>(data);
+
+    auto const fits = [size](uint64_t const offset, uint64_t const count, uint64_t const elementSize)
+    {
+        return offset <= size && count <= (size - offset) / elementSize;
+    };
+
+    bool isValid = header->m_magic == PACK_MAGIC && header->m_version == PACK_VERSION && header->m_fileBytes == size &&
+                   header->m_slotCount >= header->m_entryCount && (header->m_slotCount & (header->m_slotCount - 1)) == 0 &&
+                   fits(header->m_slotsOffset, header->m_slotCount, sizeof(sSlot)) &&
+                   fits(header->m_entriesOffset, header->m_entryCount, sizeof(sEntry)) &&
+                   fits(header->m_blocksOffset, header->m_blockCount, sizeof(sBlock)) &&
+                   fits(header->m_namesOffset, header->m_namesBytes, 1);
+
+    if (isValid)
+    {
+        m_header  = header;
+        m_slots   = reinterpret_cast<sSlot const*>(data + header->m_slotsOffset);
+        m_entries = reinterpret_cast<sEntry const*>(data + header->m_entriesOffset);
+        m_blocks  = reinterpret_cast<sBlock const*>(data + header->m_blocksOffset);
+        m_names   = reinterpret_cast<char const*>(data + header->m_namesOffset);
+    }
+
+    for (uint32_t index = 0; isValid && index < header->m_entryCount; ++index)
+    {
+        sEntry const& entry = m_entries[index];
+
+        isValid = fits(entry.m_dataOffset, entry.m_storedBytes, 1) &&
+                  static_cast<uint64_t>(entry.m_nameOffset) + entry.m_nameLength <= header->m_namesBytes &&
+                  static_cast<uint64_t>(entry.m_firstBlock) + entry.m_blockCount <= header->m_blockCount &&
+                  (entry.m_blockCount > 0 || entry.m_storedBytes == entry.m_rawBytes);
+
+        uint64_t rawBytes = 0;
+
+        for (uint32_t block = 0; isValid && block < entry.m_blockCount; ++block)
+        {
+            sBlock const& blockInfo = m_blocks[entry.m_firstBlock + block];
+
+            isValid = blockInfo.m_offset <= entry.m_storedBytes && blockInfo.m_compressedBytes <= entry.m_storedBytes - blockInfo.m_offset &&
+                      blockInfo.m_encoding <= static_cast<uint32_t>(eBlockEncoding::LZ_HUFFMAN) &&
+                      blockInfo.m_sequenceBytes <= GetMaxSequenceBytes(blockInfo.m_rawBytes);
+
+            rawBytes += blockInfo.m_rawBytes;
+        }
+
+        isValid = isValid && (entry.m_blockCount == 0 || rawBytes == entry.m_rawBytes);
+    }
+
+    for (uint32_t index = 0; isValid && index < header->m_slotCount; ++index)
+    {
+        isValid = m_slots[index].m_entryIndex <= header->m_entryCount;
+    }
+
+    if (!isValid)
+    {
+        GAME_LOG(eLogVerbosity::Warning, "(AssetPack) %s is corrupt or from another version, loading loose files", packPath.c_str());
+        CloseMapping();
+        return false;
+    }
+
+    m_path = packPath;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Waits for lookups and reads in progress on other threads. Views handed out by ReadFile() are
+/// invalid from here on.
+void AssetPack::Close()
+{
+    std::unique_lock lock(m_mutex);
+
+    CloseMapping();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool AssetPack::IsOpen() const
+{
+    std::shared_lock lock(m_mutex);
+
+    return m_header != nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool AssetPack::FindFile(std::string_view const path, sAssetFileInfo& outInfo) const
+{
+    std::shared_lock lock(m_mutex);
+
+    sEntry const* entry = FindEntry(path);
+    if (entry == nullptr) return false;
+
+    outInfo.m_size      = entry->m_rawBytes;
+    outInfo.m_writeTime = entry->m_writeTime;
+    outInfo.m_isInPack  = true;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// A stored entry comes back as a view into the mapping, without a copy; a compressed one is decoded
+/// block by block into outData.m_storage.
+bool AssetPack::ReadFile(std::string_view const path, sAssetFileData& outData) const
+{
+    std::shared_lock lock(m_mutex);
+
+    sEntry const* entry = FindEntry(path);
+    if (entry == nullptr) return false;
+
+    uint8_t const* const data = m_file.GetData() + entry->m_dataOffset;
+
+    outData.m_isInPack = true;
+    m_readCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (entry->m_blockCount == 0)
+    {
+        outData.m_storage.clear();
+        outData.m_bytes = std::span<uint8_t const>(data, static_cast<size_t>(entry->m_rawBytes));
+        m_zeroCopyCount.fetch_add(1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    PROFILE_SCOPE("AssetPack::Decompress");
+
+    outData.m_storage.resize(static_cast<size_t>(entry->m_rawBytes));
+
+    uint8_t* out = outData.m_storage.data();
+
+    for (uint32_t block = 0; block < entry->m_blockCount; ++block)
+    {
+        sBlock const&  blockInfo = m_blocks[entry->m_firstBlock + block];
+        sBlockEncoding encoding;
+
+        encoding.m_encoding        = static_cast<eBlockEncoding>(blockInfo.m_encoding);
+        encoding.m_rawBytes        = blockInfo.m_rawBytes;
+        encoding.m_sequenceBytes   = blockInfo.m_sequenceBytes;
+        encoding.m_compressedBytes = blockInfo.m_compressedBytes;
+
+        if (!DecodeBlock(encoding, data + blockInfo.m_offset, out))
+        {
+            outData.m_storage.clear();
+            outData.m_bytes = {};
+            return false;
+        }
+
+        out += blockInfo.m_rawBytes;
+    }
+
+    outData.m_bytes = outData.m_storage;
+    m_decompressedBytes.fetch_add(entry->m_rawBytes, std::memory_order_relaxed);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+String const& AssetPack::GetPath() const
+{
+    return m_path;
+}
+
+//----------------------------------------------------------------------------------------------------
+sAssetPackStats AssetPack::GetStats() const
+{
+    std::shared_lock lock(m_mutex);
+    sAssetPackStats  stats;
+
+    stats.m_entryCount        = m_header != nullptr ? static_cast<int>(m_header->m_entryCount) : 0;
+    stats.m_packBytes         = m_header != nullptr ? m_header->m_fileBytes : 0;
+    stats.m_readCount         = m_readCount.load(std::memory_order_relaxed);
+    stats.m_zeroCopyCount     = m_zeroCopyCount.load(std::memory_order_relaxed);
+    stats.m_decompressedBytes = m_decompressedBytes.load(std::memory_order_relaxed);
+    stats.m_looseReadCount    = s_looseReadCount.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Unmaps the pack; the caller holds m_mutex exclusively.
+void AssetPack::CloseMapping()
+{
+    m_file.Close();
+    m_path.clear();
+
+    m_header  = nullptr;
+    m_slots   = nullptr;
+    m_entries = nullptr;
+    m_blocks  = nullptr;
+    m_names   = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Linear probing from the path's hash; the name is compared only when the hash matches.
+AssetPack::sEntry const* AssetPack::FindEntry(std::string_view const path) const
+{
+    if (m_header == nullptr || m_header->m_entryCount == 0) return nullptr;
+
+    String                 scratch;
+    std::string_view const name = NormalizePath(path, scratch);
+    uint32_t const         hash = GetCaseInsensitiveHash(name);
+    uint32_t const         mask = m_header->m_slotCount - 1;
+
+    for (uint32_t probe = 0; probe <= mask; ++probe)
+    {
+        sSlot const& slot = m_slots[(hash + probe) & mask];
+
+        if (slot.m_entryIndex == 0) return nullptr;
+        if (slot.m_hash != hash) continue;
+
+        sEntry const& entry = m_entries[slot.m_entryIndex - 1];
+
+        if (AreNamesEqualCaseInsensitive(std::string_view(m_names + entry.m_nameOffset, entry.m_nameLength), name)) return &entry;
+    }
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Packs every file under rootDirectory into packPath, named rootDirectory/<relative path>. Files are
+/// read on the calling thread and compressed on g_jobScheduler; the pack is written to a temporary
+/// file first and renamed over packPath, which must not be the open g_assetPack.
+STATIC bool AssetPack::Build(String const& rootDirectory, String const& packPath, sAssetPackBuildSettings const& settings, sAssetPackBuildStats& outStats)
+{
+    PROFILE_SCOPE("AssetPack::Build");
+
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    struct sSourceFile
+    {
+        String               m_name;
+        int64_t              m_writeTime = 0;
+        std::vector<uint8_t> m_raw;
+        std::vector<uint8_t> m_stored;          // Compressed blocks back to back; empty when stored as is
+        std::vector<sBlock>  m_blocks;
+        uint64_t             m_dataOffset = 0;
+    };
+
+    outStats = sAssetPackBuildStats();
+
+    std::error_code                    errorCode;
+    std::vector<std::filesystem::path> paths;
+
+    for (std::filesystem::recursive_directory_iterator it(rootDirectory, errorCode), end; !errorCode && it != end; it.increment(errorCode))
+    {
+        if (!it->is_regular_file(errorCode)) continue;
+
+        String const extension = it->path().extension().string();
+        bool         isExcluded = false;
+
+        for (char const* excluded : EXCLUDED_EXTENSIONS)
+        {
+            isExcluded = isExcluded || AreNamesEqualCaseInsensitive(extension, excluded);
+        }
+
+        if (!isExcluded) paths.push_back(it->path());
+    }
+
+    if (errorCode) return false;
+
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<sSourceFile> files(paths.size());
+
+    for (size_t index = 0; index < paths.size(); ++index)
+    {
+        sSourceFile& file = files[index];
+
+        file.m_name      = (std::filesystem::path(rootDirectory) / paths[index].lexically_relative(rootDirectory)).generic_string();
+        file.m_writeTime = static_cast<int64_t>(std::filesystem::last_write_time(paths[index], errorCode).time_since_epoch().count());
+
+        if (errorCode || !ReadLooseFile(paths[index].string(), file.m_raw)) return false;
+    }
+
+    // Blocks of one file go back to back; a file keeps them only if they save enough
+    size_t const blockBytes = static_cast<size_t>(std::max(settings.m_blockKiB, 1)) * 1024;
+
+    auto const compressFile = [&](int const index)
+    {
+        sSourceFile& file = files[static_cast<size_t>(index)];
+
+        if (!settings.m_isCompressing || file.m_raw.empty()) return;
+
+        std::vector<uint8_t> payload;
+
+        for (size_t offset = 0; offset < file.m_raw.size(); offset += blockBytes)
+        {
+            size_t const   size = std::min(blockBytes, file.m_raw.size() - offset);
+            sBlockEncoding encoding;
+
+            EncodeBlock(file.m_raw.data() + offset, size, encoding, payload);
+
+            sBlock block;
+            block.m_offset          = file.m_stored.size();
+            block.m_encoding        = static_cast<uint32_t>(encoding.m_encoding);
+            block.m_rawBytes        = encoding.m_rawBytes;
+            block.m_sequenceBytes   = encoding.m_sequenceBytes;
+            block.m_compressedBytes = encoding.m_compressedBytes;
+
+            file.m_blocks.push_back(block);
+            file.m_stored.insert(file.m_stored.end(), payload.begin(), payload.end());
+        }
+
+        if (static_cast<double>(file.m_stored.size()) > static_cast<double>(file.m_raw.size()) * (1.0 - settings.m_minSavedFraction))
+        {
+            file.m_stored.clear();
+            file.m_blocks.clear();
+        }
+    };
+
+    if (g_jobScheduler != nullptr)
+    {
+        g_jobScheduler->ParallelFor(static_cast<int>(files.size()), compressFile);
+    }
+    else
+    {
+        for (int index = 0; index < static_cast<int>(files.size()); ++index) compressFile(index);
+    }
+
+    // Header, slots, entries, blocks, names, then the data
+    uint64_t const alignment = static_cast<uint64_t>(std::max(settings.m_alignment, 1));
+
+    if ((alignment & (alignment - 1)) != 0) return false;
+
+    sHeader header;
+    header.m_magic      = PACK_MAGIC;
+    header.m_version    = PACK_VERSION;
+    header.m_entryCount = static_cast<uint32_t>(files.size());
+    header.m_slotCount  = 1;
+    header.m_alignment  = static_cast<uint32_t>(alignment);
+
+    while (header.m_slotCount < header.m_entryCount * 2) header.m_slotCount *= 2;
+
+    std::vector<sSlot>  slots(header.m_slotCount);
+    std::vector<sEntry> entries(files.size());
+    std::vector<sBlock> blocks;
+    String              names;
+
+    for (sSourceFile const& file : files)
+    {
+        header.m_blockCount += static_cast<uint32_t>(file.m_blocks.size());
+        names               += file.m_name;
+    }
+
+    header.m_slotsOffset   = sizeof(sHeader);
+    header.m_entriesOffset = header.m_slotsOffset + slots.size() * sizeof(sSlot);
+    header.m_blocksOffset  = header.m_entriesOffset + entries.size() * sizeof(sEntry);
+    header.m_namesOffset   = header.m_blocksOffset + header.m_blockCount * sizeof(sBlock);
+    header.m_namesBytes    = names.size();
+
+    uint64_t dataOffset = header.m_namesOffset + header.m_namesBytes;
+    uint32_t nameOffset = 0;
+
+    for (size_t index = 0; index < files.size(); ++index)
+    {
+        sSourceFile& file  = files[index];
+        sEntry&      entry = entries[index];
+        bool const   isCompressed = !file.m_blocks.empty();
+
+        dataOffset        = AlignUp(dataOffset, alignment);
+        file.m_dataOffset = dataOffset;
+
+        entry.m_dataOffset  = dataOffset;
+        entry.m_rawBytes    = file.m_raw.size();
+        entry.m_storedBytes = isCompressed ? file.m_stored.size() : file.m_raw.size();
+        entry.m_writeTime   = file.m_writeTime;
+        entry.m_nameOffset  = nameOffset;
+        entry.m_nameLength  = static_cast<uint32_t>(file.m_name.size());
+        entry.m_firstBlock  = static_cast<uint32_t>(blocks.size());
+        entry.m_blockCount  = static_cast<uint32_t>(file.m_blocks.size());
+
+        blocks.insert(blocks.end(), file.m_blocks.begin(), file.m_blocks.end());
+
+        uint32_t const hash = GetCaseInsensitiveHash(file.m_name);
+        uint32_t       slot = hash & (header.m_slotCount - 1);
+
+        while (slots[slot].m_entryIndex != 0) slot = (slot + 1) & (header.m_slotCount - 1);
+
+        slots[slot].m_hash       = hash;
+        slots[slot].m_entryIndex = static_cast<uint32_t>(index + 1);
+
+        dataOffset += entry.m_storedBytes;
+        nameOffset += entry.m_nameLength;
+
+        outStats.m_rawBytes        += entry.m_rawBytes;
+        outStats.m_compressedCount += isCompressed ? 1 : 0;
+    }
+
+    header.m_fileBytes = dataOffset;
+
+    String const  temporaryPath = packPath + ".tmp";
+    std::ofstream out(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+
+    out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    out.write(reinterpret_cast<char const*>(slots.data()), static_cast<std::streamsize>(slots.size() * sizeof(sSlot)));
+    out.write(reinterpret_cast<char const*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(sEntry)));
+    out.write(reinterpret_cast<char const*>(blocks.data()), static_cast<std::streamsize>(blocks.size() * sizeof(sBlock)));
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    uint64_t written = header.m_namesOffset + header.m_namesBytes;
+
+    for (sSourceFile const& file : files)
+    {
+        std::vector<uint8_t> const& bytes = file.m_blocks.empty() ? file.m_raw : file.m_stored;
+        static char const           s_padding[4096] = {};
+
+        while (written < file.m_dataOffset)
+        {
+            uint64_t const padding = std::min<uint64_t>(file.m_dataOffset - written, sizeof(s_padding));
+            out.write(s_padding, static_cast<std::streamsize>(padding));
+            written += padding;
+        }
+
+        out.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        written += bytes.size();
+    }
+
+    out.close();
+
+    if (!out)
+    {
+        std::filesystem::remove(temporaryPath, errorCode);
+        return false;
+    }
+
+    std::filesystem::rename(temporaryPath, packPath, errorCode);
+    if (errorCode) return false;
+
+    outStats.m_fileCount = static_cast<int>(files.size());
+    outStats.m_packBytes = header.m_fileBytes;
+    outStats.m_seconds   = GetCurrentTimeSeconds() - startSeconds;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Size and write time of path, from g_assetPack when it has it; what caches keyed on their source
+/// compare against.
+bool StatAssetFile(String const& path, sAssetFileInfo& outInfo)
+{
+    if (g_assetPack != nullptr && g_assetPack->FindFile(path, outInfo)) return true;
+
+    std::error_code errorCode;
+
+    outInfo.m_size = static_cast<uint64_t>(std::filesystem::file_size(path, errorCode));
+    if (errorCode) return false;
+
+    outInfo.m_writeTime = static_cast<int64_t>(std::filesystem::last_write_time(path, errorCode).time_since_epoch().count());
+    outInfo.m_isInPack  = false;
+
+    return !errorCode;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ReadAssetFile(String const& path, sAssetFileData& outData)
+{
+    if (g_assetPack != nullptr && g_assetPack->ReadFile(path, outData)) return true;
+
+    outData.m_isInPack = false;
+
+    if (!ReadLooseFile(path, outData.m_storage))
+    {
+        outData.m_bytes = {};
+        return false;
+    }
+
+    outData.m_bytes = outData.m_storage;
+    s_looseReadCount.fetch_add(1, std::memory_order_relaxed);
+
+    return true;
+}
@@ -0,0 +1,134 @@
+//----------------------------------------------------------------------------------------------------
+// AssetPack.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/MappedFile.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sAssetPackBuildSettings
+{
+    int   m_alignment        = 64;        // Of every entry's data in the pack; a power of two
+    int   m_blockKiB         = 64;        // Compressed entries are split into blocks of this much raw data
+    bool  m_isCompressing    = true;
+    float m_minSavedFraction = 0.1f;      // Entries that shrink less than this are stored, and read without a copy
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sAssetPackBuildStats
+{
+    int      m_fileCount       = 0;
+    int      m_compressedCount = 0;
+    uint64_t m_rawBytes        = 0;
+    uint64_t m_packBytes       = 0;
+    double   m_seconds         = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sAssetPackStats
+{
+    int      m_entryCount        = 0;
+    uint64_t m_packBytes         = 0;
+    uint64_t m_readCount         = 0;     // Files read from the pack...
+    uint64_t m_zeroCopyCount     = 0;     // ...of which handed out as views into the mapping
+    uint64_t m_decompressedBytes = 0;
+    uint64_t m_looseReadCount    = 0;     // Files ReadAssetFile() read loose instead, pack or no pack
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sAssetFileInfo
+{
+    uint64_t m_size      = 0;
+    int64_t  m_writeTime = 0;             // std::filesystem::file_time_type ticks; for a packed file, the loose file's when packed
+    bool     m_isInPack  = false;
+};
+
+//----------------------------------------------------------------------------------------------------
+// The bytes of one asset file: a view into the pack's mapping when it is stored uncompressed there,
+// otherwise a view of m_storage. Views into the pack stay valid while the pack is open.
+//
+struct sAssetFileData
+{
+    std::span<uint8_t const> m_bytes;
+    std::vector<uint8_t>     m_storage;
+    bool                     m_isInPack = false;
+
+    std::string_view GetText() const;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Everything under Run/Data in one file, opened with one memory mapping.
+//
+// Layout: a header, the table of contents, then the entries' data, each aligned. The table is an
+// open-addressed hash table of slots (case-insensitive hash of the path, entry index), the entries
+// (offset, sizes, write time, name, blocks) and their names, so a lookup is a few reads from one or
+// two pages. An entry is stored as is, and handed to its parser as a view into the mapping, or, when
+// that saves enough, split into blocks compressed as the log archive's are and decoded on read.
+//
+// Paths are relative to Run/ as the game opens them ("Data/Fonts/DaemonFont.fnt"), with either slash
+// and in any case. A pack is read only; lookups and reads may run on any thread, and Open() and Close()
+// wait for the ones in progress (views a read handed out are still the caller's to drop first).
+// Build() writes one from a directory: the runtime caches next to the sources (.cmdc, .glyphs, .sdf)
+// are left out.
+//
+class AssetPack
+{
+public:
+    AssetPack() = default;
+
+    AssetPack(AssetPack const&)            = delete;
+    AssetPack& operator=(AssetPack const&) = delete;
+
+    bool Open(String const& packPath);
+    void Close();
+    bool IsOpen() const;
+
+    bool FindFile(std::string_view path, sAssetFileInfo& outInfo) const;
+    bool ReadFile(std::string_view path, sAssetFileData& outData) const;
+
+    String const&   GetPath() const;
+    sAssetPackStats GetStats() const;
+
+    static bool Build(String const& rootDirectory, String const& packPath, sAssetPackBuildSettings const& settings, sAssetPackBuildStats& outStats);
+
+private:
+    struct sHeader;
+    struct sSlot;
+    struct sEntry;
+    struct sBlock;
+
+    void          CloseMapping();
+    sEntry const* FindEntry(std::string_view path) const;
+
+    mutable std::shared_mutex m_mutex;      // Shared by lookups and reads, exclusive in Open() and Close()
+
+    MappedFile     m_file;
+    String         m_path;
+    sHeader const* m_header  = nullptr;
+    sSlot const*   m_slots   = nullptr;
+    sEntry const*  m_entries = nullptr;
+    sBlock const*  m_blocks  = nullptr;
+    char const*    m_names   = nullptr;
+
+    mutable std::atomic<uint64_t> m_readCount{0};
+    mutable std::atomic<uint64_t> m_zeroCopyCount{0};
+    mutable std::atomic<uint64_t> m_decompressedBytes{0};
+};
+
+//----------------------------------------------------------------------------------------------------
+// Game-side file access for data files: g_assetPack first when it is open, the loose file otherwise,
+// so a development tree without a pack (or with files added since it was built) still loads.
+//
+bool StatAssetFile(String const& path, sAssetFileInfo& outInfo);
+bool ReadAssetFile(String const& path, sAssetFileData& outData);
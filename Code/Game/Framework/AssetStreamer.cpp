@@ -0,0 +1,380 @@
+//----------------------------------------------------------------------------------------------------
+// AssetStreamer.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/AssetStreamer.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/BinaryLog.hpp"
+#include "Game/Framework/FrameProfiler.hpp"
+#include "Game/Framework/GameCommon.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Renderer/BitmapFont.hpp"
+#include "Engine/Renderer/Image.hpp"
+#include "Engine/Renderer/Shader.hpp"
+#include "Engine/Renderer/Texture.hpp"
+#include "Engine/Resource/ResourceSubsystem.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <fstream>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    // Reads a whole file and throws the bytes away, so whoever opens it next on the main thread is
+    // served from the OS cache instead of the disk.
+    //
+    bool ReadAhead(String const& path)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+
+        if (!file.is_open()) return false;
+
+        thread_local std::vector<char> t_buffer(64 * 1024);
+
+        while (file.read(t_buffer.data(), static_cast<std::streamsize>(t_buffer.size())) || file.gcount() > 0)
+        {
+        }
+
+        return true;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    char const* GetAssetTypeName(eAssetType const type)
+    {
+        switch (type)
+        {
+        case eAssetType::IMAGE:   return "image";
+        case eAssetType::TEXTURE: return "texture";
+        case eAssetType::FONT:    return "font";
+        case eAssetType::SHADER:  return "shader";
+        default:                  return "asset";
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+sAssetRequest::sAssetRequest()  = default;
+sAssetRequest::~sAssetRequest() = default;
+
+//----------------------------------------------------------------------------------------------------
+AssetStreamer::AssetStreamer(sAssetStreamerConfig const& config)
+    : m_config(config)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Waits for worker stages still running, which point back at the streamer, then releases the
+/// textures it uploaded. Must run before g_ioScheduler and the Renderer go.
+AssetStreamer::~AssetStreamer()
+{
+    for (auto& requests : m_requests)
+    {
+        for (auto& [key, request] : requests)
+        {
+            if (request->m_scheduler != nullptr)
+            {
+                request->m_scheduler->Wait(request->m_job);
+            }
+        }
+    }
+
+    for (auto& [key, request] : m_requests[static_cast<int>(eAssetType::TEXTURE)])
+    {
+        if (request->m_state.load(std::memory_order_acquire) == eAssetState::READY)
+        {
+            delete static_cast<Texture*>(request->m_asset);
+            request->m_asset = nullptr;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+AssetFuture<Image> AssetStreamer::RequestImageAsync(String const& path, eJobPriority const priority)
+{
+    return AssetFuture<Image>(Request(eAssetType::IMAGE, path, eVertexType::VERTEX_PCU, priority));
+}
+
+//----------------------------------------------------------------------------------------------------
+AssetFuture<Texture> AssetStreamer::RequestTextureAsync(String const& path, eJobPriority const priority)
+{
+    return AssetFuture<Texture>(Request(eAssetType::TEXTURE, path, eVertexType::VERTEX_PCU, priority));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @param pathNoExtension As for ResourceSubsystem::CreateOrGetBitmapFontFromFile: the .png, and the .fnt if there is one
+AssetFuture<BitmapFont> AssetStreamer::RequestFontAsync(String const& pathNoExtension, eJobPriority const priority)
+{
+    return AssetFuture<BitmapFont>(Request(eAssetType::FONT, pathNoExtension, eVertexType::VERTEX_PCU, priority));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @param pathNoExtension As for ResourceSubsystem::CreateOrGetShaderFromFile: the .hlsl
+AssetFuture<Shader> AssetStreamer::RequestShaderAsync(String const& pathNoExtension, eVertexType const vertexType, eJobPriority const priority)
+{
+    return AssetFuture<Shader>(Request(eAssetType::SHADER, pathNoExtension, vertexType, priority));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Finishes the main-thread stages of assets whose worker stage is done, most urgent and then oldest
+/// first, while the frame's upload budget lasts. Uploads are not split, so the one that crosses the
+/// budget still completes; the smoothed cost of each type keeps one that would not fit from starting.
+void AssetStreamer::Update()
+{
+    PROFILE_SCOPE("AssetStreamer::Update");
+
+    CollectFinished();
+
+    double const startSeconds = GetCurrentTimeSeconds();
+    double const endSeconds   = startSeconds + static_cast<double>(m_config.m_uploadBudgetSeconds);
+
+    std::sort(m_pending.begin(), m_pending.end(), [](std::shared_ptr<sAssetRequest> const& a, std::shared_ptr<sAssetRequest> const& b)
+    {
+        return a->m_priority != b->m_priority ? a->m_priority < b->m_priority : a->m_sequence < b->m_sequence;
+    });
+
+    int    finishedCount = 0;
+    size_t pendingIndex  = 0;
+
+    for (; pendingIndex < m_pending.size(); ++pendingIndex)
+    {
+        sAssetRequest& request = *m_pending[pendingIndex];
+
+        // Already finished by a Wait()
+        if (request.m_state.load(std::memory_order_acquire) != eAssetState::PENDING) continue;
+
+        double const estimate = m_estimatedSeconds[static_cast<int>(request.m_type)];
+
+        if (finishedCount > 0 && GetCurrentTimeSeconds() + estimate > endSeconds) break;
+
+        Finish(request);
+        ++finishedCount;
+    }
+
+    m_pending.erase(m_pending.begin(), m_pending.begin() + static_cast<std::ptrdiff_t>(pendingIndex));
+
+    double const seconds = GetCurrentTimeSeconds() - startSeconds;
+
+    m_stats.m_finishedLastFrame = finishedCount;
+    m_stats.m_secondsLastFrame  = seconds;
+    m_stats.m_maxFrameSeconds   = std::max(m_stats.m_maxFrameSeconds, seconds);
+}
+
+//----------------------------------------------------------------------------------------------------
+sAssetStreamerConfig const& AssetStreamer::GetConfig() const
+{
+    return m_config;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AssetStreamer::SetConfig(sAssetStreamerConfig const& config)
+{
+    m_config = config;
+}
+
+//----------------------------------------------------------------------------------------------------
+sAssetStreamerStats AssetStreamer::GetStats() const
+{
+    sAssetStreamerStats stats = m_stats;
+
+    for (auto const& requests : m_requests)
+    {
+        for (auto const& [key, request] : requests)
+        {
+            switch (request->m_state.load(std::memory_order_acquire))
+            {
+            case eAssetState::LOADING: ++stats.m_loadingCount; break;
+            case eAssetState::PENDING: ++stats.m_pendingCount; break;
+            case eAssetState::READY:   ++stats.m_readyCount;   break;
+            case eAssetState::FAILED:  ++stats.m_failedCount;  break;
+            }
+        }
+    }
+
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Returns the request already made for this asset, moved up to priority if that is more urgent, or
+/// makes one and submits its worker stage. A worker stage already queued keeps its lane; the new
+/// priority applies to the main-thread queue, and Wait() covers anything more urgent than that.
+std::shared_ptr<sAssetRequest> AssetStreamer::Request(eAssetType const type, String const& path, eVertexType const vertexType, eJobPriority const priority)
+{
+    String const key      = type == eAssetType::SHADER ? Stringf("%s#%d", path.c_str(), static_cast<int>(vertexType)) : path;
+    auto&        requests = m_requests[static_cast<int>(type)];
+    auto const   found    = requests.find(key);
+
+    if (found != requests.end())
+    {
+        found->second->m_priority = std::min(found->second->m_priority, priority);
+        ++m_stats.m_dedupedCount;
+        return found->second;
+    }
+
+    std::shared_ptr<sAssetRequest> request = std::make_shared<sAssetRequest>();
+
+    request->m_path           = path;
+    request->m_type           = type;
+    request->m_vertexType     = vertexType;
+    request->m_priority       = priority;
+    request->m_sequence       = m_nextSequence++;
+    request->m_requestSeconds = GetCurrentTimeSeconds();
+    request->m_scheduler      = g_ioScheduler;
+
+    requests.emplace(key, request);
+    ++m_stats.m_requestCount;
+
+    if (request->m_scheduler != nullptr)
+    {
+        request->m_job = request->m_scheduler->Submit([this, request] { RunWorkerStage(request); }, priority);
+    }
+    else
+    {
+        RunWorkerStage(request);
+    }
+
+    return request;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AssetStreamer::AddCallback(sAssetRequest& request, std::function<void(void*)> callback)
+{
+    eAssetState const state = request.m_state.load(std::memory_order_acquire);
+
+    if (state == eAssetState::READY || state == eAssetState::FAILED)
+    {
+        callback(request.m_asset);
+        return;
+    }
+
+    request.m_callbacks.push_back(std::move(callback));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Runs jobs until the request's worker stage is done, then its main-thread stage, outside the budget.
+/// The request stays in the pending list, where Update() skips it.
+void AssetStreamer::WaitForRequest(sAssetRequest& request)
+{
+    PROFILE_SCOPE("AssetStreamer::Wait");
+
+    if (request.m_scheduler != nullptr)
+    {
+        request.m_scheduler->Wait(request.m_job);
+    }
+
+    Finish(request);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Runs as a job: decodes images and textures, reads fonts' and shaders' files ahead. Hands the
+/// request to the main thread through m_finished.
+void AssetStreamer::RunWorkerStage(std::shared_ptr<sAssetRequest> const& request)
+{
+    PROFILE_SCOPE("AssetStreamer::RunWorkerStage");
+
+    String const& path = request->m_path;
+
+    switch (request->m_type)
+    {
+    case eAssetType::IMAGE:
+    case eAssetType::TEXTURE:
+        {
+            request->m_image = std::make_unique<Image>(path.c_str());
+
+            IntVec2 const dimensions = request->m_image->GetDimensions();
+            request->m_isSourceFound = dimensions.x > 0 && dimensions.y > 0;
+            break;
+        }
+    case eAssetType::FONT:
+        request->m_isSourceFound = ReadAhead(path + ".png");
+        ReadAhead(path + ".fnt");       // Tier 1 and 2 fonts have none
+        break;
+    case eAssetType::SHADER:
+        request->m_isSourceFound = ReadAhead(path + ".hlsl");
+        break;
+    default:
+        break;
+    }
+
+    request->m_state.store(eAssetState::PENDING, std::memory_order_release);
+
+    std::lock_guard const lock(m_finishedMutex);
+    m_finished.push_back(request);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// The main-thread stage: uploads or creates the asset, publishes it and runs its callbacks. Nothing
+/// is created from a source the worker could not find, and nothing that needs the Renderer without one.
+void AssetStreamer::Finish(sAssetRequest& request)
+{
+    if (request.m_state.load(std::memory_order_acquire) != eAssetState::PENDING) return;
+
+    PROFILE_SCOPE("AssetStreamer::Finish");
+
+    double const startSeconds = GetCurrentTimeSeconds();
+    bool const   canCreate    = request.m_isSourceFound && g_renderer != nullptr;
+    void*        asset        = nullptr;
+
+    switch (request.m_type)
+    {
+    case eAssetType::IMAGE:
+        if (request.m_isSourceFound) asset = request.m_image.get();
+        break;
+    case eAssetType::TEXTURE:
+        if (canCreate) asset = g_renderer->CreateTextureFromImage(*request.m_image);
+        request.m_image.reset();
+        break;
+    case eAssetType::FONT:
+        if (canCreate) asset = g_resourceSubsystem->CreateOrGetBitmapFontFromFile(request.m_path.c_str());
+        break;
+    case eAssetType::SHADER:
+        if (canCreate) asset = g_resourceSubsystem->CreateOrGetShaderFromFile(request.m_path.c_str(), request.m_vertexType);
+        break;
+    default:
+        break;
+    }
+
+    double const endSeconds = GetCurrentTimeSeconds();
+    double&      estimate   = m_estimatedSeconds[static_cast<int>(request.m_type)];
+
+    estimate = estimate > 0.0 ? estimate * 0.75 + (endSeconds - startSeconds) * 0.25 : endSeconds - startSeconds;
+
+    request.m_asset = asset;
+    request.m_state.store(asset != nullptr ? eAssetState::READY : eAssetState::FAILED, std::memory_order_release);
+
+    if (asset != nullptr)
+    {
+        m_stats.m_maxLatencySeconds = std::max(m_stats.m_maxLatencySeconds, endSeconds - request.m_requestSeconds);
+    }
+    else
+    {
+        GAME_LOG(eLogVerbosity::Warning, "(AssetStreamer) could not load %s %s", GetAssetTypeName(request.m_type), request.m_path.c_str());
+    }
+
+    // A callback may request or wait for other assets, so run them from a list of our own
+    std::vector<std::function<void(void*)>> callbacks;
+    callbacks.swap(request.m_callbacks);
+
+    for (std::function<void(void*)> const& callback : callbacks)
+    {
+        callback(asset);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void AssetStreamer::CollectFinished()
+{
+    std::lock_guard const lock(m_finishedMutex);
+
+    m_pending.insert(m_pending.end(), m_finished.begin(), m_finished.end());
+    m_finished.clear();
+}
@@ -0,0 +1,202 @@
+//----------------------------------------------------------------------------------------------------
+// AssetStreamer.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/JobScheduler.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class BitmapFont;
+class Image;
+class Shader;
+class Texture;
+
+//----------------------------------------------------------------------------------------------------
+// Loaded from the <AssetStreaming> element of Data/GameConfig.xml.
+//
+struct sAssetStreamerConfig
+{
+    float m_uploadBudgetSeconds = 0.002f;     // Main-thread time per frame for uploads and creation; the most urgent one still runs
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eAssetType : uint8_t
+{
+    IMAGE,          // Decoded on an IO thread; nothing to do on the main thread
+    TEXTURE,        // Decoded on an IO thread, uploaded on the main thread
+    FONT,           // Files read ahead on an IO thread, created by the ResourceSubsystem on the main thread
+    SHADER,         // Likewise
+    COUNT
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eAssetState : uint8_t
+{
+    LOADING,        // Worker stage queued or running
+    PENDING,        // Worker stage done, waiting for its turn on the main thread
+    READY,
+    FAILED
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sAssetStreamerStats
+{
+    int    m_requestCount      = 0;       // Distinct assets requested
+    int    m_dedupedCount      = 0;       // Requests answered with an asset already requested
+    int    m_loadingCount      = 0;
+    int    m_pendingCount      = 0;
+    int    m_readyCount        = 0;
+    int    m_failedCount       = 0;
+    int    m_finishedLastFrame = 0;       // Assets the last Update made ready or failed
+    double m_secondsLastFrame  = 0.0;     // Main-thread time the last Update spent on them
+    double m_maxFrameSeconds   = 0.0;     // Worst Update so far
+    double m_maxLatencySeconds = 0.0;     // Worst time from request to ready
+};
+
+//----------------------------------------------------------------------------------------------------
+// Shared state of one requested asset. The worker stage owns m_image and m_isSourceFound while
+// LOADING; everything else is main thread only.
+//
+struct sAssetRequest
+{
+    sAssetRequest();
+    ~sAssetRequest();
+
+    String                                  m_path;
+    eAssetType                              m_type       = eAssetType::IMAGE;
+    eVertexType                             m_vertexType = eVertexType::VERTEX_PCU;
+    eJobPriority                            m_priority   = eJobPriority::NORMAL;
+    uint64_t                                m_sequence   = 0;
+    std::atomic<eAssetState>                m_state{eAssetState::LOADING};
+    JobScheduler*                           m_scheduler = nullptr;     // Where the worker stage runs; nullptr ran it inline
+    JobHandle                               m_job;
+    std::unique_ptr<Image>                  m_image;
+    bool                                    m_isSourceFound  = false;
+    void*                                   m_asset          = nullptr;
+    double                                  m_requestSeconds = 0.0;
+    std::vector<std::function<void(void*)>> m_callbacks;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Shared reference to a requested asset. Get() is nullptr until the asset is ready, and stays
+// nullptr if it failed. An empty future is never ready.
+//
+template <typename T>
+class AssetFuture
+{
+public:
+    AssetFuture() = default;
+
+    bool IsValid() const { return m_request != nullptr; }
+    bool IsReady() const { return m_request != nullptr && m_request->m_state.load(std::memory_order_acquire) == eAssetState::READY; }
+    bool HasFailed() const { return m_request != nullptr && m_request->m_state.load(std::memory_order_acquire) == eAssetState::FAILED; }
+    bool IsDone() const { return IsReady() || HasFailed(); }
+    T*   Get() const { return IsReady() ? static_cast<T*>(m_request->m_asset) : nullptr; }
+
+    String const& GetPath() const { return m_request->m_path; }
+
+private:
+    friend class AssetStreamer;
+
+    explicit AssetFuture(std::shared_ptr<sAssetRequest> request) : m_request(std::move(request)) {}
+
+    std::shared_ptr<sAssetRequest> m_request;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Asynchronous, prioritized loading of the game's images, textures, fonts and shaders.
+//
+// A request returns at once with a future. Its worker stage runs as a g_ioScheduler job at the
+// request's priority: images and textures are read and decoded there, while fonts and shaders only
+// have their files read ahead, so the ResourceSubsystem finds them in the OS cache. The rest
+// needs the main thread (texture upload, font and shader creation) and happens in Update(), most
+// urgent first, until the frame's upload budget is spent; the first one of a frame always runs, so
+// a budget shorter than one upload still makes progress. Requests for an asset already requested
+// share its future; a more urgent one moves it up the main-thread queue.
+//
+// OnDone() callbacks run on the main thread when the asset becomes ready or fails, or at once if it
+// already has. Wait() finishes an asset now, helping with jobs meanwhile, for code that cannot go on
+// without it. Assets stay loaded for the streamer's lifetime: the streamer owns the images and
+// textures it made, the ResourceSubsystem the fonts and shaders. Everything but the worker stage is
+// main thread only.
+//
+class AssetStreamer
+{
+public:
+    explicit AssetStreamer(sAssetStreamerConfig const& config);
+    ~AssetStreamer();
+
+    AssetStreamer(AssetStreamer const&)            = delete;
+    AssetStreamer& operator=(AssetStreamer const&) = delete;
+
+    AssetFuture<Image>      RequestImageAsync(String const& path, eJobPriority priority = eJobPriority::NORMAL);
+    AssetFuture<Texture>    RequestTextureAsync(String const& path, eJobPriority priority = eJobPriority::NORMAL);
+    AssetFuture<BitmapFont> RequestFontAsync(String const& pathNoExtension, eJobPriority priority = eJobPriority::NORMAL);
+    AssetFuture<Shader>     RequestShaderAsync(String const& pathNoExtension, eVertexType vertexType = eVertexType::VERTEX_PCU, eJobPriority priority = eJobPriority::NORMAL);
+
+    template <typename T>
+    void OnDone(AssetFuture<T> const& future, std::type_identity_t<std::function<void(T*)>> callback);
+
+    template <typename T>
+    T* Wait(AssetFuture<T> const& future);
+
+    void Update();
+
+    sAssetStreamerConfig const& GetConfig() const;
+    void                        SetConfig(sAssetStreamerConfig const& config);
+    sAssetStreamerStats         GetStats() const;
+
+private:
+    std::shared_ptr<sAssetRequest> Request(eAssetType type, String const& path, eVertexType vertexType, eJobPriority priority);
+    void                           AddCallback(sAssetRequest& request, std::function<void(void*)> callback);
+    void                           WaitForRequest(sAssetRequest& request);
+    void                           RunWorkerStage(std::shared_ptr<sAssetRequest> const& request);
+    void                           Finish(sAssetRequest& request);
+    void                           CollectFinished();
+
+    sAssetStreamerConfig m_config;
+    sAssetStreamerStats  m_stats;
+    uint64_t             m_nextSequence = 0;
+
+    std::unordered_map<String, std::shared_ptr<sAssetRequest>> m_requests[static_cast<int>(eAssetType::COUNT)];
+    std::vector<std::shared_ptr<sAssetRequest>>                m_pending;                                                     // Worker stage done, in no order
+    double                                                     m_estimatedSeconds[static_cast<int>(eAssetType::COUNT)] = {};  // Main-thread cost per type, smoothed
+
+    // Filled by workers, drained by Update()
+    std::mutex                                  m_finishedMutex;
+    std::vector<std::shared_ptr<sAssetRequest>> m_finished;
+};
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+void AssetStreamer::OnDone(AssetFuture<T> const& future, std::type_identity_t<std::function<void(T*)>> callback)
+{
+    if (!future.IsValid()) return;
+
+    AddCallback(*future.m_request, [callback = std::move(callback)](void* asset) { callback(static_cast<T*>(asset)); });
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+T* AssetStreamer::Wait(AssetFuture<T> const& future)
+{
+    if (!future.IsValid()) return nullptr;
+
+    WaitForRequest(*future.m_request);
+
+    return future.Get();
+}
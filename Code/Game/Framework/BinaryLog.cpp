@@ -0,0 +1,666 @@
+//----------------------------------------------------------------------------------------------------
+// BinaryLog.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/BinaryLog.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <chrono>
+#include <cstdio>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    // Per-thread ring, and the id of the BinaryLog that handed it out
+    thread_local LogThreadRing* t_logRing        = nullptr;
+    thread_local uint64_t       t_logRingOwnerId = 0;
+
+    std::atomic<uint64_t> s_nextLogId{1};
+
+    // GAME_LOG records written before the first BinaryLog exists; closed once it takes them
+    std::mutex s_earlyMutex;
+    sLogRecord s_earlyRecords[BinaryLog::EARLY_RECORDS];
+    int        s_earlyCount        = 0;
+    uint64_t   s_earlyDroppedCount = 0;
+    bool       s_isEarlyClosed     = false;
+
+    uint32_t RoundUpToPowerOfTwo(uint32_t const value)
+    {
+        uint32_t power = 1;
+
+        while (power < value)
+        {
+            power <<= 1;
+        }
+
+        return power;
+    }
+
+    bool IsConversionIn(char const conversion, char const* conversions)
+    {
+        return conversion != '\0' && std::strchr(conversions, conversion) != nullptr;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+LogThreadRing::LogThreadRing(uint16_t const threadIndex, int const capacity)
+    : m_threadIndex(threadIndex)
+    , m_records(static_cast<size_t>(capacity))
+    , m_mask(static_cast<uint32_t>(capacity) - 1)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Producer side; called only by the owning thread.
+sLogRecord* LogThreadRing::BeginWrite()
+{
+    uint32_t const writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+    uint32_t const readIndex  = m_readIndex.load(std::memory_order_acquire);
+
+    if (writeIndex - readIndex > m_mask)
+    {
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    return &m_records[writeIndex & m_mask];
+}
+
+//----------------------------------------------------------------------------------------------------
+void LogThreadRing::EndWrite()
+{
+    m_writeIndex.store(m_writeIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Consumer side; called only by the logging thread.
+sLogRecord const* LogThreadRing::BeginRead()
+{
+    uint32_t const readIndex  = m_readIndex.load(std::memory_order_relaxed);
+    uint32_t const writeIndex = m_writeIndex.load(std::memory_order_acquire);
+
+    return readIndex != writeIndex ? &m_records[readIndex & m_mask] : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+void LogThreadRing::EndRead()
+{
+    m_readIndex.store(m_readIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t LogThreadRing::GetWrittenCount() const
+{
+    return m_writeIndex.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+BinaryLog::BinaryLog(sBinaryLogConfig const& config)
+    : m_config(config)
+    , m_id(s_nextLogId.fetch_add(1, std::memory_order_relaxed))
+{
+    m_ringCapacity = static_cast<int>(RoundUpToPowerOfTwo(static_cast<uint32_t>(m_config.m_recordsPerThread > 1 ? m_config.m_recordsPerThread : 2)));
+    m_batch.resize(static_cast<size_t>(m_config.m_batchSize > 0 ? m_config.m_batchSize : 1));
+
+    if (m_config.m_maxEntries <= 0)
+    {
+        m_config.m_maxEntries = (m_config.m_threadCount > 0 ? m_config.m_threadCount : 1) * m_ringCapacity;
+    }
+
+    AdoptEarlyRecords();
+
+    // Lines are timestamped in UTC from here; GetCurrentTimeSeconds() only counts from an arbitrary start
+    m_unixSecondsOffset = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count() - GetCurrentTimeSeconds();
+
+    if (!m_config.m_filePath.empty())
+    {
+        m_archive = std::make_unique<LogArchive>(m_config.m_filePath, m_config.m_archive, m_config.m_thread);
+
+        if (m_archive->IsOpen())
+        {
+            AddSink(WriteToFile, this);
+        }
+    }
+
+    if (m_config.m_isForwardedToEngine)
+    {
+        AddSink(ForwardToEngine, this);
+    }
+
+    m_thread.Start([this] { LoggingThreadMain(); }, m_config.m_thread, 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Formats and writes everything already recorded, then stops the logging thread. Every thread that
+/// may still GAME_LOG must be gone by now.
+BinaryLog::~BinaryLog()
+{
+    {
+        std::lock_guard lock(m_wakeMutex);
+        m_isStopping = true;
+    }
+
+    m_wakeCondition.notify_one();
+    m_thread.Join();
+
+    // Archives the last segment, and waits for it to be compressed
+    m_archive.reset();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Sinks added later start with the next batch.
+void BinaryLog::AddSink(LogSinkFunction const function, void* userData)
+{
+    std::lock_guard lock(m_sinksMutex);
+    m_sinks.push_back(sLogSink{ function, userData });
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Blocks until every record the calling thread wrote before the call has reached the sinks, along
+/// with whatever the other threads' rings held by then.
+void BinaryLog::Flush()
+{
+    // A sink that logs would otherwise wait on itself
+    if (m_thread.IsCurrentThread()) return;
+
+    std::unique_lock lock(m_wakeMutex);
+    uint64_t const   request = ++m_flushRequested;
+
+    m_wakeCondition.notify_one();
+    m_flushCondition.wait(lock, [this, request]() { return m_flushCompleted >= request; });
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// While disabled, records are still formatted but the batches go nowhere; for benchmarks.
+void BinaryLog::SetOutputEnabled(bool const isOutputEnabled)
+{
+    m_isOutputEnabled.store(isOutputEnabled, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+sBinaryLogConfig const& BinaryLog::GetConfig() const
+{
+    return m_config;
+}
+
+//----------------------------------------------------------------------------------------------------
+sBinaryLogStats BinaryLog::GetStats() const
+{
+    sBinaryLogStats stats;
+    stats.m_formattedCount = m_formattedCount.load(std::memory_order_relaxed);
+    stats.m_batchCount     = m_batchCount.load(std::memory_order_relaxed);
+    stats.m_droppedCount   = m_ringlessDropCount.load(std::memory_order_relaxed);
+
+    std::lock_guard lock(m_ringsMutex);
+
+    for (std::unique_ptr<LogThreadRing> const& ring : m_rings)
+    {
+        stats.m_recordedCount += ring->GetWrittenCount();
+        stats.m_droppedCount  += ring->m_droppedCount.load(std::memory_order_relaxed);
+    }
+
+    stats.m_ringCount    = static_cast<int>(m_rings.size());
+    stats.m_threadCount  = stats.m_ringCount - static_cast<int>(m_freeRings.size());
+    stats.m_refusedCount = m_refusedCount;
+
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// nullptr when the file sink is off.
+LogArchive* BinaryLog::GetArchive() const
+{
+    return m_archive.get();
+}
+
+//----------------------------------------------------------------------------------------------------
+ThreadPoolUsage const& BinaryLog::GetUsage() const
+{
+    return m_usage;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Expands record's format with its args, appending to out. Each conversion prints its arg as the
+/// type it was recorded with: %d of a float prints the float truncated, %f of an int the int as a
+/// double, %s of a number the number. Missing args print as <missing>.
+STATIC void BinaryLog::FormatRecord(sLogRecord const& record, String& out)
+{
+    char const* cursor   = record.m_format;
+    int         argIndex = 0;
+
+    while (*cursor != '\0')
+    {
+        char const* percent = std::strchr(cursor, '%');
+
+        if (percent == nullptr)
+        {
+            out.append(cursor);
+            break;
+        }
+
+        out.append(cursor, static_cast<size_t>(percent - cursor));
+
+        if (percent[1] == '%')
+        {
+            out.push_back('%');
+            cursor = percent + 2;
+            continue;
+        }
+
+        // Keep the flags, width and precision; drop the length modifier, which the recorded type replaces
+        int constexpr SPEC_CHARS = 24;
+        char          spec[SPEC_CHARS + 4];
+        int           specLength = 0;
+        char const*   scan       = percent + 1;
+
+        spec[specLength++] = '%';
+
+        while (specLength < SPEC_CHARS && (IsConversionIn(*scan, "-+ #0.") || (*scan >= '0' && *scan <= '9')))
+        {
+            spec[specLength++] = *scan++;
+        }
+
+        while (IsConversionIn(*scan, "hljztL"))
+        {
+            ++scan;
+        }
+
+        char const conversion = *scan;
+
+        if (conversion == '\0')
+        {
+            out.append(percent);
+            break;
+        }
+
+        cursor = scan + 1;
+
+        if (argIndex >= record.m_argCount)
+        {
+            out.append("<missing>");
+            continue;
+        }
+
+        eLogArg const  type  = record.m_argTypes[argIndex];
+        uint64_t const value = record.m_args[argIndex];
+        ++argIndex;
+
+        auto const finishSpec = [&spec, specLength](char const* suffix) -> char const*
+        {
+            std::strcpy(spec + specLength, suffix);
+            return spec;
+        };
+
+        char buffer[256];
+        int  length = 0;
+
+        switch (type)
+        {
+        case eLogArg::INT:
+            {
+                long long const asInt = static_cast<long long>(static_cast<int64_t>(value));
+
+                if (IsConversionIn(conversion, "fFeEgGaA")) length = std::snprintf(buffer, sizeof(buffer), finishSpec(conversion == 'f' ? "f" : "g"), static_cast<double>(asInt));
+                else if (IsConversionIn(conversion, "uxXo")) length = std::snprintf(buffer, sizeof(buffer), finishSpec(conversion == 'u' ? "llu" : conversion == 'x' ? "llx" : conversion == 'X' ? "llX" : "llo"), static_cast<unsigned long long>(asInt));
+                else if (conversion == 'c') length = std::snprintf(buffer, sizeof(buffer), finishSpec("c"), static_cast<int>(asInt));
+                else length = std::snprintf(buffer, sizeof(buffer), finishSpec("lld"), asInt);
+                break;
+            }
+
+        case eLogArg::UINT:
+            {
+                unsigned long long const asUnsigned = static_cast<unsigned long long>(value);
+
+                if (IsConversionIn(conversion, "fFeEgGaA")) length = std::snprintf(buffer, sizeof(buffer), finishSpec(conversion == 'f' ? "f" : "g"), static_cast<double>(asUnsigned));
+                else if (IsConversionIn(conversion, "xXo")) length = std::snprintf(buffer, sizeof(buffer), finishSpec(conversion == 'x' ? "llx" : conversion == 'X' ? "llX" : "llo"), asUnsigned);
+                else if (conversion == 'c') length = std::snprintf(buffer, sizeof(buffer), finishSpec("c"), static_cast<int>(asUnsigned));
+                else length = std::snprintf(buffer, sizeof(buffer), finishSpec("llu"), asUnsigned);
+                break;
+            }
+
+        case eLogArg::DOUBLE:
+            {
+                double asDouble = 0.0;
+                std::memcpy(&asDouble, &value, sizeof(double));
+
+                char const doubleConversion[2] = { IsConversionIn(conversion, "fFeEgGaA") ? conversion : 'g', '\0' };
+
+                if (IsConversionIn(conversion, "di")) length = std::snprintf(buffer, sizeof(buffer), finishSpec("lld"), static_cast<long long>(asDouble));
+                else length = std::snprintf(buffer, sizeof(buffer), finishSpec(doubleConversion), asDouble);
+                break;
+            }
+
+        case eLogArg::TEXT:
+            {
+                std::string_view const text(record.m_text + (value >> 8), static_cast<size_t>(value & 0xFF));
+
+                // Plain %s needs no terminated copy
+                if (specLength == 1)
+                {
+                    out.append(text.data(), text.size());
+                    continue;
+                }
+
+                String const terminated(text);
+                length = std::snprintf(buffer, sizeof(buffer), finishSpec("s"), terminated.c_str());
+                break;
+            }
+
+        case eLogArg::POINTER:
+            {
+                length = std::snprintf(buffer, sizeof(buffer), finishSpec("p"), reinterpret_cast<void const*>(static_cast<uintptr_t>(value)));
+                break;
+            }
+        }
+
+        if (length > 0)
+        {
+            out.append(buffer, length < static_cast<int>(sizeof(buffer)) ? static_cast<size_t>(length) : sizeof(buffer) - 1);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// A thread refused a ring asks again only once another thread has freed one.
+STATIC LogThreadRing* BinaryLog::GetThreadRing()
+{
+    if (t_logRingOwnerId != g_binaryLog->m_id || (t_logRing == nullptr && g_binaryLog->m_freeRingCount.load(std::memory_order_relaxed) > 0))
+    {
+        thread_local sThreadRingLease lease;
+
+        // A ring of an earlier log died with it
+        t_logRingOwnerId = g_binaryLog->m_id;
+        t_logRing        = g_binaryLog->AcquireThreadRing();
+        lease.m_logId    = t_logRingOwnerId;
+        lease.m_ring     = t_logRing;
+    }
+
+    return t_logRing;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Runs as the thread exits. The log must still be g_binaryLog: one destroyed before the thread
+/// exits took its rings with it.
+BinaryLog::sThreadRingLease::~sThreadRingLease()
+{
+    if (m_ring != nullptr && g_binaryLog != nullptr && g_binaryLog->m_id == m_logId)
+    {
+        g_binaryLog->ReleaseThreadRing(m_ring);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// GAME_LOG before the App has created the log; dropped, with nothing to count them, once it is gone.
+STATIC void BinaryLog::WriteEarly(sLogRecord const& record)
+{
+    std::lock_guard lock(s_earlyMutex);
+
+    if (s_isEarlyClosed) return;
+
+    if (s_earlyCount == EARLY_RECORDS)
+    {
+        ++s_earlyDroppedCount;
+        return;
+    }
+
+    s_earlyRecords[s_earlyCount++] = record;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Batched file sink: the whole batch is built into one string and appended to the archive's
+/// active segment at once. Each line starts with the prefix LogArchive indexes and queries by.
+STATIC void BinaryLog::WriteToFile(sLogLine const* lines, int const lineCount, void* userData)
+{
+    BinaryLog* log = static_cast<BinaryLog*>(userData);
+
+    log->m_fileText.clear();
+
+    for (int index = 0; index < lineCount; ++index)
+    {
+        sLogLine const& line = lines[index];
+        char            prefix[128];
+        int const       prefixLength = FormatLogLinePrefix(log->m_unixSecondsOffset + line.m_seconds, line.m_threadIndex, static_cast<int>(line.m_verbosity), line.m_category, prefix, sizeof(prefix));
+
+        log->m_fileText.append(prefix, static_cast<size_t>(prefixLength));
+        log->m_fileText.append(line.m_text);
+        log->m_fileText.push_back('\n');
+    }
+
+    log->m_archive->Append(log->m_fileText.data(), log->m_fileText.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Hands each line to the Engine's LogSubsystem, which adds its own timestamp and sends it on to
+/// the sinks LogConfig.json enables. The producing thread's index is kept in the text, and so is the
+/// category unless it is LogGame, the only one the Engine declares for the game.
+STATIC void BinaryLog::ForwardToEngine(sLogLine const* lines, int const lineCount, void* userData)
+{
+    UNUSED(userData)
+
+    for (int index = 0; index < lineCount; ++index)
+    {
+        sLogLine const& line = lines[index];
+
+        if (std::strcmp(line.m_category, "LogGame") == 0)
+        {
+            DAEMON_LOG(LogGame, line.m_verbosity, Stringf("(t%u) %s", static_cast<unsigned>(line.m_threadIndex), line.m_text.c_str()));
+        }
+        else
+        {
+            DAEMON_LOG(LogGame, line.m_verbosity, Stringf("(t%u)(%s) %s", static_cast<unsigned>(line.m_threadIndex), line.m_category, line.m_text.c_str()));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Called on a thread's first GAME_LOG. Reuses the ring of an exited thread, or creates one while the
+/// rings stay within m_maxEntries; nullptr otherwise.
+LogThreadRing* BinaryLog::AcquireThreadRing()
+{
+    std::lock_guard lock(m_ringsMutex);
+
+    if (!m_freeRings.empty())
+    {
+        LogThreadRing* ring = m_freeRings.back();
+        m_freeRings.pop_back();
+        m_freeRingCount.store(static_cast<int>(m_freeRings.size()), std::memory_order_relaxed);
+
+        return ring;
+    }
+
+    if ((static_cast<int>(m_rings.size()) + 1) * m_ringCapacity <= m_config.m_maxEntries)
+    {
+        m_rings.push_back(std::make_unique<LogThreadRing>(static_cast<uint16_t>(m_rings.size()), m_ringCapacity));
+
+        return m_rings.back().get();
+    }
+
+    // Straight to the Engine, since this thread's own GAME_LOG would be dropped too
+    if (m_refusedCount++ == 0)
+    {
+        DAEMON_LOG(LogGame, eLogVerbosity::Warning, Stringf("(BinaryLog) all %d rings of %d records are taken (maxEntries=%d); GAME_LOG from threads without one is dropped",
+                   static_cast<int>(m_rings.size()), m_ringCapacity, m_config.m_maxEntries));
+    }
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Records still unread in the ring are drained as usual; the next thread writes after them.
+void BinaryLog::ReleaseThreadRing(LogThreadRing* ring)
+{
+    std::lock_guard lock(m_ringsMutex);
+
+    m_freeRings.push_back(ring);
+    m_freeRingCount.store(static_cast<int>(m_freeRings.size()), std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Writes the records GAME_LOG kept before any log existed into a first ring, which the next thread
+/// to log then takes, and closes that buffer.
+void BinaryLog::AdoptEarlyRecords()
+{
+    std::lock_guard lock(s_earlyMutex);
+
+    if (s_isEarlyClosed) return;
+
+    s_isEarlyClosed = true;
+    m_ringlessDropCount.fetch_add(s_earlyDroppedCount, std::memory_order_relaxed);
+
+    if (s_earlyCount == 0) return;
+
+    LogThreadRing* ring = AcquireThreadRing();
+
+    for (int index = 0; ring != nullptr && index < s_earlyCount; ++index)
+    {
+        sLogRecord* record = ring->BeginWrite();
+        if (record == nullptr) break;
+
+        *record = s_earlyRecords[index];
+        ring->EndWrite();
+    }
+
+    if (ring != nullptr) ReleaseThreadRing(ring);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Drains every ring until all are empty, then sleeps m_pollSeconds or until a Flush() or the
+/// destructor wakes it. A flush is complete once a drain that started after it has finished, along
+/// with any rotation requested before it.
+void BinaryLog::LoggingThreadMain()
+{
+    std::unique_lock lock(m_wakeMutex);
+
+    while (true)
+    {
+        uint64_t const flushRequested = m_flushRequested;
+        bool const     isStopping     = m_isStopping;
+
+        lock.unlock();
+        m_usage.BeginBusy(0);
+
+        int const drainedCount = DrainRings();
+
+        // Written through a mapping, the segment needs no flush; only rotation is left to check
+        if (m_archive != nullptr)
+        {
+            std::lock_guard sinksLock(m_sinksMutex);
+            m_archive->Poll();
+        }
+
+        m_usage.EndBusy(0);
+        lock.lock();
+
+        if (flushRequested != m_flushCompleted)
+        {
+            m_flushCompleted = flushRequested;
+            m_flushCondition.notify_all();
+        }
+
+        if (isStopping) return;
+
+        if (drainedCount == 0)
+        {
+            m_wakeCondition.wait_for(lock, std::chrono::duration<float>(m_config.m_pollSeconds), [this, flushRequested]()
+            {
+                return m_isStopping || m_flushRequested != flushRequested;
+            });
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Formats the records of every ring into m_batch, up to a batch per ring per pass so one busy thread
+/// cannot hold back the others, and emits each batch as it fills.
+/// @return The number of records formatted.
+int BinaryLog::DrainRings()
+{
+    {
+        std::lock_guard lock(m_ringsMutex);
+
+        m_drainRings.clear();
+
+        for (std::unique_ptr<LogThreadRing> const& ring : m_rings)
+        {
+            m_drainRings.push_back(ring.get());
+        }
+    }
+
+    int const batchSize    = static_cast<int>(m_batch.size());
+    int       drainedCount = 0;
+    bool      isAnyLeft    = true;
+
+    while (isAnyLeft)
+    {
+        isAnyLeft = false;
+
+        for (LogThreadRing* ring : m_drainRings)
+        {
+            for (int taken = 0; taken < batchSize; ++taken)
+            {
+                sLogRecord const* record = ring->BeginRead();
+
+                if (record == nullptr) break;
+
+                sLogLine& line     = m_batch[static_cast<size_t>(m_batchUsed++)];
+                line.m_category    = record->m_category;
+                line.m_verbosity   = record->m_verbosity;
+                line.m_seconds     = record->m_seconds;
+                line.m_threadIndex = ring->m_threadIndex;
+                line.m_text.clear();
+                FormatRecord(*record, line.m_text);
+
+                ring->EndRead();
+                ++drainedCount;
+
+                if (m_batchUsed == batchSize) EmitBatch();
+            }
+
+            isAnyLeft = isAnyLeft || ring->BeginRead() != nullptr;
+        }
+    }
+
+    EmitBatch();
+
+    return drainedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void BinaryLog::EmitBatch()
+{
+    if (m_batchUsed == 0) return;
+
+    if (m_isOutputEnabled.load(std::memory_order_relaxed))
+    {
+        std::lock_guard lock(m_sinksMutex);
+
+        for (sLogSink const& sink : m_sinks)
+        {
+            sink.m_function(m_batch.data(), m_batchUsed, sink.m_userData);
+        }
+    }
+
+    m_formattedCount.fetch_add(static_cast<uint64_t>(m_batchUsed), std::memory_order_relaxed);
+    m_batchCount.fetch_add(1, std::memory_order_relaxed);
+    m_batchUsed = 0;
+}
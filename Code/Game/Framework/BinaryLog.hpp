@@ -0,0 +1,344 @@
+//----------------------------------------------------------------------------------------------------
+// BinaryLog.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/LogArchive.hpp"
+#include "Game/Framework/ThreadTopology.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/LogSubsystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Records the format and raw args on the calling thread; the text is built on the logging thread.
+// format and category must be string literals (only their pointers are recorded), with at most six args.
+#define GAME_LOG(verbosity, format, ...) BinaryLog::Write("LogGame", verbosity, "" format, ##__VA_ARGS__)
+#define GAME_LOG_CATEGORY(category, verbosity, format, ...) BinaryLog::Write("" category, verbosity, "" format, ##__VA_ARGS__)
+
+//----------------------------------------------------------------------------------------------------
+// Loaded from the <Log> element of Data/GameConfig.xml.
+//
+struct sBinaryLogConfig
+{
+    int    m_maxEntries          = 0;                 // Records all thread rings hold together; 0 = a ring for each of m_threadCount
+    int    m_recordsPerThread    = 1024;              // Ring size per logging thread, rounded up to a power of two
+    int    m_threadCount         = 16;                // Threads expected to log at once; set by the App from the pool sizes
+    int    m_batchSize           = 256;               // Lines formatted before a batch goes to the sinks
+    float  m_pollSeconds         = 0.002f;            // Logging thread sleep while every ring is empty
+    String m_filePath            = "Logs/Game.log";   // Batched file sink, rotated into m_archive; empty disables it
+    bool   m_isForwardedToEngine = true;              // Also hand every line to DAEMON_LOG and the Engine's sinks
+
+    sLogArchiveConfig m_archive;
+    sThreadPoolConfig m_thread = { .m_name = "Log" };     // Placement of the logging thread (0) and the archive compressor (1)
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sBinaryLogStats
+{
+    uint64_t m_recordedCount  = 0;      // Records written into a ring
+    uint64_t m_formattedCount = 0;      // Of those, formatted by the logging thread
+    uint64_t m_droppedCount   = 0;      // Records refused because their thread's ring was full or it had none
+    uint64_t m_batchCount     = 0;
+    int      m_threadCount    = 0;      // Threads holding a ring
+    int      m_ringCount      = 0;      // Rings created; those of exited threads are handed to the next new thread
+    int      m_refusedCount   = 0;      // Times a thread found every ring taken
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eLogArg : uint8_t
+{
+    INT,
+    UINT,
+    DOUBLE,
+    TEXT,           // (offset << 8) | length into sLogRecord::m_text
+    POINTER
+};
+
+//----------------------------------------------------------------------------------------------------
+// One GAME_LOG call before formatting: three cache lines, written in place in the thread's ring.
+//
+struct alignas(64) sLogRecord
+{
+    static int constexpr MAX_ARGS   = 6;
+    static int constexpr TEXT_BYTES = 104;
+
+    char const*   m_format    = nullptr;
+    char const*   m_category  = nullptr;
+    double        m_seconds   = 0.0;
+    eLogVerbosity m_verbosity = eLogVerbosity::Display;
+    uint8_t       m_argCount  = 0;
+    uint8_t       m_textUsed  = 0;
+    eLogArg       m_argTypes[MAX_ARGS] = {};
+    uint64_t      m_args[MAX_ARGS]     = {};
+    char          m_text[TEXT_BYTES];           // String args, copied and not terminated; truncated past TEXT_BYTES in all
+};
+
+//----------------------------------------------------------------------------------------------------
+// A formatted record, as handed to the sinks.
+//
+struct sLogLine
+{
+    char const*   m_category    = nullptr;
+    eLogVerbosity m_verbosity   = eLogVerbosity::Display;
+    double        m_seconds     = 0.0;
+    uint16_t      m_threadIndex = 0;     // Index of the ring it was written to; reused once its thread exits
+    String        m_text;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Receives each batch of lines in order, on the logging thread.
+//
+using LogSinkFunction = void (*)(sLogLine const* lines, int lineCount, void* userData);
+
+//----------------------------------------------------------------------------------------------------
+// Single-producer / single-consumer ring of records. The owning thread writes a record in place
+// between BeginWrite and EndWrite without locks; the logging thread reads them in the same way.
+//
+class LogThreadRing
+{
+public:
+    LogThreadRing(uint16_t threadIndex, int capacity);
+
+    sLogRecord* BeginWrite();           // nullptr when the ring is full; the record is then counted as dropped
+    void        EndWrite();
+
+    sLogRecord const* BeginRead();      // Oldest unread record, nullptr when the ring is empty
+    void              EndRead();
+
+    uint32_t GetWrittenCount() const;
+
+    uint16_t              m_threadIndex = 0;
+    std::atomic<uint32_t> m_droppedCount{0};
+
+private:
+    std::vector<sLogRecord>           m_records;
+    uint32_t                          m_mask = 0;
+    alignas(64) std::atomic<uint32_t> m_writeIndex{0};
+    alignas(64) std::atomic<uint32_t> m_readIndex{0};
+};
+
+//----------------------------------------------------------------------------------------------------
+// Game-side logging backend for GAME_LOG, cheap enough to call from the frame's hot paths.
+//
+// A GAME_LOG call does no formatting: it copies the format pointer, a timestamp and its args, tagged
+// by type, into a record in its own thread's lock-free ring; strings are copied into the record.
+// A logging thread drains every ring, formats the records there (the format's length modifiers are
+// ignored; each arg prints as the type it was recorded with), and hands them to the sinks a batch at
+// a time. Built in are a file sink, which appends each batch at once to a LogArchive (rotated,
+// compressed and indexed segments; see LogArchive.hpp), and one that forwards every line to
+// DAEMON_LOG, so the Engine's LogSubsystem still fans it out to its own sinks (LogConfig.json).
+//
+// Memory is fixed up front rather than queued without bound: each thread's ring holds
+// m_recordsPerThread records, and rings are only created while they total at most m_maxEntries. A
+// thread's ring goes back to a free list when the thread exits, for the next thread to reuse. A
+// record that finds its ring full, or its thread without one, is dropped and counted, never
+// waited for; the first thread refused a ring logs a warning.
+//
+// Records written before the App creates the log (while g_binaryLog is null) are kept, up to
+// EARLY_RECORDS, and written into the first ring when the log starts. Lines from different
+// threads reach the sinks ordered per thread, not globally; each carries its own timestamp.
+//
+class BinaryLog
+{
+public:
+    static int constexpr EARLY_RECORDS = 256;
+
+    explicit BinaryLog(sBinaryLogConfig const& config);
+    ~BinaryLog();
+
+    BinaryLog(BinaryLog const&)            = delete;
+    BinaryLog& operator=(BinaryLog const&) = delete;
+
+    template <typename... Args>
+    static void Write(char const* category, eLogVerbosity verbosity, char const* format, Args const&... args);
+
+    void AddSink(LogSinkFunction function, void* userData);
+    void Flush();
+    void SetOutputEnabled(bool isOutputEnabled);
+
+    sBinaryLogConfig const& GetConfig() const;
+    sBinaryLogStats         GetStats() const;
+    LogArchive*             GetArchive() const;
+    ThreadPoolUsage const&  GetUsage() const;
+
+    static void FormatRecord(sLogRecord const& record, String& out);
+
+private:
+    struct sLogSink
+    {
+        LogSinkFunction m_function = nullptr;
+        void*           m_userData = nullptr;
+    };
+
+    // Destroyed when its thread exits, which returns the ring to the log that handed it out
+    struct sThreadRingLease
+    {
+        ~sThreadRingLease();
+
+        uint64_t       m_logId = 0;
+        LogThreadRing* m_ring  = nullptr;
+    };
+
+    static LogThreadRing* GetThreadRing();
+    static void           WriteEarly(sLogRecord const& record);
+    static void           WriteToFile(sLogLine const* lines, int lineCount, void* userData);
+    static void           ForwardToEngine(sLogLine const* lines, int lineCount, void* userData);
+
+    LogThreadRing* AcquireThreadRing();
+    void           ReleaseThreadRing(LogThreadRing* ring);
+    void           AdoptEarlyRecords();
+    void           LoggingThreadMain();
+    int            DrainRings();
+    void           EmitBatch();
+
+    sBinaryLogConfig m_config;
+    uint64_t         m_id = 0;                                              // Unique per log, unlike its address
+
+    mutable std::mutex                          m_ringsMutex;
+    std::vector<std::unique_ptr<LogThreadRing>> m_rings;                    // Every ring created, free or not, so all are drained
+    std::vector<LogThreadRing*>                 m_freeRings;                // Rings of exited threads
+    std::vector<LogThreadRing*>                 m_drainRings;               // Logging thread's copy of m_rings
+    int                                         m_ringCapacity = 0;
+    int                                         m_refusedCount = 0;         // Guarded by m_ringsMutex
+    std::atomic<int>                            m_freeRingCount{0};
+    std::atomic<uint64_t>                       m_ringlessDropCount{0};
+
+    std::mutex                  m_sinksMutex;
+    std::vector<sLogSink>       m_sinks;
+    std::atomic<bool>           m_isOutputEnabled{true};
+    std::unique_ptr<LogArchive> m_archive;
+    double                      m_unixSecondsOffset = 0.0;                 // Added to a line's seconds for its UTC time
+    String                      m_fileText;                                // Logging thread scratch for one batch
+
+    std::vector<sLogLine> m_batch;                                          // Logging thread only
+    int                   m_batchUsed = 0;
+    std::atomic<uint64_t> m_formattedCount{0};
+    std::atomic<uint64_t> m_batchCount{0};
+
+    PoolThread              m_thread;
+    ThreadPoolUsage         m_usage{1};
+    std::mutex              m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_flushCondition;
+    uint64_t                m_flushRequested = 0;       // Guarded by m_wakeMutex
+    uint64_t                m_flushCompleted = 0;       // Guarded by m_wakeMutex
+    bool                    m_isStopping     = false;   // Guarded by m_wakeMutex
+};
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+void EncodeLogArg(sLogRecord& record, T const& value)
+{
+    using Arg = std::decay_t<T>;
+
+    uint8_t const index = record.m_argCount++;
+
+    auto const copyText = [&record, index](std::string_view const text)
+    {
+        size_t const length = text.size() < static_cast<size_t>(sLogRecord::TEXT_BYTES - record.m_textUsed) ? text.size() : static_cast<size_t>(sLogRecord::TEXT_BYTES - record.m_textUsed);
+
+        std::memcpy(record.m_text + record.m_textUsed, text.data(), length);
+        record.m_argTypes[index] = eLogArg::TEXT;
+        record.m_args[index]     = (static_cast<uint64_t>(record.m_textUsed) << 8) | length;
+        record.m_textUsed        = static_cast<uint8_t>(record.m_textUsed + length);
+    };
+
+    if constexpr (std::is_array_v<T>)
+    {
+        copyText(std::string_view(value));
+    }
+    else if constexpr (std::is_same_v<Arg, char const*> || std::is_same_v<Arg, char*>)
+    {
+        copyText(value != nullptr ? std::string_view(value) : std::string_view("(null)"));
+    }
+    else if constexpr (std::is_convertible_v<Arg const&, std::string_view>)
+    {
+        copyText(std::string_view(value));
+    }
+    else if constexpr (std::is_enum_v<Arg>)
+    {
+        record.m_argTypes[index] = eLogArg::INT;
+        record.m_args[index]     = static_cast<uint64_t>(static_cast<int64_t>(value));
+    }
+    else if constexpr (std::is_integral_v<Arg> && std::is_signed_v<Arg>)
+    {
+        record.m_argTypes[index] = eLogArg::INT;
+        record.m_args[index]     = static_cast<uint64_t>(static_cast<int64_t>(value));
+    }
+    else if constexpr (std::is_integral_v<Arg>)
+    {
+        record.m_argTypes[index] = eLogArg::UINT;
+        record.m_args[index]     = static_cast<uint64_t>(value);
+    }
+    else if constexpr (std::is_floating_point_v<Arg>)
+    {
+        double const asDouble = static_cast<double>(value);
+
+        record.m_argTypes[index] = eLogArg::DOUBLE;
+        std::memcpy(&record.m_args[index], &asDouble, sizeof(double));
+    }
+    else if constexpr (std::is_pointer_v<Arg>)
+    {
+        record.m_argTypes[index] = eLogArg::POINTER;
+        record.m_args[index]     = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+    }
+    else
+    {
+        static_assert(!sizeof(Arg*), "GAME_LOG args must be numbers, enums, pointers or strings");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename... Args>
+void BinaryLog::Write(char const* category, eLogVerbosity const verbosity, char const* format, Args const&... args)
+{
+    static_assert(sizeof...(Args) <= sLogRecord::MAX_ARGS, "GAME_LOG takes at most six args");
+
+    auto const fill = [&](sLogRecord& record)
+    {
+        record.m_format    = format;
+        record.m_category  = category;
+        record.m_seconds   = GetCurrentTimeSeconds();
+        record.m_verbosity = verbosity;
+        record.m_argCount  = 0;
+        record.m_textUsed  = 0;
+        (EncodeLogArg(record, args), ...);
+    };
+
+    // Startup only: kept until the App creates the log
+    if (g_binaryLog == nullptr)
+    {
+        sLogRecord record;
+        fill(record);
+        WriteEarly(record);
+        return;
+    }
+
+    LogThreadRing* ring = GetThreadRing();
+
+    if (ring == nullptr)
+    {
+        g_binaryLog->m_ringlessDropCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    sLogRecord* record = ring->BeginWrite();
+    if (record == nullptr) return;
+
+    fill(*record);
+    ring->EndWrite();
+}
@@ -0,0 +1,545 @@
+//----------------------------------------------------------------------------------------------------
+// BlockCodec.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/BlockCodec.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    int constexpr MIN_MATCH       = 4;
+    int constexpr MAX_OFFSET      = 65535;
+    int constexpr HASH_BITS       = 16;
+    int constexpr MAX_CHAIN_DEPTH = 16;
+    int constexpr LAST_LITERALS   = 5;                // Trailing bytes always left as literals, as in LZ4
+    int constexpr MAX_CODE_BITS   = 11;               // Huffman code length cap; also the decode table's index width
+    int constexpr CODE_TABLE_SIZE = 128;              // 256 code lengths, a nibble each
+
+    //------------------------------------------------------------------------------------------------
+    uint32_t ReadUint32(uint8_t const* bytes)
+    {
+        uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    uint32_t HashSequence(uint8_t const* bytes)
+    {
+        return (ReadUint32(bytes) * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    void WriteLength(std::vector<uint8_t>& out, size_t length)
+    {
+        while (length >= 255)
+        {
+            out.push_back(255);
+            length -= 255;
+        }
+
+        out.push_back(static_cast<uint8_t>(length));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Every earlier position of the block, chained by the hash of the four bytes there.
+    struct sMatchFinder
+    {
+        std::vector<int32_t> m_heads;
+        std::vector<int32_t> m_previous;
+        int                  m_insertedCount = 0;
+
+        void Reset(int const sourceSize)
+        {
+            m_heads.assign(static_cast<size_t>(1) << HASH_BITS, -1);
+            m_previous.resize(static_cast<size_t>(sourceSize));
+            m_insertedCount = 0;
+        }
+
+        // Longest match for position among its MAX_CHAIN_DEPTH nearest candidates; 0 below MIN_MATCH
+        int FindLongest(uint8_t const* source, int const position, int const matchLimit, int& outFrom)
+        {
+            for (; m_insertedCount < position; ++m_insertedCount)
+            {
+                uint32_t const hash         = HashSequence(source + m_insertedCount);
+                m_previous[m_insertedCount] = m_heads[hash];
+                m_heads[hash]               = m_insertedCount;
+            }
+
+            int bestLength = 0;
+            int candidate  = m_heads[HashSequence(source + position)];
+
+            for (int depth = 0; depth < MAX_CHAIN_DEPTH && candidate >= 0 && position - candidate <= MAX_OFFSET; ++depth)
+            {
+                // Only worth comparing if it could beat the best so far
+                if (source[candidate + bestLength] == source[position + bestLength] && ReadUint32(source + candidate) == ReadUint32(source + position))
+                {
+                    int length = MIN_MATCH;
+
+                    while (position + length < matchLimit && source[candidate + length] == source[position + length])
+                    {
+                        ++length;
+                    }
+
+                    if (length > bestLength)
+                    {
+                        bestLength = length;
+                        outFrom    = candidate;
+                    }
+                }
+
+                candidate = m_previous[candidate];
+            }
+
+            return bestLength;
+        }
+    };
+
+    //------------------------------------------------------------------------------------------------
+    void WriteSequence(std::vector<uint8_t>& out, uint8_t const* literals, size_t const literalCount, int const offset, size_t const matchLength)
+    {
+        size_t const matchCode = matchLength - MIN_MATCH;
+
+        out.push_back(static_cast<uint8_t>((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(matchCode, 15)));
+        if (literalCount >= 15) WriteLength(out, literalCount - 15);
+        out.insert(out.end(), literals, literals + literalCount);
+        out.push_back(static_cast<uint8_t>(offset & 0xFF));
+        out.push_back(static_cast<uint8_t>(offset >> 8));
+        if (matchCode >= 15) WriteLength(out, matchCode - 15);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // LZ4-style block compression: a run of sequences, each a token (literal count in the high nibble,
+    // match length - 4 in the low one, 15 meaning more length bytes follow), the literals, then a
+    // two-byte offset back into what was already decoded. The last sequence is literals only.
+    // Decoding stays a plain copy loop; the effort goes into the encoder, which runs on the background
+    // thread: it walks hash chains for the longest match and defers a match by a byte when the next
+    // position has a longer one, as LZ4's high-compression mode does. Log lines repeat their prefix,
+    // format and most of their args, which is where the ratio comes from; text assets repeat keys
+    // and keywords the same way.
+    void CompressBlock(uint8_t const* source, int const sourceSize, std::vector<uint8_t>& out)
+    {
+        static thread_local sMatchFinder s_finder;
+        s_finder.Reset(sourceSize);
+
+        out.clear();
+        out.reserve(static_cast<size_t>(sourceSize) + sourceSize / 255 + 16);
+
+        int const matchLimit = sourceSize - LAST_LITERALS;
+        int       anchor     = 0;
+        int       position   = 0;
+
+        while (position + MIN_MATCH <= matchLimit)
+        {
+            int matchFrom   = 0;
+            int matchLength = s_finder.FindLongest(source, position, matchLimit, matchFrom);
+
+            if (matchLength < MIN_MATCH)
+            {
+                ++position;
+                continue;
+            }
+
+            while (position + 1 + MIN_MATCH <= matchLimit)
+            {
+                int       nextFrom   = 0;
+                int const nextLength = s_finder.FindLongest(source, position + 1, matchLimit, nextFrom);
+
+                if (nextLength <= matchLength) break;
+
+                ++position;
+                matchLength = nextLength;
+                matchFrom   = nextFrom;
+            }
+
+            WriteSequence(out, source + anchor, static_cast<size_t>(position - anchor), position - matchFrom, static_cast<size_t>(matchLength));
+
+            position += matchLength;
+            anchor    = position;
+        }
+
+        size_t const literalCount = static_cast<size_t>(sourceSize - anchor);
+
+        out.push_back(static_cast<uint8_t>(std::min<size_t>(literalCount, 15) << 4));
+        if (literalCount >= 15) WriteLength(out, literalCount - 15);
+        out.insert(out.end(), source + anchor, source + sourceSize);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Huffman code lengths for counts, none longer than MAX_CODE_BITS: built the usual way, and rebuilt
+    // from halved counts until the longest code fits.
+    void BuildCodeLengths(uint32_t const (&counts)[256], uint8_t (&outLengths)[256])
+    {
+        struct sNode
+        {
+            uint64_t m_weight = 0;
+            int      m_parent = -1;
+        };
+
+        uint64_t weights[256];
+        int      usedCount = 0;
+
+        for (int symbol = 0; symbol < 256; ++symbol)
+        {
+            weights[symbol]    = counts[symbol];
+            outLengths[symbol] = 0;
+            usedCount         += counts[symbol] > 0 ? 1 : 0;
+        }
+
+        if (usedCount <= 1)
+        {
+            for (int symbol = 0; symbol < 256; ++symbol)
+            {
+                if (counts[symbol] > 0) outLengths[symbol] = 1;
+            }
+
+            return;
+        }
+
+        while (true)
+        {
+            // Leaves are 0..255; merged nodes follow
+            std::vector<sNode> nodes(256);
+            std::vector<int>   open;
+
+            for (int symbol = 0; symbol < 256; ++symbol)
+            {
+                nodes[symbol].m_weight = weights[symbol];
+                if (weights[symbol] > 0) open.push_back(symbol);
+            }
+
+            auto const heavier = [&nodes](int const a, int const b) { return nodes[a].m_weight > nodes[b].m_weight; };
+            std::make_heap(open.begin(), open.end(), heavier);
+
+            while (open.size() > 1)
+            {
+                std::pop_heap(open.begin(), open.end(), heavier);
+                int const first = open.back();
+                open.pop_back();
+                std::pop_heap(open.begin(), open.end(), heavier);
+                int const second = open.back();
+                open.pop_back();
+
+                int const merged = static_cast<int>(nodes.size());
+                nodes.push_back(sNode{ nodes[first].m_weight + nodes[second].m_weight, -1 });
+                nodes[first].m_parent  = merged;
+                nodes[second].m_parent = merged;
+
+                open.push_back(merged);
+                std::push_heap(open.begin(), open.end(), heavier);
+            }
+
+            int longest = 0;
+
+            for (int symbol = 0; symbol < 256; ++symbol)
+            {
+                if (weights[symbol] == 0) continue;
+
+                int depth = 0;
+
+                for (int node = symbol; nodes[node].m_parent >= 0; node = nodes[node].m_parent)
+                {
+                    ++depth;
+                }
+
+                outLengths[symbol] = static_cast<uint8_t>(depth);
+                longest            = std::max(longest, depth);
+            }
+
+            if (longest <= MAX_CODE_BITS) return;
+
+            for (uint64_t& weight : weights)
+            {
+                if (weight > 0) weight = (weight + 1) / 2;
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Canonical codes for lengths, bit-reversed so they can be written and read least significant bit first.
+    void BuildCodes(uint8_t const (&lengths)[256], uint16_t (&outCodes)[256])
+    {
+        int lengthCounts[MAX_CODE_BITS + 1] = {};
+        int nextCode[MAX_CODE_BITS + 2]     = {};
+
+        for (int symbol = 0; symbol < 256; ++symbol)
+        {
+            ++lengthCounts[lengths[symbol]];
+        }
+
+        lengthCounts[0] = 0;
+
+        for (int length = 1; length <= MAX_CODE_BITS; ++length)
+        {
+            nextCode[length + 1] = (nextCode[length] + lengthCounts[length]) << 1;
+        }
+
+        for (int symbol = 0; symbol < 256; ++symbol)
+        {
+            int const length = lengths[symbol];
+            if (length == 0) continue;
+
+            uint32_t const code     = static_cast<uint32_t>(nextCode[length]++);
+            uint32_t       reversed = 0;
+
+            for (int bit = 0; bit < length; ++bit)
+            {
+                reversed |= ((code >> bit) & 1u) << (length - 1 - bit);
+            }
+
+            outCodes[symbol] = static_cast<uint16_t>(reversed);
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Entropy stage, as zstd has after its match finder: the LZ sequences of a block coded with a
+    // Huffman code of their own byte counts. Log text is mostly digits, letters and a few punctuation
+    // marks, so the literals left between matches shrink by about half again. Writes the code lengths
+    // (a nibble per byte value) and then the bits; false if that would not be smaller.
+    bool EncodeHuffman(std::vector<uint8_t> const& source, std::vector<uint8_t>& out)
+    {
+        uint32_t counts[256] = {};
+
+        for (uint8_t const byte : source)
+        {
+            ++counts[byte];
+        }
+
+        uint8_t  lengths[256];
+        uint16_t codes[256] = {};
+        BuildCodeLengths(counts, lengths);
+        BuildCodes(lengths, codes);
+
+        uint64_t bitCount = 0;
+
+        for (int symbol = 0; symbol < 256; ++symbol)
+        {
+            bitCount += static_cast<uint64_t>(counts[symbol]) * lengths[symbol];
+        }
+
+        if (CODE_TABLE_SIZE + (bitCount + 7) / 8 >= source.size()) return false;
+
+        out.clear();
+        out.reserve(CODE_TABLE_SIZE + static_cast<size_t>((bitCount + 7) / 8) + 8);
+
+        for (int symbol = 0; symbol < 256; symbol += 2)
+        {
+            out.push_back(static_cast<uint8_t>(lengths[symbol] | (lengths[symbol + 1] << 4)));
+        }
+
+        uint64_t bits     = 0;
+        int      bitsUsed = 0;
+
+        for (uint8_t const byte : source)
+        {
+            bits     |= static_cast<uint64_t>(codes[byte]) << bitsUsed;
+            bitsUsed += lengths[byte];
+
+            while (bitsUsed >= 8)
+            {
+                out.push_back(static_cast<uint8_t>(bits));
+                bits     >>= 8;
+                bitsUsed  -= 8;
+            }
+        }
+
+        if (bitsUsed > 0) out.push_back(static_cast<uint8_t>(bits));
+
+        return true;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Decodes outSize bytes a table lookup each: every MAX_CODE_BITS-bit pattern maps straight to the
+    // symbol whose code it starts with. false on an invalid code table or a stream that runs short.
+    bool DecodeHuffman(uint8_t const* source, size_t const sourceSize, uint8_t* out, size_t const outSize)
+    {
+        if (sourceSize < CODE_TABLE_SIZE) return false;
+
+        uint8_t lengths[256];
+
+        for (int symbol = 0; symbol < 256; symbol += 2)
+        {
+            lengths[symbol]     = source[symbol / 2] & 0x0F;
+            lengths[symbol + 1] = source[symbol / 2] >> 4;
+        }
+
+        // A complete prefix code fills the table exactly
+        uint32_t kraft = 0;
+
+        for (uint8_t const length : lengths)
+        {
+            if (length > MAX_CODE_BITS) return false;
+            if (length > 0) kraft += 1u << (MAX_CODE_BITS - length);
+        }
+
+        if (kraft > (1u << MAX_CODE_BITS)) return false;
+
+        uint16_t codes[256] = {};
+        BuildCodes(lengths, codes);
+
+        static thread_local std::vector<uint16_t> s_table;
+        s_table.assign(static_cast<size_t>(1) << MAX_CODE_BITS, 0);
+
+        for (int symbol = 0; symbol < 256; ++symbol)
+        {
+            int const length = lengths[symbol];
+            if (length == 0) continue;
+
+            for (uint32_t fill = codes[symbol]; fill < (1u << MAX_CODE_BITS); fill += 1u << length)
+            {
+                s_table[fill] = static_cast<uint16_t>((symbol << 4) | length);
+            }
+        }
+
+        uint8_t const* in          = source + CODE_TABLE_SIZE;
+        uint8_t const* inEnd       = source + sourceSize;
+        uint64_t       bits        = 0;
+        int            bitsHeld    = 0;
+        uint32_t const patternMask = (1u << MAX_CODE_BITS) - 1;
+
+        for (size_t index = 0; index < outSize; ++index)
+        {
+            while (bitsHeld <= 56 && in < inEnd)
+            {
+                bits     |= static_cast<uint64_t>(*in++) << bitsHeld;
+                bitsHeld += 8;
+            }
+
+            uint16_t const entry  = s_table[bits & patternMask];
+            int const      length = entry & 0x0F;
+
+            if (length == 0 || length > bitsHeld) return false;
+
+            out[index] = static_cast<uint8_t>(entry >> 4);
+            bits     >>= length;
+            bitsHeld  -= length;
+        }
+
+        return true;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // false on any sequence that would read or write out of bounds; destination must hold rawSize.
+    bool DecompressBlock(uint8_t const* source, size_t const sourceSize, uint8_t* destination, size_t const rawSize)
+    {
+        uint8_t const* in     = source;
+        uint8_t const* inEnd  = source + sourceSize;
+        uint8_t*       out    = destination;
+        uint8_t*       outEnd = destination + rawSize;
+
+        auto const readLength = [&in, inEnd](size_t& length) -> bool
+        {
+            uint8_t extra = 255;
+
+            while (extra == 255)
+            {
+                if (in >= inEnd) return false;
+                extra   = *in++;
+                length += extra;
+            }
+
+            return true;
+        };
+
+        while (in < inEnd)
+        {
+            uint8_t const token         = *in++;
+            size_t        literalLength = token >> 4;
+
+            if (literalLength == 15 && !readLength(literalLength)) return false;
+            if (literalLength > static_cast<size_t>(inEnd - in) || literalLength > static_cast<size_t>(outEnd - out)) return false;
+
+            std::memcpy(out, in, literalLength);
+            in  += literalLength;
+            out += literalLength;
+
+            if (in == inEnd) break;
+            if (inEnd - in < 2) return false;
+
+            size_t const offset      = static_cast<size_t>(in[0]) | (static_cast<size_t>(in[1]) << 8);
+            size_t       matchLength = token & 0x0F;
+            in += 2;
+
+            if (matchLength == 15 && !readLength(matchLength)) return false;
+            matchLength += MIN_MATCH;
+
+            if (offset == 0 || offset > static_cast<size_t>(out - destination) || matchLength > static_cast<size_t>(outEnd - out)) return false;
+
+            // Byte by byte: the match may overlap the bytes it produces
+            uint8_t const* from = out - offset;
+
+            for (size_t index = 0; index < matchLength; ++index)
+            {
+                out[index] = from[index];
+            }
+
+            out += matchLength;
+        }
+
+        return out == outEnd;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void EncodeBlock(uint8_t const* const data, size_t const size, sBlockEncoding& outEncoding, std::vector<uint8_t>& outPayload)
+{
+    static thread_local std::vector<uint8_t> s_sequences;
+
+    CompressBlock(data, static_cast<int>(size), s_sequences);
+
+    outEncoding.m_rawBytes      = static_cast<uint32_t>(size);
+    outEncoding.m_sequenceBytes = static_cast<uint32_t>(s_sequences.size());
+
+    if (EncodeHuffman(s_sequences, outPayload))
+    {
+        outEncoding.m_encoding = eBlockEncoding::LZ_HUFFMAN;
+    }
+    else if (s_sequences.size() < size)
+    {
+        outEncoding.m_encoding = eBlockEncoding::LZ;
+        outPayload.swap(s_sequences);
+    }
+    else
+    {
+        outEncoding.m_encoding = eBlockEncoding::STORED;
+        outPayload.assign(data, data + size);
+    }
+
+    outEncoding.m_compressedBytes = static_cast<uint32_t>(outPayload.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// All literals is the worst case: one length byte per 255 of them, and a token.
+size_t GetMaxSequenceBytes(size_t const rawBytes)
+{
+    return rawBytes + rawBytes / 255 + 16;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool DecodeBlock(sBlockEncoding const& encoding, uint8_t const* const payload, uint8_t* const out)
+{
+    static thread_local std::vector<uint8_t> s_sequences;
+
+    switch (encoding.m_encoding)
+    {
+    case eBlockEncoding::STORED:
+        if (encoding.m_compressedBytes != encoding.m_rawBytes) return false;
+        std::memcpy(out, payload, encoding.m_rawBytes);
+        return true;
+
+    case eBlockEncoding::LZ:
+        return DecompressBlock(payload, encoding.m_compressedBytes, out, encoding.m_rawBytes);
+
+    case eBlockEncoding::LZ_HUFFMAN:
+        if (encoding.m_sequenceBytes > GetMaxSequenceBytes(encoding.m_rawBytes)) return false;
+        s_sequences.resize(encoding.m_sequenceBytes);
+        return DecodeHuffman(payload, encoding.m_compressedBytes, s_sequences.data(), s_sequences.size())
+            && DecompressBlock(s_sequences.data(), s_sequences.size(), out, encoding.m_rawBytes);
+
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,40 @@
+//----------------------------------------------------------------------------------------------------
+// BlockCodec.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+enum class eBlockEncoding : uint32_t
+{
+    STORED     = 0,     // Raw bytes
+    LZ         = 1,     // LZ4-style sequences
+    LZ_HUFFMAN = 2      // The sequences again, Huffman coded
+};
+
+//----------------------------------------------------------------------------------------------------
+// What a decoder needs besides the payload; stored by each container in its own block header.
+//
+struct sBlockEncoding
+{
+    eBlockEncoding m_encoding        = eBlockEncoding::STORED;
+    uint32_t       m_rawBytes        = 0;
+    uint32_t       m_sequenceBytes   = 0;     // LZ sequences, before the Huffman stage
+    uint32_t       m_compressedBytes = 0;     // Payload
+};
+
+//----------------------------------------------------------------------------------------------------
+// Block compression shared by the log archive and the asset pack. A block is compressed on its own,
+// so any block decodes without the others. EncodeBlock picks the smallest of the three encodings;
+// DecodeBlock writes outEncoding.m_rawBytes bytes to out and returns false on a payload that would
+// read or write out of bounds. No valid block of rawBytes has more than GetMaxSequenceBytes(rawBytes)
+// bytes of sequences, so containers can reject a corrupt header before decoding it.
+//
+void   EncodeBlock(uint8_t const* data, size_t size, sBlockEncoding& outEncoding, std::vector<uint8_t>& outPayload);
+bool   DecodeBlock(sBlockEncoding const& encoding, uint8_t const* payload, uint8_t* out);
+size_t GetMaxSequenceBytes(size_t rawBytes);
@@ -0,0 +1,343 @@
+//----------------------------------------------------------------------------------------------------
+// CommandScript.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/CommandScript.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/AssetPack.hpp"
+#include "Game/Framework/FrameProfiler.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/HashedName.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    uint32_t constexpr BLOB_MAGIC   = 0x444D4344;     // "DCMD"
+    uint32_t constexpr BLOB_VERSION = 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Compile xmlPath's root element, or read the compiled blob when it is current.
+bool CommandScript::Load(String const& xmlPath)
+{
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    sAssetFileInfo source;
+    if (!StatAssetFile(xmlPath, source)) return false;
+
+    uint64_t const sourceSize = source.m_size;
+    int64_t const  sourceTime = source.m_writeTime;
+    String const   blobPath   = xmlPath + ".cmdc";
+    bool const     isCached   = ReadBlob(blobPath, sourceSize, sourceTime);
+
+    if (!isCached)
+    {
+        sAssetFileData file;
+        if (!ReadAssetFile(xmlPath, file)) return false;
+
+        XmlDocument document;
+        if (document.Parse(file.GetText().data(), file.GetText().size()) != tinyxml2::XML_SUCCESS || document.RootElement() == nullptr) return false;
+        if (!CompileXml(*document.RootElement())) return false;
+
+        WriteBlob(blobPath, sourceSize, sourceTime);
+    }
+
+    m_stats.m_wasLoadedFromBlob = isCached;
+    m_stats.m_loadSeconds       = GetCurrentTimeSeconds() - startSeconds;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// One record per child element of scriptElement; the element itself only groups them.
+bool CommandScript::CompileXml(XmlElement const& scriptElement)
+{
+    Clear();
+
+    std::unordered_map<std::string_view, uint32_t> offsetsByText;
+    std::unordered_map<uint32_t, uint32_t>         nameIndicesByOffset;
+
+    // The views point into the XML document, which outlives this call
+    auto const intern = [&](char const* text) -> uint32_t
+    {
+        std::string_view const view(text != nullptr ? text : "");
+        auto const             found = offsetsByText.find(view);
+
+        if (found != offsetsByText.end()) return found->second;
+
+        uint32_t const offset = static_cast<uint32_t>(m_strings.size());
+        m_strings.insert(m_strings.end(), view.begin(), view.end());
+        m_strings.push_back('\0');
+        offsetsByText.emplace(view, offset);
+
+        return offset;
+    };
+
+    for (XmlElement const* command = scriptElement.FirstChildElement(); command != nullptr; command = command->NextSiblingElement())
+    {
+        uint32_t const nameOffset = intern(command->Name());
+        auto const     nameIndex  = nameIndicesByOffset.emplace(nameOffset, static_cast<uint32_t>(m_nameOffsets.size()));
+
+        if (nameIndex.second) m_nameOffsets.push_back(nameOffset);
+
+        sCommandRecord record;
+        record.m_nameIndex = nameIndex.first->second;
+        record.m_firstArg  = static_cast<uint32_t>(m_args.size());
+
+        for (XmlAttribute const* attribute = command->FirstAttribute(); attribute != nullptr; attribute = attribute->Next())
+        {
+            m_args.push_back(sCommandArg{ intern(attribute->Name()), intern(attribute->Value()) });
+            ++record.m_argCount;
+        }
+
+        m_records.push_back(record);
+    }
+
+    BuildEventArgs();
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool CommandScript::CompileXmlText(char const* xmlText)
+{
+    XmlDocument document;
+    if (document.Parse(xmlText) != tinyxml2::XML_SUCCESS || document.RootElement() == nullptr) return false;
+
+    return CompileXml(*document.RootElement());
+}
+
+//----------------------------------------------------------------------------------------------------
+void CommandScript::Clear()
+{
+    m_strings.clear();
+    m_nameOffsets.clear();
+    m_records.clear();
+    m_args.clear();
+    m_eventNames.clear();
+    m_eventIds.clear();
+    m_flatArgs.clear();
+    m_eventArgs.clear();
+    m_waits.clear();
+    m_stats = sCommandScriptStats();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Fires every command in order, all at once; waits are skipped.
+/// @return The number of commands fired.
+int CommandScript::Execute() const
+{
+    PROFILE_SCOPE("CommandScript::Execute");
+
+    int firedCount = 0;
+
+    for (int index = 0; index < GetCommandCount(); ++index)
+    {
+        if (m_waits[index].m_isWait) continue;
+
+        ExecuteCommand(index);
+        ++firedCount;
+    }
+
+    return firedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Each command gets its own copy of the compiled args, as a freshly tokenized command would, so a
+/// handler that changes its args does not change the next run. A wait fires nothing.
+void CommandScript::ExecuteCommand(int const commandIndex) const
+{
+    size_t const index = static_cast<size_t>(commandIndex);
+    if (m_waits[index].m_isWait) return;
+
+    uint32_t const nameIndex = m_records[index].m_nameIndex;
+    EventId const  id        = m_eventIds[nameIndex];
+
+    if (g_eventDispatcher != nullptr && g_eventDispatcher->GetSubscriberCount(id) > 0)
+    {
+        FlatProperties args = m_flatArgs[index];
+        g_eventDispatcher->FireEvent(id, args);
+        return;
+    }
+
+    // Console commands (TestFont, BenchText, ...) cannot take the path above. They are registered
+    // with the Engine's EventSystem, which has no interned ids and calls them with a
+    // NamedProperties-based EventArgs&, and the DevConsole finds them there by name, so they cannot
+    // move to g_eventDispatcher without changing the Engine. They get the prebuilt EventArgs,
+    // copied per call, and a FireEvent by name.
+    EventArgs args = m_eventArgs[index];
+    g_eventSystem->FireEvent(m_eventNames[nameIndex], args);
+}
+
+//----------------------------------------------------------------------------------------------------
+int CommandScript::GetCommandCount() const
+{
+    return static_cast<int>(m_records.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+String const& CommandScript::GetEventName(int const commandIndex) const
+{
+    return m_eventNames[m_records[static_cast<size_t>(commandIndex)].m_nameIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+sCommandWait const& CommandScript::GetWait(int const commandIndex) const
+{
+    return m_waits[static_cast<size_t>(commandIndex)];
+}
+
+//----------------------------------------------------------------------------------------------------
+sCommandScriptStats const& CommandScript::GetStats() const
+{
+    return m_stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool CommandScript::ReadBlob(String const& blobPath, uint64_t const sourceSize, int64_t const sourceTime)
+{
+    std::ifstream file(blobPath, std::ios::in | std::ios::binary);
+    if (!file.is_open()) return false;
+
+    sBlobHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!file || header.m_magic != BLOB_MAGIC || header.m_version != BLOB_VERSION ||
+        header.m_sourceSize != sourceSize || header.m_sourceTime != sourceTime)
+    {
+        return false;
+    }
+
+    Clear();
+
+    m_strings.resize(header.m_stringBytes);
+    m_nameOffsets.resize(header.m_nameCount);
+    m_records.resize(header.m_recordCount);
+    m_args.resize(header.m_argCount);
+
+    file.read(m_strings.data(), static_cast<std::streamsize>(m_strings.size()));
+    file.read(reinterpret_cast<char*>(m_nameOffsets.data()), static_cast<std::streamsize>(m_nameOffsets.size() * sizeof(uint32_t)));
+    file.read(reinterpret_cast<char*>(m_records.data()), static_cast<std::streamsize>(m_records.size() * sizeof(sCommandRecord)));
+    file.read(reinterpret_cast<char*>(m_args.data()), static_cast<std::streamsize>(m_args.size() * sizeof(sCommandArg)));
+
+    // Every offset must land on a string inside the pool, which must end in a terminator
+    bool isValid = static_cast<bool>(file) && (m_strings.empty() || m_strings.back() == '\0');
+
+    for (uint32_t const offset : m_nameOffsets)
+    {
+        isValid = isValid && offset < m_strings.size();
+    }
+
+    for (sCommandRecord const& record : m_records)
+    {
+        isValid = isValid && record.m_nameIndex < m_nameOffsets.size() && record.m_firstArg <= m_args.size() &&
+                  record.m_argCount <= m_args.size() - record.m_firstArg;
+    }
+
+    for (sCommandArg const& arg : m_args)
+    {
+        isValid = isValid && arg.m_keyOffset < m_strings.size() && arg.m_valueOffset < m_strings.size();
+    }
+
+    if (!isValid)
+    {
+        Clear();
+        return false;
+    }
+
+    BuildEventArgs();
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Best effort: a read-only data folder just means every load compiles the XML again.
+void CommandScript::WriteBlob(String const& blobPath, uint64_t const sourceSize, int64_t const sourceTime) const
+{
+    std::ofstream file(blobPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return;
+
+    sBlobHeader header;
+    header.m_magic       = BLOB_MAGIC;
+    header.m_version     = BLOB_VERSION;
+    header.m_sourceSize  = sourceSize;
+    header.m_sourceTime  = sourceTime;
+    header.m_stringBytes = static_cast<uint32_t>(m_strings.size());
+    header.m_nameCount   = static_cast<uint32_t>(m_nameOffsets.size());
+    header.m_recordCount = static_cast<uint32_t>(m_records.size());
+    header.m_argCount    = static_cast<uint32_t>(m_args.size());
+
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.write(m_strings.data(), static_cast<std::streamsize>(m_strings.size()));
+    file.write(reinterpret_cast<char const*>(m_nameOffsets.data()), static_cast<std::streamsize>(m_nameOffsets.size() * sizeof(uint32_t)));
+    file.write(reinterpret_cast<char const*>(m_records.data()), static_cast<std::streamsize>(m_records.size() * sizeof(sCommandRecord)));
+    file.write(reinterpret_cast<char const*>(m_args.data()), static_cast<std::streamsize>(m_args.size() * sizeof(sCommandArg)));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Expands the records into the event names and ids, args and waits Execute() uses, once per
+/// compile or load.
+void CommandScript::BuildEventArgs()
+{
+    m_eventNames.clear();
+    m_eventIds.clear();
+    m_flatArgs.clear();
+    m_eventArgs.clear();
+    m_waits.clear();
+    m_eventNames.reserve(m_nameOffsets.size());
+    m_eventIds.reserve(m_nameOffsets.size());
+    m_flatArgs.resize(m_records.size());
+    m_eventArgs.resize(m_records.size());
+    m_waits.resize(m_records.size());
+
+    for (uint32_t const offset : m_nameOffsets)
+    {
+        m_eventNames.emplace_back(&m_strings[offset]);
+        m_eventIds.push_back(g_eventDispatcher != nullptr ? g_eventDispatcher->Intern(HashedName(&m_strings[offset])) : EventId());
+    }
+
+    for (size_t index = 0; index < m_records.size(); ++index)
+    {
+        sCommandRecord const& record = m_records[index];
+
+        for (uint32_t arg = record.m_firstArg; arg < record.m_firstArg + record.m_argCount; ++arg)
+        {
+            char const* const key   = &m_strings[m_args[arg].m_keyOffset];
+            char const* const value = &m_strings[m_args[arg].m_valueOffset];
+
+            m_flatArgs[index].SetValue(HashedName(key), value);
+            m_eventArgs[index].SetValue(String(key), String(value));
+        }
+
+        String const& name = m_eventNames[record.m_nameIndex];
+
+        if (AreNamesEqualCaseInsensitive(name, "Wait"))
+        {
+            m_waits[index].m_isWait = true;
+            m_waits[index].m_frames = m_eventArgs[index].GetValue("frames", 1);
+        }
+        else if (AreNamesEqualCaseInsensitive(name, "WaitSeconds"))
+        {
+            m_waits[index].m_isWait  = true;
+            m_waits[index].m_seconds = m_eventArgs[index].GetValue("seconds", 0.f);
+        }
+    }
+
+    m_stats.m_commandCount   = static_cast<int>(m_records.size());
+    m_stats.m_eventNameCount = static_cast<int>(m_nameOffsets.size());
+}
@@ -0,0 +1,114 @@
+//----------------------------------------------------------------------------------------------------
+// CommandScript.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/EventDispatcher.hpp"
+#include "Game/Framework/FlatProperties.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/XmlUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sCommandScriptStats
+{
+    bool   m_wasLoadedFromBlob = false;
+    double m_loadSeconds       = 0.0;
+    int    m_commandCount      = 0;
+    int    m_eventNameCount    = 0;     // Distinct event names among the commands
+};
+
+//----------------------------------------------------------------------------------------------------
+// <Wait frames="N"/> (N defaults to 1) or <WaitSeconds seconds="S"/>. Script runners pause on these;
+// Execute() skips them.
+//
+struct sCommandWait
+{
+    bool  m_isWait  = false;
+    int   m_frames  = 0;
+    float m_seconds = 0.f;
+};
+
+//----------------------------------------------------------------------------------------------------
+// A DevConsole XML command script (<CommandScript>, <Trigger>, ...) compiled once into records that
+// replay straight against g_eventDispatcher, or g_eventSystem for console commands.
+//
+// Each child element <Name key="value" .../> becomes one record: an index into the script's table
+// of distinct event names plus a run of (key, value) offsets into one pooled string buffer. Right
+// after compiling, every name is interned in g_eventDispatcher and every record's args are built
+// twice, as FlatProperties and as EventArgs, holding each attribute as a string exactly as
+// DevConsole's command tokenizer would. Execute() then fires each record by EventId with a copy of
+// its FlatProperties, which does not allocate for short args, when the dispatcher has subscribers
+// for it; otherwise it copies the EventArgs and fires by name through g_eventSystem. Either way: no
+// XML parse, no command line to build and tokenize again.
+//
+// Load() keeps the compiled records next to the script ("<name>.xml.cmdc"), stamped with the
+// script's size and modification time, and reads that instead of the XML while it is current.
+// CompileXml() compiles an element already in memory, e.g. an embedded <Trigger> block. Load and
+// compile on the main thread, since that is where names can be interned.
+//
+class CommandScript
+{
+public:
+    bool Load(String const& xmlPath);
+    bool CompileXml(XmlElement const& scriptElement);
+    bool CompileXmlText(char const* xmlText);
+    void Clear();
+
+    int  Execute() const;
+    void ExecuteCommand(int commandIndex) const;
+
+    int                        GetCommandCount() const;
+    String const&              GetEventName(int commandIndex) const;
+    sCommandWait const&        GetWait(int commandIndex) const;
+    sCommandScriptStats const& GetStats() const;
+
+private:
+    struct sBlobHeader
+    {
+        uint32_t m_magic       = 0;
+        uint32_t m_version     = 0;
+        uint64_t m_sourceSize  = 0;
+        int64_t  m_sourceTime  = 0;
+        uint32_t m_stringBytes = 0;
+        uint32_t m_nameCount   = 0;
+        uint32_t m_recordCount = 0;
+        uint32_t m_argCount    = 0;
+    };
+
+    // One command: event m_nameIndex with args [m_firstArg, m_firstArg + m_argCount)
+    struct sCommandRecord
+    {
+        uint32_t m_nameIndex = 0;
+        uint32_t m_firstArg  = 0;
+        uint32_t m_argCount  = 0;
+    };
+
+    // Byte offsets of NUL-terminated strings in m_strings
+    struct sCommandArg
+    {
+        uint32_t m_keyOffset   = 0;
+        uint32_t m_valueOffset = 0;
+    };
+
+    bool ReadBlob(String const& blobPath, uint64_t sourceSize, int64_t sourceTime);
+    void WriteBlob(String const& blobPath, uint64_t sourceSize, int64_t sourceTime) const;
+    void BuildEventArgs();
+
+    std::vector<char>           m_strings;          // Pooled, deduplicated attribute keys and values
+    std::vector<uint32_t>       m_nameOffsets;      // Event name offsets in m_strings, by name index
+    std::vector<sCommandRecord> m_records;
+    std::vector<sCommandArg>    m_args;
+    std::vector<String>         m_eventNames;       // Built from m_nameOffsets, by name index
+    std::vector<EventId>        m_eventIds;         // Interned from m_eventNames, by name index
+    std::vector<FlatProperties> m_flatArgs;         // Built from m_args, by record
+    std::vector<EventArgs>      m_eventArgs;        // Built from m_args, by record
+    std::vector<sCommandWait>   m_waits;            // Built from m_eventArgs, by record
+    sCommandScriptStats         m_stats;
+};
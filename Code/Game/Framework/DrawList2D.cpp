@@ -0,0 +1,338 @@
+//----------------------------------------------------------------------------------------------------
+// DrawList2D.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/DrawList2D.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FrameArena.hpp"
+#include "Game/Framework/FrameProfiler.hpp"
+#include "Game/Framework/GameCommon.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+DrawList2D::DrawList2D(Renderer* renderer)
+    : m_renderer(renderer)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void DrawList2D::AddVerts(sDrawState2D const& state, Vertex_PCU const* verts, int const vertexCount)
+{
+    if (verts == nullptr || vertexCount <= 0) return;
+
+    int const stateIndex = GetOrAddStateIndex(state);
+
+    // Consecutive draws with the same state extend the previous command instead of adding one
+    if (!m_commands.empty() && m_commands.back().m_stateIndex == stateIndex)
+    {
+        m_commands.back().m_vertexCount += vertexCount;
+    }
+    else
+    {
+        sDrawCommand command;
+        command.m_sortKey     = MakeSortKey(state);
+        command.m_stateIndex  = stateIndex;
+        command.m_firstVertex = static_cast<int>(m_vertices.size());
+        command.m_vertexCount = vertexCount;
+        m_commands.push_back(command);
+    }
+
+    m_vertices.insert(m_vertices.end(), verts, verts + vertexCount);
+
+    ++m_pendingStats.m_commandCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void DrawList2D::AddVerts(sDrawState2D const& state, VertexList_PCU const& verts)
+{
+    AddVerts(state, verts.data(), static_cast<int>(verts.size()));
+}
+
+//----------------------------------------------------------------------------------------------------
+void DrawList2D::AddRing(sDrawState2D const& state, Vec2 const& center, float const radius, float const thickness, Rgba8 const& color)
+{
+    GetPrimitiveBatch(state).AddRing(center, radius, thickness, color);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DrawList2D::AddDisc(sDrawState2D const& state, Vec2 const& center, float const radius, Rgba8 const& color)
+{
+    GetPrimitiveBatch(state).AddDisc(center, radius, color);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DrawList2D::AddLine(sDrawState2D const& state, Vec2 const& start, Vec2 const& end, float const thickness, Rgba8 const& color)
+{
+    GetPrimitiveBatch(state).AddLine(start, end, thickness, color);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DrawList2D::AddCapsule(sDrawState2D const& state, Vec2 const& start, Vec2 const& end, float const radius, Rgba8 const& color)
+{
+    GetPrimitiveBatch(state).AddCapsule(start, end, radius, color);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DrawList2D::Flush()
+{
+    PROFILE_SCOPE("DrawList2D::Flush");
+
+    ++m_totalFlushCount;
+
+    ExpandPrimitiveBatches();
+
+    SortCommands();
+
+    // Pack every run of equal state into one contiguous range of m_sortedVertices
+    m_sortedVertices.resize(m_vertices.size());
+
+    sDrawState2D const* appliedState = nullptr;
+    int                 writeIndex   = 0;
+    size_t              commandIndex = 0;
+
+    if (m_renderer != nullptr && !m_commands.empty())
+    {
+        m_renderer->SetModelConstants();
+    }
+
+    while (commandIndex < m_commands.size())
+    {
+        int const runStateIndex = m_commands[commandIndex].m_stateIndex;
+        int const runStart      = writeIndex;
+
+        // A run is one state, not one key: m_states holds each distinct state once, so equal index is equal state
+        for (; commandIndex < m_commands.size() && m_commands[commandIndex].m_stateIndex == runStateIndex; ++commandIndex)
+        {
+            sDrawCommand const& command = m_commands[commandIndex];
+
+            std::copy_n(m_vertices.begin() + command.m_firstVertex, command.m_vertexCount, m_sortedVertices.begin() + writeIndex);
+            writeIndex += command.m_vertexCount;
+        }
+
+        sDrawState2D const& runState = m_states[runStateIndex];
+
+        ApplyState(runState, appliedState);
+        appliedState = &runState;
+
+        if (m_renderer != nullptr)
+        {
+            m_renderer->DrawVertexArray(writeIndex - runStart, &m_sortedVertices[runStart]);
+        }
+
+        ++m_pendingStats.m_drawCount;
+    }
+
+    // Leave the default shader/texture bound, as the immediate-mode draw helpers expect
+    if (m_renderer != nullptr && appliedState != nullptr)
+    {
+        m_renderer->BindTexture(nullptr);
+        m_renderer->BindShader(nullptr);
+    }
+
+    m_pendingStats.m_vertexCount = static_cast<int>(m_vertices.size());
+    m_lastFlushStats             = m_pendingStats;
+    m_pendingStats               = sDrawList2DStats();
+
+    m_states.clear();
+    m_commands.clear();
+    m_shaders.clear();
+    m_textures.clear();
+    m_vertices.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+sDrawList2DStats const& DrawList2D::GetLastFlushStats() const
+{
+    return m_lastFlushStats;
+}
+
+//----------------------------------------------------------------------------------------------------
+int DrawList2D::GetTotalFlushCount() const
+{
+    return m_totalFlushCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int DrawList2D::GetOrAddStateIndex(sDrawState2D const& state)
+{
+    // A frame uses a handful of distinct states, so a linear scan beats hashing here
+    for (int stateIndex = static_cast<int>(m_states.size()) - 1; stateIndex >= 0; --stateIndex)
+    {
+        sDrawState2D const& existing = m_states[stateIndex];
+
+        if (existing.m_shader == state.m_shader && existing.m_texture == state.m_texture &&
+            existing.m_blendMode == state.m_blendMode && existing.m_samplerMode == state.m_samplerMode &&
+            existing.m_rasterizerMode == state.m_rasterizerMode && existing.m_depthMode == state.m_depthMode &&
+            existing.m_layer == state.m_layer)
+        {
+            return stateIndex;
+        }
+    }
+
+    m_states.push_back(state);
+
+    return static_cast<int>(m_states.size()) - 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+PrimitiveBatch2D& DrawList2D::GetPrimitiveBatch(sDrawState2D const& state)
+{
+    size_t const stateIndex = static_cast<size_t>(GetOrAddStateIndex(state));
+
+    if (stateIndex >= m_primitiveBatches.size())
+    {
+        m_primitiveBatches.resize(stateIndex + 1);
+    }
+
+    ++m_pendingStats.m_instanceCount;
+
+    return m_primitiveBatches[stateIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Stable sort by key, then by state, so states whose keys collide still form one run each.
+/// std::stable_sort takes its merge buffer from the heap on every flush; this
+/// bottom-up merge sort ping-pongs through a scratch array from g_frameArena instead.
+void DrawList2D::SortCommands()
+{
+    size_t const count = m_commands.size();
+    auto const   isLess = [](sDrawCommand const& a, sDrawCommand const& b)
+    {
+        return a.m_sortKey < b.m_sortKey || (a.m_sortKey == b.m_sortKey && a.m_stateIndex < b.m_stateIndex);
+    };
+
+    if (count < 2) return;
+
+    if (g_frameArena == nullptr)
+    {
+        std::stable_sort(m_commands.begin(), m_commands.end(), isLess);
+        return;
+    }
+
+    sDrawCommand* from = m_commands.data();
+    sDrawCommand* to   = g_frameArena->AllocateArray<sDrawCommand>(static_cast<int>(count));
+
+    for (size_t width = 1; width < count; width *= 2)
+    {
+        for (size_t start = 0; start < count; start += 2 * width)
+        {
+            size_t const middle = std::min(start + width, count);
+            size_t const end    = std::min(start + 2 * width, count);
+
+            std::merge(from + start, from + middle, from + middle, from + end, to + start, isLess);
+        }
+
+        std::swap(from, to);
+    }
+
+    if (from != m_commands.data())
+    {
+        std::copy_n(from, count, m_commands.data());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// CPU fallback for instancing: each state's instances become one command built from the unit meshes.
+void DrawList2D::ExpandPrimitiveBatches()
+{
+    size_t const batchCount = m_primitiveBatches.size() < m_states.size() ? m_primitiveBatches.size() : m_states.size();
+
+    for (size_t stateIndex = 0; stateIndex < batchCount; ++stateIndex)
+    {
+        PrimitiveBatch2D& batch = m_primitiveBatches[stateIndex];
+
+        if (batch.IsEmpty()) continue;
+
+        sDrawCommand command;
+        command.m_sortKey     = MakeSortKey(m_states[stateIndex]);
+        command.m_stateIndex  = static_cast<int>(stateIndex);
+        command.m_firstVertex = static_cast<int>(m_vertices.size());
+        command.m_vertexCount = batch.GetExpandedVertexCount();
+        m_commands.push_back(command);
+
+        batch.ExpandInto(m_vertices);
+        batch.Clear();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// [layer:8][shader:8][texture:16][blend:8][sampler:8][rasterizer:8][depth:8]
+/// Shader and texture ids are handed out in first-use order each flush and only their low bits kept,
+/// so past 256 shaders or 65536 textures two states can share a key. The key only orders the
+/// commands; runs are merged by state index, so a collision costs batching, never a wrong state.
+uint64_t DrawList2D::MakeSortKey(sDrawState2D const& state)
+{
+    uint64_t const shaderId  = GetOrAddResourceId(m_shaders, state.m_shader) & 0xFFu;
+    uint64_t const textureId = GetOrAddResourceId(m_textures, state.m_texture);
+
+    return static_cast<uint64_t>(state.m_layer) << 56 |
+           shaderId << 48 |
+           textureId << 32 |
+           static_cast<uint64_t>(state.m_blendMode) << 24 |
+           static_cast<uint64_t>(state.m_samplerMode) << 16 |
+           static_cast<uint64_t>(state.m_rasterizerMode) << 8 |
+           static_cast<uint64_t>(state.m_depthMode);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint16_t DrawList2D::GetOrAddResourceId(std::vector<void const*>& resources, void const* resource)
+{
+    for (size_t resourceIndex = 0; resourceIndex < resources.size(); ++resourceIndex)
+    {
+        if (resources[resourceIndex] == resource) return static_cast<uint16_t>(resourceIndex);
+    }
+
+    resources.push_back(resource);
+
+    return static_cast<uint16_t>(resources.size() - 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DrawList2D::ApplyState(sDrawState2D const& state, sDrawState2D const* previousState)
+{
+    bool const isFirst = previousState == nullptr;
+    int        changes = 0;
+
+    if (isFirst || previousState->m_blendMode != state.m_blendMode)
+    {
+        if (m_renderer != nullptr) m_renderer->SetBlendMode(state.m_blendMode);
+        ++changes;
+    }
+
+    if (isFirst || previousState->m_rasterizerMode != state.m_rasterizerMode)
+    {
+        if (m_renderer != nullptr) m_renderer->SetRasterizerMode(state.m_rasterizerMode);
+        ++changes;
+    }
+
+    if (isFirst || previousState->m_samplerMode != state.m_samplerMode)
+    {
+        if (m_renderer != nullptr) m_renderer->SetSamplerMode(state.m_samplerMode);
+        ++changes;
+    }
+
+    if (isFirst || previousState->m_depthMode != state.m_depthMode)
+    {
+        if (m_renderer != nullptr) m_renderer->SetDepthMode(state.m_depthMode);
+        ++changes;
+    }
+
+    if (isFirst || previousState->m_texture != state.m_texture)
+    {
+        if (m_renderer != nullptr) m_renderer->BindTexture(state.m_texture);
+        ++changes;
+    }
+
+    if (isFirst || previousState->m_shader != state.m_shader)
+    {
+        if (m_renderer != nullptr) m_renderer->BindShader(state.m_shader);
+        ++changes;
+    }
+
+    m_pendingStats.m_stateChanges += changes;
+}
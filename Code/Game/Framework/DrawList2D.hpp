@@ -0,0 +1,103 @@
+//----------------------------------------------------------------------------------------------------
+// DrawList2D.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/PrimitiveBatch2D.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/Vertex_PCU.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Shader;
+class Texture;
+
+//----------------------------------------------------------------------------------------------------
+// Every render state a 2D draw sets before DrawVertexArray; null shader/texture mean the defaults.
+//
+struct sDrawState2D
+{
+    Shader*         m_shader         = nullptr;
+    Texture const*  m_texture        = nullptr;
+    eBlendMode      m_blendMode      = eBlendMode::ALPHA;
+    eSamplerMode    m_samplerMode    = eSamplerMode::POINT_CLAMP;
+    eRasterizerMode m_rasterizerMode = eRasterizerMode::SOLID_CULL_NONE;
+    eDepthMode      m_depthMode      = eDepthMode::DISABLED;
+    uint8_t         m_layer          = 0;     // Lower layers draw first; state sorting never crosses layers
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sDrawList2DStats
+{
+    int m_commandCount  = 0;    // AddVerts calls since the last flush
+    int m_instanceCount = 0;    // AddRing/AddDisc/AddLine/AddCapsule calls since the last flush
+    int m_drawCount     = 0;    // DrawVertexArray calls the flush emitted
+    int m_stateChanges  = 0;    // Render-state setter calls the flush emitted
+    int m_vertexCount   = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Deferred 2D geometry, sorted and merged by render state.
+//
+// AddVerts() only copies vertices into one growing array. Flush() stable-sorts the commands by
+// (layer, shader, texture, blend, sampler, rasterizer, depth), packs each run of equal state into one
+// contiguous range, and emits one DrawVertexArray per run, setting only the states that changed.
+// Primitives added with AddRing/AddDisc/AddLine/AddCapsule are kept as compact instances per state
+// (see PrimitiveBatch2D) and only expanded to triangles inside Flush().
+// Call Flush() once per camera, right before Renderer::EndCamera. All storage keeps its capacity,
+// so steady-state frames reuse the same buffers; the sort's scratch comes from g_frameArena.
+//
+// Within a layer, draws with different states may be reordered; put overlapping translucent
+// geometry that must keep its order on separate layers. With a null Renderer (headless) Flush()
+// does all the sorting and batching and only counts the draws, so batching can be checked without a GPU.
+//
+class DrawList2D
+{
+public:
+    explicit DrawList2D(Renderer* renderer);
+
+    void AddVerts(sDrawState2D const& state, Vertex_PCU const* verts, int vertexCount);
+    void AddVerts(sDrawState2D const& state, VertexList_PCU const& verts);
+    void AddRing(sDrawState2D const& state, Vec2 const& center, float radius, float thickness, Rgba8 const& color);
+    void AddDisc(sDrawState2D const& state, Vec2 const& center, float radius, Rgba8 const& color);
+    void AddLine(sDrawState2D const& state, Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color);
+    void AddCapsule(sDrawState2D const& state, Vec2 const& start, Vec2 const& end, float radius, Rgba8 const& color);
+    void Flush();
+
+    sDrawList2DStats const& GetLastFlushStats() const;
+    int                     GetTotalFlushCount() const;
+
+private:
+    struct sDrawCommand
+    {
+        uint64_t m_sortKey     = 0;
+        int      m_stateIndex  = 0;
+        int      m_firstVertex = 0;
+        int      m_vertexCount = 0;
+    };
+
+    int               GetOrAddStateIndex(sDrawState2D const& state);
+    PrimitiveBatch2D& GetPrimitiveBatch(sDrawState2D const& state);
+    void              ExpandPrimitiveBatches();
+    void              SortCommands();
+    uint64_t          MakeSortKey(sDrawState2D const& state);
+    uint16_t          GetOrAddResourceId(std::vector<void const*>& resources, void const* resource);
+    void              ApplyState(sDrawState2D const& state, sDrawState2D const* previousState);
+
+    Renderer*                     m_renderer = nullptr;
+    std::vector<sDrawState2D>     m_states;
+    std::vector<sDrawCommand>     m_commands;
+    std::vector<PrimitiveBatch2D> m_primitiveBatches;     // Indexed like m_states; never shrinks, so instance storage is reused
+    std::vector<void const*>      m_shaders;
+    std::vector<void const*>      m_textures;
+    VertexList_PCU                m_vertices;
+    VertexList_PCU                m_sortedVertices;
+    sDrawList2DStats              m_pendingStats;
+    sDrawList2DStats              m_lastFlushStats;
+    int                           m_totalFlushCount = 0;
+};
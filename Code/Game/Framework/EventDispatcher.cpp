@@ -0,0 +1,408 @@
+//----------------------------------------------------------------------------------------------------
+// EventDispatcher.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/EventDispatcher.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/BinaryLog.hpp"
+#include "Game/Framework/FrameProfiler.hpp"
+#include "Game/Framework/GameCommon.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+EventDispatcher::EventDispatcher(sEventDispatcherConfig const& config)
+    : m_postCapacity(static_cast<uint32_t>(std::max(config.m_postCapacity, 1)))
+{
+    m_postPool = std::make_unique<sPostedEvent[]>(m_postCapacity);
+
+    // Free stack starts as 0 -> 1 -> ... -> capacity - 1
+    for (uint32_t node = 0; node < m_postCapacity; ++node)
+    {
+        m_postPool[node].m_next.store(node + 1 < m_postCapacity ? node + 1 : NO_NODE, std::memory_order_relaxed);
+    }
+
+    m_freeHead.store(0, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Posts still queued are discarded undelivered; producers must be finished before shutdown.
+EventDispatcher::~EventDispatcher() = default;
+
+//----------------------------------------------------------------------------------------------------
+/// @return The id already interned for name (in any letter case), or a new one.
+EventId EventDispatcher::Intern(HashedName const& name)
+{
+    EventId const existing = Find(name);
+    if (existing.IsValid()) return existing;
+
+    EventId const id{ static_cast<uint32_t>(m_names.size()) };
+
+    // New ranges start empty at the end of the subscriber array
+    m_names.emplace_back(name.GetText());
+    m_ranges.push_back(sEventRange{ static_cast<uint32_t>(m_subscribers.size()), 0 });
+    m_idsByHash.emplace(name.GetHash(), id.m_index);
+
+    return id;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return The interned id for name, or an invalid id if it was never interned.
+EventId EventDispatcher::Find(HashedName const& name) const
+{
+    auto const [begin, end] = m_idsByHash.equal_range(name.GetHash());
+
+    for (auto found = begin; found != end; ++found)
+    {
+        if (AreNamesEqualCaseInsensitive(m_names[found->second], name.GetText())) return EventId{ found->second };
+    }
+
+    return EventId();
+}
+
+//----------------------------------------------------------------------------------------------------
+String const& EventDispatcher::GetName(EventId const id) const
+{
+    static String const s_invalidName = "<invalid event>";
+
+    return id.m_index < m_names.size() ? m_names[id.m_index] : s_invalidName;
+}
+
+//----------------------------------------------------------------------------------------------------
+int EventDispatcher::GetEventCount() const
+{
+    return static_cast<int>(m_names.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int EventDispatcher::GetSubscriberCount(EventId const id) const
+{
+    if (id.m_index >= m_ranges.size()) return 0;
+
+    sEventRange const& range = m_ranges[id.m_index];
+    int                count = 0;
+
+    for (uint32_t index = range.m_first; index < range.m_first + range.m_count; ++index)
+    {
+        if (!m_subscribers[index].IsRemoved()) ++count;
+    }
+
+    for (sPendingAdd const& pending : m_pendingAdds)
+    {
+        if (pending.m_id == id) ++count;
+    }
+
+    return count;
+}
+
+//----------------------------------------------------------------------------------------------------
+void EventDispatcher::Subscribe(EventId const id, GameEventCallback const callback)
+{
+    AddSubscriber(id, sSubscriber{ callback, nullptr, nullptr });
+}
+
+//----------------------------------------------------------------------------------------------------
+void EventDispatcher::Unsubscribe(EventId const id, GameEventCallback const callback)
+{
+    RemoveSubscriber(id, sSubscriber{ callback, nullptr, nullptr });
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return The number of subscribers called, including one that consumed the event.
+int EventDispatcher::FireEvent(EventId const id, FlatProperties& args)
+{
+    if (id.m_index >= m_ranges.size()) return 0;
+
+    // The range cannot move while m_fireDepth > 0; structural changes wait for the flush below
+    sEventRange const range       = m_ranges[id.m_index];
+    int               calledCount = 0;
+
+    ++m_fireDepth;
+
+    for (uint32_t index = range.m_first; index < range.m_first + range.m_count; ++index)
+    {
+        sSubscriber const subscriber = m_subscribers[index];
+        if (subscriber.IsRemoved()) continue;
+
+        ++calledCount;
+
+        bool const wasConsumed = subscriber.m_function != nullptr ? subscriber.m_function(args) : subscriber.m_invoker(subscriber.m_object, args);
+        if (wasConsumed) break;
+    }
+
+    if (--m_fireDepth == 0 && (m_hasTombstones || !m_pendingAdds.empty()))
+    {
+        FlushDeferredChanges();
+    }
+
+    return calledCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int EventDispatcher::FireEvent(EventId const id)
+{
+    FlatProperties emptyArgs;
+
+    return FireEvent(id, emptyArgs);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// String path, for callers that only have a name: one hash lookup, then the same dispatch.
+int EventDispatcher::FireEvent(HashedName const& name, FlatProperties& args)
+{
+    return FireEvent(Find(name), args);
+}
+
+//----------------------------------------------------------------------------------------------------
+void EventDispatcher::AddSubscriber(EventId const id, sSubscriber const& subscriber)
+{
+    if (id.m_index >= m_ranges.size()) return;
+
+    if (m_fireDepth > 0)
+    {
+        m_pendingAdds.push_back(sPendingAdd{ id, subscriber });
+        return;
+    }
+
+    // Insert at the end of this event's range and shift every later range by one
+    sEventRange&   range    = m_ranges[id.m_index];
+    uint32_t const insertAt = range.m_first + range.m_count;
+
+    m_subscribers.insert(m_subscribers.begin() + insertAt, subscriber);
+    ++range.m_count;
+
+    for (sEventRange& laterRange : m_ranges)
+    {
+        if (&laterRange != &range && laterRange.m_first >= insertAt) ++laterRange.m_first;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void EventDispatcher::RemoveSubscriber(EventId const id, sSubscriber const& subscriber)
+{
+    if (id.m_index >= m_ranges.size()) return;
+
+    // Not yet added: drop it from the queue
+    for (auto pending = m_pendingAdds.begin(); pending != m_pendingAdds.end(); ++pending)
+    {
+        if (pending->m_id == id && pending->m_subscriber.Matches(subscriber))
+        {
+            m_pendingAdds.erase(pending);
+            return;
+        }
+    }
+
+    sEventRange& range = m_ranges[id.m_index];
+
+    for (uint32_t index = range.m_first; index < range.m_first + range.m_count; ++index)
+    {
+        if (!m_subscribers[index].Matches(subscriber)) continue;
+
+        if (m_fireDepth > 0)
+        {
+            m_subscribers[index] = sSubscriber();
+            m_hasTombstones      = true;
+            return;
+        }
+
+        m_subscribers.erase(m_subscribers.begin() + index);
+        --range.m_count;
+
+        for (sEventRange& laterRange : m_ranges)
+        {
+            if (&laterRange != &range && laterRange.m_first > index) --laterRange.m_first;
+        }
+
+        return;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Rebuild the subscriber array without tombstones, then apply the queued additions in order.
+void EventDispatcher::FlushDeferredChanges()
+{
+    if (m_hasTombstones)
+    {
+        std::vector<sSubscriber> compacted;
+        compacted.reserve(m_subscribers.size());
+
+        for (sEventRange& range : m_ranges)
+        {
+            uint32_t const newFirst = static_cast<uint32_t>(compacted.size());
+
+            for (uint32_t index = range.m_first; index < range.m_first + range.m_count; ++index)
+            {
+                if (!m_subscribers[index].IsRemoved()) compacted.push_back(m_subscribers[index]);
+            }
+
+            range.m_first = newFirst;
+            range.m_count = static_cast<uint32_t>(compacted.size()) - newFirst;
+        }
+
+        m_subscribers.swap(compacted);
+        m_hasTombstones = false;
+    }
+
+    std::vector<sPendingAdd> pendingAdds;
+    pendingAdds.swap(m_pendingAdds);
+
+    for (sPendingAdd const& pending : pendingAdds)
+    {
+        AddSubscriber(pending.m_id, pending.m_subscriber);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Any thread. The args are copied; the event fires at the next DrainPostedEvents().
+/// @return false if the pool is exhausted (the post is dropped and counted) or id was never interned.
+bool EventDispatcher::Post(EventId const id, FlatProperties const& args, eEventPost const mode)
+{
+    if (!id.IsValid()) return false;
+
+    uint32_t const node = PopFreeNode();
+
+    if (node == NO_NODE)
+    {
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    sPostedEvent& posted = m_postPool[node];
+    posted.m_args        = args;
+    posted.m_id          = id;
+    posted.m_mode        = mode;
+
+    // Release: the consumer's exchange must see the filled node
+    uint32_t head = m_postedHead.load(std::memory_order_relaxed);
+
+    do
+    {
+        posted.m_next.store(head, std::memory_order_relaxed);
+    }
+    while (!m_postedHead.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool EventDispatcher::Post(EventId const id, eEventPost const mode)
+{
+    return Post(id, FlatProperties(), mode);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Main thread. Takes every post made so far and fires them oldest first; of coalesced posts of
+/// one event in this batch only the newest is fired, at its own position.
+void EventDispatcher::DrainPostedEvents()
+{
+    PROFILE_SCOPE("EventDispatcher::DrainPostedEvents");
+
+    m_queueStats                = sEventQueueStats();
+    m_queueStats.m_droppedCount = m_droppedCount.exchange(0, std::memory_order_relaxed);
+
+    if (m_queueStats.m_droppedCount > 0)
+    {
+        GAME_LOG(eLogVerbosity::Warning, "(EventDispatcher) %d posted events dropped, raise <EventQueue postCapacity>", m_queueStats.m_droppedCount);
+    }
+
+    uint32_t node = m_postedHead.exchange(NO_NODE, std::memory_order_acquire);
+    if (node == NO_NODE) return;
+
+    // The list is newest first; reverse into posting order
+    m_drainBatch.clear();
+
+    for (; node != NO_NODE; node = m_postPool[node].m_next.load(std::memory_order_relaxed))
+    {
+        m_drainBatch.push_back(node);
+    }
+
+    std::reverse(m_drainBatch.begin(), m_drainBatch.end());
+
+    m_lastCoalescedPosition.resize(m_names.size(), NO_NODE);
+
+    for (uint32_t position = 0; position < m_drainBatch.size(); ++position)
+    {
+        sPostedEvent const& posted = m_postPool[m_drainBatch[position]];
+
+        if (posted.m_mode == eEventPost::COALESCED && posted.m_id.m_index < m_lastCoalescedPosition.size())
+        {
+            m_lastCoalescedPosition[posted.m_id.m_index] = position;
+        }
+    }
+
+    for (uint32_t position = 0; position < m_drainBatch.size(); ++position)
+    {
+        sPostedEvent& posted       = m_postPool[m_drainBatch[position]];
+        bool const    isCoalesced  = posted.m_mode == eEventPost::COALESCED;
+        bool const    isSuperseded = isCoalesced && m_lastCoalescedPosition[posted.m_id.m_index] != position;
+
+        if (!isSuperseded)
+        {
+            // The newest coalesced post is the last one of its event in the batch; clear for the next drain
+            if (isCoalesced) m_lastCoalescedPosition[posted.m_id.m_index] = NO_NODE;
+
+            FireEvent(posted.m_id, posted.m_args);
+            ++m_queueStats.m_deliveredCount;
+        }
+
+        // Producers may reuse the node as soon as it is pushed, so it is not read after this
+        posted.m_args.Clear();
+        PushFreeNode(m_drainBatch[position]);
+    }
+
+    m_queueStats.m_drainedCount = static_cast<int>(m_drainBatch.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+sEventQueueStats const& EventDispatcher::GetQueueStats() const
+{
+    return m_queueStats;
+}
+
+//----------------------------------------------------------------------------------------------------
+int EventDispatcher::GetPostCapacity() const
+{
+    return static_cast<int>(m_postCapacity);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Lock-free pop for many producers. The tag in the high word changes on every push and pop, so a
+/// node that was popped and pushed back between our load and our CAS makes the CAS fail (no ABA).
+uint32_t EventDispatcher::PopFreeNode()
+{
+    uint64_t head = m_freeHead.load(std::memory_order_acquire);
+
+    for (;;)
+    {
+        uint32_t const node = static_cast<uint32_t>(head);
+        if (node == NO_NODE) return NO_NODE;
+
+        uint32_t const next    = m_postPool[node].m_next.load(std::memory_order_relaxed);
+        uint64_t const newHead = ((head >> 32) + 1) << 32 | next;
+
+        if (m_freeHead.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire)) return node;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void EventDispatcher::PushFreeNode(uint32_t const node)
+{
+    uint64_t head = m_freeHead.load(std::memory_order_relaxed);
+    uint64_t newHead;
+
+    do
+    {
+        m_postPool[node].m_next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        newHead = ((head >> 32) + 1) << 32 | node;
+    }
+    while (!m_freeHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
@@ -0,0 +1,199 @@
+//----------------------------------------------------------------------------------------------------
+// EventDispatcher.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FlatProperties.hpp"
+#include "Game/Framework/HashedName.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Interned event name: an index into the dispatcher's table, equal for names that differ only in case.
+//
+struct EventId
+{
+    uint32_t m_index = UINT32_MAX;
+
+    bool IsValid() const { return m_index != UINT32_MAX; }
+    bool operator==(EventId const& other) const { return m_index == other.m_index; }
+    bool operator!=(EventId const& other) const { return m_index != other.m_index; }
+};
+
+//----------------------------------------------------------------------------------------------------
+// Dispatcher events carry FlatProperties rather than EventArgs, so firing or posting one with a few
+// small args does not allocate.
+//
+using GameEventCallback = bool (*)(FlatProperties& args);
+
+//----------------------------------------------------------------------------------------------------
+// Loaded from the <EventQueue> element of Data/GameConfig.xml.
+//
+struct sEventDispatcherConfig
+{
+    int m_postCapacity = 4096;      // Posted events that can wait for the next drain; Post() fails beyond it
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eEventPost : uint8_t
+{
+    QUEUED,         // Every post is delivered
+    COALESCED       // Of the coalesced posts of one event drained together, only the last is delivered
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sEventQueueStats
+{
+    int m_drainedCount   = 0;       // Posts taken off the queue by the last drain
+    int m_deliveredCount = 0;       // Of those, dispatched (the rest were coalesced away)
+    int m_droppedCount   = 0;       // Posts refused since the last drain because the pool was empty
+};
+
+//----------------------------------------------------------------------------------------------------
+// Game-side event dispatch by interned id, for events fired often enough that EventSystem's
+// per-call string hashing and case-insensitive compares show up (gameplay notifications, not
+// console commands, which the DevConsole still routes through g_eventSystem).
+//
+// Intern() maps a name to an EventId once, usually at subscribe time or in a constructor; names
+// are HashedNames, so Intern("OnGameStateChanged"_hcis) does not even hash at runtime. Every
+// event's subscribers sit in one contiguous array, [first, first + count) per id, so FireEvent(id)
+// is an index plus a linear walk. A subscriber returning true consumes the event, and the ones after
+// it are not called.
+//
+// Subscribing or unsubscribing from inside a callback is allowed: removals are tombstoned and
+// additions queued until the outermost FireEvent returns. Everything but Post() is main thread only.
+//
+// Post() may be called from any thread. It takes a preallocated node from a lock-free pool (a
+// tagged-index stack), copies the args into it and pushes it onto a lock-free list; nothing is
+// locked, and nothing is allocated unless the args hold long strings or nested properties (see
+// FlatProperties). DrainPostedEvents(), called from App::BeginFrame right after
+// EventSystem::BeginFrame, takes the whole list in one exchange and fires the events in posting
+// order. Events posted by those handlers wait for the next drain.
+//
+class EventDispatcher
+{
+public:
+    explicit EventDispatcher(sEventDispatcherConfig const& config);
+    ~EventDispatcher();
+
+    EventDispatcher(EventDispatcher const&)            = delete;
+    EventDispatcher& operator=(EventDispatcher const&) = delete;
+
+    EventId       Intern(HashedName const& name);
+    EventId       Find(HashedName const& name) const;
+    String const& GetName(EventId id) const;
+    int           GetEventCount() const;
+    int           GetSubscriberCount(EventId id) const;
+
+    void Subscribe(EventId id, GameEventCallback callback);
+    void Unsubscribe(EventId id, GameEventCallback callback);
+
+    template <typename T, bool (T::*Method)(FlatProperties&)>
+    void Subscribe(EventId id, T* object);
+    template <typename T, bool (T::*Method)(FlatProperties&)>
+    void Unsubscribe(EventId id, T* object);
+
+    int FireEvent(EventId id, FlatProperties& args);
+    int FireEvent(EventId id);
+    int FireEvent(HashedName const& name, FlatProperties& args);
+
+    bool Post(EventId id, FlatProperties const& args, eEventPost mode = eEventPost::QUEUED);
+    bool Post(EventId id, eEventPost mode = eEventPost::QUEUED);
+    void DrainPostedEvents();
+
+    sEventQueueStats const& GetQueueStats() const;
+    int                     GetPostCapacity() const;
+
+private:
+    using Invoker = bool (*)(void* object, FlatProperties& args);
+
+    // Either m_function, or m_invoker with its object; all null marks one removed mid-dispatch
+    struct sSubscriber
+    {
+        GameEventCallback m_function = nullptr;
+        Invoker           m_invoker  = nullptr;
+        void*             m_object   = nullptr;
+
+        bool IsRemoved() const { return m_function == nullptr && m_invoker == nullptr; }
+        bool Matches(sSubscriber const& other) const { return m_function == other.m_function && m_invoker == other.m_invoker && m_object == other.m_object; }
+    };
+
+    struct sEventRange
+    {
+        uint32_t m_first = 0;
+        uint32_t m_count = 0;
+    };
+
+    struct sPendingAdd
+    {
+        EventId     m_id;
+        sSubscriber m_subscriber;
+    };
+
+    static uint32_t constexpr NO_NODE = UINT32_MAX;
+
+    // A pool node; m_next links it into either the free stack or the posted list
+    struct sPostedEvent
+    {
+        FlatProperties        m_args;
+        EventId               m_id;
+        eEventPost            m_mode = eEventPost::QUEUED;
+        std::atomic<uint32_t> m_next = NO_NODE;
+    };
+
+    template <typename T, bool (T::*Method)(FlatProperties&)>
+    static bool InvokeMethod(void* object, FlatProperties& args);
+
+    void AddSubscriber(EventId id, sSubscriber const& subscriber);
+    void RemoveSubscriber(EventId id, sSubscriber const& subscriber);
+    void FlushDeferredChanges();
+
+    uint32_t PopFreeNode();
+    void     PushFreeNode(uint32_t node);
+
+    std::vector<String>                         m_names;           // By EventId, spelled as first interned
+    std::vector<sEventRange>                    m_ranges;          // By EventId
+    std::vector<sSubscriber>                    m_subscribers;     // Every event's subscribers, grouped by EventId
+    std::unordered_multimap<uint32_t, uint32_t> m_idsByHash;       // GetCaseInsensitiveHash -> EventId
+    std::vector<sPendingAdd>                    m_pendingAdds;
+    int                                         m_fireDepth     = 0;
+    bool                                        m_hasTombstones = false;
+
+    std::unique_ptr<sPostedEvent[]> m_postPool;
+    uint32_t                        m_postCapacity = 0;
+    std::atomic<uint64_t>           m_freeHead;                 // (ABA tag << 32) | node index
+    std::atomic<uint32_t>           m_postedHead   = NO_NODE;   // Newest post first
+    std::atomic<int>                m_droppedCount = 0;
+    std::vector<uint32_t>           m_drainBatch;               // Drain scratch, in posting order
+    std::vector<uint32_t>           m_lastCoalescedPosition;    // By EventId, within the current batch
+    sEventQueueStats                m_queueStats;
+};
+
+//----------------------------------------------------------------------------------------------------
+template <typename T, bool (T::*Method)(FlatProperties&)>
+void EventDispatcher::Subscribe(EventId const id, T* object)
+{
+    AddSubscriber(id, sSubscriber{ nullptr, &InvokeMethod<T, Method>, object });
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename T, bool (T::*Method)(FlatProperties&)>
+void EventDispatcher::Unsubscribe(EventId const id, T* object)
+{
+    RemoveSubscriber(id, sSubscriber{ nullptr, &InvokeMethod<T, Method>, object });
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename T, bool (T::*Method)(FlatProperties&)>
+bool EventDispatcher::InvokeMethod(void* object, FlatProperties& args)
+{
+    return (static_cast<T*>(object)->*Method)(args);
+}
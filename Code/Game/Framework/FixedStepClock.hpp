@@ -0,0 +1,25 @@
+//----------------------------------------------------------------------------------------------------
+// FixedStepClock.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Clock.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// A clock advanced only by Step(), never by wall time. Clock's default constructor still makes it a
+// child of the system clock, and Clock offers no way to detach it, so the headless loop, its only
+// user, never calls TickSystemClock() and reads wall time itself. The loop steps it by exactly
+// 1/fixedTimeStepHz per simulation step, so the clocks under it (the game clock, script waits) see
+// the same deltas on every run. Step() goes through Clock::Advance, which applies the time scale and
+// pause of each child as TickSystemClock() does.
+//
+class FixedStepClock : public Clock
+{
+public:
+    void Step(double const deltaSeconds)
+    {
+        Advance(deltaSeconds);
+    }
+};
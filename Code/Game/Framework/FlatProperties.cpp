@@ -0,0 +1,591 @@
+//----------------------------------------------------------------------------------------------------
+// FlatProperties.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FlatProperties.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    bool IsAtEnd(char const* cursor)
+    {
+        while (std::isspace(static_cast<unsigned char>(*cursor))) ++cursor;
+        return *cursor == '\0';
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Reads up to maxCount comma-separated numbers; @return how many, or 0 if anything else is in the text.
+    //
+    template <typename T>
+    int ParseNumberList(char const* text, T* outValues, int const maxCount)
+    {
+        char const* cursor = text;
+
+        for (int index = 0; index < maxCount; ++index)
+        {
+            char* end = nullptr;
+
+            if constexpr (std::is_floating_point_v<T>) outValues[index] = static_cast<T>(std::strtod(cursor, &end));
+            else outValues[index] = static_cast<T>(std::strtol(cursor, &end, 10));
+
+            if (end == cursor) return 0;
+
+            cursor = end;
+            while (std::isspace(static_cast<unsigned char>(*cursor))) ++cursor;
+
+            if (*cursor == '\0') return index + 1;
+            if (*cursor != ',') return 0;
+            ++cursor;
+        }
+
+        return 0;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ParsePropertyText(char const* text, bool& out)
+{
+    if (AreNamesEqualCaseInsensitive(text, "true") || AreNamesEqualCaseInsensitive(text, "1"))
+    {
+        out = true;
+        return true;
+    }
+
+    if (AreNamesEqualCaseInsensitive(text, "false") || AreNamesEqualCaseInsensitive(text, "0"))
+    {
+        out = false;
+        return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ParsePropertyText(char const* text, int& out)
+{
+    char*      end   = nullptr;
+    long const value = std::strtol(text, &end, 10);
+
+    if (end == text || !IsAtEnd(end)) return false;
+
+    out = static_cast<int>(value);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ParsePropertyText(char const* text, float& out)
+{
+    char*       end   = nullptr;
+    float const value = std::strtof(text, &end);
+
+    if (end == text || !IsAtEnd(end)) return false;
+
+    out = value;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ParsePropertyText(char const* text, Vec2& out)
+{
+    float values[2];
+    if (ParseNumberList(text, values, 2) != 2) return false;
+
+    out = Vec2(values[0], values[1]);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ParsePropertyText(char const* text, IntVec2& out)
+{
+    int values[2];
+    if (ParseNumberList(text, values, 2) != 2) return false;
+
+    out = IntVec2(values[0], values[1]);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// "r,g,b" or "r,g,b,a", each 0-255; alpha defaults to 255.
+bool ParsePropertyText(char const* text, Rgba8& out)
+{
+    int       values[4] = { 0, 0, 0, 255 };
+    int const count     = ParseNumberList(text, values, 4);
+
+    if (count < 3) return false;
+
+    for (int& value : values) value = std::clamp(value, 0, 255);
+
+    out = Rgba8(static_cast<unsigned char>(values[0]), static_cast<unsigned char>(values[1]), static_cast<unsigned char>(values[2]), static_cast<unsigned char>(values[3]));
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties::sEntry::~sEntry()
+{
+    ReleaseValue();
+    ReleaseKey();
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties::sEntry::sEntry(sEntry const& copyFrom)
+{
+    CopyFrom(copyFrom);
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties::sEntry::sEntry(sEntry&& moveFrom) noexcept
+{
+    MoveFrom(moveFrom);
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties::sEntry& FlatProperties::sEntry::operator=(sEntry const& copyFrom)
+{
+    if (this != &copyFrom)
+    {
+        ReleaseValue();
+        ReleaseKey();
+        CopyFrom(copyFrom);
+    }
+
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties::sEntry& FlatProperties::sEntry::operator=(sEntry&& moveFrom) noexcept
+{
+    if (this != &moveFrom)
+    {
+        ReleaseValue();
+        ReleaseKey();
+        MoveFrom(moveFrom);
+    }
+
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* FlatProperties::sEntry::GetKey() const
+{
+    return m_isKeyHeap ? m_heapKey : m_inlineKey;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::string_view FlatProperties::sEntry::GetKeyView() const
+{
+    return std::string_view(GetKey(), m_keyLength);
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* FlatProperties::sEntry::GetText() const
+{
+    if (m_kind == eValueKind::TEXT_INLINE) return reinterpret_cast<char const*>(m_bytes);
+
+    if (m_kind == eValueKind::TEXT_HEAP)
+    {
+        char const* text = nullptr;
+        std::memcpy(&text, m_bytes, sizeof(text));
+        return text;
+    }
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties const* FlatProperties::sEntry::GetNested() const
+{
+    if (m_kind != eValueKind::NESTED) return nullptr;
+
+    FlatProperties const* nested = nullptr;
+    std::memcpy(&nested, m_bytes, sizeof(nested));
+    return nested;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FlatProperties::sEntry::SetKey(std::string_view const key)
+{
+    ReleaseKey();
+
+    size_t const length = key.size();
+    m_keyLength         = static_cast<uint32_t>(length);
+
+    if (length < KEY_INLINE_CHARS)
+    {
+        std::memcpy(m_inlineKey, key.data(), length);
+        m_inlineKey[length] = '\0';
+        return;
+    }
+
+    m_heapKey = new char[length + 1];
+    std::memcpy(m_heapKey, key.data(), length);
+    m_heapKey[length] = '\0';
+    m_isKeyHeap = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FlatProperties::sEntry::ReleaseValue()
+{
+    if (m_kind == eValueKind::TEXT_HEAP) delete[] GetText();
+    if (m_kind == eValueKind::NESTED) delete GetNested();
+
+    m_kind         = eValueKind::NONE;
+    m_type         = nullptr;
+    m_cacheType    = nullptr;
+    m_didCacheFail = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FlatProperties::sEntry::ReleaseKey()
+{
+    if (m_isKeyHeap) delete[] m_heapKey;
+
+    m_isKeyHeap    = false;
+    m_keyLength    = 0;
+    m_inlineKey[0] = '\0';
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Deep copy; expects this entry to hold nothing.
+void FlatProperties::sEntry::CopyFrom(sEntry const& other)
+{
+    SetKey(other.GetKeyView());
+
+    m_hash         = other.m_hash;
+    m_kind         = other.m_kind;
+    m_type         = other.m_type;
+    m_cacheType    = other.m_cacheType;
+    m_didCacheFail = other.m_didCacheFail;
+    std::memcpy(m_bytes, other.m_bytes, VALUE_BYTES);
+    std::memcpy(m_cache, other.m_cache, CACHE_BYTES);
+
+    if (m_kind == eValueKind::TEXT_HEAP)
+    {
+        char const*  text   = other.GetText();
+        size_t const length = std::strlen(text);
+        char*        copy   = new char[length + 1];
+        std::memcpy(copy, text, length + 1);
+        std::memcpy(m_bytes, &copy, sizeof(copy));
+    }
+    else if (m_kind == eValueKind::NESTED)
+    {
+        FlatProperties* copy = new FlatProperties(*other.GetNested());
+        std::memcpy(m_bytes, &copy, sizeof(copy));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Takes other's heap pointers and leaves it empty; expects this entry to hold nothing.
+void FlatProperties::sEntry::MoveFrom(sEntry& other)
+{
+    m_hash         = other.m_hash;
+    m_keyLength    = other.m_keyLength;
+    m_kind         = other.m_kind;
+    m_isKeyHeap    = other.m_isKeyHeap;
+    m_type         = other.m_type;
+    m_cacheType    = other.m_cacheType;
+    m_didCacheFail = other.m_didCacheFail;
+    std::memcpy(m_bytes, other.m_bytes, VALUE_BYTES);
+    std::memcpy(m_cache, other.m_cache, CACHE_BYTES);
+
+    if (m_isKeyHeap) m_heapKey = other.m_heapKey;
+    else std::memcpy(m_inlineKey, other.m_inlineKey, KEY_INLINE_CHARS);
+
+    other.m_kind         = eValueKind::NONE;
+    other.m_isKeyHeap    = false;
+    other.m_keyLength    = 0;
+    other.m_inlineKey[0] = '\0';
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties::~FlatProperties() = default;
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties::FlatProperties(FlatProperties const& copyFrom)
+    : m_spill(copyFrom.m_spill),
+      m_count(copyFrom.m_count)
+{
+    if (copyFrom.IsInline())
+    {
+        std::copy_n(copyFrom.m_inline, m_count, m_inline);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties::FlatProperties(FlatProperties&& moveFrom) noexcept
+    : m_spill(std::move(moveFrom.m_spill)),
+      m_count(moveFrom.m_count)
+{
+    std::move(moveFrom.m_inline, moveFrom.m_inline + INLINE_CAPACITY, m_inline);
+    moveFrom.m_spill.clear();
+    moveFrom.m_count = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties& FlatProperties::operator=(FlatProperties const& copyFrom)
+{
+    if (this != &copyFrom)
+    {
+        Clear();
+        m_spill = copyFrom.m_spill;
+        m_count = copyFrom.m_count;
+
+        if (copyFrom.IsInline())
+        {
+            std::copy_n(copyFrom.m_inline, m_count, m_inline);
+        }
+    }
+
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties& FlatProperties::operator=(FlatProperties&& moveFrom) noexcept
+{
+    if (this != &moveFrom)
+    {
+        Clear();
+        m_spill = std::move(moveFrom.m_spill);
+        m_count = moveFrom.m_count;
+        std::move(moveFrom.m_inline, moveFrom.m_inline + INLINE_CAPACITY, m_inline);
+        moveFrom.m_spill.clear();
+        moveFrom.m_count = 0;
+    }
+
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FlatProperties::SetValue(HashedName const& key, char const* text)
+{
+    SetText(key, text, std::strlen(text));
+}
+
+//----------------------------------------------------------------------------------------------------
+void FlatProperties::SetValue(HashedName const& key, String const& text)
+{
+    SetText(key, text.c_str(), text.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+void FlatProperties::SetValue(HashedName const& key, FlatProperties const& nested)
+{
+    FlatProperties* copy = new FlatProperties(nested);
+
+    sEntry& entry = FindOrAddEntry(key);
+    entry.ReleaseValue();
+    entry.m_kind = eValueKind::NESTED;
+    std::memcpy(entry.m_bytes, &copy, sizeof(copy));
+}
+
+//----------------------------------------------------------------------------------------------------
+String FlatProperties::GetValue(HashedName const& key, char const* defaultValue) const
+{
+    return String(GetText(key, defaultValue));
+}
+
+//----------------------------------------------------------------------------------------------------
+String FlatProperties::GetValue(HashedName const& key, String const& defaultValue) const
+{
+    char const* text = GetText(key, nullptr);
+    return text != nullptr ? String(text) : defaultValue;
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* FlatProperties::GetText(HashedName const& key, char const* defaultValue) const
+{
+    sEntry const* entry = FindEntry(key);
+    char const*   text  = entry != nullptr ? entry->GetText() : nullptr;
+
+    return text != nullptr ? text : defaultValue;
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties const* FlatProperties::GetNested(HashedName const& key) const
+{
+    sEntry const* entry = FindEntry(key);
+    return entry != nullptr ? entry->GetNested() : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool FlatProperties::HasKey(HashedName const& key) const
+{
+    return FindEntry(key) != nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool FlatProperties::Remove(HashedName const& key)
+{
+    sEntry const* entry = FindEntry(key);
+    if (entry == nullptr) return false;
+
+    sEntry*   entries = GetEntries();
+    int const index   = static_cast<int>(entry - entries);
+
+    if (IsInline())
+    {
+        std::move(entries + index + 1, entries + m_count, entries + index);
+        entries[m_count - 1].ReleaseValue();
+        entries[m_count - 1].ReleaseKey();
+    }
+    else
+    {
+        m_spill.erase(m_spill.begin() + index);
+    }
+
+    --m_count;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+int FlatProperties::GetCount() const
+{
+    return m_count;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return false once the entries have spilled to the heap (more than INLINE_CAPACITY at some point).
+bool FlatProperties::IsInline() const
+{
+    return m_spill.empty();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Keeps the spill vector's capacity, so a reused FlatProperties does not allocate again.
+void FlatProperties::Clear()
+{
+    for (int index = 0; index < INLINE_CAPACITY; ++index)
+    {
+        m_inline[index].ReleaseValue();
+        m_inline[index].ReleaseKey();
+    }
+
+    m_spill.clear();
+    m_count = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties::sEntry* FlatProperties::GetEntries()
+{
+    return IsInline() ? m_inline : m_spill.data();
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties::sEntry const* FlatProperties::GetEntries() const
+{
+    return IsInline() ? m_inline : m_spill.data();
+}
+
+//----------------------------------------------------------------------------------------------------
+FlatProperties::sEntry const* FlatProperties::FindEntry(HashedName const& key) const
+{
+    sEntry const* begin = GetEntries();
+    sEntry const* end   = begin + m_count;
+    sEntry const* entry = std::lower_bound(begin, end, key.GetHash(), [](sEntry const& candidate, uint32_t const value) { return candidate.m_hash < value; });
+
+    for (; entry != end && entry->m_hash == key.GetHash(); ++entry)
+    {
+        if (AreNamesEqualCaseInsensitive(entry->GetKeyView(), key.GetText())) return entry;
+    }
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Inserts an empty entry at its sorted position when the key is new, spilling every entry to
+/// m_spill when the inline array is full.
+FlatProperties::sEntry& FlatProperties::FindOrAddEntry(HashedName const& key)
+{
+    if (sEntry const* found = FindEntry(key))
+    {
+        return GetEntries()[found - GetEntries()];
+    }
+
+    if (IsInline() && m_count == INLINE_CAPACITY)
+    {
+        m_spill.reserve(INLINE_CAPACITY * 2);
+
+        for (sEntry& entry : m_inline)
+        {
+            m_spill.push_back(std::move(entry));
+        }
+    }
+
+    sEntry*   entries = GetEntries();
+    int const index   = static_cast<int>(std::upper_bound(entries, entries + m_count, key.GetHash(), [](uint32_t const value, sEntry const& candidate) { return value < candidate.m_hash; }) - entries);
+
+    sEntry* entry = nullptr;
+
+    if (IsInline())
+    {
+        std::move_backward(entries + index, entries + m_count, entries + m_count + 1);
+        entry = &entries[index];
+        entry->ReleaseValue();
+        entry->ReleaseKey();
+    }
+    else
+    {
+        entry = &*m_spill.emplace(m_spill.begin() + index);
+    }
+
+    entry->m_hash = key.GetHash();
+    entry->SetKey(key.GetText());
+    ++m_count;
+
+    return *entry;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FlatProperties::SetTrivial(HashedName const& key, TypeTag const type, void const* value, size_t const size)
+{
+    sEntry& entry = FindOrAddEntry(key);
+
+    entry.ReleaseValue();
+    entry.m_kind = eValueKind::TRIVIAL;
+    entry.m_type = type;
+    std::memcpy(entry.m_bytes, value, size);
+}
+
+//----------------------------------------------------------------------------------------------------
+void FlatProperties::SetText(HashedName const& key, char const* text, size_t const length)
+{
+    // Copied out before the entry is touched, in case text is that entry's own value
+    char  inlineText[VALUE_BYTES];
+    char* heapText = nullptr;
+
+    if (length < VALUE_BYTES)
+    {
+        std::memcpy(inlineText, text, length);
+        inlineText[length] = '\0';
+    }
+    else
+    {
+        heapText = new char[length + 1];
+        std::memcpy(heapText, text, length);
+        heapText[length] = '\0';
+    }
+
+    sEntry& entry = FindOrAddEntry(key);
+    entry.ReleaseValue();
+
+    if (heapText == nullptr)
+    {
+        entry.m_kind = eValueKind::TEXT_INLINE;
+        std::memcpy(entry.m_bytes, inlineText, length + 1);
+    }
+    else
+    {
+        entry.m_kind = eValueKind::TEXT_HEAP;
+        std::memcpy(entry.m_bytes, &heapText, sizeof(heapText));
+    }
+}
@@ -0,0 +1,226 @@
+//----------------------------------------------------------------------------------------------------
+// FlatProperties.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/HashedName.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Text -> typed conversions used when a value set as a string is read back as T ("3.14" as float).
+// Each returns false and leaves out untouched when the text does not parse; types without an
+// overload never convert.
+//
+bool ParsePropertyText(char const* text, bool& out);
+bool ParsePropertyText(char const* text, int& out);
+bool ParsePropertyText(char const* text, float& out);
+bool ParsePropertyText(char const* text, Vec2& out);
+bool ParsePropertyText(char const* text, IntVec2& out);
+bool ParsePropertyText(char const* text, Rgba8& out);
+
+template <typename T>
+bool ParsePropertyText(char const*, T&) { return false; }
+
+//----------------------------------------------------------------------------------------------------
+// Case-insensitive name -> value map with NamedProperties' Set/GetValue surface, laid out so that
+// the common case never touches the heap.
+//
+// Values live in a 32-byte inline buffer tagged with their type: any trivially copyable T that fits
+// (bool, int, float, Vec2, Rgba8, AABB2, EventId, ...) is stored by memcpy, and strings up to 31
+// chars are stored in place. Longer strings and nested FlatProperties are the only values that
+// allocate.
+//
+// Entries are kept sorted by key hash (GetCaseInsensitiveHash) in a flat array with room for
+// INLINE_CAPACITY entries inside the object, spilling to a std::vector past that. A lookup is a
+// binary search on the hash plus a case-insensitive compare of the key. Keys are HashedNames: a
+// "key"_hcis literal carries a compile-time hash, a plain string is hashed without allocating.
+// Keys up to 23 chars are stored in place.
+//
+// Reading a string value as another type parses the text once and caches the result in the entry
+// (16 bytes, enough for Vec2 / IntVec2 / Rgba8), so repeated typed reads of a string cost a compare.
+// The cache is mutable state behind a const getter: one FlatProperties must not be read from two
+// threads at once.
+//
+class FlatProperties
+{
+public:
+    static int constexpr INLINE_CAPACITY = 6;
+    static int constexpr VALUE_BYTES     = 32;
+
+    FlatProperties() = default;
+    ~FlatProperties();
+
+    FlatProperties(FlatProperties const& copyFrom);
+    FlatProperties(FlatProperties&& moveFrom) noexcept;
+    FlatProperties& operator=(FlatProperties const& copyFrom);
+    FlatProperties& operator=(FlatProperties&& moveFrom) noexcept;
+
+    template <typename T>
+    void SetValue(HashedName const& key, T const& value);
+    void SetValue(HashedName const& key, char const* text);
+    void SetValue(HashedName const& key, String const& text);
+    void SetValue(HashedName const& key, FlatProperties const& nested);
+
+    // A value set as T reads back as T; a string reads back as T if it parses; anything else
+    // (missing key, other type, unparsable text) yields defaultValue
+    template <typename T>
+    T GetValue(HashedName const& key, T const& defaultValue) const;
+
+    // String values only; GetText() returns the stored chars without building a String
+    String                GetValue(HashedName const& key, char const* defaultValue) const;
+    String                GetValue(HashedName const& key, String const& defaultValue) const;
+    char const*           GetText(HashedName const& key, char const* defaultValue) const;
+    FlatProperties const* GetNested(HashedName const& key) const;
+
+    bool HasKey(HashedName const& key) const;
+    bool Remove(HashedName const& key);
+    int  GetCount() const;
+    bool IsInline() const;
+    void Clear();
+
+private:
+    using TypeTag = void const*;
+
+    template <typename T>
+    static TypeTag GetTypeTag();
+
+    static int constexpr KEY_INLINE_CHARS = 24;
+    static int constexpr CACHE_BYTES      = 16;
+
+    enum class eValueKind : uint8_t
+    {
+        NONE,
+        TRIVIAL,            // m_bytes holds a T tagged m_type
+        TEXT_INLINE,        // m_bytes holds a NUL-terminated string
+        TEXT_HEAP,          // m_bytes holds a char* from new[]
+        NESTED              // m_bytes holds a FlatProperties* from new
+    };
+
+    struct sEntry
+    {
+        sEntry() = default;
+        ~sEntry();
+        sEntry(sEntry const& copyFrom);
+        sEntry(sEntry&& moveFrom) noexcept;
+        sEntry& operator=(sEntry const& copyFrom);
+        sEntry& operator=(sEntry&& moveFrom) noexcept;
+
+        char const*           GetKey() const;
+        char const*           GetText() const;
+        FlatProperties const* GetNested() const;
+        std::string_view      GetKeyView() const;
+        void                  SetKey(std::string_view key);
+        void                  ReleaseValue();
+        void                  ReleaseKey();
+        void                  CopyFrom(sEntry const& other);
+        void                  MoveFrom(sEntry& other);
+
+        uint32_t        m_hash         = 0;
+        uint32_t        m_keyLength    = 0;
+        eValueKind      m_kind         = eValueKind::NONE;
+        bool            m_isKeyHeap    = false;
+        mutable bool    m_didCacheFail = false;        // The text did not parse as m_cacheType
+        TypeTag         m_type         = nullptr;      // TRIVIAL only
+        mutable TypeTag m_cacheType    = nullptr;      // Type of the parsed text in m_cache
+        alignas(8) unsigned char         m_bytes[VALUE_BYTES] = {};
+        alignas(8) mutable unsigned char m_cache[CACHE_BYTES] = {};
+        union
+        {
+            char  m_inlineKey[KEY_INLINE_CHARS] = {};
+            char* m_heapKey;
+        };
+    };
+
+    sEntry*       GetEntries();
+    sEntry const* GetEntries() const;
+    sEntry const* FindEntry(HashedName const& key) const;
+    sEntry&       FindOrAddEntry(HashedName const& key);
+    void          SetTrivial(HashedName const& key, TypeTag type, void const* value, size_t size);
+    void          SetText(HashedName const& key, char const* text, size_t length);
+
+    template <typename T>
+    bool ReadConverted(sEntry const& entry, TypeTag type, T& outValue) const;
+
+    sEntry              m_inline[INLINE_CAPACITY];
+    std::vector<sEntry> m_spill;                // Holds every entry once the count passes INLINE_CAPACITY
+    int                 m_count = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+FlatProperties::TypeTag FlatProperties::GetTypeTag()
+{
+    static char const s_tag = 0;
+    return &s_tag;
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+void FlatProperties::SetValue(HashedName const& key, T const& value)
+{
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= VALUE_BYTES, "FlatProperties stores trivially copyable values of up to 32 bytes");
+    SetTrivial(key, GetTypeTag<T>(), &value, sizeof(T));
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+T FlatProperties::GetValue(HashedName const& key, T const& defaultValue) const
+{
+    sEntry const* entry = FindEntry(key);
+    if (entry == nullptr) return defaultValue;
+
+    T value = defaultValue;
+
+    if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= VALUE_BYTES)
+    {
+        if (entry->m_kind == eValueKind::TRIVIAL && entry->m_type == GetTypeTag<T>())
+        {
+            std::memcpy(&value, entry->m_bytes, sizeof(T));
+            return value;
+        }
+    }
+
+    return ReadConverted(*entry, GetTypeTag<T>(), value) ? value : defaultValue;
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+bool FlatProperties::ReadConverted(sEntry const& entry, TypeTag const type, T& outValue) const
+{
+    if (entry.m_kind != eValueKind::TEXT_INLINE && entry.m_kind != eValueKind::TEXT_HEAP) return false;
+
+    if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= CACHE_BYTES)
+    {
+        if (entry.m_cacheType == type)
+        {
+            if (entry.m_didCacheFail) return false;
+            std::memcpy(&outValue, entry.m_cache, sizeof(T));
+            return true;
+        }
+
+        T          parsed   = outValue;
+        bool const didParse = ParsePropertyText(entry.GetText(), parsed);
+
+        entry.m_cacheType    = type;
+        entry.m_didCacheFail = !didParse;
+        if (didParse) std::memcpy(entry.m_cache, &parsed, sizeof(T));
+        if (didParse) outValue = parsed;
+
+        return didParse;
+    }
+    else
+    {
+        return ParsePropertyText(entry.GetText(), outValue);
+    }
+}
@@ -0,0 +1,460 @@
+//----------------------------------------------------------------------------------------------------
+// FontGlyphTable.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FontGlyphTable.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/AssetPack.hpp"
+#include "Game/Framework/GlyphWidthScan.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    uint32_t constexpr BLOB_MAGIC   = 0x54474644;     // "DFGT"
+    uint32_t constexpr BLOB_VERSION = 1;
+
+    //------------------------------------------------------------------------------------------------
+    // Value of key=... on a .fnt line, or fallback; quoted values are not needed for the tables
+    //
+    int GetFntValue(String const& line, char const* key, int const fallback)
+    {
+        size_t const keyLength = std::strlen(key);
+        size_t       position  = 0;
+
+        while ((position = line.find(key, position)) != String::npos)
+        {
+            bool const isWordStart = position == 0 || line[position - 1] == ' ';
+
+            if (isWordStart && position + keyLength < line.size() && line[position + keyLength] == '=')
+            {
+                return std::atoi(line.c_str() + position + keyLength + 1);
+            }
+
+            position += keyLength;
+        }
+
+        return fallback;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    bool StartsWith(String const& line, char const* prefix)
+    {
+        return line.compare(0, std::strlen(prefix), prefix) == 0;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Load glyph and kerning tables for fntPath, from the binary blob when it is current.
+bool FontGlyphTable::Load(String const& fntPath)
+{
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    // Size and time of the packed copy when g_assetPack has one, so the blob follows the pack
+    sAssetFileInfo source;
+    if (!StatAssetFile(fntPath, source)) return false;
+
+    uint64_t const sourceSize = source.m_size;
+    int64_t const  sourceTime = source.m_writeTime;
+    String const   blobPath   = fntPath + ".glyphs";
+
+    m_stats                     = sFontGlyphTableStats();
+    m_stats.m_wasLoadedFromBlob = ReadBlob(blobPath, sourceSize, sourceTime);
+
+    if (!m_stats.m_wasLoadedFromBlob)
+    {
+        sAssetFileData file;
+        if (!ReadAssetFile(fntPath, file)) return false;
+
+        if (!ParseFnt(String(file.GetText()))) return false;
+
+        WriteBlob(blobPath, sourceSize, sourceTime);
+    }
+
+    m_stats.m_loadSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool FontGlyphTable::IsLoaded() const
+{
+    return m_lineHeight > 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+sGlyphMetrics const* FontGlyphTable::FindGlyph(uint32_t const codepoint) const
+{
+    if (codepoint < 256)
+    {
+        sGlyphMetrics const& glyph = m_flatGlyphs[codepoint];
+        return glyph.m_isPresent != 0 ? &glyph : nullptr;
+    }
+
+    auto const found = std::lower_bound(m_sparseCodepoints.begin(), m_sparseCodepoints.end(), codepoint);
+
+    if (found == m_sparseCodepoints.end() || *found != codepoint) return nullptr;
+
+    return &m_sparseGlyphs[static_cast<size_t>(found - m_sparseCodepoints.begin())];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return Kerning in font pixels between first and second, 0 when the pair has none.
+int FontGlyphTable::GetKerning(uint32_t const first, uint32_t const second) const
+{
+    if (m_kerningKeys.empty()) return 0;
+
+    // Keys are stored +1 in the high word so a (0, 0) pair can never look like an empty slot
+    uint64_t const key  = (static_cast<uint64_t>(first + 1) << 32) | second;
+    uint32_t const mask = static_cast<uint32_t>(m_kerningKeys.size()) - 1;
+
+    for (uint32_t slot = HashPair(key) & mask;; slot = (slot + 1) & mask)
+    {
+        uint64_t const slotKey = m_kerningKeys[slot];
+
+        if (slotKey == key) return m_kerningAmounts[slot];
+        if (slotKey == 0) return 0;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+float FontGlyphTable::GetTextWidth(float const cellHeight, String const& text, float const cellAspect) const
+{
+    if (!IsLoaded()) return 0.f;
+
+    float const scale    = cellHeight / static_cast<float>(m_lineHeight);
+    int         advance  = 0;
+    uint32_t    previous = 0;
+
+    for (size_t index = 0; index < text.size(); ++index)
+    {
+        uint32_t const       codepoint = static_cast<unsigned char>(text[index]);
+        sGlyphMetrics const* glyph     = FindGlyph(codepoint);
+        if (glyph == nullptr) continue;
+
+        if (index > 0) advance += GetKerning(previous, codepoint);
+
+        advance  += glyph->m_advance;
+        previous = codepoint;
+    }
+
+    return static_cast<float>(advance) * scale * cellAspect;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FontGlyphTable::AddVertsForText2D(VertexList_PCU& verts, String const& text, Vec2 const& textMins, float const cellHeight, Rgba8 const& tint, float const cellAspect) const
+{
+    if (!IsLoaded() || text.empty()) return;
+
+    float const scaleY   = cellHeight / static_cast<float>(m_lineHeight);
+    float const scaleX   = scaleY * cellAspect;
+    float const topY     = textMins.y + cellHeight;
+    float       cursorX  = textMins.x;
+    uint32_t    previous = 0;
+
+    size_t const firstVertex = verts.size();
+    verts.resize(firstVertex + text.size() * 6);
+
+    Vertex_PCU* out = verts.data() + firstVertex;
+
+    for (size_t index = 0; index < text.size(); ++index)
+    {
+        uint32_t const       codepoint = static_cast<unsigned char>(text[index]);
+        sGlyphMetrics const* glyph     = FindGlyph(codepoint);
+        if (glyph == nullptr) continue;
+
+        if (index > 0) cursorX += static_cast<float>(GetKerning(previous, codepoint)) * scaleX;
+
+        float const minX = cursorX + static_cast<float>(glyph->m_offsetX) * scaleX;
+        float const maxY = topY - static_cast<float>(glyph->m_offsetY) * scaleY;
+        float const maxX = minX + static_cast<float>(glyph->m_width) * scaleX;
+        float const minY = maxY - static_cast<float>(glyph->m_height) * scaleY;
+
+        *out++ = Vertex_PCU(Vec3(minX, minY, 0.f), tint, Vec2(glyph->m_uvMinsX, glyph->m_uvMinsY));
+        *out++ = Vertex_PCU(Vec3(maxX, minY, 0.f), tint, Vec2(glyph->m_uvMaxsX, glyph->m_uvMinsY));
+        *out++ = Vertex_PCU(Vec3(maxX, maxY, 0.f), tint, Vec2(glyph->m_uvMaxsX, glyph->m_uvMaxsY));
+        *out++ = Vertex_PCU(Vec3(minX, minY, 0.f), tint, Vec2(glyph->m_uvMinsX, glyph->m_uvMinsY));
+        *out++ = Vertex_PCU(Vec3(maxX, maxY, 0.f), tint, Vec2(glyph->m_uvMaxsX, glyph->m_uvMaxsY));
+        *out++ = Vertex_PCU(Vec3(minX, maxY, 0.f), tint, Vec2(glyph->m_uvMinsX, glyph->m_uvMaxsY));
+
+        cursorX  += static_cast<float>(glyph->m_advance) * scaleX;
+        previous = codepoint;
+    }
+
+    // Characters the font has no glyph for emitted nothing
+    verts.resize(static_cast<size_t>(out - verts.data()));
+}
+
+//----------------------------------------------------------------------------------------------------
+sFontGlyphTableStats const& FontGlyphTable::GetStats() const
+{
+    return m_stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Cell i of the grid (row-major from the top-left) becomes codepoint i. Empty cells keep a half-cell
+/// advance so spaces still separate words; there is no kerning.
+void FontGlyphTable::BuildFromColumnExtents(IntVec2 const& atlasDimensions, IntVec2 const& cellCounts, std::vector<sGlyphColumnExtents> const& extents)
+{
+    Reset();
+    m_stats = sFontGlyphTableStats();
+
+    if (cellCounts.x <= 0 || cellCounts.y <= 0) return;
+
+    int const   cellWidth     = atlasDimensions.x / cellCounts.x;
+    int const   cellHeight    = atlasDimensions.y / cellCounts.y;
+    float const textureWidth  = static_cast<float>(atlasDimensions.x);
+    float const textureHeight = static_cast<float>(atlasDimensions.y);
+
+    if (cellWidth <= 0 || cellHeight <= 0) return;
+
+    m_lineHeight = cellHeight;
+    m_base       = cellHeight;
+
+    int const cellCount = static_cast<int>(extents.size()) < cellCounts.x * cellCounts.y ? static_cast<int>(extents.size()) : cellCounts.x * cellCounts.y;
+
+    for (int cellIndex = 0; cellIndex < cellCount; ++cellIndex)
+    {
+        sGlyphColumnExtents const& cell    = extents[static_cast<size_t>(cellIndex)];
+        bool const                 isEmpty = cell.m_firstColumn < 0;
+        int const                  x       = (cellIndex % cellCounts.x) * cellWidth + (isEmpty ? 0 : cell.m_firstColumn);
+        int const                  y       = (cellIndex / cellCounts.x) * cellHeight;
+        int const                  width   = isEmpty ? 0 : cell.m_lastColumn - cell.m_firstColumn + 1;
+
+        sGlyphMetrics glyph;
+        glyph.m_uvMinsX   = static_cast<float>(x) / textureWidth;
+        glyph.m_uvMaxsX   = static_cast<float>(x + width) / textureWidth;
+        glyph.m_uvMinsY   = 1.f - static_cast<float>(y + cellHeight) / textureHeight;
+        glyph.m_uvMaxsY   = 1.f - static_cast<float>(y) / textureHeight;
+        glyph.m_width     = static_cast<int16_t>(width);
+        glyph.m_height    = static_cast<int16_t>(cellHeight);
+        glyph.m_advance   = static_cast<int16_t>(isEmpty ? cellWidth / 2 : width + 1);
+        glyph.m_isPresent = 1;
+
+        SetGlyph(static_cast<uint32_t>(cellIndex), glyph);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void FontGlyphTable::Reset()
+{
+    std::fill(std::begin(m_flatGlyphs), std::end(m_flatGlyphs), sGlyphMetrics());
+    m_lineHeight = 0;
+    m_base       = 0;
+    m_sparseCodepoints.clear();
+    m_sparseGlyphs.clear();
+    m_kerningKeys.clear();
+    m_kerningAmounts.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool FontGlyphTable::ParseFnt(String const& text)
+{
+    Reset();
+
+    std::vector<uint64_t> kerningKeys;
+    std::vector<int16_t>  kerningAmounts;
+    float                 textureWidth  = 1.f;
+    float                 textureHeight = 1.f;
+
+    std::istringstream stream(text);
+    String             line;
+
+    while (std::getline(stream, line))
+    {
+        if (StartsWith(line, "common "))
+        {
+            m_lineHeight  = GetFntValue(line, "lineHeight", 0);
+            m_base        = GetFntValue(line, "base", 0);
+            textureWidth  = static_cast<float>(GetFntValue(line, "scaleW", 1));
+            textureHeight = static_cast<float>(GetFntValue(line, "scaleH", 1));
+        }
+        else if (StartsWith(line, "char "))
+        {
+            int const x      = GetFntValue(line, "x", 0);
+            int const y      = GetFntValue(line, "y", 0);
+            int const width  = GetFntValue(line, "width", 0);
+            int const height = GetFntValue(line, "height", 0);
+
+            sGlyphMetrics glyph;
+            glyph.m_uvMinsX   = static_cast<float>(x) / textureWidth;
+            glyph.m_uvMaxsX   = static_cast<float>(x + width) / textureWidth;
+            glyph.m_uvMinsY   = 1.f - static_cast<float>(y + height) / textureHeight;
+            glyph.m_uvMaxsY   = 1.f - static_cast<float>(y) / textureHeight;
+            glyph.m_offsetX   = static_cast<int16_t>(GetFntValue(line, "xoffset", 0));
+            glyph.m_offsetY   = static_cast<int16_t>(GetFntValue(line, "yoffset", 0));
+            glyph.m_width     = static_cast<int16_t>(width);
+            glyph.m_height    = static_cast<int16_t>(height);
+            glyph.m_advance   = static_cast<int16_t>(GetFntValue(line, "xadvance", 0));
+            glyph.m_isPresent = 1;
+
+            SetGlyph(static_cast<uint32_t>(GetFntValue(line, "id", 0)), glyph);
+        }
+        else if (StartsWith(line, "kerning "))
+        {
+            uint32_t const first  = static_cast<uint32_t>(GetFntValue(line, "first", 0));
+            uint32_t const second = static_cast<uint32_t>(GetFntValue(line, "second", 0));
+
+            kerningKeys.push_back((static_cast<uint64_t>(first + 1) << 32) | second);
+            kerningAmounts.push_back(static_cast<int16_t>(GetFntValue(line, "amount", 0)));
+        }
+    }
+
+    BuildKerningTable(kerningKeys, kerningAmounts);
+
+    m_stats.m_kerningCount = static_cast<int>(kerningKeys.size());
+
+    return m_lineHeight > 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FontGlyphTable::SetGlyph(uint32_t const codepoint, sGlyphMetrics const& glyph)
+{
+    ++m_stats.m_glyphCount;
+
+    if (codepoint < 256)
+    {
+        m_flatGlyphs[codepoint] = glyph;
+        return;
+    }
+
+    auto const   found = std::lower_bound(m_sparseCodepoints.begin(), m_sparseCodepoints.end(), codepoint);
+    size_t const index = static_cast<size_t>(found - m_sparseCodepoints.begin());
+
+    if (found != m_sparseCodepoints.end() && *found == codepoint)
+    {
+        m_sparseGlyphs[index] = glyph;
+        --m_stats.m_glyphCount;
+        return;
+    }
+
+    m_sparseCodepoints.insert(found, codepoint);
+    m_sparseGlyphs.insert(m_sparseGlyphs.begin() + static_cast<std::ptrdiff_t>(index), glyph);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Open addressing with linear probing, at most half full so probe runs stay short.
+void FontGlyphTable::BuildKerningTable(std::vector<uint64_t> const& keys, std::vector<int16_t> const& amounts)
+{
+    m_kerningKeys.clear();
+    m_kerningAmounts.clear();
+
+    if (keys.empty()) return;
+
+    size_t slotCount = 16;
+    while (slotCount < keys.size() * 2) slotCount *= 2;
+
+    m_kerningKeys.assign(slotCount, 0);
+    m_kerningAmounts.assign(slotCount, 0);
+
+    uint32_t const mask = static_cast<uint32_t>(slotCount) - 1;
+
+    for (size_t index = 0; index < keys.size(); ++index)
+    {
+        uint32_t slot = HashPair(keys[index]) & mask;
+
+        while (m_kerningKeys[slot] != 0 && m_kerningKeys[slot] != keys[index])
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        m_kerningKeys[slot]    = keys[index];
+        m_kerningAmounts[slot] = amounts[index];
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool FontGlyphTable::ReadBlob(String const& blobPath, uint64_t const sourceSize, int64_t const sourceTime)
+{
+    std::ifstream file(blobPath, std::ios::in | std::ios::binary);
+    if (!file.is_open()) return false;
+
+    sBlobHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!file || header.m_magic != BLOB_MAGIC || header.m_version != BLOB_VERSION ||
+        header.m_sourceSize != sourceSize || header.m_sourceTime != sourceTime ||
+        header.m_lineHeight <= 0 || (header.m_kerningSlots & (header.m_kerningSlots - 1)) != 0)
+    {
+        return false;
+    }
+
+    m_sparseCodepoints.resize(header.m_sparseCount);
+    m_sparseGlyphs.resize(header.m_sparseCount);
+    m_kerningKeys.resize(header.m_kerningSlots);
+    m_kerningAmounts.resize(header.m_kerningSlots);
+
+    file.read(reinterpret_cast<char*>(m_flatGlyphs), sizeof(m_flatGlyphs));
+    file.read(reinterpret_cast<char*>(m_sparseCodepoints.data()), static_cast<std::streamsize>(m_sparseCodepoints.size() * sizeof(uint32_t)));
+    file.read(reinterpret_cast<char*>(m_sparseGlyphs.data()), static_cast<std::streamsize>(m_sparseGlyphs.size() * sizeof(sGlyphMetrics)));
+    file.read(reinterpret_cast<char*>(m_kerningKeys.data()), static_cast<std::streamsize>(m_kerningKeys.size() * sizeof(uint64_t)));
+    file.read(reinterpret_cast<char*>(m_kerningAmounts.data()), static_cast<std::streamsize>(m_kerningAmounts.size() * sizeof(int16_t)));
+
+    if (!file)
+    {
+        m_lineHeight = 0;
+        return false;
+    }
+
+    m_lineHeight = header.m_lineHeight;
+    m_base       = header.m_base;
+
+    for (sGlyphMetrics const& glyph : m_flatGlyphs)
+    {
+        m_stats.m_glyphCount += glyph.m_isPresent != 0 ? 1 : 0;
+    }
+
+    m_stats.m_glyphCount += static_cast<int>(m_sparseGlyphs.size());
+    m_stats.m_kerningCount = static_cast<int>(std::count_if(m_kerningKeys.begin(), m_kerningKeys.end(), [](uint64_t const key) { return key != 0; }));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Best effort: a read-only data folder just means every start parses the .fnt again.
+void FontGlyphTable::WriteBlob(String const& blobPath, uint64_t const sourceSize, int64_t const sourceTime) const
+{
+    std::ofstream file(blobPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return;
+
+    sBlobHeader header;
+    header.m_magic        = BLOB_MAGIC;
+    header.m_version      = BLOB_VERSION;
+    header.m_sourceSize   = sourceSize;
+    header.m_sourceTime   = sourceTime;
+    header.m_lineHeight   = m_lineHeight;
+    header.m_base         = m_base;
+    header.m_sparseCount  = static_cast<uint32_t>(m_sparseCodepoints.size());
+    header.m_kerningSlots = static_cast<uint32_t>(m_kerningKeys.size());
+
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.write(reinterpret_cast<char const*>(m_flatGlyphs), sizeof(m_flatGlyphs));
+    file.write(reinterpret_cast<char const*>(m_sparseCodepoints.data()), static_cast<std::streamsize>(m_sparseCodepoints.size() * sizeof(uint32_t)));
+    file.write(reinterpret_cast<char const*>(m_sparseGlyphs.data()), static_cast<std::streamsize>(m_sparseGlyphs.size() * sizeof(sGlyphMetrics)));
+    file.write(reinterpret_cast<char const*>(m_kerningKeys.data()), static_cast<std::streamsize>(m_kerningKeys.size() * sizeof(uint64_t)));
+    file.write(reinterpret_cast<char const*>(m_kerningAmounts.data()), static_cast<std::streamsize>(m_kerningAmounts.size() * sizeof(int16_t)));
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC uint32_t FontGlyphTable::HashPair(uint64_t key)
+{
+    // 64-bit finalizer (MurmurHash3 fmix64)
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+
+    return static_cast<uint32_t>(key);
+}
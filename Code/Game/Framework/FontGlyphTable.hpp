@@ -0,0 +1,110 @@
+//----------------------------------------------------------------------------------------------------
+// FontGlyphTable.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Renderer/Vertex_PCU.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct sGlyphColumnExtents;
+
+//----------------------------------------------------------------------------------------------------
+// One glyph, 32 bytes so two share a cache line. Pixel metrics are BMFont's, y measured down from
+// the top of the line; UVs are already normalized and flipped for a bottom-left texture origin.
+//
+struct alignas(32) sGlyphMetrics
+{
+    float   m_uvMinsX   = 0.f;
+    float   m_uvMinsY   = 0.f;
+    float   m_uvMaxsX   = 0.f;
+    float   m_uvMaxsY   = 0.f;
+    int16_t m_offsetX   = 0;
+    int16_t m_offsetY   = 0;
+    int16_t m_width     = 0;
+    int16_t m_height    = 0;
+    int16_t m_advance   = 0;
+    int16_t m_isPresent = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sFontGlyphTableStats
+{
+    bool   m_wasLoadedFromBlob = false;
+    double m_loadSeconds       = 0.0;
+    int    m_glyphCount        = 0;
+    int    m_kerningCount      = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Glyph and kerning lookup for a BMFont (.fnt) font, laid out for per-character speed.
+//
+// Codepoints 0-255 (ASCII and Latin-1, everything a std::string byte can name) index a flat array;
+// anything above goes to a sorted sparse array. Kerning pairs live in an open-addressed table keyed
+// by (first << 32 | second), so a lookup is one hash and usually one probe.
+//
+// Load() keeps a binary copy of the parsed tables next to the .fnt ("<name>.fnt.glyphs"), stamped
+// with the .fnt's size and modification time; later loads read that instead of parsing text. A stale
+// or unreadable blob is simply rebuilt.
+//
+// BuildFromColumnExtents() fills the table for a fixed-grid atlas instead (one cell per codepoint,
+// as GlyphWidthScan reports them), giving each glyph its inked width plus a one-column gap.
+//
+// AddVertsForText2D() follows the BMFont layout rules (cell height = lineHeight, kerning before
+// the advance) and only writes VertexList_PCU. g_textCache lays out the PCU text of the fonts the App
+// loads tables for through it, and BenchText compares it against BitmapFont.
+//
+class FontGlyphTable
+{
+public:
+    bool Load(String const& fntPath);
+    void BuildFromColumnExtents(IntVec2 const& atlasDimensions, IntVec2 const& cellCounts, std::vector<sGlyphColumnExtents> const& extents);
+    bool IsLoaded() const;
+
+    sGlyphMetrics const* FindGlyph(uint32_t codepoint) const;
+    int                  GetKerning(uint32_t first, uint32_t second) const;
+
+    float GetTextWidth(float cellHeight, String const& text, float cellAspect = 1.f) const;
+    void  AddVertsForText2D(VertexList_PCU& verts, String const& text, Vec2 const& textMins, float cellHeight, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f) const;
+
+    sFontGlyphTableStats const& GetStats() const;
+
+private:
+    struct sBlobHeader
+    {
+        uint32_t m_magic        = 0;
+        uint32_t m_version      = 0;
+        uint64_t m_sourceSize   = 0;
+        int64_t  m_sourceTime   = 0;
+        int32_t  m_lineHeight   = 0;
+        int32_t  m_base         = 0;
+        uint32_t m_sparseCount  = 0;
+        uint32_t m_kerningSlots = 0;
+    };
+
+    void Reset();
+    bool ParseFnt(String const& text);
+    bool ReadBlob(String const& blobPath, uint64_t sourceSize, int64_t sourceTime);
+    void WriteBlob(String const& blobPath, uint64_t sourceSize, int64_t sourceTime) const;
+    void SetGlyph(uint32_t codepoint, sGlyphMetrics const& glyph);
+    void BuildKerningTable(std::vector<uint64_t> const& keys, std::vector<int16_t> const& amounts);
+
+    static uint32_t HashPair(uint64_t key);
+
+    sGlyphMetrics              m_flatGlyphs[256];
+    std::vector<uint32_t>      m_sparseCodepoints;      // Sorted; parallel to m_sparseGlyphs
+    std::vector<sGlyphMetrics> m_sparseGlyphs;
+    std::vector<uint64_t>      m_kerningKeys;           // Power-of-two slots; 0 marks an empty slot
+    std::vector<int16_t>       m_kerningAmounts;
+    int                        m_lineHeight = 0;
+    int                        m_base       = 0;
+    sFontGlyphTableStats       m_stats;
+};
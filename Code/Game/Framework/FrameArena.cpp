@@ -0,0 +1,272 @@
+//----------------------------------------------------------------------------------------------------
+// FrameArena.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FrameArena.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+//----------------------------------------------------------------------------------------------------
+// Process-wide allocation counting. Replacing the global operator new is the only hook that also sees
+// the Engine's allocations; the array and nothrow forms forward to these two by default. Types aligned
+// past __STDCPP_DEFAULT_NEW_ALIGNMENT__ take the align_val_t form, which the CRT cannot serve with
+// malloc, so that one pairs _aligned_malloc with its own deletes.
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    std::atomic<uint64_t> s_heapAllocationCount{0};
+}
+
+//----------------------------------------------------------------------------------------------------
+void* operator new(size_t const size)
+{
+    s_heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* const memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc();
+}
+
+//----------------------------------------------------------------------------------------------------
+void operator delete(void* const memory) noexcept
+{
+    std::free(memory);
+}
+
+//----------------------------------------------------------------------------------------------------
+void operator delete(void* const memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+//----------------------------------------------------------------------------------------------------
+void* operator new(size_t const size, std::align_val_t const alignment)
+{
+    s_heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* const memory = _aligned_malloc(size == 0 ? 1 : size, static_cast<size_t>(alignment)))
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc();
+}
+
+//----------------------------------------------------------------------------------------------------
+void operator delete(void* const memory, std::align_val_t) noexcept
+{
+    _aligned_free(memory);
+}
+
+//----------------------------------------------------------------------------------------------------
+void operator delete(void* const memory, size_t, std::align_val_t) noexcept
+{
+    _aligned_free(memory);
+}
+
+//----------------------------------------------------------------------------------------------------
+FrameArena::FrameArena(sFrameArenaConfig const& config)
+{
+    AddBlock(static_cast<size_t>(config.m_blockKiB > 0 ? config.m_blockKiB : 1) * 1024);
+
+    m_frameStartCount = GetHeapAllocationCount();
+}
+
+//----------------------------------------------------------------------------------------------------
+FrameArena::~FrameArena()
+{
+    for (sBlock const& block : m_blocks)
+    {
+        ::operator delete(block.m_memory);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// alignment must be a power of two. Blocks come from operator new, aligned only to 16 bytes, so the
+/// padding is worked out from the address, in a new block as in the current one.
+void* FrameArena::Allocate(size_t const bytes, size_t const alignment)
+{
+    auto const alignedOffset = [alignment](sBlock const& block, size_t const offset)
+    {
+        uintptr_t const address = reinterpret_cast<uintptr_t>(block.m_memory) + offset;
+
+        return offset + (((address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1)) - address);
+    };
+
+    sBlock const* block   = &m_blocks.back();
+    size_t        aligned = alignedOffset(*block, m_offset);
+
+    if (aligned + bytes > block->m_size)
+    {
+        AddBlock(bytes + alignment);
+        block   = &m_blocks.back();
+        aligned = alignedOffset(*block, 0);
+    }
+
+    void* const memory = block->m_memory + aligned;
+
+    m_usedBytes += aligned + bytes - m_offset;
+    m_offset    = aligned + bytes;
+
+    return memory;
+}
+
+//----------------------------------------------------------------------------------------------------
+VertexList_PCU& FrameArena::AcquireVertsPCU()
+{
+    if (m_pcuListsInUse == m_pcuLists.size())
+    {
+        m_pcuLists.emplace_back();
+    }
+
+    VertexList_PCU& verts = m_pcuLists[m_pcuListsInUse++];
+    verts.clear();
+
+    return verts;
+}
+
+//----------------------------------------------------------------------------------------------------
+VertexList_Font& FrameArena::AcquireVertsFont()
+{
+    if (m_fontListsInUse == m_fontLists.size())
+    {
+        m_fontLists.emplace_back();
+    }
+
+    VertexList_Font& verts = m_fontLists[m_fontListsInUse++];
+    verts.clear();
+
+    return verts;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// End of frame: free everything at once and record this frame's heap allocation count.
+void FrameArena::Reset()
+{
+    if (m_usedBytes > m_peakBytes)
+    {
+        m_peakBytes = m_usedBytes;
+    }
+
+    // The frame overflowed into extra blocks: fold them into one block big enough for the peak
+    if (m_blocks.size() > 1)
+    {
+        size_t const peakBytes = m_peakBytes;
+
+        for (sBlock const& block : m_blocks)
+        {
+            ::operator delete(block.m_memory);
+        }
+
+        m_blocks.clear();
+        AddBlock(peakBytes + peakBytes / 4);
+    }
+
+    m_offset         = 0;
+    m_usedBytes      = 0;
+    m_pcuListsInUse  = 0;
+    m_fontListsInUse = 0;
+
+    uint64_t const count = GetHeapAllocationCount();
+    m_lastFrameCount     = count - m_frameStartCount;
+
+    if (m_checkFramesLeft > 0)
+    {
+        ++m_check.m_frameCount;
+        m_check.m_totalAllocations += m_lastFrameCount;
+
+        if (m_lastFrameCount > 0) ++m_check.m_allocatingFrames;
+        if (m_lastFrameCount > m_check.m_maxFrameAllocations) m_check.m_maxFrameAllocations = m_lastFrameCount;
+
+        if (--m_checkFramesLeft == 0) m_isCheckDone = true;
+    }
+
+    // Read again so the folding above is charged to this frame, not the next
+    m_frameStartCount = GetHeapAllocationCount();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Record heap allocations over the next frameCount frames; the result is available from
+/// ConsumeCheckResult() once they have all ended.
+void FrameArena::CheckAllocations(int const frameCount)
+{
+    m_check           = sFrameArenaCheck();
+    m_checkFramesLeft = frameCount > 0 ? frameCount : 1;
+    m_isCheckDone     = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool FrameArena::ConsumeCheckResult(sFrameArenaCheck& outResult)
+{
+    if (!m_isCheckDone) return false;
+
+    outResult     = m_check;
+    m_isCheckDone = false;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t FrameArena::GetUsedBytes() const
+{
+    return m_usedBytes;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t FrameArena::GetCapacityBytes() const
+{
+    size_t capacity = 0;
+
+    for (sBlock const& block : m_blocks)
+    {
+        capacity += block.m_size;
+    }
+
+    return capacity;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t FrameArena::GetPeakBytes() const
+{
+    return m_peakBytes;
+}
+
+//----------------------------------------------------------------------------------------------------
+int FrameArena::GetListCount() const
+{
+    return static_cast<int>(m_pcuLists.size() + m_fontLists.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t FrameArena::GetLastFrameHeapAllocations() const
+{
+    return m_lastFrameCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC uint64_t FrameArena::GetHeapAllocationCount()
+{
+    return s_heapAllocationCount.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+void FrameArena::AddBlock(size_t const minimumBytes)
+{
+    size_t const previousSize = m_blocks.empty() ? 0 : m_blocks.back().m_size;
+    size_t const size         = minimumBytes > previousSize * 2 ? minimumBytes : previousSize * 2;
+
+    m_blocks.push_back({ static_cast<unsigned char*>(::operator new(size)), size });
+    m_offset = 0;
+}
@@ -0,0 +1,113 @@
+//----------------------------------------------------------------------------------------------------
+// FrameArena.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/Vertex_Font.hpp"
+#include "Engine/Renderer/Vertex_PCU.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <type_traits>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Loaded from the <FrameArena> element of Data/GameConfig.xml.
+//
+struct sFrameArenaConfig
+{
+    int m_blockKiB = 256;       // Size of the first block; the arena grows to the peak frame and then stays put
+};
+
+//----------------------------------------------------------------------------------------------------
+// Result of a CheckAllocations(frames) run.
+//
+struct sFrameArenaCheck
+{
+    int      m_frameCount          = 0;
+    int      m_allocatingFrames    = 0;     // Frames that made at least one heap allocation
+    uint64_t m_totalAllocations    = 0;
+    uint64_t m_maxFrameAllocations = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Per-frame scratch memory, released all at once by Reset() in App::EndFrame.
+//
+// Allocate()/AllocateArray() bump a pointer through one block. When a frame needs more, extra
+// blocks are chained for that frame and Reset() replaces them with a single block of the peak size,
+// so after the first few frames no call reaches the heap.
+//
+// The Engine's AddVertsFor* and BitmapFont::AddVertsForText2D take std::vector lists, which cannot
+// use a custom allocator. AcquireVertsPCU()/AcquireVertsFont() therefore hand out lists from a
+// frame-scoped pool instead: each comes back empty but keeps the capacity it grew to, so a steady
+// frame that builds the same geometry never reallocates. Everything acquired is invalid after Reset().
+//
+// GetHeapAllocationCount() counts every operator new in the process (Engine included); the arena
+// records the count per frame and CheckAllocations() reports on the next N frames.
+//
+class FrameArena
+{
+public:
+    explicit FrameArena(sFrameArenaConfig const& config);
+    ~FrameArena();
+
+    FrameArena(FrameArena const&)            = delete;
+    FrameArena& operator=(FrameArena const&) = delete;
+
+    void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    template <typename T>
+    T* AllocateArray(int count);
+
+    VertexList_PCU&  AcquireVertsPCU();
+    VertexList_Font& AcquireVertsFont();
+
+    void Reset();
+
+    void CheckAllocations(int frameCount);
+    bool ConsumeCheckResult(sFrameArenaCheck& outResult);
+
+    size_t   GetUsedBytes() const;
+    size_t   GetCapacityBytes() const;
+    size_t   GetPeakBytes() const;
+    int      GetListCount() const;
+    uint64_t GetLastFrameHeapAllocations() const;
+
+    static uint64_t GetHeapAllocationCount();
+
+private:
+    struct sBlock
+    {
+        unsigned char* m_memory = nullptr;
+        size_t         m_size   = 0;
+    };
+
+    void AddBlock(size_t minimumBytes);
+
+    std::vector<sBlock>         m_blocks;
+    size_t                      m_offset          = 0;     // Into m_blocks.back()
+    size_t                      m_usedBytes       = 0;     // This frame, across all blocks
+    size_t                      m_peakBytes       = 0;
+    std::deque<VertexList_PCU>  m_pcuLists;                // deque: acquired references stay valid as the pool grows
+    std::deque<VertexList_Font> m_fontLists;
+    size_t                      m_pcuListsInUse   = 0;
+    size_t                      m_fontListsInUse  = 0;
+    uint64_t                    m_frameStartCount = 0;
+    uint64_t                    m_lastFrameCount  = 0;
+    int                         m_checkFramesLeft = 0;
+    bool                        m_isCheckDone     = false;
+    sFrameArenaCheck            m_check;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Uninitialized storage; T must be trivially destructible, nothing is destroyed on Reset().
+template <typename T>
+T* FrameArena::AllocateArray(int const count)
+{
+    static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+
+    return static_cast<T*>(Allocate(sizeof(T) * static_cast<size_t>(count), alignof(T)));
+}
@@ -0,0 +1,190 @@
+//----------------------------------------------------------------------------------------------------
+// FramePacer.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FramePacer.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Time.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cmath>
+//----------------------------------------------------------------------------------------------------
+#define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
+#include <windows.h>			// #include this (massive, platform-specific) header in VERY few places (and .CPPs only)
+#include <timeapi.h>
+
+//----------------------------------------------------------------------------------------------------
+FramePacer::FramePacer(sFramePacingConfig const& config)
+    : m_config(config)
+{
+    // Default scheduler granularity is ~15.6 ms; ask for 1 ms so the coarse sleep is usable (winmm.lib)
+    timeBeginPeriod(1);
+
+    m_frameStartSeconds = GetCurrentTimeSeconds();
+}
+
+//----------------------------------------------------------------------------------------------------
+FramePacer::~FramePacer()
+{
+    timeEndPeriod(1);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Block until the current frame has used its budget, then start timing the next frame.
+/// @param doesWindowHaveFocus false switches to the m_unfocusedHz idle throttle.
+void FramePacer::WaitForNextFrame(bool const doesWindowHaveFocus)
+{
+    float targetHz = m_config.m_targetHz;
+
+    if (!doesWindowHaveFocus && m_config.m_unfocusedHz > 0.f)
+    {
+        targetHz = m_config.m_unfocusedHz;
+    }
+
+    double const nowSeconds = GetCurrentTimeSeconds();
+
+    if (targetHz <= 0.f)
+    {
+        RecordFrame(nowSeconds - m_frameStartSeconds);
+        m_frameStartSeconds = nowSeconds;
+        return;
+    }
+
+    double const periodSeconds   = 1.0 / static_cast<double>(targetHz);
+    double const deadlineSeconds = m_frameStartSeconds + periodSeconds;
+
+    SleepUntil(deadlineSeconds);
+
+    double const endSeconds = GetCurrentTimeSeconds();
+    RecordFrame(endSeconds - m_frameStartSeconds);
+
+    // Advance the schedule by whole periods to avoid drift, but resync after a long hitch (or a focus
+    // change to a lower rate) instead of running a burst of catch-up frames.
+    m_frameStartSeconds = (endSeconds - deadlineSeconds < periodSeconds) ? deadlineSeconds : endSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+sFramePacingConfig const& FramePacer::GetConfig() const
+{
+    return m_config;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FramePacer::SetConfig(sFramePacingConfig const& config)
+{
+    m_config = config;
+}
+
+//----------------------------------------------------------------------------------------------------
+int FramePacer::GetHistoryCount() const
+{
+    return m_historyCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @param framesAgo 0 is the most recently finished frame.
+double FramePacer::GetFrameSeconds(int const framesAgo) const
+{
+    if (framesAgo < 0 || framesAgo >= m_historyCount) return 0.0;
+
+    int const index = (m_historyHead - 1 - framesAgo + HISTORY_SIZE) % HISTORY_SIZE;
+
+    return m_frameHistory[index];
+}
+
+//----------------------------------------------------------------------------------------------------
+double FramePacer::GetAverageFrameSeconds() const
+{
+    if (m_historyCount == 0) return 0.0;
+
+    double sum = 0.0;
+
+    for (int i = 0; i < m_historyCount; ++i)
+    {
+        sum += m_frameHistory[i];
+    }
+
+    return sum / static_cast<double>(m_historyCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return Standard deviation of the frame time.
+double FramePacer::GetJitterSeconds() const
+{
+    if (m_historyCount < 2) return 0.0;
+
+    double const average  = GetAverageFrameSeconds();
+    double       variance = 0.0;
+
+    for (int i = 0; i < m_historyCount; ++i)
+    {
+        double const delta = m_frameHistory[i] - average;
+        variance += delta * delta;
+    }
+
+    return std::sqrt(variance / static_cast<double>(m_historyCount));
+}
+
+//----------------------------------------------------------------------------------------------------
+void FramePacer::GetHistogram(int (&outBuckets)[BUCKET_COUNT]) const
+{
+    for (int& bucket : outBuckets)
+    {
+        bucket = 0;
+    }
+
+    for (int i = 0; i < m_historyCount; ++i)
+    {
+        int bucketIndex = static_cast<int>(m_frameHistory[i] * 1000.0);
+
+        if (bucketIndex >= BUCKET_COUNT) bucketIndex = BUCKET_COUNT - 1;
+
+        ++outBuckets[bucketIndex];
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Sleep in 1 ms slices while more than the spin margin remains, then spin to the deadline.
+/// Every slice measures how late Sleep() woke up; the worst recent overshoot widens the margin,
+/// and decays slowly so a single scheduler hiccup does not pin the margin high forever.
+void FramePacer::SleepUntil(double const deadlineSeconds)
+{
+    double const minSpinSeconds = static_cast<double>(m_config.m_minSpinSeconds);
+
+    for (;;)
+    {
+        double const remainingSeconds = deadlineSeconds - GetCurrentTimeSeconds();
+
+        if (remainingSeconds <= minSpinSeconds + m_sleepOvershootSeconds) break;
+
+        double const sleepStartSeconds = GetCurrentTimeSeconds();
+        Sleep(1);
+        double const overshootSeconds = (GetCurrentTimeSeconds() - sleepStartSeconds) - 0.001;
+
+        m_sleepOvershootSeconds *= 0.99;
+
+        if (overshootSeconds > m_sleepOvershootSeconds)
+        {
+            m_sleepOvershootSeconds = overshootSeconds;
+        }
+    }
+
+    while (GetCurrentTimeSeconds() < deadlineSeconds)
+    {
+        YieldProcessor();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void FramePacer::RecordFrame(double const frameSeconds)
+{
+    m_frameHistory[m_historyHead] = frameSeconds;
+    m_historyHead                 = (m_historyHead + 1) % HISTORY_SIZE;
+
+    if (m_historyCount < HISTORY_SIZE)
+    {
+        ++m_historyCount;
+    }
+}
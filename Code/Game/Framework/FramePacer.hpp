@@ -0,0 +1,57 @@
+//----------------------------------------------------------------------------------------------------
+// FramePacer.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+// Loaded from the <FramePacing> element of Data/GameConfig.xml.
+//
+struct sFramePacingConfig
+{
+    float m_targetHz         = 60.f;     // Frame rate while the window has focus; 0 = unlimited
+    float m_unfocusedHz      = 15.f;     // Idle throttle while the window is in the background; 0 = same as m_targetHz
+    float m_minSpinSeconds   = 0.001f;   // Spin margin kept after the coarse sleep, on top of the adaptive overshoot estimate
+    bool  m_isHistogramShown = false;    // Draw the frame-time histogram on the debug HUD
+};
+
+//----------------------------------------------------------------------------------------------------
+// Hybrid sleep-then-spin frame limiter.
+//
+// WaitForNextFrame() sleeps for most of the remaining frame budget, then spins on the high-resolution
+// clock for the last stretch. The spin margin adapts to the worst recently observed Sleep() overshoot,
+// so the wait lands well under a millisecond from the deadline without burning a full core.
+//
+class FramePacer
+{
+public:
+    static int constexpr HISTORY_SIZE = 240;
+    static int constexpr BUCKET_COUNT = 34;     // 1 ms buckets; the last one collects everything >= 33 ms
+
+    explicit FramePacer(sFramePacingConfig const& config);
+    ~FramePacer();
+
+    void WaitForNextFrame(bool doesWindowHaveFocus);
+
+    sFramePacingConfig const& GetConfig() const;
+    void                      SetConfig(sFramePacingConfig const& config);
+
+    // Frame-time statistics over the last HISTORY_SIZE frames, in seconds
+    int    GetHistoryCount() const;
+    double GetFrameSeconds(int framesAgo) const;
+    double GetAverageFrameSeconds() const;
+    double GetJitterSeconds() const;
+    void   GetHistogram(int (&outBuckets)[BUCKET_COUNT]) const;
+
+private:
+    void SleepUntil(double deadlineSeconds);
+    void RecordFrame(double frameSeconds);
+
+    sFramePacingConfig m_config;
+    double             m_frameStartSeconds          = 0.0;
+    double             m_sleepOvershootSeconds      = 0.0;
+    double             m_frameHistory[HISTORY_SIZE] = {};
+    int                m_historyCount               = 0;
+    int                m_historyHead                = 0;
+};
@@ -0,0 +1,314 @@
+//----------------------------------------------------------------------------------------------------
+// FrameProfiler.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FrameProfiler.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/GameCommon.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+#include "Engine/Core/Time.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <fstream>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    int constexpr MAX_ZONE_DEPTH = 64;
+
+    struct sOpenZone
+    {
+        char const* m_name         = nullptr;
+        double      m_startSeconds = 0.0;
+    };
+
+    std::atomic<uint64_t> s_nextProfilerId{1};
+
+    // Per-thread state; the buffer is owned by the profiler t_threadBufferOwnerId names, the open-zone
+    // stack lives on the thread itself
+    thread_local ProfileThreadBuffer* t_threadBuffer        = nullptr;
+    thread_local uint64_t             t_threadBufferOwnerId = 0;
+    thread_local sOpenZone            t_openZones[MAX_ZONE_DEPTH];
+}
+
+//----------------------------------------------------------------------------------------------------
+ProfileThreadBuffer::ProfileThreadBuffer(uint16_t const threadIndex, int const capacity)
+    : m_threadIndex(threadIndex)
+    , m_zones(static_cast<size_t>(capacity))
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Producer side; called only by the owning thread.
+void ProfileThreadBuffer::Push(sProfileZone const& zone)
+{
+    uint32_t const writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+    uint32_t const readIndex  = m_readIndex.load(std::memory_order_acquire);
+
+    if (writeIndex - readIndex >= static_cast<uint32_t>(m_zones.size()))
+    {
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    m_zones[writeIndex % m_zones.size()] = zone;
+    m_writeIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Consumer side; called only by the main thread.
+void ProfileThreadBuffer::Drain(std::vector<sProfileZone>& outZones)
+{
+    uint32_t const readIndex  = m_readIndex.load(std::memory_order_relaxed);
+    uint32_t const writeIndex = m_writeIndex.load(std::memory_order_acquire);
+
+    for (uint32_t index = readIndex; index != writeIndex; ++index)
+    {
+        outZones.push_back(m_zones[index % m_zones.size()]);
+    }
+
+    m_readIndex.store(writeIndex, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------------------------------
+FrameProfiler::FrameProfiler(sFrameProfilerConfig const& config)
+    : m_config(config)
+    , m_id(s_nextProfilerId.fetch_add(1, std::memory_order_relaxed))
+{
+    m_lastFrameEndSeconds = GetCurrentTimeSeconds();
+}
+
+//----------------------------------------------------------------------------------------------------
+FrameProfiler::~FrameProfiler()
+{
+    if (IsCapturing())
+    {
+        WriteChromeTrace();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Close the previous frame: move every thread's finished zones into m_lastFrameZones.
+/// Call on the main thread before any other per-frame work.
+void FrameProfiler::BeginFrame()
+{
+    double const nowSeconds = GetCurrentTimeSeconds();
+
+    m_lastFrameStartSeconds = m_lastFrameEndSeconds;
+    m_lastFrameEndSeconds   = nowSeconds;
+    m_lastFrameZones.clear();
+
+    {
+        std::lock_guard lock(m_threadBuffersMutex);
+
+        for (std::unique_ptr<ProfileThreadBuffer> const& threadBuffer : m_threadBuffers)
+        {
+            threadBuffer->Drain(m_lastFrameZones);
+        }
+    }
+
+    if (m_captureFramesLeft > 0)
+    {
+        m_capturedZones.insert(m_capturedZones.end(), m_lastFrameZones.begin(), m_lastFrameZones.end());
+
+        if (--m_captureFramesLeft == 0)
+        {
+            WriteChromeTrace();
+            m_capturedZones.clear();
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void FrameProfiler::BeginZone(char const* name)
+{
+    if (g_profiler == nullptr || !g_profiler->m_config.m_isEnabled) return;
+
+    // A ring leased from an earlier profiler died with it
+    if (t_threadBufferOwnerId != g_profiler->m_id)
+    {
+        thread_local sThreadBufferLease lease;
+
+        t_threadBufferOwnerId = g_profiler->m_id;
+        t_threadBuffer        = g_profiler->AcquireThreadBuffer();
+        lease.m_profilerId    = t_threadBufferOwnerId;
+        lease.m_buffer        = t_threadBuffer;
+    }
+
+    ProfileThreadBuffer* threadBuffer = t_threadBuffer;
+
+    // Zones nested deeper than the stack are still counted in m_depth so EndZone stays balanced
+    if (threadBuffer->m_depth < MAX_ZONE_DEPTH)
+    {
+        t_openZones[threadBuffer->m_depth] = { name, GetCurrentTimeSeconds() };
+    }
+
+    ++threadBuffer->m_depth;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void FrameProfiler::EndZone()
+{
+    ProfileThreadBuffer* threadBuffer = t_threadBuffer;
+
+    if (threadBuffer == nullptr || g_profiler == nullptr || t_threadBufferOwnerId != g_profiler->m_id) return;
+    if (threadBuffer->m_depth == 0) return;
+
+    --threadBuffer->m_depth;
+
+    if (threadBuffer->m_depth >= MAX_ZONE_DEPTH) return;
+
+    sOpenZone const& openZone = t_openZones[threadBuffer->m_depth];
+    sProfileZone     zone;
+
+    zone.m_name         = openZone.m_name;
+    zone.m_startSeconds = openZone.m_startSeconds;
+    zone.m_endSeconds   = GetCurrentTimeSeconds();
+    zone.m_threadIndex  = threadBuffer->m_threadIndex;
+    zone.m_depth        = threadBuffer->m_depth;
+
+    threadBuffer->Push(zone);
+}
+
+//----------------------------------------------------------------------------------------------------
+sFrameProfilerConfig const& FrameProfiler::GetConfig() const
+{
+    return m_config;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FrameProfiler::SetOverlayShown(bool const isOverlayShown)
+{
+    m_config.m_isOverlayShown = isOverlayShown;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sProfileZone> const& FrameProfiler::GetLastFrameZones() const
+{
+    return m_lastFrameZones;
+}
+
+//----------------------------------------------------------------------------------------------------
+double FrameProfiler::GetLastFrameStartSeconds() const
+{
+    return m_lastFrameStartSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+double FrameProfiler::GetLastFrameEndSeconds() const
+{
+    return m_lastFrameEndSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+int FrameProfiler::GetThreadCount() const
+{
+    std::lock_guard lock(m_threadBuffersMutex);
+
+    return static_cast<int>(m_threadBuffers.size() - m_freeThreadBuffers.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Record the next frameCount frames, then write them to filePath as Chrome trace JSON.
+void FrameProfiler::StartCapture(int const frameCount, std::string const& filePath)
+{
+    m_capturedZones.clear();
+    m_captureFilePath   = filePath;
+    m_captureFramesLeft = frameCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool FrameProfiler::IsCapturing() const
+{
+    return m_captureFramesLeft > 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Slow path, once per thread: reuse the ring of an exited thread, or allocate one and remember it
+/// for collection.
+ProfileThreadBuffer* FrameProfiler::AcquireThreadBuffer()
+{
+    std::lock_guard lock(m_threadBuffersMutex);
+
+    if (!m_freeThreadBuffers.empty())
+    {
+        ProfileThreadBuffer* threadBuffer = m_freeThreadBuffers.back();
+        m_freeThreadBuffers.pop_back();
+        threadBuffer->m_depth = 0;
+
+        return threadBuffer;
+    }
+
+    uint16_t const threadIndex = static_cast<uint16_t>(m_threadBuffers.size());
+
+    m_threadBuffers.push_back(std::make_unique<ProfileThreadBuffer>(threadIndex, m_config.m_recordsPerThread));
+
+    return m_threadBuffers.back().get();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Called as a thread exits. The ring stays in m_threadBuffers, so zones it has not drained yet still
+/// reach the next frame.
+void FrameProfiler::ReleaseThreadBuffer(ProfileThreadBuffer* threadBuffer)
+{
+    std::lock_guard lock(m_threadBuffersMutex);
+
+    m_freeThreadBuffers.push_back(threadBuffer);
+}
+
+//----------------------------------------------------------------------------------------------------
+FrameProfiler::sThreadBufferLease::~sThreadBufferLease()
+{
+    if (m_buffer != nullptr && g_profiler != nullptr && g_profiler->m_id == m_profilerId)
+    {
+        g_profiler->ReleaseThreadBuffer(m_buffer);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Chrome "Trace Event Format": one complete ("X") event per zone, timestamps in microseconds.
+void FrameProfiler::WriteChromeTrace() const
+{
+    std::ofstream file(m_captureFilePath, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        DAEMON_LOG(LogGame, eLogVerbosity::Warning, Stringf("(FrameProfiler) cannot open %s for writing", m_captureFilePath.c_str()));
+        return;
+    }
+
+    // Zones are drained in end order, so the earliest start is not necessarily the first record
+    double originSeconds = m_capturedZones.empty() ? 0.0 : m_capturedZones.front().m_startSeconds;
+
+    for (sProfileZone const& zone : m_capturedZones)
+    {
+        if (zone.m_startSeconds < originSeconds) originSeconds = zone.m_startSeconds;
+    }
+
+    file << "{\"traceEvents\":[\n";
+
+    for (size_t zoneIndex = 0; zoneIndex < m_capturedZones.size(); ++zoneIndex)
+    {
+        sProfileZone const& zone = m_capturedZones[zoneIndex];
+
+        file << Stringf("{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+                        zone.m_name,
+                        static_cast<unsigned int>(zone.m_threadIndex),
+                        (zone.m_startSeconds - originSeconds) * 1000000.0,
+                        (zone.m_endSeconds - zone.m_startSeconds) * 1000000.0,
+                        zoneIndex + 1 < m_capturedZones.size() ? "," : "");
+    }
+
+    file << "]}\n";
+
+    DAEMON_LOG(LogGame, eLogVerbosity::Display, Stringf("(FrameProfiler) wrote %d zones to %s", static_cast<int>(m_capturedZones.size()), m_captureFilePath.c_str()));
+}
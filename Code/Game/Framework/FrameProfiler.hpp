@@ -0,0 +1,129 @@
+//----------------------------------------------------------------------------------------------------
+// FrameProfiler.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b)       PROFILE_CONCAT_INNER(a, b)
+
+// Times the enclosing scope; name must be a string literal (only the pointer is recorded)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+//----------------------------------------------------------------------------------------------------
+// Loaded from the <Profiler> element of Data/GameConfig.xml.
+//
+struct sFrameProfilerConfig
+{
+    bool m_isEnabled        = true;     // false makes every PROFILE_SCOPE a no-op
+    bool m_isOverlayShown   = false;    // Draw the flame graph of the last frame on screen
+    int  m_recordsPerThread = 8192;     // Ring capacity per thread; zones past this within one frame are dropped
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sProfileZone
+{
+    char const* m_name         = nullptr;
+    double      m_startSeconds = 0.0;
+    double      m_endSeconds   = 0.0;
+    uint16_t    m_threadIndex  = 0;
+    uint16_t    m_depth        = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Single-producer / single-consumer ring of finished zones. The owning thread pushes without locks;
+// the main thread drains it once per frame in FrameProfiler::BeginFrame.
+//
+class ProfileThreadBuffer
+{
+public:
+    ProfileThreadBuffer(uint16_t threadIndex, int capacity);
+
+    void Push(sProfileZone const& zone);
+    void Drain(std::vector<sProfileZone>& outZones);
+
+    uint16_t              m_threadIndex = 0;
+    uint16_t              m_depth       = 0;        // Touched only by the owning thread
+    std::atomic<uint32_t> m_droppedCount{0};
+
+private:
+    std::vector<sProfileZone> m_zones;
+    std::atomic<uint32_t>     m_writeIndex{0};
+    std::atomic<uint32_t>     m_readIndex{0};
+};
+
+//----------------------------------------------------------------------------------------------------
+// Hierarchical CPU profiler. Any thread may open zones with PROFILE_SCOPE; each thread leases its own
+// lock-free ring on first use and hands it back when it exits, so threads that come and go reuse the
+// rings of earlier ones instead of adding more (a reused ring keeps its thread index). Once per frame
+// the main thread collects every ring into the finished frame, which feeds the flame-graph overlay
+// and, while capturing, a Chrome trace export (load the file in chrome://tracing or ui.perfetto.dev).
+//
+class FrameProfiler
+{
+public:
+    explicit FrameProfiler(sFrameProfilerConfig const& config);
+    ~FrameProfiler();
+
+    void BeginFrame();
+
+    static void BeginZone(char const* name);
+    static void EndZone();
+
+    sFrameProfilerConfig const&      GetConfig() const;
+    void                             SetOverlayShown(bool isOverlayShown);
+    std::vector<sProfileZone> const& GetLastFrameZones() const;
+    double                           GetLastFrameStartSeconds() const;
+    double                           GetLastFrameEndSeconds() const;
+    int                              GetThreadCount() const;      // Threads holding a ring now
+
+    void StartCapture(int frameCount, std::string const& filePath);
+    bool IsCapturing() const;
+
+private:
+    // Held by each profiling thread; hands its ring back to the profiler that leased it on thread exit
+    struct sThreadBufferLease
+    {
+        ~sThreadBufferLease();
+
+        uint64_t             m_profilerId = 0;
+        ProfileThreadBuffer* m_buffer     = nullptr;
+    };
+
+    ProfileThreadBuffer* AcquireThreadBuffer();
+    void                 ReleaseThreadBuffer(ProfileThreadBuffer* threadBuffer);
+    void                 WriteChromeTrace() const;
+
+    sFrameProfilerConfig                              m_config;
+    uint64_t                                          m_id = 0;                 // Unique per profiler, unlike its address
+    mutable std::mutex                                m_threadBuffersMutex;
+    std::vector<std::unique_ptr<ProfileThreadBuffer>> m_threadBuffers;          // Every ring, leased or free; all are drained
+    std::vector<ProfileThreadBuffer*>                 m_freeThreadBuffers;      // Rings of exited threads
+    std::vector<sProfileZone>                         m_lastFrameZones;
+    double                                            m_lastFrameStartSeconds = 0.0;
+    double                                            m_lastFrameEndSeconds   = 0.0;
+
+    std::vector<sProfileZone> m_capturedZones;
+    std::string               m_captureFilePath;
+    int                       m_captureFramesLeft = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+class ProfileScope
+{
+public:
+    explicit ProfileScope(char const* name) { FrameProfiler::BeginZone(name); }
+    ~ProfileScope() { FrameProfiler::EndZone(); }
+
+    ProfileScope(ProfileScope const&)            = delete;
+    ProfileScope& operator=(ProfileScope const&) = delete;
+};
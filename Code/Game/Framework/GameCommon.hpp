@@ -10,16 +10,40 @@ class ResourceSubsystem;
 struct Rgba8;
 struct Vec2;
 class App;
+class AssetPack;
+class AssetStreamer;
+class BinaryLog;
 class BitmapFont;
+class DrawList2D;
+class EventDispatcher;
+class FrameArena;
+class FrameProfiler;
 class Game;
+class JobScheduler;
+class ScriptRunner;
+class ShaderCache;
+class TextLayoutCache;
 
 // one-time declaration
 extern App*                   g_app;
+extern AssetPack*             g_assetPack;
+extern AssetStreamer*         g_assetStreamer;
+extern BinaryLog*             g_binaryLog;
 extern BitmapFont*            g_bitmapFont;
+extern DrawList2D*            g_drawList;
+extern EventDispatcher*       g_eventDispatcher;
+extern FrameArena*            g_frameArena;
+extern FrameProfiler*         g_profiler;
 extern Game*                  g_game;
+extern JobScheduler*          g_ioScheduler;
+extern JobScheduler*          g_jobScheduler;
+extern ScriptRunner*          g_scriptRunner;
+extern ShaderCache*           g_shaderCache;
+extern TextLayoutCache*       g_textCache;
 
 //----------------------------------------------------------------------------------------------------
 // DebugRender-related
+// Geometry is queued on g_drawList and drawn at its next Flush(), which Game::Render issues before EndCamera.
 //
 void DebugDrawRing(Vec2 const& center, float radius, float thickness, Rgba8 const& color);
 void DebugDrawLine(Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color);
@@ -0,0 +1,251 @@
+//----------------------------------------------------------------------------------------------------
+// GlyphWidthScan.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/GlyphWidthScan.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FrameProfiler.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/JobScheduler.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Renderer/Image.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <thread>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define GLYPH_SCAN_SIMD_BYTES 32
+#elif defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define GLYPH_SCAN_SIMD_BYTES 16
+#else
+#define GLYPH_SCAN_SIMD_BYTES 0
+#endif
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    static_assert(sizeof(Rgba8) == 4, "GlyphWidthScan reads texels as r,g,b,a bytes");
+
+    //------------------------------------------------------------------------------------------------
+    // Reference: walks each column top to bottom until it finds ink
+    //
+    sGlyphColumnExtents ScanCellScalar(Rgba8 const* cellTopLeft, int const stride, IntVec2 const& cellSize, uint8_t const alphaThreshold)
+    {
+        sGlyphColumnExtents extents;
+
+        for (int x = 0; x < cellSize.x; ++x)
+        {
+            for (int y = 0; y < cellSize.y; ++y)
+            {
+                if (cellTopLeft[y * stride + x].a >= alphaThreshold)
+                {
+                    if (extents.m_firstColumn < 0) extents.m_firstColumn = static_cast<int16_t>(x);
+                    extents.m_lastColumn = static_cast<int16_t>(x);
+                    break;
+                }
+            }
+        }
+
+        return extents;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Streams the cell row by row, keeping a byte-wise max per column (unsigned max of whole texels
+    // is the max of each channel, so the alpha byte ends up as the column's peak alpha). Only the
+    // final cellSize.x alphas are compared against the threshold.
+    //
+    sGlyphColumnExtents ScanCellSIMD(Rgba8 const* cellTopLeft, int const stride, IntVec2 const& cellSize, uint8_t const alphaThreshold)
+    {
+        thread_local std::vector<uint8_t> t_columnMax;
+
+        int const byteCount = cellSize.x * 4;
+        t_columnMax.assign(static_cast<size_t>(byteCount), 0);
+        uint8_t* columnMax = t_columnMax.data();
+
+        for (int y = 0; y < cellSize.y; ++y)
+        {
+            uint8_t const* row  = reinterpret_cast<uint8_t const*>(cellTopLeft + y * stride);
+            int            byte = 0;
+
+#if GLYPH_SCAN_SIMD_BYTES == 32
+            for (; byte + 32 <= byteCount; byte += 32)
+            {
+                __m256i const peak = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(columnMax + byte));
+                __m256i const next = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(row + byte));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(columnMax + byte), _mm256_max_epu8(peak, next));
+            }
+#elif GLYPH_SCAN_SIMD_BYTES == 16
+            for (; byte + 16 <= byteCount; byte += 16)
+            {
+                __m128i const peak = _mm_loadu_si128(reinterpret_cast<__m128i const*>(columnMax + byte));
+                __m128i const next = _mm_loadu_si128(reinterpret_cast<__m128i const*>(row + byte));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(columnMax + byte), _mm_max_epu8(peak, next));
+            }
+#endif
+            for (; byte < byteCount; ++byte)
+            {
+                if (row[byte] > columnMax[byte]) columnMax[byte] = row[byte];
+            }
+        }
+
+        sGlyphColumnExtents extents;
+
+        for (int x = 0; x < cellSize.x; ++x)
+        {
+            if (columnMax[x * 4 + 3] >= alphaThreshold)
+            {
+                if (extents.m_firstColumn < 0) extents.m_firstColumn = static_cast<int16_t>(x);
+                extents.m_lastColumn = static_cast<int16_t>(x);
+            }
+        }
+
+        return extents;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScanGlyphColumnExtents(Rgba8 const* texels, IntVec2 const& dimensions, sGlyphScanSettings const& settings, std::vector<sGlyphColumnExtents>& outExtents)
+{
+    PROFILE_SCOPE("ScanGlyphColumnExtents");
+
+    outExtents.clear();
+
+    if (texels == nullptr || settings.m_cellCounts.x <= 0 || settings.m_cellCounts.y <= 0) return;
+
+    IntVec2 const cellSize(dimensions.x / settings.m_cellCounts.x, dimensions.y / settings.m_cellCounts.y);
+    int const     cellCount = settings.m_cellCounts.x * settings.m_cellCounts.y;
+
+    outExtents.resize(static_cast<size_t>(cellCount));
+
+    if (cellSize.x <= 0 || cellSize.y <= 0) return;
+
+    auto const scanCell = [&](int const cellIndex)
+    {
+        int const    cellX       = cellIndex % settings.m_cellCounts.x;
+        int const    cellY       = cellIndex / settings.m_cellCounts.x;
+        Rgba8 const* cellTopLeft = texels + static_cast<size_t>(cellY) * cellSize.y * dimensions.x + static_cast<size_t>(cellX) * cellSize.x;
+
+        outExtents[static_cast<size_t>(cellIndex)] = settings.m_path == eGlyphScanPath::SIMD
+                                                         ? ScanCellSIMD(cellTopLeft, dimensions.x, cellSize, settings.m_alphaThreshold)
+                                                         : ScanCellScalar(cellTopLeft, dimensions.x, cellSize, settings.m_alphaThreshold);
+    };
+
+    if (settings.m_isParallel && g_jobScheduler != nullptr)
+    {
+        g_jobScheduler->ParallelFor(cellCount, scanCell);
+    }
+    else
+    {
+        for (int cellIndex = 0; cellIndex < cellCount; ++cellIndex) scanCell(cellIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* GetGlyphScanSIMDName()
+{
+#if GLYPH_SCAN_SIMD_BYTES == 32
+    return "AVX2 x8";
+#elif GLYPH_SCAN_SIMD_BYTES == 16
+    return "SSE2 x4";
+#else
+    return "scalar";
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+GlyphWidthScan::~GlyphWidthScan()
+{
+    while (m_state.load(std::memory_order_acquire) == eState::RUNNING)
+    {
+        std::this_thread::yield();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return false when a scan is still running or there is no g_ioScheduler to run it on.
+bool GlyphWidthScan::Start(String const& imagePath, sGlyphScanSettings const& settings, EventId const completionEvent)
+{
+    if (g_ioScheduler == nullptr || IsBusy()) return false;
+
+    m_imagePath       = imagePath;
+    m_completionEvent = completionEvent;
+    m_settings        = settings;
+    m_didSucceed      = false;
+
+    m_state.store(eState::RUNNING, std::memory_order_release);
+    g_ioScheduler->Submit([this] { RunJob(); }, eJobPriority::BACKGROUND);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool GlyphWidthScan::IsBusy() const
+{
+    return m_state.load(std::memory_order_acquire) == eState::RUNNING;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool GlyphWidthScan::IsReady() const
+{
+    return m_state.load(std::memory_order_acquire) == eState::READY && m_didSucceed;
+}
+
+//----------------------------------------------------------------------------------------------------
+IntVec2 GlyphWidthScan::GetAtlasDimensions() const
+{
+    return m_atlasDimensions;
+}
+
+//----------------------------------------------------------------------------------------------------
+IntVec2 GlyphWidthScan::GetCellCounts() const
+{
+    return m_settings.m_cellCounts;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sGlyphColumnExtents> const& GlyphWidthScan::GetExtents() const
+{
+    return m_extents;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Runs on a worker; the ParallelFor inside fans the cells out to the other workers.
+void GlyphWidthScan::RunJob()
+{
+    PROFILE_SCOPE("GlyphWidthScan::RunJob");
+
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    Image const image(m_imagePath.c_str());
+    m_atlasDimensions = image.GetDimensions();
+    m_didSucceed      = m_atlasDimensions.x > 0 && m_atlasDimensions.y > 0;
+
+    if (m_didSucceed)
+    {
+        ScanGlyphColumnExtents(static_cast<Rgba8 const*>(image.GetRawData()), m_atlasDimensions, m_settings, m_extents);
+    }
+    else
+    {
+        m_extents.clear();
+    }
+
+    m_seconds = GetCurrentTimeSeconds() - startSeconds;
+
+    FlatProperties args;
+    args.SetValue("image"_hcis, m_imagePath);
+    args.SetValue("success"_hcis, m_didSucceed);
+    args.SetValue("glyphs"_hcis, static_cast<int>(m_extents.size()));
+    args.SetValue("ms"_hcis, static_cast<float>(m_seconds * 1000.0));
+
+    // READY before the post, so a handler sees a finished scan; the post publishes the results.
+    // Once READY the destructor may run, so only locals are used after the store.
+    EventId const completionEvent = m_completionEvent;
+
+    m_state.store(eState::READY, std::memory_order_release);
+    g_eventDispatcher->Post(completionEvent, args);
+}
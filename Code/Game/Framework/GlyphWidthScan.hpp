@@ -0,0 +1,90 @@
+//----------------------------------------------------------------------------------------------------
+// GlyphWidthScan.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/EventDispatcher.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/IntVec2.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Inked columns of one glyph cell, cell-local and inclusive; both -1 when the cell is empty.
+//
+struct sGlyphColumnExtents
+{
+    int16_t m_firstColumn = -1;
+    int16_t m_lastColumn  = -1;
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eGlyphScanPath : uint8_t
+{
+    SCALAR,     // Pixel by pixel, column by column; the reference
+    SIMD        // Per-column alpha max across rows with SSE2 (AVX2 when compiled with /arch:AVX2)
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sGlyphScanSettings
+{
+    IntVec2        m_cellCounts     = IntVec2(16, 16);      // Glyph grid of the atlas, glyph 0 top-left
+    uint8_t        m_alphaThreshold = 1;                    // A column is inked if any texel reaches this alpha
+    eGlyphScanPath m_path           = eGlyphScanPath::SIMD;
+    bool           m_isParallel     = true;                 // One g_jobScheduler task per cell
+};
+
+//----------------------------------------------------------------------------------------------------
+// Column extents of every cell of a fixed-grid font atlas (rows top-down, as stored in the .png),
+// one entry per cell in glyph order.
+//
+void        ScanGlyphColumnExtents(Rgba8 const* texels, IntVec2 const& dimensions, sGlyphScanSettings const& settings, std::vector<sGlyphColumnExtents>& outExtents);
+char const* GetGlyphScanSIMDName();
+
+//----------------------------------------------------------------------------------------------------
+// Loads an atlas image on g_ioScheduler and scans it on g_jobScheduler, off the main thread.
+//
+// Start() returns immediately. When the scan is done the job posts the completion event to
+// g_eventDispatcher, with args image=<path> success=<bool> glyphs=<n> ms=<t>, so it fires on the main
+// thread at the next BeginFrame; the extents stay readable until the next Start(). Destroying a scan
+// waits for a running job.
+//
+class GlyphWidthScan
+{
+public:
+    ~GlyphWidthScan();
+
+    bool Start(String const& imagePath, sGlyphScanSettings const& settings, EventId completionEvent);
+
+    bool IsBusy() const;
+    bool IsReady() const;
+
+    IntVec2                                 GetAtlasDimensions() const;
+    IntVec2                                 GetCellCounts() const;
+    std::vector<sGlyphColumnExtents> const& GetExtents() const;
+
+private:
+    enum class eState : uint8_t
+    {
+        IDLE,
+        RUNNING,        // Owned by the job; nothing below may be touched on the main thread
+        READY
+    };
+
+    void RunJob();
+
+    std::atomic<eState>              m_state = eState::IDLE;
+    String                           m_imagePath;
+    EventId                          m_completionEvent;
+    sGlyphScanSettings               m_settings;
+    IntVec2                          m_atlasDimensions;
+    std::vector<sGlyphColumnExtents> m_extents;
+    bool                             m_didSucceed = false;
+    double                           m_seconds    = 0.0;
+};
@@ -0,0 +1,80 @@
+//----------------------------------------------------------------------------------------------------
+// HashedName.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+//----------------------------------------------------------------------------------------------------
+constexpr char ToLowerASCII(char const c)
+{
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+//----------------------------------------------------------------------------------------------------
+// 32-bit FNV-1a of the ASCII-lowercased text. Every game-side name table (FlatProperties,
+// EventDispatcher) keys on this hash, so a name hashed at compile time matches one hashed at runtime.
+//
+constexpr uint32_t GetCaseInsensitiveHash(std::string_view const text)
+{
+    uint32_t hash = 2166136261u;
+
+    for (char const c : text)
+    {
+        hash ^= static_cast<uint8_t>(ToLowerASCII(c));
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+//----------------------------------------------------------------------------------------------------
+constexpr bool AreNamesEqualCaseInsensitive(std::string_view const a, std::string_view const b)
+{
+    if (a.size() != b.size()) return false;
+
+    for (size_t index = 0; index < a.size(); ++index)
+    {
+        if (ToLowerASCII(a[index]) != ToLowerASCII(b[index])) return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A name plus its case-insensitive hash: the game-side, non-owning counterpart of
+// HashedCaseInsensitiveString. It views its text, which must outlive it; literals always do.
+//
+// "health"_hcis is consteval, so the hash is a constant baked into the caller, and a lookup keyed by
+// it does no hashing and builds no std::string. A plain char const* or String converts implicitly
+// and is hashed on the spot, so every API taking a HashedName still accepts ordinary strings.
+//
+class HashedName
+{
+public:
+    constexpr HashedName() = default;
+    constexpr HashedName(char const* text) : HashedName(std::string_view(text)) {}
+    constexpr HashedName(std::string_view const text) : m_text(text), m_hash(GetCaseInsensitiveHash(text)) {}
+    HashedName(std::string const& text) : HashedName(std::string_view(text)) {}
+
+    constexpr std::string_view GetText() const { return m_text; }
+    constexpr uint32_t         GetHash() const { return m_hash; }
+
+    constexpr bool operator==(HashedName const& other) const { return m_hash == other.m_hash && AreNamesEqualCaseInsensitive(m_text, other.m_text); }
+    constexpr bool operator!=(HashedName const& other) const { return !(*this == other); }
+
+private:
+    std::string_view m_text;
+    uint32_t         m_hash = GetCaseInsensitiveHash(std::string_view());
+};
+
+//----------------------------------------------------------------------------------------------------
+consteval HashedName operator""_hcis(char const* text, size_t const length)
+{
+    return HashedName(std::string_view(text, length));
+}
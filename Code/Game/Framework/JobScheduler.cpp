@@ -0,0 +1,697 @@
+//----------------------------------------------------------------------------------------------------
+// JobScheduler.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/JobScheduler.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FrameProfiler.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <chrono>
+#include <thread>
+
+//----------------------------------------------------------------------------------------------------
+// One submitted job. Deleted when the scheduler has run it and no JobHandle refers to it.
+//
+struct sJob
+{
+    std::function<void()> m_function;
+    std::atomic<int>      m_refCount{2};            // The scheduler's, dropped once run, and the first JobHandle's
+    std::atomic<int>      m_pendingCount{1};        // Unfinished dependencies, plus one while Submit() registers them
+    std::atomic<bool>     m_isComplete{false};
+    std::mutex            m_continuationsMutex;
+    std::vector<sJob*>    m_continuations;          // Jobs depending on this one, not yet runnable
+    JobScheduler*         m_scheduler = nullptr;    // Where it runs, even when its last dependency finishes on another
+    eJobPriority          m_priority = eJobPriority::NORMAL;
+};
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    // Where FindJob() found a job
+    int constexpr SOURCE_OWN    = 0;
+    int constexpr SOURCE_STOLEN = 1;
+    int constexpr SOURCE_SHARED = 2;
+
+    // Set on each worker thread; lets Submit() from a job push to the worker's own deque
+    thread_local JobScheduler* t_workerScheduler = nullptr;
+    thread_local int           t_workerIndex     = -1;
+    thread_local uint32_t      t_helperSeed      = 0x9E3779B9u;
+
+    void ReleaseJob(sJob* job)
+    {
+        if (job != nullptr && job->m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete job;
+        }
+    }
+
+    uint32_t NextRandom(uint32_t& seed)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+
+    int RoundUpToPowerOfTwo(int const value)
+    {
+        int power = 2;
+
+        while (power < value)
+        {
+            power <<= 1;
+        }
+
+        return power;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+JobHandle::JobHandle(sJob* job)
+    : m_job(job)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+JobHandle::~JobHandle()
+{
+    ReleaseJob(m_job);
+}
+
+//----------------------------------------------------------------------------------------------------
+JobHandle::JobHandle(JobHandle const& other)
+    : m_job(other.m_job)
+{
+    if (m_job != nullptr) m_job->m_refCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+JobHandle::JobHandle(JobHandle&& other) noexcept
+    : m_job(other.m_job)
+{
+    other.m_job = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+JobHandle& JobHandle::operator=(JobHandle const& other)
+{
+    if (other.m_job != nullptr) other.m_job->m_refCount.fetch_add(1, std::memory_order_relaxed);
+
+    ReleaseJob(m_job);
+    m_job = other.m_job;
+
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+JobHandle& JobHandle::operator=(JobHandle&& other) noexcept
+{
+    if (this != &other)
+    {
+        ReleaseJob(m_job);
+        m_job       = other.m_job;
+        other.m_job = nullptr;
+    }
+
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool JobHandle::IsValid() const
+{
+    return m_job != nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool JobHandle::IsComplete() const
+{
+    return m_job == nullptr || m_job->m_isComplete.load(std::memory_order_acquire);
+}
+
+//----------------------------------------------------------------------------------------------------
+JobDeque::JobDeque(int const capacity)
+    : m_slots(static_cast<size_t>(RoundUpToPowerOfTwo(capacity)))
+    , m_mask(static_cast<int64_t>(m_slots.size()) - 1)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Owner only.
+bool JobDeque::Push(sJob* job)
+{
+    int64_t const bottom = m_bottom.load(std::memory_order_relaxed);
+    int64_t const top    = m_top.load(std::memory_order_acquire);
+
+    if (bottom - top > m_mask) return false;
+
+    m_slots[static_cast<size_t>(bottom & m_mask)].store(job, std::memory_order_relaxed);
+    m_bottom.store(bottom + 1, std::memory_order_release);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Owner only: the newest job. Racing thieves for the last one, it takes it only by winning the same
+/// compare-and-swap they use.
+sJob* JobDeque::Pop()
+{
+    int64_t const bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+
+    // Claim the slot before looking at top; seq_cst orders this store before that load
+    m_bottom.store(bottom, std::memory_order_seq_cst);
+
+    int64_t top = m_top.load(std::memory_order_seq_cst);
+
+    if (top > bottom)
+    {
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    sJob* job = m_slots[static_cast<size_t>(bottom & m_mask)].load(std::memory_order_relaxed);
+
+    if (top == bottom)
+    {
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            job = nullptr;
+        }
+
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return job;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Any thread: the oldest job, or nullptr when empty or another thread took it first.
+sJob* JobDeque::Steal()
+{
+    int64_t       top    = m_top.load(std::memory_order_seq_cst);
+    int64_t const bottom = m_bottom.load(std::memory_order_seq_cst);
+
+    if (top >= bottom) return nullptr;
+
+    sJob* job = m_slots[static_cast<size_t>(top & m_mask)].load(std::memory_order_relaxed);
+
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        return nullptr;
+    }
+
+    return job;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool JobDeque::IsEmpty() const
+{
+    return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+JobScheduler::sWorker::sWorker(int const dequeCapacity)
+    : m_deques{ JobDeque(dequeCapacity), JobDeque(dequeCapacity), JobDeque(dequeCapacity) }
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+JobScheduler::JobScheduler(sJobSchedulerConfig const& config)
+    : m_config(config)
+{
+    int const workerCount = ResolveWorkerCount(m_config);
+
+    m_config.m_threads.m_threadCount = workerCount;
+    m_usage = std::make_unique<ThreadPoolUsage>(workerCount);
+    m_workers.reserve(static_cast<size_t>(workerCount));
+
+    for (int workerIndex = 0; workerIndex < workerCount; ++workerIndex)
+    {
+        m_workers.push_back(std::make_unique<sWorker>(m_config.m_dequeCapacity));
+        m_workers.back()->m_stealSeed = 0x9E3779B9u * static_cast<uint32_t>(workerIndex + 1);
+    }
+
+    // Started once every worker exists, since each may steal from all the others
+    for (int workerIndex = 0; workerIndex < workerCount; ++workerIndex)
+    {
+        m_workers[static_cast<size_t>(workerIndex)]->m_thread.Start([this, workerIndex] { WorkerMain(workerIndex); }, m_config.m_threads, workerIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Finishes every queued job, and every job those schedule, then joins the workers. Jobs still
+/// waiting on a dependency from another scheduler are waited for and run too, so none is left
+/// behind to leak or to be scheduled here later.
+JobScheduler::~JobScheduler()
+{
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_isQuitting = true;
+    }
+
+    m_sleepCondition.notify_all();
+
+    for (std::unique_ptr<sWorker> const& worker : m_workers)
+    {
+        worker->m_thread.Join();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Queues job to run once every dependency has finished; right away if none is left. Empty handles
+/// among the dependencies are ignored.
+JobHandle JobScheduler::Submit(std::function<void()> job, eJobPriority const priority, std::span<JobHandle const> const dependencies)
+{
+    sJob* newJob        = new sJob;
+    newJob->m_function  = std::move(job);
+    newJob->m_priority  = priority;
+    newJob->m_scheduler = this;
+
+    // Counted before any dependency can see it, so the last one to finish never counts it out first
+    if (!dependencies.empty())
+    {
+        m_waitingCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    for (JobHandle const& dependency : dependencies)
+    {
+        sJob* dependencyJob = dependency.m_job;
+        if (dependencyJob == nullptr) continue;
+
+        std::lock_guard lock(dependencyJob->m_continuationsMutex);
+
+        if (!dependencyJob->m_isComplete.load(std::memory_order_relaxed))
+        {
+            newJob->m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+            dependencyJob->m_continuations.push_back(newJob);
+        }
+    }
+
+    JobHandle handle(newJob);
+
+    if (newJob->m_pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        ScheduleReady(newJob, !dependencies.empty());
+    }
+
+    return handle;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Continuation: job runs once dependency has finished.
+JobHandle JobScheduler::Then(JobHandle const& dependency, std::function<void()> job, eJobPriority const priority)
+{
+    return Submit(std::move(job), priority, std::span<JobHandle const>(&dependency, 1));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Returns once job has finished, running other jobs on this thread meanwhile, most urgent first and
+/// none less urgent than job; with none of those runnable, it yields. Jobs in less urgent lanes,
+/// including any job waits on, are left to the workers: a job must not depend on a less urgent one
+/// when every worker may be waiting on it.
+void JobScheduler::Wait(JobHandle const& job)
+{
+    if (job.IsComplete()) return;
+
+    eJobPriority const priority = job.m_job->m_priority;
+
+    while (!job.IsComplete())
+    {
+        if (!RunOneJob(priority))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Run body(0) ... body(count - 1) across the workers and the calling thread; returns when all have
+/// finished. Indices are handed out in chunks from a shared counter, so uneven work still balances,
+/// and while waiting for stragglers the caller runs other jobs instead of idling.
+void JobScheduler::ParallelFor(int const count, std::function<void(int)> const& body, eJobPriority const priority)
+{
+    if (count <= 0) return;
+
+    if (count == 1)
+    {
+        body(0);
+        return;
+    }
+
+    struct sParallelForState
+    {
+        std::function<void(int)> const* m_body  = nullptr;
+        int                             m_count = 0;
+        int                             m_grain = 1;
+        std::atomic<int>                m_nextIndex{0};
+        std::atomic<int>                m_doneCount{0};
+    };
+
+    int const participantCount = count < GetWorkerCount() + 1 ? count : GetWorkerCount() + 1;
+
+    // Shared: a helper job may start after the loop has already been finished by others
+    std::shared_ptr<sParallelForState> const state = std::make_shared<sParallelForState>();
+    state->m_body  = &body;
+    state->m_count = count;
+    state->m_grain = count / (participantCount * 8) > 1 ? count / (participantCount * 8) : 1;      // About eight chunks each
+
+    auto const runChunks = [](sParallelForState& loop)
+    {
+        for (int first = loop.m_nextIndex.fetch_add(loop.m_grain); first < loop.m_count; first = loop.m_nextIndex.fetch_add(loop.m_grain))
+        {
+            int const last = first + loop.m_grain < loop.m_count ? first + loop.m_grain : loop.m_count;
+
+            for (int index = first; index < last; ++index)
+            {
+                (*loop.m_body)(index);
+            }
+
+            loop.m_doneCount.fetch_add(last - first, std::memory_order_release);
+        }
+    };
+
+    for (int helperIndex = 1; helperIndex < participantCount; ++helperIndex)
+    {
+        Submit([state, runChunks]
+        {
+            PROFILE_SCOPE("JobScheduler::ParallelFor");
+            runChunks(*state);
+        }, priority);
+    }
+
+    runChunks(*state);
+
+    while (state->m_doneCount.load(std::memory_order_acquire) < count)
+    {
+        if (!RunOneJob(priority))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// The workers a scheduler made from config starts, before it exists.
+STATIC int JobScheduler::ResolveWorkerCount(sJobSchedulerConfig const& config)
+{
+    int workerCount = config.m_threads.m_threadCount;
+
+    // SMT siblings share a core's execution units; a worker on each would mostly contend with the other
+    if (workerCount <= 0)
+    {
+        workerCount = GetCpuTopology().m_physicalCount - 1;
+    }
+
+    return workerCount > 0 ? workerCount : 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+int JobScheduler::GetWorkerCount() const
+{
+    return static_cast<int>(m_workers.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// The thread count in m_threads is the one resolved at construction.
+sJobSchedulerConfig const& JobScheduler::GetConfig() const
+{
+    return m_config;
+}
+
+//----------------------------------------------------------------------------------------------------
+ThreadPoolUsage const& JobScheduler::GetUsage() const
+{
+    return *m_usage;
+}
+
+//----------------------------------------------------------------------------------------------------
+sJobSchedulerStats JobScheduler::GetStats() const
+{
+    sJobSchedulerStats stats;
+    stats.m_executedCount = m_helperExecutedCount.load(std::memory_order_relaxed);
+    stats.m_stolenCount   = m_helperStolenCount.load(std::memory_order_relaxed);
+    stats.m_sharedCount   = m_helperSharedCount.load(std::memory_order_relaxed);
+
+    for (std::unique_ptr<sWorker> const& worker : m_workers)
+    {
+        stats.m_executedCount += worker->m_executedCount.load(std::memory_order_relaxed);
+        stats.m_stolenCount   += worker->m_stolenCount.load(std::memory_order_relaxed);
+        stats.m_sharedCount   += worker->m_sharedCount.load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Runs jobs until the destructor asks it to quit and no job is left anywhere. Once out of work it
+/// keeps searching for m_spinMicroseconds, then sleeps until the next Schedule(). Each unbroken run
+/// of jobs counts as busy time in m_usage.
+void JobScheduler::WorkerMain(int const workerIndex)
+{
+    t_workerScheduler = this;
+    t_workerIndex     = workerIndex;
+
+    sWorker&     worker      = *m_workers[static_cast<size_t>(workerIndex)];
+    double const spinSeconds = static_cast<double>(m_config.m_threads.m_spinMicroseconds) * 1.0e-6;
+    bool         isBusy      = false;
+
+    for (;;)
+    {
+        uint64_t const epoch  = m_wakeEpoch.load(std::memory_order_seq_cst);
+        int            source = SOURCE_OWN;
+        sJob*          job    = FindJob(workerIndex, worker.m_stealSeed, source);
+
+        if (job == nullptr)
+        {
+            if (isBusy)
+            {
+                m_usage->EndBusy(workerIndex);
+                isBusy = false;
+            }
+
+            double const spinEndSeconds = GetCurrentTimeSeconds() + spinSeconds;
+
+            do
+            {
+                std::this_thread::yield();
+                job = FindJob(workerIndex, worker.m_stealSeed, source);
+            }
+            while (job == nullptr && GetCurrentTimeSeconds() < spinEndSeconds);
+        }
+
+        if (job != nullptr)
+        {
+            if (!isBusy)
+            {
+                m_usage->BeginBusy(workerIndex);
+                isBusy = true;
+            }
+
+            Execute(job, workerIndex, source);
+            continue;
+        }
+
+        std::unique_lock lock(m_sleepMutex);
+
+        if (m_isQuitting)
+        {
+            // Read first: a job leaves the count only once it is queued
+            bool const hasWaitingJobs = m_waitingCount.load(std::memory_order_seq_cst) > 0;
+
+            if (HasQueuedJobs()) continue;
+            if (!hasWaitingJobs) return;
+
+            // Only jobs waiting on another scheduler's are left; that one queues them here when ready
+            m_sleepCondition.wait_for(lock, std::chrono::milliseconds(1));
+            continue;
+        }
+
+        // A Schedule() after epoch was read bumps it, so this cannot sleep through that job
+        m_sleepingCount.fetch_add(1, std::memory_order_seq_cst);
+        m_sleepCondition.wait(lock, [this, epoch] { return m_isQuitting || m_wakeEpoch.load(std::memory_order_seq_cst) != epoch; });
+        m_sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Makes a job whose dependencies have all finished runnable: on the calling worker's own deque, or
+/// the shared queue from any other thread (or when that deque is full). Wakes one sleeping worker.
+void JobScheduler::Schedule(sJob* job)
+{
+    int const lane = static_cast<int>(job->m_priority);
+
+    bool const isPushed = t_workerScheduler == this && m_workers[static_cast<size_t>(t_workerIndex)]->m_deques[lane].Push(job);
+
+    if (!isPushed)
+    {
+        std::lock_guard lock(m_sharedMutex);
+        m_shared[lane].push_back(job);
+        m_sharedQueuedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    m_wakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+
+    if (m_sleepingCount.load(std::memory_order_seq_cst) > 0)
+    {
+        // Taking the mutex orders this notify after a sleeper's predicate check
+        { std::lock_guard lock(m_sleepMutex); }
+        m_sleepCondition.notify_one();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Marks job complete and schedules each continuation whose last dependency it was.
+void JobScheduler::Complete(sJob* job)
+{
+    std::vector<sJob*> continuations;
+
+    {
+        std::lock_guard lock(job->m_continuationsMutex);
+        job->m_isComplete.store(true, std::memory_order_release);
+        continuations.swap(job->m_continuations);
+    }
+
+    for (sJob* continuation : continuations)
+    {
+        if (continuation->m_pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            continuation->m_scheduler->ScheduleReady(continuation, true);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// A job whose last dependency just finished: scheduled, then no longer counted as waiting, so a
+/// quitting worker cannot see neither.
+void JobScheduler::ScheduleReady(sJob* job, bool const isWaiting)
+{
+    Schedule(job);
+
+    if (isWaiting)
+    {
+        m_waitingCount.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// The most urgent runnable job: lane by lane, the worker's own deque first (workerIndex -1 has
+/// none), then the shared queue, then the other workers' deques from a random start. Lanes less
+/// urgent than leastUrgent are not searched.
+sJob* JobScheduler::FindJob(int const workerIndex, uint32_t& stealSeed, int& outSource, eJobPriority const leastUrgent)
+{
+    int const workerCount = GetWorkerCount();
+
+    for (int lane = 0; lane <= static_cast<int>(leastUrgent); ++lane)
+    {
+        if (workerIndex >= 0)
+        {
+            if (sJob* job = m_workers[static_cast<size_t>(workerIndex)]->m_deques[lane].Pop())
+            {
+                outSource = SOURCE_OWN;
+                return job;
+            }
+        }
+
+        if (m_sharedQueuedCount.load(std::memory_order_relaxed) > 0)
+        {
+            std::lock_guard lock(m_sharedMutex);
+
+            if (!m_shared[lane].empty())
+            {
+                sJob* job = m_shared[lane].front();
+                m_shared[lane].pop_front();
+                m_sharedQueuedCount.fetch_sub(1, std::memory_order_relaxed);
+
+                outSource = SOURCE_SHARED;
+                return job;
+            }
+        }
+
+        int const start = static_cast<int>(NextRandom(stealSeed) % static_cast<uint32_t>(workerCount));
+
+        for (int offset = 0; offset < workerCount; ++offset)
+        {
+            int const victim = (start + offset) % workerCount;
+            if (victim == workerIndex) continue;
+
+            if (sJob* job = m_workers[static_cast<size_t>(victim)]->m_deques[lane].Steal())
+            {
+                outSource = SOURCE_STOLEN;
+                return job;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Runs one job no less urgent than leastUrgent on the calling thread, for threads that wait; a
+/// worker waiting inside a job starts with its own deque.
+/// @return false if no such job was runnable.
+bool JobScheduler::RunOneJob(eJobPriority const leastUrgent)
+{
+    int const workerIndex = t_workerScheduler == this ? t_workerIndex : -1;
+    int       source      = SOURCE_OWN;
+    sJob*     job         = FindJob(workerIndex, workerIndex >= 0 ? m_workers[static_cast<size_t>(workerIndex)]->m_stealSeed : t_helperSeed, source, leastUrgent);
+
+    if (job == nullptr) return false;
+
+    Execute(job, workerIndex, source);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void JobScheduler::Execute(sJob* job, int const workerIndex, int const source)
+{
+    job->m_function();
+    job->m_function = nullptr;      // Captures go now, not when the last handle does
+
+    Complete(job);
+
+    std::atomic<uint64_t>& executedCount = workerIndex >= 0 ? m_workers[static_cast<size_t>(workerIndex)]->m_executedCount : m_helperExecutedCount;
+    std::atomic<uint64_t>& stolenCount   = workerIndex >= 0 ? m_workers[static_cast<size_t>(workerIndex)]->m_stolenCount : m_helperStolenCount;
+    std::atomic<uint64_t>& sharedCount   = workerIndex >= 0 ? m_workers[static_cast<size_t>(workerIndex)]->m_sharedCount : m_helperSharedCount;
+
+    executedCount.fetch_add(1, std::memory_order_relaxed);
+    if (source == SOURCE_STOLEN) stolenCount.fetch_add(1, std::memory_order_relaxed);
+    if (source == SOURCE_SHARED) sharedCount.fetch_add(1, std::memory_order_relaxed);
+
+    ReleaseJob(job);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool JobScheduler::HasQueuedJobs() const
+{
+    if (m_sharedQueuedCount.load(std::memory_order_acquire) > 0) return true;
+
+    for (std::unique_ptr<sWorker> const& worker : m_workers)
+    {
+        for (JobDeque const& deque : worker->m_deques)
+        {
+            if (!deque.IsEmpty()) return true;
+        }
+    }
+
+    return false;
+}
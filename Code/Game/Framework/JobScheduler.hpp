@@ -0,0 +1,181 @@
+//----------------------------------------------------------------------------------------------------
+// JobScheduler.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ThreadTopology.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Loaded from the <JobScheduler> element of Data/GameConfig.xml; m_threads from the matching <Pool>
+// of the <Threading> block.
+//
+struct sJobSchedulerConfig
+{
+    sThreadPoolConfig m_threads       = { .m_name = "Jobs" };     // Thread count 0 = one per physical core, minus the main thread's
+    int               m_dequeCapacity = 4096;                     // Jobs per worker deque and lane, rounded up to a power of two; overflow goes to the shared queue
+};
+
+//----------------------------------------------------------------------------------------------------
+// Lanes, most urgent first. A thread looking for work empties every source of a lane (its own deque,
+// the shared queue, the other workers' deques) before it looks at the next one.
+//
+enum class eJobPriority : uint8_t
+{
+    FRAME_CRITICAL,     // Work the current frame is waiting on
+    NORMAL,
+    BACKGROUND,         // Streaming, baking, scans: only runs on otherwise idle threads
+    COUNT
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sJobSchedulerStats
+{
+    uint64_t m_executedCount = 0;       // Jobs run, by workers and by threads helping in Wait()/ParallelFor()
+    uint64_t m_stolenCount   = 0;       // Of those, taken from another worker's deque
+    uint64_t m_sharedCount   = 0;       // Of those, taken from the shared queue
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sJob;
+
+//----------------------------------------------------------------------------------------------------
+// Shared reference to a submitted job, to wait on it or make other jobs depend on it. An empty handle
+// counts as complete.
+//
+class JobHandle
+{
+public:
+    JobHandle() = default;
+    ~JobHandle();
+
+    JobHandle(JobHandle const& other);
+    JobHandle(JobHandle&& other) noexcept;
+    JobHandle& operator=(JobHandle const& other);
+    JobHandle& operator=(JobHandle&& other) noexcept;
+
+    bool IsValid() const;
+    bool IsComplete() const;
+
+private:
+    friend class JobScheduler;
+
+    explicit JobHandle(sJob* job);
+
+    sJob* m_job = nullptr;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Single-owner / multi-thief deque of jobs (Chase-Lev). The owning worker pushes and pops at the
+// bottom, newest first, without locks; other threads steal from the top, oldest first, with one
+// compare-and-swap. Fixed capacity: Push() fails when full.
+//
+class JobDeque
+{
+public:
+    explicit JobDeque(int capacity);
+
+    bool  Push(sJob* job);
+    sJob* Pop();
+    sJob* Steal();
+
+    bool IsEmpty() const;
+
+private:
+    std::vector<std::atomic<sJob*>>  m_slots;
+    int64_t                          m_mask = 0;
+    alignas(64) std::atomic<int64_t> m_top{0};
+    alignas(64) std::atomic<int64_t> m_bottom{0};
+};
+
+//----------------------------------------------------------------------------------------------------
+// Game-side work-stealing scheduler for CPU-bound work the game splits itself (atlas baking, image
+// scans, vertex building).
+//
+// The Engine's JobSystem runs the ResourceSubsystem's loads; this pool is for the game's own jobs.
+// Each worker has a deque per priority lane. Jobs a worker submits go on its own deque, where it runs
+// them newest first while idle workers steal the oldest; jobs from other threads go through a shared
+// queue per lane. A job may depend on others and only becomes runnable when they have all finished,
+// which is how graphs and continuations (Then) are built. Threads that wait, in Wait() or
+// ParallelFor(), run jobs meanwhile instead of blocking, but only jobs at least as urgent as the one
+// they wait for, so a FRAME_CRITICAL wait is never stuck behind a BACKGROUND bake. Workers are
+// placed by m_threads: count, affinity, stack size, and how long they spin looking for work before
+// they sleep.
+//
+class JobScheduler
+{
+public:
+    explicit JobScheduler(sJobSchedulerConfig const& config);
+    ~JobScheduler();
+
+    JobScheduler(JobScheduler const&)            = delete;
+    JobScheduler& operator=(JobScheduler const&) = delete;
+
+    JobHandle Submit(std::function<void()> job, eJobPriority priority = eJobPriority::NORMAL, std::span<JobHandle const> dependencies = {});
+    JobHandle Then(JobHandle const& dependency, std::function<void()> job, eJobPriority priority = eJobPriority::NORMAL);
+    void      Wait(JobHandle const& job);
+    void      ParallelFor(int count, std::function<void(int)> const& body, eJobPriority priority = eJobPriority::NORMAL);
+
+    static int ResolveWorkerCount(sJobSchedulerConfig const& config);
+
+    int                        GetWorkerCount() const;
+    sJobSchedulerStats         GetStats() const;
+    sJobSchedulerConfig const& GetConfig() const;
+    ThreadPoolUsage const&     GetUsage() const;
+
+private:
+    struct sWorker
+    {
+        explicit sWorker(int dequeCapacity);
+
+        JobDeque              m_deques[static_cast<int>(eJobPriority::COUNT)];
+        PoolThread            m_thread;
+        std::atomic<uint64_t> m_executedCount{0};
+        std::atomic<uint64_t> m_stolenCount{0};
+        std::atomic<uint64_t> m_sharedCount{0};
+        uint32_t              m_stealSeed = 0;
+    };
+
+    void  WorkerMain(int workerIndex);
+    void  Schedule(sJob* job);
+    void  Complete(sJob* job);
+    void  ScheduleReady(sJob* job, bool isWaiting);
+    sJob* FindJob(int workerIndex, uint32_t& stealSeed, int& outSource, eJobPriority leastUrgent = eJobPriority::BACKGROUND);
+    bool  RunOneJob(eJobPriority leastUrgent);
+    void  Execute(sJob* job, int workerIndex, int source);
+    bool  HasQueuedJobs() const;
+
+    sJobSchedulerConfig                   m_config;
+    std::vector<std::unique_ptr<sWorker>> m_workers;
+    std::unique_ptr<ThreadPoolUsage>      m_usage;
+
+    // Shared queues, for jobs submitted off the workers and for full deques
+    mutable std::mutex m_sharedMutex;
+    std::deque<sJob*>  m_shared[static_cast<int>(eJobPriority::COUNT)];
+    std::atomic<int>   m_sharedQueuedCount{0};
+
+    // Jobs submitted with unfinished dependencies; the destructor runs them before the workers quit
+    std::atomic<int> m_waitingCount{0};
+
+    // Idle workers sleep until a job is scheduled
+    std::mutex              m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+    std::atomic<uint64_t>   m_wakeEpoch{0};
+    std::atomic<int>        m_sleepingCount{0};
+    bool                    m_isQuitting = false;         // Guarded by m_sleepMutex
+
+    std::atomic<uint64_t> m_helperExecutedCount{0};        // Jobs run by threads that are not workers
+    std::atomic<uint64_t> m_helperStolenCount{0};
+    std::atomic<uint64_t> m_helperSharedCount{0};
+};
@@ -0,0 +1,918 @@
+//----------------------------------------------------------------------------------------------------
+// LogArchive.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/LogArchive.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/BlockCodec.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+#include "Engine/Core/Time.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    uint32_t constexpr BLOCK_MAGIC   = 0x425A4C47u;     // "GLZB"
+    uint32_t constexpr INDEX_MAGIC   = 0x58444947u;     // "GIDX"
+    uint32_t constexpr INDEX_VERSION = 1;
+
+    uint64_t constexpr ACTIVE_GROW_BYTES = 8ull * 1024 * 1024;
+
+    //------------------------------------------------------------------------------------------------
+    // <name>.gidx: this, the category names (a uint16 length, then the name), then an sIndexBlock per block.
+    struct sIndexHeader
+    {
+        uint32_t m_magic           = 0;
+        uint32_t m_version         = 0;
+        uint32_t m_blockCount      = 0;
+        uint32_t m_categoryCount   = 0;
+        uint64_t m_rawBytes        = 0;
+        uint64_t m_compressedBytes = 0;     // Size of the .glz
+        double   m_firstSeconds    = 0.0;
+        double   m_lastSeconds     = 0.0;
+    };
+
+    struct sIndexBlock
+    {
+        uint64_t m_offset          = 0;     // Of the block's sBlockHeader in the .glz
+        uint32_t m_compressedBytes = 0;     // Payload after the sBlockHeader
+        uint32_t m_rawBytes        = 0;
+        uint32_t m_lineCount       = 0;
+        uint32_t m_verbosityMask   = 0;     // Bit per verbosity value, capped at 31
+        uint64_t m_threadMask      = 0;     // Bit per thread index modulo 64
+        uint64_t m_categoryMask    = 0;     // Bit per index in the category table; the last bit also stands for every later one
+        double   m_firstSeconds    = 0.0;
+        double   m_lastSeconds     = 0.0;
+    };
+
+    // <name>.glz: per block, this and then its payload
+    struct sBlockHeader
+    {
+        uint32_t m_magic           = 0;
+        uint32_t m_encoding        = 0;     // eBlockEncoding
+        uint32_t m_rawBytes        = 0;
+        uint32_t m_sequenceBytes   = 0;     // LZ sequences, before the Huffman stage
+        uint32_t m_compressedBytes = 0;
+        uint32_t m_lineCount       = 0;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    // Days since 1970-01-01 of a proleptic Gregorian date, and back (H. Hinnant's algorithms).
+    int64_t DaysFromCivil(int64_t year, int const month, int const day)
+    {
+        year -= month <= 2 ? 1 : 0;
+
+        int64_t const era       = (year >= 0 ? year : year - 399) / 400;
+        int64_t const yearOfEra = year - era * 400;
+        int64_t const dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        int64_t const dayOfEra  = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    void CivilFromDays(int64_t days, int64_t& outYear, int& outMonth, int& outDay)
+    {
+        days += 719468;
+
+        int64_t const era       = (days >= 0 ? days : days - 146096) / 146097;
+        int64_t const dayOfEra  = days - era * 146097;
+        int64_t const yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        int64_t const dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        int64_t const monthKey  = (5 * dayOfYear + 2) / 153;
+
+        outDay   = static_cast<int>(dayOfYear - (153 * monthKey + 2) / 5 + 1);
+        outMonth = static_cast<int>(monthKey < 10 ? monthKey + 3 : monthKey - 9);
+        outYear  = yearOfEra + era * 400 + (outMonth <= 2 ? 1 : 0);
+    }
+
+    double GetUnixSecondsNow()
+    {
+        return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Reads digits into outValue; false unless exactly count digits are there.
+    bool ParseDigits(std::string_view const text, size_t const start, size_t const count, int64_t& outValue)
+    {
+        if (start + count > text.size()) return false;
+
+        outValue = 0;
+
+        for (size_t index = start; index < start + count; ++index)
+        {
+            if (text[index] < '0' || text[index] > '9') return false;
+            outValue = outValue * 10 + (text[index] - '0');
+        }
+
+        return true;
+    }
+
+    // Parses "(<prefix><unsigned>)" at cursor, advancing past it.
+    bool ParseTaggedNumber(std::string_view const line, size_t& cursor, char const prefix, int& outValue)
+    {
+        if (cursor + 3 > line.size() || line[cursor] != '(' || line[cursor + 1] != prefix) return false;
+
+        size_t index = cursor + 2;
+        int    value = 0;
+
+        while (index < line.size() && line[index] >= '0' && line[index] <= '9')
+        {
+            value = value * 10 + (line[index] - '0');
+            ++index;
+        }
+
+        if (index == cursor + 2 || index >= line.size() || line[index] != ')') return false;
+
+        outValue = value;
+        cursor   = index + 1;
+
+        return true;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // The smallest of the block encodings for text; out holds the payload to write after header.
+    void EncodeBlock(std::string_view const text, sBlockHeader& header, std::vector<uint8_t>& out)
+    {
+        sBlockEncoding encoding;
+        ::EncodeBlock(reinterpret_cast<uint8_t const*>(text.data()), text.size(), encoding, out);
+
+        header.m_magic           = BLOCK_MAGIC;
+        header.m_encoding        = static_cast<uint32_t>(encoding.m_encoding);
+        header.m_rawBytes        = encoding.m_rawBytes;
+        header.m_sequenceBytes   = encoding.m_sequenceBytes;
+        header.m_compressedBytes = encoding.m_compressedBytes;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    bool DecodeBlock(sBlockHeader const& header, uint8_t const* payload, std::vector<uint8_t>& out)
+    {
+        sBlockEncoding encoding;
+        encoding.m_encoding        = static_cast<eBlockEncoding>(header.m_encoding);
+        encoding.m_rawBytes        = header.m_rawBytes;
+        encoding.m_sequenceBytes   = header.m_sequenceBytes;
+        encoding.m_compressedBytes = header.m_compressedBytes;
+
+        out.resize(header.m_rawBytes);
+
+        return ::DecodeBlock(encoding, payload, out.data());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    bool ReadWholeFile(std::filesystem::path const& path, std::vector<uint8_t>& out)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return false;
+
+        std::streamsize const size = file.tellg();
+        if (size < 0) return false;
+
+        out.resize(static_cast<size_t>(size));
+        file.seekg(0);
+
+        return size == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(out.data()), size));
+    }
+
+    // Sorted by name, which starts with the segment's rotation time
+    std::vector<std::filesystem::path> ListFiles(std::filesystem::path const& directory, char const* extension)
+    {
+        std::vector<std::filesystem::path> paths;
+        std::error_code                    errorCode;
+
+        for (std::filesystem::directory_entry const& entry : std::filesystem::directory_iterator(directory, errorCode))
+        {
+            if (entry.is_regular_file(errorCode) && entry.path().extension() == extension)
+            {
+                paths.push_back(entry.path());
+            }
+        }
+
+        std::sort(paths.begin(), paths.end());
+
+        return paths;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Writes unixSeconds as "2026-10-16T12:34:56.123456Z".
+/// @return The characters written, or 0 if out is too small.
+int FormatLogTimestamp(double const unixSeconds, char* out, int const outSize)
+{
+    int64_t const micros     = static_cast<int64_t>(unixSeconds * 1.0e6 + (unixSeconds >= 0.0 ? 0.5 : -0.5));
+    int64_t       seconds    = micros / 1000000;
+    int64_t       fraction   = micros % 1000000;
+
+    if (fraction < 0)
+    {
+        fraction += 1000000;
+        --seconds;
+    }
+
+    int64_t days          = seconds / 86400;
+    int64_t secondsOfDay  = seconds % 86400;
+
+    if (secondsOfDay < 0)
+    {
+        secondsOfDay += 86400;
+        --days;
+    }
+
+    int64_t year;
+    int     month;
+    int     day;
+    CivilFromDays(days, year, month, day);
+
+    int const length = std::snprintf(out, static_cast<size_t>(outSize), "%04lld-%02d-%02dT%02d:%02d:%02d.%06lldZ",
+                                     static_cast<long long>(year), month, day,
+                                     static_cast<int>(secondsOfDay / 3600), static_cast<int>(secondsOfDay / 60 % 60), static_cast<int>(secondsOfDay % 60),
+                                     static_cast<long long>(fraction));
+
+    return length > 0 && length < outSize ? length : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Reads "YYYY-MM-DD", optionally followed by "THH:MM", ":SS" and ".ffffff", and an optional 'Z'.
+/// Times are UTC.
+bool ParseLogTimestamp(std::string_view const text, double& outUnixSeconds)
+{
+    int64_t year;
+    int64_t month;
+    int64_t day;
+
+    if (!ParseDigits(text, 0, 4, year) || text.size() < 10 || text[4] != '-' || text[7] != '-') return false;
+    if (!ParseDigits(text, 5, 2, month) || !ParseDigits(text, 8, 2, day)) return false;
+    if (month < 1 || month > 12 || day < 1 || day > 31) return false;
+
+    int64_t hour   = 0;
+    int64_t minute = 0;
+    int64_t second = 0;
+    double  fraction = 0.0;
+    size_t  cursor   = 10;
+
+    if (cursor < text.size() && (text[cursor] == 'T' || text[cursor] == ' '))
+    {
+        if (!ParseDigits(text, cursor + 1, 2, hour) || cursor + 3 >= text.size() || text[cursor + 3] != ':' || !ParseDigits(text, cursor + 4, 2, minute)) return false;
+        cursor += 6;
+
+        if (cursor < text.size() && text[cursor] == ':')
+        {
+            if (!ParseDigits(text, cursor + 1, 2, second)) return false;
+            cursor += 3;
+
+            if (cursor < text.size() && text[cursor] == '.')
+            {
+                double scale = 0.1;
+                ++cursor;
+
+                while (cursor < text.size() && text[cursor] >= '0' && text[cursor] <= '9')
+                {
+                    fraction += (text[cursor] - '0') * scale;
+                    scale    *= 0.1;
+                    ++cursor;
+                }
+            }
+        }
+    }
+
+    if (cursor < text.size() && text[cursor] == 'Z') ++cursor;
+    if (cursor != text.size()) return false;
+
+    outUnixSeconds = static_cast<double>(DaysFromCivil(year, static_cast<int>(month), static_cast<int>(day)) * 86400 + hour * 3600 + minute * 60 + second) + fraction;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Writes "[timestamp](t3)(v4)(category) ", the part of an archived line before its text.
+int FormatLogLinePrefix(double const unixSeconds, int const threadIndex, int const verbosity, char const* category, char* out, int const outSize)
+{
+    int const timestampLength = FormatLogTimestamp(unixSeconds, out + 1, outSize - 1);
+    if (timestampLength == 0) return 0;
+
+    out[0] = '[';
+
+    int const restSize = outSize - 1 - timestampLength;
+    int const length   = std::snprintf(out + 1 + timestampLength, static_cast<size_t>(restSize), "](t%d)(v%d)(%s) ", threadIndex, verbosity, category);
+
+    return length > 0 && length < restSize ? 1 + timestampLength + length : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Splits a line written with FormatLogLinePrefix; the views point into line.
+bool ParseLogLinePrefix(std::string_view const line, sLogLinePrefix& outPrefix)
+{
+    if (line.empty() || line[0] != '[') return false;
+
+    size_t const timestampEnd = line.find(']');
+    if (timestampEnd == std::string_view::npos || !ParseLogTimestamp(line.substr(1, timestampEnd - 1), outPrefix.m_unixSeconds)) return false;
+
+    size_t cursor = timestampEnd + 1;
+
+    if (!ParseTaggedNumber(line, cursor, 't', outPrefix.m_threadIndex)) return false;
+    if (!ParseTaggedNumber(line, cursor, 'v', outPrefix.m_verbosity)) return false;
+    if (cursor >= line.size() || line[cursor] != '(') return false;
+
+    size_t const categoryEnd = line.find(')', cursor);
+    if (categoryEnd == std::string_view::npos) return false;
+
+    outPrefix.m_category = line.substr(cursor + 1, categoryEnd - cursor - 1);
+    cursor               = categoryEnd + 1;
+
+    if (cursor < line.size() && line[cursor] == ' ') ++cursor;
+    outPrefix.m_text = line.substr(cursor);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Queues any raw segments a crash left behind, previous active file included, then starts a new
+/// active segment and the compressor thread.
+LogArchive::LogArchive(String const& activePath, sLogArchiveConfig const& config, sThreadPoolConfig const& threads)
+    : m_config(config)
+    , m_activePath(activePath)
+{
+    std::error_code errorCode;
+    std::filesystem::create_directories(std::filesystem::path(m_activePath).parent_path(), errorCode);
+    std::filesystem::create_directories(m_config.m_archiveDirectory, errorCode);
+
+    for (std::filesystem::path const& leftover : ListFiles(m_config.m_archiveDirectory, ".log"))
+    {
+        m_queue.push_back(leftover.string());
+    }
+
+    if (std::filesystem::file_size(m_activePath, errorCode) > 0 && !errorCode)
+    {
+        // The active file is mapped zero-filled past what was written, so one that starts with a NUL
+        // never got a line and would archive to an empty .glz that still counts against retention
+        std::ifstream activeFile(m_activePath, std::ios::binary);
+        int const     firstByte = activeFile.get();
+        activeFile.close();
+
+        if (firstByte == std::char_traits<char>::eof() || firstByte == '\0')
+        {
+            std::filesystem::remove(m_activePath, errorCode);
+        }
+        else
+        {
+            String const archived = MoveToArchive(m_activePath);
+            if (!archived.empty()) m_queue.push_back(archived);
+        }
+    }
+
+    OpenActiveSegment();
+
+    m_compressor.Start([this] { CompressorThreadMain(); }, threads, 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Archives the active segment and waits for every queued segment to be compressed.
+LogArchive::~LogArchive()
+{
+    if (m_activeUsed > 0)
+    {
+        RotateActiveSegment();
+    }
+
+    if (m_active.IsOpen())
+    {
+        m_active.Close(0);
+
+        std::error_code errorCode;
+        std::filesystem::remove(m_activePath, errorCode);
+    }
+
+    {
+        std::lock_guard lock(m_queueMutex);
+        m_isStopping = true;
+    }
+
+    m_queueCondition.notify_one();
+    m_compressor.Join();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool LogArchive::IsOpen() const
+{
+    return m_active.IsOpen();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Copies text into the mapped active segment, growing it a chunk at a time, and rotates once the
+/// segment reaches m_segmentMiB.
+void LogArchive::Append(char const* text, size_t const length)
+{
+    if (!m_active.IsOpen() || length == 0) return;
+
+    if (m_activeUsed + length > m_active.GetSize())
+    {
+        uint64_t const capacity = std::max(m_active.GetSize() + ACTIVE_GROW_BYTES, m_activeUsed + length);
+
+        if (!m_active.Grow(capacity))
+        {
+            DAEMON_LOG(LogGame, eLogVerbosity::Warning, Stringf("(LogArchive) cannot grow %s to %llu bytes", m_activePath.c_str(), static_cast<unsigned long long>(capacity)));
+            m_active.Close(m_activeUsed);
+            return;
+        }
+    }
+
+    std::memcpy(m_active.GetData() + m_activeUsed, text, length);
+    m_activeUsed += length;
+
+    if (m_activeUsed >= static_cast<uint64_t>(m_config.m_segmentMiB) * 1024 * 1024)
+    {
+        RotateActiveSegment();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Rotates a non-empty segment that has been open m_segmentMinutes, or when RequestRotation() asked.
+void LogArchive::Poll()
+{
+    bool const isRequested = m_isRotationRequested.exchange(false, std::memory_order_relaxed);
+    bool const isExpired   = GetCurrentTimeSeconds() - m_activeOpenSeconds >= static_cast<double>(m_config.m_segmentMinutes) * 60.0;
+
+    if ((isRequested || isExpired) && m_activeUsed > 0)
+    {
+        RotateActiveSegment();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// The logging thread rotates on its next Poll().
+void LogArchive::RequestRotation()
+{
+    m_isRotationRequested.store(true, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Blocks until every segment queued so far is compressed and indexed.
+void LogArchive::WaitForCompression()
+{
+    std::unique_lock lock(m_queueMutex);
+    m_idleCondition.wait(lock, [this]() { return m_queue.empty() && !m_isCompressing; });
+}
+
+//----------------------------------------------------------------------------------------------------
+sLogArchiveConfig const& LogArchive::GetConfig() const
+{
+    return m_config;
+}
+
+//----------------------------------------------------------------------------------------------------
+ThreadPoolUsage const& LogArchive::GetUsage() const
+{
+    return m_usage;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Appends the lines of archiveDirectory matching query to outLines, oldest first, up to its
+/// m_maxLines. Every index is read (the stats total every segment) but only the blocks whose time
+/// range and masks can hold a match are decompressed.
+/// @return false if archiveDirectory cannot be read.
+STATIC bool LogArchive::Query(String const& archiveDirectory, sLogQuery const& query, std::vector<String>& outLines, sLogQueryStats& outStats)
+{
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    outStats = sLogQueryStats();
+
+    std::error_code errorCode;
+    if (!std::filesystem::is_directory(archiveDirectory, errorCode)) return false;
+
+    uint32_t const verbosityMask = query.m_maxVerbosity >= 31 ? 0xFFFFFFFFu : (1u << (query.m_maxVerbosity + 1)) - 1;
+    uint64_t const threadMask    = query.m_threadIndex >= 0 ? 1ull << (query.m_threadIndex % 64) : ~0ull;
+
+    std::vector<uint8_t> indexBytes;
+    std::vector<uint8_t> rawBlock;
+    MappedFile           archive;
+
+    for (std::filesystem::path const& indexPath : ListFiles(archiveDirectory, ".gidx"))
+    {
+        if (!ReadWholeFile(indexPath, indexBytes) || indexBytes.size() < sizeof(sIndexHeader)) continue;
+
+        sIndexHeader header;
+        std::memcpy(&header, indexBytes.data(), sizeof(header));
+        if (header.m_magic != INDEX_MAGIC || header.m_version != INDEX_VERSION) continue;
+
+        // Category table: uint16 length, then the name
+        size_t   cursor       = sizeof(sIndexHeader);
+        uint64_t categoryMask = query.m_category.empty() ? ~0ull : 0;
+
+        for (uint32_t category = 0; category < header.m_categoryCount && cursor + 2 <= indexBytes.size(); ++category)
+        {
+            uint16_t length;
+            std::memcpy(&length, indexBytes.data() + cursor, sizeof(length));
+            cursor += 2;
+
+            if (!query.m_category.empty() && std::string_view(reinterpret_cast<char const*>(indexBytes.data() + cursor), length) == query.m_category)
+            {
+                categoryMask = 1ull << std::min<uint32_t>(category, 63);
+            }
+
+            cursor += length;
+        }
+
+        if (cursor + static_cast<size_t>(header.m_blockCount) * sizeof(sIndexBlock) > indexBytes.size()) continue;
+
+        ++outStats.m_segmentCount;
+        outStats.m_blockCount   += static_cast<int>(header.m_blockCount);
+        outStats.m_rawBytes     += header.m_rawBytes;
+        outStats.m_archiveBytes += header.m_compressedBytes + indexBytes.size();
+
+        bool const isFull = static_cast<int>(outLines.size()) >= query.m_maxLines;
+
+        if (isFull || categoryMask == 0 || header.m_lastSeconds < query.m_fromUnixSeconds || header.m_firstSeconds > query.m_toUnixSeconds) continue;
+
+        std::filesystem::path archivePath = indexPath;
+        archivePath.replace_extension(".glz");
+
+        for (uint32_t blockIndex = 0; blockIndex < header.m_blockCount && static_cast<int>(outLines.size()) < query.m_maxLines; ++blockIndex)
+        {
+            sIndexBlock block;
+            std::memcpy(&block, indexBytes.data() + cursor + blockIndex * sizeof(sIndexBlock), sizeof(block));
+
+            if (block.m_lastSeconds < query.m_fromUnixSeconds || block.m_firstSeconds > query.m_toUnixSeconds) continue;
+            if ((block.m_verbosityMask & verbosityMask) == 0 || (block.m_threadMask & threadMask) == 0 || (block.m_categoryMask & categoryMask) == 0) continue;
+
+            if (!archive.IsOpen())
+            {
+                if (!archive.OpenForRead(archivePath.string())) break;
+                ++outStats.m_segmentsOpened;
+            }
+
+            if (block.m_offset + sizeof(sBlockHeader) + block.m_compressedBytes > archive.GetSize()) break;
+
+            sBlockHeader blockHeader;
+            std::memcpy(&blockHeader, archive.GetData() + block.m_offset, sizeof(blockHeader));
+
+            if (blockHeader.m_magic != BLOCK_MAGIC || blockHeader.m_compressedBytes != block.m_compressedBytes) break;
+            if (!DecodeBlock(blockHeader, archive.GetData() + block.m_offset + sizeof(sBlockHeader), rawBlock)) continue;
+
+            ++outStats.m_blocksDecompressed;
+
+            std::string_view const text(reinterpret_cast<char const*>(rawBlock.data()), rawBlock.size());
+            size_t                 lineStart = 0;
+
+            while (lineStart < text.size() && static_cast<int>(outLines.size()) < query.m_maxLines)
+            {
+                size_t lineEnd = text.find('\n', lineStart);
+                if (lineEnd == std::string_view::npos) lineEnd = text.size();
+
+                std::string_view const line = text.substr(lineStart, lineEnd - lineStart);
+                sLogLinePrefix         prefix;
+                lineStart = lineEnd + 1;
+
+                if (!ParseLogLinePrefix(line, prefix)) continue;
+                if (prefix.m_unixSeconds < query.m_fromUnixSeconds || prefix.m_unixSeconds > query.m_toUnixSeconds) continue;
+                if (prefix.m_verbosity > query.m_maxVerbosity) continue;
+                if (query.m_threadIndex >= 0 && prefix.m_threadIndex != query.m_threadIndex) continue;
+                if (!query.m_category.empty() && prefix.m_category != query.m_category) continue;
+                if (!query.m_text.empty() && prefix.m_text.find(query.m_text) == std::string_view::npos) continue;
+
+                outLines.emplace_back(line);
+                ++outStats.m_matchCount;
+            }
+        }
+
+        archive.Close();
+    }
+
+    outStats.m_seconds = GetCurrentTimeSeconds() - startSeconds;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool LogArchive::OpenActiveSegment()
+{
+    m_activeUsed        = 0;
+    m_activeOpenSeconds = GetCurrentTimeSeconds();
+
+    uint64_t const segmentBytes = static_cast<uint64_t>(std::max(m_config.m_segmentMiB, 1)) * 1024 * 1024;
+
+    if (!m_active.CreateForWrite(m_activePath, std::min(segmentBytes, ACTIVE_GROW_BYTES)))
+    {
+        DAEMON_LOG(LogGame, eLogVerbosity::Warning, Stringf("(LogArchive) cannot open %s for writing", m_activePath.c_str()));
+        return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Cuts the active segment to its length, moves it into the archive directory for the compressor
+/// and opens a new one.
+void LogArchive::RotateActiveSegment()
+{
+    m_active.Close(m_activeUsed);
+
+    String const archived = MoveToArchive(m_activePath);
+
+    if (!archived.empty())
+    {
+        {
+            std::lock_guard lock(m_queueMutex);
+            m_queue.push_back(archived);
+        }
+
+        m_queueCondition.notify_one();
+    }
+
+    OpenActiveSegment();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Renames path to "<archive directory>/<stem>_<YYYYMMDD_HHMMSS>_<sequence>.log", by the current UTC time.
+/// @return The new path, empty if the move failed.
+String LogArchive::MoveToArchive(String const& path)
+{
+    char timestamp[40];
+    FormatLogTimestamp(GetUnixSecondsNow(), timestamp, sizeof(timestamp));
+
+    // "2026-10-16T12:34:56" -> "20261016_123456"
+    char const stamp[] = { timestamp[0], timestamp[1], timestamp[2], timestamp[3], timestamp[5], timestamp[6], timestamp[8], timestamp[9], '_',
+                           timestamp[11], timestamp[12], timestamp[14], timestamp[15], timestamp[17], timestamp[18], '\0' };
+
+    std::filesystem::path const source(path);
+    std::filesystem::path const target = std::filesystem::path(m_config.m_archiveDirectory) / Stringf("%s_%s_%04d.log", source.stem().string().c_str(), stamp, m_segmentSequence++);
+
+    std::error_code errorCode;
+    std::filesystem::rename(source, target, errorCode);
+
+    // Across volumes a rename cannot work
+    if (errorCode)
+    {
+        errorCode.clear();
+        std::filesystem::copy_file(source, target, std::filesystem::copy_options::overwrite_existing, errorCode);
+        if (!errorCode) std::filesystem::remove(source, errorCode);
+    }
+
+    if (errorCode)
+    {
+        DAEMON_LOG(LogGame, eLogVerbosity::Warning, Stringf("(LogArchive) cannot move %s to %s", path.c_str(), target.string().c_str()));
+        return String();
+    }
+
+    return target.string();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Compresses queued segments one at a time, oldest first; after the destructor asks it to stop it
+/// still empties the queue.
+void LogArchive::CompressorThreadMain()
+{
+    std::unique_lock lock(m_queueMutex);
+
+    while (true)
+    {
+        m_queueCondition.wait(lock, [this]() { return m_isStopping || !m_queue.empty(); });
+
+        if (m_queue.empty()) return;
+
+        String const rawPath = m_queue.front();
+        m_queue.pop_front();
+        m_isCompressing = true;
+
+        lock.unlock();
+        m_usage.BeginBusy(0);
+
+        if (CompressSegment(rawPath))
+        {
+            EnforceRetention();
+        }
+
+        m_usage.EndBusy(0);
+        lock.lock();
+
+        m_isCompressing = false;
+        m_idleCondition.notify_all();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Writes rawPath's lines as <stem>.glz and <stem>.gidx, then deletes it. A segment left by a crash
+/// ends at its first NUL, where the mapped capacity was never written.
+bool LogArchive::CompressSegment(String const& rawPath) const
+{
+    std::filesystem::path archivePath = rawPath;
+    std::filesystem::path indexPath   = rawPath;
+    archivePath.replace_extension(".glz");
+    indexPath.replace_extension(".gidx");
+
+    MappedFile raw;
+
+    if (!raw.OpenForRead(rawPath))
+    {
+        DAEMON_LOG(LogGame, eLogVerbosity::Warning, Stringf("(LogArchive) cannot read %s", rawPath.c_str()));
+        return false;
+    }
+
+    char const*  data     = reinterpret_cast<char const*>(raw.GetData());
+    size_t       dataSize = static_cast<size_t>(raw.GetSize());
+    void const*  firstNul = data != nullptr ? std::memchr(data, '\0', dataSize) : nullptr;
+
+    if (firstNul != nullptr) dataSize = static_cast<size_t>(static_cast<char const*>(firstNul) - data);
+
+    std::ofstream archive(archivePath, std::ios::binary | std::ios::trunc);
+
+    if (!archive.is_open())
+    {
+        DAEMON_LOG(LogGame, eLogVerbosity::Warning, Stringf("(LogArchive) cannot write %s", archivePath.string().c_str()));
+        return false;
+    }
+
+    size_t const blockBytes = static_cast<size_t>(std::max(m_config.m_blockKiB, 1)) * 1024;
+
+    sIndexHeader header;
+    header.m_magic        = INDEX_MAGIC;
+    header.m_version      = INDEX_VERSION;
+    header.m_firstSeconds = 1.0e300;
+    header.m_lastSeconds  = -1.0e300;
+
+    std::vector<sIndexBlock> blocks;
+    std::vector<String>      categories;
+    std::vector<uint8_t>     compressed;
+    uint64_t                 offset    = 0;
+    size_t                   blockFrom = 0;
+
+    while (blockFrom < dataSize)
+    {
+        // Whole lines up to blockBytes; a longer line makes a block of its own
+        size_t blockTo = std::min(blockFrom + blockBytes, dataSize);
+
+        if (blockTo < dataSize)
+        {
+            std::string_view const window(data + blockFrom, blockTo - blockFrom);
+            size_t const           lastNewline = window.rfind('\n');
+
+            if (lastNewline != std::string_view::npos)
+            {
+                blockTo = blockFrom + lastNewline + 1;
+            }
+            else
+            {
+                char const* newline = static_cast<char const*>(std::memchr(data + blockTo, '\n', dataSize - blockTo));
+                blockTo             = newline != nullptr ? static_cast<size_t>(newline - data) + 1 : dataSize;
+            }
+        }
+
+        sIndexBlock block;
+        block.m_offset       = offset;
+        block.m_rawBytes     = static_cast<uint32_t>(blockTo - blockFrom);
+        block.m_firstSeconds = 1.0e300;
+        block.m_lastSeconds  = -1.0e300;
+
+        std::string_view const text(data + blockFrom, blockTo - blockFrom);
+        size_t                 lineStart = 0;
+
+        while (lineStart < text.size())
+        {
+            size_t lineEnd = text.find('\n', lineStart);
+            if (lineEnd == std::string_view::npos) lineEnd = text.size();
+
+            sLogLinePrefix prefix;
+
+            if (ParseLogLinePrefix(text.substr(lineStart, lineEnd - lineStart), prefix))
+            {
+                auto const found         = std::find(categories.begin(), categories.end(), prefix.m_category);
+                size_t const category    = static_cast<size_t>(found - categories.begin());
+
+                if (found == categories.end()) categories.emplace_back(prefix.m_category);
+
+                ++block.m_lineCount;
+                block.m_verbosityMask |= 1u << std::clamp(prefix.m_verbosity, 0, 31);
+                block.m_threadMask    |= 1ull << (prefix.m_threadIndex % 64);
+                block.m_categoryMask  |= 1ull << std::min<size_t>(category, 63);
+                block.m_firstSeconds   = std::min(block.m_firstSeconds, prefix.m_unixSeconds);
+                block.m_lastSeconds    = std::max(block.m_lastSeconds, prefix.m_unixSeconds);
+            }
+
+            lineStart = lineEnd + 1;
+        }
+
+        sBlockHeader blockHeader;
+        EncodeBlock(text, blockHeader, compressed);
+
+        blockHeader.m_lineCount = block.m_lineCount;
+        block.m_compressedBytes = blockHeader.m_compressedBytes;
+
+        archive.write(reinterpret_cast<char const*>(&blockHeader), sizeof(blockHeader));
+        archive.write(reinterpret_cast<char const*>(compressed.data()), block.m_compressedBytes);
+
+        offset += sizeof(sBlockHeader) + block.m_compressedBytes;
+
+        header.m_rawBytes    += block.m_rawBytes;
+        header.m_firstSeconds = std::min(header.m_firstSeconds, block.m_firstSeconds);
+        header.m_lastSeconds  = std::max(header.m_lastSeconds, block.m_lastSeconds);
+
+        blocks.push_back(block);
+        blockFrom = blockTo;
+    }
+
+    archive.close();
+
+    if (archive.fail())
+    {
+        DAEMON_LOG(LogGame, eLogVerbosity::Warning, Stringf("(LogArchive) cannot write %s", archivePath.string().c_str()));
+        return false;
+    }
+
+    header.m_blockCount      = static_cast<uint32_t>(blocks.size());
+    header.m_categoryCount   = static_cast<uint32_t>(categories.size());
+    header.m_compressedBytes = offset;
+
+    // The index goes last, and whole, so queries never see a segment half written
+    std::filesystem::path temporaryPath = indexPath;
+    temporaryPath += ".tmp";
+
+    {
+        std::ofstream index(temporaryPath, std::ios::binary | std::ios::trunc);
+        index.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+        for (String const& category : categories)
+        {
+            uint16_t const length = static_cast<uint16_t>(std::min<size_t>(category.size(), 0xFFFF));
+            index.write(reinterpret_cast<char const*>(&length), sizeof(length));
+            index.write(category.data(), length);
+        }
+
+        index.write(reinterpret_cast<char const*>(blocks.data()), static_cast<std::streamsize>(blocks.size() * sizeof(sIndexBlock)));
+
+        if (!index.good())
+        {
+            DAEMON_LOG(LogGame, eLogVerbosity::Warning, Stringf("(LogArchive) cannot write %s", temporaryPath.string().c_str()));
+            return false;
+        }
+    }
+
+    std::error_code errorCode;
+    std::filesystem::rename(temporaryPath, indexPath, errorCode);
+    if (errorCode) return false;
+
+    raw.Close();
+    std::filesystem::remove(rawPath, errorCode);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Deletes the oldest archives until at most m_maxArchives are left, totalling at most m_maxArchiveMiB.
+void LogArchive::EnforceRetention() const
+{
+    std::vector<std::filesystem::path> const indexPaths = ListFiles(m_config.m_archiveDirectory, ".gidx");
+    std::vector<uint64_t>                    sizes;
+    uint64_t                                 totalBytes = 0;
+    std::error_code                          errorCode;
+
+    for (std::filesystem::path const& indexPath : indexPaths)
+    {
+        std::filesystem::path archivePath = indexPath;
+        archivePath.replace_extension(".glz");
+
+        uint64_t const indexBytes   = std::filesystem::file_size(indexPath, errorCode);
+        uint64_t const archiveBytes = std::filesystem::file_size(archivePath, errorCode);
+
+        sizes.push_back((errorCode ? 0 : archiveBytes) + indexBytes);
+        totalBytes += sizes.back();
+        errorCode.clear();
+    }
+
+    uint64_t const maxBytes = static_cast<uint64_t>(m_config.m_maxArchiveMiB) * 1024 * 1024;
+    size_t         count    = indexPaths.size();
+
+    for (size_t oldest = 0; oldest + 1 < indexPaths.size() && (count > static_cast<size_t>(m_config.m_maxArchives) || totalBytes > maxBytes); ++oldest)
+    {
+        std::filesystem::path archivePath = indexPaths[oldest];
+        archivePath.replace_extension(".glz");
+
+        // Index first, so a query never finds an index without its archive
+        std::filesystem::remove(indexPaths[oldest], errorCode);
+        std::filesystem::remove(archivePath, errorCode);
+
+        totalBytes -= sizes[oldest];
+        --count;
+    }
+}
@@ -0,0 +1,148 @@
+//----------------------------------------------------------------------------------------------------
+// LogArchive.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/MappedFile.hpp"
+#include "Game/Framework/ThreadTopology.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Loaded from the <LogArchive> element of Data/GameConfig.xml.
+//
+struct sLogArchiveConfig
+{
+    String m_archiveDirectory = "Logs/Archive";        // Compressed segments and their indices
+    int    m_segmentMiB       = 64;                    // Rotate once the active segment reaches this size...
+    float  m_segmentMinutes   = 60.f;                  // ...or has been open this long
+    int    m_blockKiB         = 64;                    // Text per compressed block; the unit a query decompresses
+    int    m_maxArchives      = 200;                   // Oldest compressed segments are deleted past either cap
+    int    m_maxArchiveMiB    = 500;
+};
+
+//----------------------------------------------------------------------------------------------------
+// The fields every archived line starts with:
+//   [2026-10-16T12:34:56.123456Z](t3)(v4)(LogGame) text
+// v is the eLogVerbosity value (lower is more severe) and t the producing thread's index.
+//
+struct sLogLinePrefix
+{
+    double           m_unixSeconds = 0.0;
+    int              m_threadIndex = 0;
+    int              m_verbosity   = 0;
+    std::string_view m_category;
+    std::string_view m_text;
+};
+
+int  FormatLogTimestamp(double unixSeconds, char* out, int outSize);
+bool ParseLogTimestamp(std::string_view text, double& outUnixSeconds);
+int  FormatLogLinePrefix(double unixSeconds, int threadIndex, int verbosity, char const* category, char* out, int outSize);
+bool ParseLogLinePrefix(std::string_view line, sLogLinePrefix& outPrefix);
+
+//----------------------------------------------------------------------------------------------------
+// Lines match when every filter set on the query matches.
+//
+struct sLogQuery
+{
+    double m_fromUnixSeconds = 0.0;
+    double m_toUnixSeconds   = 1.0e300;
+    int    m_maxVerbosity    = 255;         // Lines at this verbosity or more severe
+    int    m_threadIndex     = -1;          // -1 = any thread
+    String m_category;                      // Empty = any category
+    String m_text;                          // Substring of the text; empty = any
+    int    m_maxLines        = 100;         // The earliest matches are kept
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sLogQueryStats
+{
+    int      m_segmentCount       = 0;
+    int      m_segmentsOpened     = 0;      // Segments whose index left at least one block to read
+    int      m_blockCount         = 0;
+    int      m_blocksDecompressed = 0;
+    int      m_matchCount         = 0;
+    uint64_t m_rawBytes           = 0;      // Across every segment, before and after compression
+    uint64_t m_archiveBytes       = 0;
+    double   m_seconds            = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Rotating, compressed store for the BinaryLog file sink.
+//
+// Text lines are appended to the active segment through a memory-mapped file, grown a few MiB at a
+// time. When the segment reaches m_segmentMiB or m_segmentMinutes it is closed, cut to its length
+// and moved into the archive directory, and a background thread compresses it:
+//   <name>.glz   blocks of about m_blockKiB of text, each compressed on its own (LZ4-style: literal
+//                runs and back-references within the block) behind a small header, so any block
+//                decompresses without the others
+//   <name>.gidx  per block: its offset, its time range, and masks of the verbosities, threads and
+//                categories of its lines
+// The index is written last, so a segment is only visible to queries once it is complete. The
+// oldest archives are then deleted past m_maxArchives or m_maxArchiveMiB. Raw segments left by a
+// crash are picked up and compressed on the next start.
+//
+// Query() reads every index, skips the segments and blocks whose range and masks rule them out, and
+// decompresses only the blocks left, straight from the mapped .glz.
+//
+// Append() and Poll() belong to one thread (the logging thread); RequestRotation() and Query() may
+// be called from any. The compressor thread is placed as thread 1 of the logging thread's pool.
+//
+class LogArchive
+{
+public:
+    LogArchive(String const& activePath, sLogArchiveConfig const& config, sThreadPoolConfig const& threads);
+    ~LogArchive();
+
+    LogArchive(LogArchive const&)            = delete;
+    LogArchive& operator=(LogArchive const&) = delete;
+
+    bool IsOpen() const;
+    void Append(char const* text, size_t length);
+    void Poll();
+    void RequestRotation();
+    void WaitForCompression();
+
+    sLogArchiveConfig const& GetConfig() const;
+    ThreadPoolUsage const&   GetUsage() const;
+
+    static bool Query(String const& archiveDirectory, sLogQuery const& query, std::vector<String>& outLines, sLogQueryStats& outStats);
+
+private:
+    bool   OpenActiveSegment();
+    void   RotateActiveSegment();
+    String MoveToArchive(String const& path);
+    void   CompressorThreadMain();
+    bool   CompressSegment(String const& rawPath) const;
+    void   EnforceRetention() const;
+
+    sLogArchiveConfig m_config;
+    String            m_activePath;
+
+    // Logging thread
+    MappedFile m_active;
+    uint64_t   m_activeUsed        = 0;
+    double     m_activeOpenSeconds = 0.0;
+    int        m_segmentSequence   = 0;
+    std::atomic<bool> m_isRotationRequested{false};
+
+    // Compressor thread
+    PoolThread              m_compressor;
+    ThreadPoolUsage         m_usage{1};
+    std::mutex              m_queueMutex;
+    std::condition_variable m_queueCondition;
+    std::condition_variable m_idleCondition;
+    std::deque<String>      m_queue;                    // Raw segments in the archive directory, oldest first
+    bool                    m_isCompressing = false;
+    bool                    m_isStopping    = false;
+};
@@ -0,0 +1,175 @@
+//----------------------------------------------------------------------------------------------------
+// MappedFile.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/MappedFile.hpp"
+//----------------------------------------------------------------------------------------------------
+#define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
+#include <windows.h>			// #include this (massive, platform-specific) header in VERY few places (and .CPPs only)
+
+//----------------------------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Maps all of path read-only. An empty file opens with no data.
+bool MappedFile::OpenForRead(String const& path)
+{
+    Close();
+
+    HANDLE const file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file       = file;
+    m_size       = static_cast<uint64_t>(size.QuadPart);
+    m_isWritable = false;
+
+    if (m_size == 0) return true;
+
+    if (!MapView())
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Creates path, or truncates it, and maps capacity bytes of it for writing.
+bool MappedFile::CreateForWrite(String const& path, uint64_t const capacity)
+{
+    Close();
+
+    HANDLE const file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    m_file       = file;
+    m_size       = capacity;
+    m_isWritable = true;
+
+    if (!MapView())
+    {
+        Close(0);
+        return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Remaps a writable file at a larger capacity; the bytes written so far are kept, GetData() moves.
+bool MappedFile::Grow(uint64_t const capacity)
+{
+    if (!m_isWritable || m_file == nullptr) return false;
+    if (capacity <= m_size) return true;
+
+    UnmapView();
+    m_size = capacity;
+
+    return MapView();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Unmaps and closes the file. A writable file is first cut to usedSize if that is below its capacity.
+void MappedFile::Close(uint64_t const usedSize)
+{
+    if (m_file == nullptr) return;
+
+    UnmapView();
+
+    if (m_isWritable && usedSize < m_size)
+    {
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<LONGLONG>(usedSize);
+
+        SetFilePointerEx(static_cast<HANDLE>(m_file), end, nullptr, FILE_BEGIN);
+        SetEndOfFile(static_cast<HANDLE>(m_file));
+    }
+
+    CloseHandle(static_cast<HANDLE>(m_file));
+
+    m_file       = nullptr;
+    m_size       = 0;
+    m_isWritable = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool MappedFile::IsOpen() const
+{
+    return m_file != nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint8_t* MappedFile::GetData()
+{
+    return m_view;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint8_t const* MappedFile::GetData() const
+{
+    return m_view;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t MappedFile::GetSize() const
+{
+    return m_size;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Maps m_size bytes; for a writable file this also extends the file to m_size.
+bool MappedFile::MapView()
+{
+    DWORD const protection = m_isWritable ? PAGE_READWRITE : PAGE_READONLY;
+    DWORD const access     = m_isWritable ? FILE_MAP_WRITE : FILE_MAP_READ;
+
+    HANDLE const mapping = CreateFileMappingA(static_cast<HANDLE>(m_file), nullptr, protection, static_cast<DWORD>(m_size >> 32), static_cast<DWORD>(m_size & 0xFFFFFFFFu), nullptr);
+    if (mapping == nullptr) return false;
+
+    void* view = MapViewOfFile(mapping, access, 0, 0, 0);
+
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_view    = static_cast<uint8_t*>(view);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MappedFile::UnmapView()
+{
+    if (m_view != nullptr)
+    {
+        UnmapViewOfFile(m_view);
+        m_view = nullptr;
+    }
+
+    if (m_mapping != nullptr)
+    {
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+        m_mapping = nullptr;
+    }
+}
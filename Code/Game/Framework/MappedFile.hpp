@@ -0,0 +1,45 @@
+//----------------------------------------------------------------------------------------------------
+// MappedFile.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+// A file mapped into the address space, either read-only as a whole or writable with a capacity
+// that can grow. A writable file is as long as its capacity while mapped; Close() cuts it back to
+// the bytes actually used.
+//
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile const&)            = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    bool OpenForRead(String const& path);
+    bool CreateForWrite(String const& path, uint64_t capacity);
+    bool Grow(uint64_t capacity);
+    void Close(uint64_t usedSize = UINT64_MAX);
+
+    bool           IsOpen() const;
+    uint8_t*       GetData();
+    uint8_t const* GetData() const;
+    uint64_t       GetSize() const;
+
+private:
+    bool MapView();
+    void UnmapView();
+
+    void*    m_file       = nullptr;      // HANDLE
+    void*    m_mapping    = nullptr;      // HANDLE
+    uint8_t* m_view       = nullptr;
+    uint64_t m_size       = 0;
+    bool     m_isWritable = false;
+};
@@ -0,0 +1,202 @@
+//----------------------------------------------------------------------------------------------------
+// PrimitiveBatch2D.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/PrimitiveBatch2D.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/VertexBuilder2D.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/MathUtils.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    int constexpr NUM_SIDES      = PrimitiveBatch2D::NUM_CIRCLE_SIDES;
+    int constexpr NUM_HALF_SIDES = NUM_SIDES / 2;
+
+    int constexpr RING_VERTS    = 6 * NUM_SIDES;
+    int constexpr DISC_VERTS    = 3 * NUM_SIDES;
+    int constexpr LINE_VERTS    = 6;
+    int constexpr CAPSULE_VERTS = 6 + 2 * 3 * NUM_HALF_SIDES;
+
+    //------------------------------------------------------------------------------------------------
+    // Unit mesh for capsule caps: points on the half circle from -90 to +90 degrees. Full circles
+    // use the tables in VertexBuilder2D.
+    //
+    struct sUnitMeshes2D
+    {
+        Vec2 m_halfCircle[NUM_HALF_SIDES + 1];
+
+        sUnitMeshes2D()
+        {
+            float constexpr DEGREES_PER_SIDE = 360.f / static_cast<float>(NUM_SIDES);
+
+            for (int sideNum = 0; sideNum <= NUM_HALF_SIDES; ++sideNum)
+            {
+                float const degrees   = -90.f + DEGREES_PER_SIDE * static_cast<float>(sideNum);
+                m_halfCircle[sideNum] = Vec2(CosDegrees(degrees), SinDegrees(degrees));
+            }
+        }
+    };
+
+    sUnitMeshes2D const& GetUnitMeshes()
+    {
+        static sUnitMeshes2D const s_unitMeshes;
+        return s_unitMeshes;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void WriteTriangle(Vertex_PCU*& out, Vec2 const& a, Vec2 const& b, Vec2 const& c, Rgba8 const& color)
+    {
+        *out++ = Vertex_PCU(Vec3(a.x, a.y, 0.f), color);
+        *out++ = Vertex_PCU(Vec3(b.x, b.y, 0.f), color);
+        *out++ = Vertex_PCU(Vec3(c.x, c.y, 0.f), color);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Counter-clockwise quad a-b-c-d, as two triangles
+    void WriteQuad(Vertex_PCU*& out, Vec2 const& a, Vec2 const& b, Vec2 const& c, Vec2 const& d, Rgba8 const& color)
+    {
+        WriteTriangle(out, a, b, c, color);
+        WriteTriangle(out, a, c, d, color);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void sCircleColumns2D::Clear()
+{
+    m_centerX.clear();
+    m_centerY.clear();
+    m_radius.clear();
+    m_thickness.clear();
+    m_color.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void sLineColumns2D::Clear()
+{
+    m_startX.clear();
+    m_startY.clear();
+    m_endX.clear();
+    m_endY.clear();
+    m_thickness.clear();
+    m_color.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void PrimitiveBatch2D::AddRing(Vec2 const& center, float const radius, float const thickness, Rgba8 const& color)
+{
+    m_rings.m_centerX.push_back(center.x);
+    m_rings.m_centerY.push_back(center.y);
+    m_rings.m_radius.push_back(radius);
+    m_rings.m_thickness.push_back(thickness);
+    m_rings.m_color.push_back(color);
+}
+
+//----------------------------------------------------------------------------------------------------
+void PrimitiveBatch2D::AddDisc(Vec2 const& center, float const radius, Rgba8 const& color)
+{
+    m_discs.m_centerX.push_back(center.x);
+    m_discs.m_centerY.push_back(center.y);
+    m_discs.m_radius.push_back(radius);
+    m_discs.m_color.push_back(color);
+}
+
+//----------------------------------------------------------------------------------------------------
+void PrimitiveBatch2D::AddLine(Vec2 const& start, Vec2 const& end, float const thickness, Rgba8 const& color)
+{
+    m_lines.m_startX.push_back(start.x);
+    m_lines.m_startY.push_back(start.y);
+    m_lines.m_endX.push_back(end.x);
+    m_lines.m_endY.push_back(end.y);
+    m_lines.m_thickness.push_back(thickness);
+    m_lines.m_color.push_back(color);
+}
+
+//----------------------------------------------------------------------------------------------------
+void PrimitiveBatch2D::AddCapsule(Vec2 const& start, Vec2 const& end, float const radius, Rgba8 const& color)
+{
+    m_capsules.push_back({ start, end, radius, color });
+}
+
+//----------------------------------------------------------------------------------------------------
+void PrimitiveBatch2D::Clear()
+{
+    m_rings.Clear();
+    m_discs.Clear();
+    m_lines.Clear();
+    m_capsules.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PrimitiveBatch2D::IsEmpty() const
+{
+    return GetInstanceCount() == 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int PrimitiveBatch2D::GetInstanceCount() const
+{
+    return m_rings.GetCount() + m_discs.GetCount() + m_lines.GetCount() + static_cast<int>(m_capsules.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int PrimitiveBatch2D::GetInstanceBytes() const
+{
+    int constexpr RING_BYTES = 4 * sizeof(float) + sizeof(Rgba8);
+    int constexpr DISC_BYTES = 3 * sizeof(float) + sizeof(Rgba8);
+    int constexpr LINE_BYTES = 5 * sizeof(float) + sizeof(Rgba8);
+
+    return m_rings.GetCount() * RING_BYTES +
+           m_discs.GetCount() * DISC_BYTES +
+           m_lines.GetCount() * LINE_BYTES +
+           static_cast<int>(m_capsules.size() * sizeof(sCapsuleInstance2D));
+}
+
+//----------------------------------------------------------------------------------------------------
+int PrimitiveBatch2D::GetExpandedVertexCount() const
+{
+    return m_rings.GetCount() * RING_VERTS +
+           m_discs.GetCount() * DISC_VERTS +
+           m_lines.GetCount() * LINE_VERTS +
+           static_cast<int>(m_capsules.size()) * CAPSULE_VERTS;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// CPU expansion: append every instance's triangles (counter-clockwise) to outVerts.
+void PrimitiveBatch2D::ExpandInto(VertexList_PCU& outVerts) const
+{
+    AddVertsForRings2D(outVerts, { m_rings.m_centerX.data(), m_rings.m_centerY.data(), m_rings.m_radius.data(), m_rings.m_thickness.data(), m_rings.m_color.data(), m_rings.GetCount() }, NUM_SIDES);
+    AddVertsForDiscs2D(outVerts, { m_discs.m_centerX.data(), m_discs.m_centerY.data(), m_discs.m_radius.data(), nullptr, m_discs.m_color.data(), m_discs.GetCount() }, NUM_SIDES);
+    AddVertsForLineSegments2D(outVerts, { m_lines.m_startX.data(), m_lines.m_startY.data(), m_lines.m_endX.data(), m_lines.m_endY.data(), m_lines.m_thickness.data(), m_lines.m_color.data(), m_lines.GetCount() });
+
+    if (m_capsules.empty()) return;
+
+    sUnitMeshes2D const& unit = GetUnitMeshes();
+
+    size_t const firstVertex = outVerts.size();
+    outVerts.resize(firstVertex + m_capsules.size() * CAPSULE_VERTS);
+
+    Vertex_PCU* out = outVerts.data() + firstVertex;
+
+    for (sCapsuleInstance2D const& capsule : m_capsules)
+    {
+        Vec2 const forward = (capsule.m_end - capsule.m_start).GetNormalized();
+        Vec2 const left    = forward.GetRotated90Degrees();
+        Vec2 const offset  = left * capsule.m_radius;
+
+        WriteQuad(out, capsule.m_start - offset, capsule.m_end - offset, capsule.m_end + offset, capsule.m_start + offset, capsule.m_color);
+
+        // Half-circle points are in (forward, left) space; the start cap is the same fan rotated 180 degrees
+        for (int sideNum = 0; sideNum < NUM_HALF_SIDES; ++sideNum)
+        {
+            Vec2 const from = forward * unit.m_halfCircle[sideNum].x + left * unit.m_halfCircle[sideNum].y;
+            Vec2 const to   = forward * unit.m_halfCircle[sideNum + 1].x + left * unit.m_halfCircle[sideNum + 1].y;
+
+            WriteTriangle(out, capsule.m_end, capsule.m_end + from * capsule.m_radius, capsule.m_end + to * capsule.m_radius, capsule.m_color);
+            WriteTriangle(out, capsule.m_start, capsule.m_start - from * capsule.m_radius, capsule.m_start - to * capsule.m_radius, capsule.m_color);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+//----------------------------------------------------------------------------------------------------
+// PrimitiveBatch2D.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Renderer/Vertex_PCU.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Per-instance records, stored column by column so VertexBuilder2D can expand them with SIMD.
+//
+struct sCircleColumns2D
+{
+    std::vector<float> m_centerX;
+    std::vector<float> m_centerY;
+    std::vector<float> m_radius;        // Centre line of the band for rings
+    std::vector<float> m_thickness;     // Rings only
+    std::vector<Rgba8> m_color;
+
+    int  GetCount() const { return static_cast<int>(m_color.size()); }
+    void Clear();
+};
+
+struct sLineColumns2D
+{
+    std::vector<float> m_startX;
+    std::vector<float> m_startY;
+    std::vector<float> m_endX;
+    std::vector<float> m_endY;
+    std::vector<float> m_thickness;
+    std::vector<Rgba8> m_color;
+
+    int  GetCount() const { return static_cast<int>(m_color.size()); }
+    void Clear();
+};
+
+struct sCapsuleInstance2D
+{
+    Vec2  m_start;
+    Vec2  m_end;
+    float m_radius = 0.f;
+    Rgba8 m_color;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Instanced rings, discs, lines and capsules sharing one render state.
+//
+// Unit meshes (a cos/sin table per shape) are built once for the whole program; adding a primitive
+// only appends a 16-24 byte record instead of tessellating 96-192 vertices with trig on every call.
+// ExpandInto() is the CPU path that turns instances back into triangles: rings, discs and lines go
+// through the SIMD builders in VertexBuilder2D, capsules through the half-circle unit mesh. It is
+// what DrawList2D uses today, and it keeps the batch checkable without a GPU. An Engine-side
+// instanced draw can take the instance arrays as-is once the Renderer exposes one.
+//
+class PrimitiveBatch2D
+{
+public:
+    static int constexpr NUM_CIRCLE_SIDES = 32;
+
+    void AddRing(Vec2 const& center, float radius, float thickness, Rgba8 const& color);
+    void AddDisc(Vec2 const& center, float radius, Rgba8 const& color);
+    void AddLine(Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color);
+    void AddCapsule(Vec2 const& start, Vec2 const& end, float radius, Rgba8 const& color);
+
+    void Clear();
+    bool IsEmpty() const;
+    int  GetInstanceCount() const;
+    int  GetInstanceBytes() const;
+    int  GetExpandedVertexCount() const;
+
+    void ExpandInto(VertexList_PCU& outVerts) const;
+
+private:
+    sCircleColumns2D                m_rings;
+    sCircleColumns2D                m_discs;
+    sLineColumns2D                  m_lines;
+    std::vector<sCapsuleInstance2D> m_capsules;
+};
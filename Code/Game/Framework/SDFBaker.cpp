@@ -0,0 +1,268 @@
+//----------------------------------------------------------------------------------------------------
+// SDFBaker.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/SDFBaker.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/JobScheduler.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Time.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    double constexpr   INF_DISTANCE = 1.0e20;
+    uint32_t constexpr SDF_MAGIC    = 0x46445344;     // "DSDF"
+    uint32_t constexpr SDF_VERSION  = 1;
+
+    //------------------------------------------------------------------------------------------------
+    struct sSDFCacheHeader
+    {
+        uint32_t m_magic      = 0;
+        uint32_t m_version    = 0;
+        uint64_t m_sourceHash = 0;
+        int32_t  m_width      = 0;
+        int32_t  m_height     = 0;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    // Per-thread scratch for one cell; doubles so the "no texel" sentinel keeps the envelope exact
+    //
+    struct sEDTScratch
+    {
+        std::vector<double> m_inside;      // Squared distance to the nearest inside texel
+        std::vector<double> m_outside;     // Squared distance to the nearest outside texel
+        std::vector<double> m_line;
+        std::vector<double> m_envelopeZ;
+        std::vector<int>    m_envelopeV;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    // 1D squared distance transform of n samples, stride apart, in place:
+    // d[q] = min over p of (q - p)^2 + f[p], via the lower envelope of parabolas rooted at each p
+    //
+    void DistanceTransform1D(double* grid, int const stride, int const n, double* f, int* v, double* z)
+    {
+        v[0] = 0;
+        z[0] = -INF_DISTANCE;
+        z[1] = INF_DISTANCE;
+        f[0] = grid[0];
+
+        for (int q = 1, k = 0; q < n; ++q)
+        {
+            f[q] = grid[q * stride];
+
+            double const q2 = static_cast<double>(q) * q;
+            double       s  = 0.0;
+
+            do
+            {
+                int const r = v[k];
+                s           = (f[q] - f[r] + q2 - static_cast<double>(r) * r) / static_cast<double>(q - r) / 2.0;
+            }
+            while (s <= z[k] && --k > -1);
+
+            ++k;
+            v[k]     = q;
+            z[k]     = s;
+            z[k + 1] = INF_DISTANCE;
+        }
+
+        for (int q = 0, k = 0; q < n; ++q)
+        {
+            while (z[k + 1] < static_cast<double>(q)) ++k;
+
+            int const    r  = v[k];
+            double const qr = static_cast<double>(q - r);
+
+            grid[q * stride] = f[r] + qr * qr;
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // 2D transform of grid (width x height, row-major) in place: columns, then rows
+    //
+    void DistanceTransform2D(std::vector<double>& grid, int const width, int const height, sEDTScratch& scratch)
+    {
+        int const longest = width > height ? width : height;
+
+        scratch.m_line.resize(static_cast<size_t>(longest));
+        scratch.m_envelopeV.resize(static_cast<size_t>(longest));
+        scratch.m_envelopeZ.resize(static_cast<size_t>(longest) + 1);
+
+        for (int x = 0; x < width; ++x)
+        {
+            DistanceTransform1D(grid.data() + x, width, height, scratch.m_line.data(), scratch.m_envelopeV.data(), scratch.m_envelopeZ.data());
+        }
+
+        for (int y = 0; y < height; ++y)
+        {
+            DistanceTransform1D(grid.data() + static_cast<size_t>(y) * width, 1, width, scratch.m_line.data(), scratch.m_envelopeV.data(), scratch.m_envelopeZ.data());
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void BakeCell(Rgba8 const* sourceTexels, IntVec2 const& dimensions, sSDFBakeSettings const& settings, int const cellIndex, uint8_t* outDistances)
+    {
+        thread_local sEDTScratch t_scratch;
+
+        int const cellWidth  = dimensions.x / settings.m_cellCountX;
+        int const cellHeight = dimensions.y / settings.m_cellCountY;
+        int const originX    = (cellIndex % settings.m_cellCountX) * cellWidth;
+        int const originY    = (cellIndex / settings.m_cellCountX) * cellHeight;
+        int const cellTexels = cellWidth * cellHeight;
+
+        t_scratch.m_inside.resize(static_cast<size_t>(cellTexels));
+        t_scratch.m_outside.resize(static_cast<size_t>(cellTexels));
+
+        for (int y = 0; y < cellHeight; ++y)
+        {
+            Rgba8 const* sourceRow = sourceTexels + static_cast<size_t>(originY + y) * dimensions.x + originX;
+
+            for (int x = 0; x < cellWidth; ++x)
+            {
+                bool const isInside = sourceRow[x].a >= settings.m_alphaThreshold;
+
+                t_scratch.m_inside[y * cellWidth + x]  = isInside ? 0.0 : INF_DISTANCE;
+                t_scratch.m_outside[y * cellWidth + x] = isInside ? INF_DISTANCE : 0.0;
+            }
+        }
+
+        DistanceTransform2D(t_scratch.m_inside, cellWidth, cellHeight, t_scratch);
+        DistanceTransform2D(t_scratch.m_outside, cellWidth, cellHeight, t_scratch);
+
+        float const scale = 0.5f / settings.m_spreadTexels;
+
+        for (int y = 0; y < cellHeight; ++y)
+        {
+            uint8_t* outRow = outDistances + static_cast<size_t>(originY + y) * dimensions.x + originX;
+
+            for (int x = 0; x < cellWidth; ++x)
+            {
+                // Inside texels measure to the nearest outside texel and vice versa; the edge lies half a texel between them
+                double const toInside       = t_scratch.m_inside[y * cellWidth + x];
+                double const toOutside      = t_scratch.m_outside[y * cellWidth + x];
+                float const  signedDistance = static_cast<float>(toInside == 0.0 ? std::sqrt(toOutside) - 0.5 : 0.5 - std::sqrt(toInside));
+                float const  value          = std::clamp(0.5f + signedDistance * scale, 0.f, 1.f);
+
+                outRow[x] = static_cast<uint8_t>(value * 255.f + 0.5f);
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // FNV-1a over the texels and every setting that changes the output
+    //
+    uint64_t HashSource(Rgba8 const* sourceTexels, IntVec2 const& dimensions, sSDFBakeSettings const& settings)
+    {
+        uint64_t hash = 14695981039346656037ull;
+
+        auto const mix = [&hash](uint64_t const value)
+        {
+            hash ^= value;
+            hash *= 1099511628211ull;
+        };
+
+        size_t const texelCount = static_cast<size_t>(dimensions.x) * static_cast<size_t>(dimensions.y);
+
+        for (size_t index = 0; index < texelCount; ++index)
+        {
+            mix(sourceTexels[index].a);
+        }
+
+        mix(static_cast<uint64_t>(dimensions.x));
+        mix(static_cast<uint64_t>(dimensions.y));
+        mix(static_cast<uint64_t>(settings.m_cellCountX));
+        mix(static_cast<uint64_t>(settings.m_cellCountY));
+        mix(static_cast<uint64_t>(settings.m_spreadTexels * 1000.f));
+        mix(settings.m_alphaThreshold);
+        mix(SDF_VERSION);
+
+        return hash;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void BakeSDFAtlas(Rgba8 const* sourceTexels, IntVec2 const& dimensions, sSDFBakeSettings const& settings, std::vector<uint8_t>& outDistances)
+{
+    outDistances.assign(static_cast<size_t>(dimensions.x) * static_cast<size_t>(dimensions.y), 0);
+
+    if (sourceTexels == nullptr || settings.m_cellCountX <= 0 || settings.m_cellCountY <= 0) return;
+    if (dimensions.x < settings.m_cellCountX || dimensions.y < settings.m_cellCountY) return;
+
+    int const cellCount = settings.m_cellCountX * settings.m_cellCountY;
+
+    auto const bakeCell = [&](int const cellIndex)
+    {
+        BakeCell(sourceTexels, dimensions, settings, cellIndex, outDistances.data());
+    };
+
+    if (g_jobScheduler != nullptr)
+    {
+        g_jobScheduler->ParallelFor(cellCount, bakeCell);
+    }
+    else
+    {
+        for (int cellIndex = 0; cellIndex < cellCount; ++cellIndex) bakeCell(cellIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return false only when the bake could not run; a cache that cannot be written is not an error.
+bool BakeSDFAtlasCached(Rgba8 const* sourceTexels, IntVec2 const& dimensions, sSDFBakeSettings const& settings, String const& cachePath, std::vector<uint8_t>& outDistances, sSDFBakeStats& outStats)
+{
+    if (sourceTexels == nullptr || dimensions.x <= 0 || dimensions.y <= 0) return false;
+
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    outStats              = sSDFBakeStats();
+    outStats.m_sourceHash = HashSource(sourceTexels, dimensions, settings);
+
+    size_t const texelCount = static_cast<size_t>(dimensions.x) * static_cast<size_t>(dimensions.y);
+
+    {
+        std::ifstream   file(cachePath, std::ios::in | std::ios::binary);
+        sSDFCacheHeader header;
+
+        if (file.is_open() && file.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+            header.m_magic == SDF_MAGIC && header.m_version == SDF_VERSION && header.m_sourceHash == outStats.m_sourceHash &&
+            header.m_width == dimensions.x && header.m_height == dimensions.y)
+        {
+            outDistances.resize(texelCount);
+
+            if (file.read(reinterpret_cast<char*>(outDistances.data()), static_cast<std::streamsize>(texelCount)))
+            {
+                outStats.m_wasCached = true;
+                outStats.m_seconds   = GetCurrentTimeSeconds() - startSeconds;
+                return true;
+            }
+        }
+    }
+
+    BakeSDFAtlas(sourceTexels, dimensions, settings, outDistances);
+
+    std::ofstream file(cachePath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (file.is_open())
+    {
+        sSDFCacheHeader header;
+        header.m_magic      = SDF_MAGIC;
+        header.m_version    = SDF_VERSION;
+        header.m_sourceHash = outStats.m_sourceHash;
+        header.m_width      = dimensions.x;
+        header.m_height     = dimensions.y;
+
+        file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        file.write(reinterpret_cast<char const*>(outDistances.data()), static_cast<std::streamsize>(texelCount));
+    }
+
+    outStats.m_seconds = GetCurrentTimeSeconds() - startSeconds;
+
+    return true;
+}
@@ -0,0 +1,45 @@
+//----------------------------------------------------------------------------------------------------
+// SDFBaker.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/IntVec2.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sSDFBakeSettings
+{
+    int     m_cellCountX     = 16;      // Glyph grid of the atlas; distances never cross a cell edge
+    int     m_cellCountY     = 16;
+    float   m_spreadTexels   = 4.f;     // Distance, in source texels, that maps to the full 0..1 range
+    uint8_t m_alphaThreshold = 128;     // Source alpha at or above this is inside the glyph
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sSDFBakeStats
+{
+    bool     m_wasCached  = false;
+    double   m_seconds    = 0.0;
+    uint64_t m_sourceHash = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Signed distance field atlases from plain bitmap font atlases.
+//
+// Each glyph cell is thresholded on alpha and run through an exact Euclidean distance transform
+// (Felzenszwalb & Huttenlocher: two 1D lower-envelope passes, linear in the texel count), once for
+// the inside and once for the outside. The output is one byte per texel, 0.5 on the glyph edge and
+// larger inside, matching the alpha-channel threshold in Data/Shaders/SDF.hlsl. Cells are baked in
+// parallel on g_jobScheduler when it exists.
+//
+// BakeSDFAtlasCached() keeps the result in cachePath, keyed by a hash of the source texels and the
+// settings, so later runs with the same atlas skip the bake.
+//
+void BakeSDFAtlas(Rgba8 const* sourceTexels, IntVec2 const& dimensions, sSDFBakeSettings const& settings, std::vector<uint8_t>& outDistances);
+bool BakeSDFAtlasCached(Rgba8 const* sourceTexels, IntVec2 const& dimensions, sSDFBakeSettings const& settings, String const& cachePath, std::vector<uint8_t>& outDistances, sSDFBakeStats& outStats);
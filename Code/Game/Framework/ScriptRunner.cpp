@@ -0,0 +1,235 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptRunner.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptRunner.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FrameProfiler.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/HashedName.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Clock.hpp"
+#include "Engine/Core/Time.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+ScriptRunner::ScriptRunner(sScriptRunnerConfig const& config)
+    : m_config(config)
+{
+    m_progressEventId  = g_eventDispatcher->Intern("ScriptProgress"_hcis);
+    m_completedEventId = g_eventDispatcher->Intern("ScriptCompleted"_hcis);
+    m_cancelledEventId = g_eventDispatcher->Intern("ScriptCancelled"_hcis);
+}
+
+//----------------------------------------------------------------------------------------------------
+int ScriptRunner::Start(CommandScript&& script, String const& label)
+{
+    std::unique_ptr<sScriptRun> run = std::make_unique<sScriptRun>();
+    run->m_script = std::move(script);
+    run->m_label  = label;
+    run->m_id     = m_nextRunId++;
+
+    int const runId = run->m_id;
+    m_runs.push_back(std::move(run));
+    m_stats.m_runningCount = static_cast<int>(m_runs.size());
+
+    return runId;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Stops the script where its cursor is and fires ScriptCancelled. Safe to call from a command the
+/// script itself fired.
+bool ScriptRunner::Cancel(int const runId)
+{
+    for (size_t index = 0; index < m_runs.size(); ++index)
+    {
+        sScriptRun& run = *m_runs[index];
+        if (run.m_id != runId || run.m_isDone) continue;
+
+        run.m_isDone = true;
+
+        ++m_iterationDepth;
+        FireRunEvent(m_cancelledEventId, run);
+        --m_iterationDepth;
+
+        if (m_iterationDepth == 0) RemoveDoneRuns(nullptr);
+        return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return The number of scripts cancelled; ones started by the ScriptCancelled handlers keep running.
+int ScriptRunner::CancelAll()
+{
+    size_t const runCount       = m_runs.size();
+    int          cancelledCount = 0;
+
+    ++m_iterationDepth;
+
+    for (size_t index = 0; index < runCount; ++index)
+    {
+        sScriptRun& run = *m_runs[index];
+        if (run.m_isDone) continue;
+
+        run.m_isDone = true;
+        FireRunEvent(m_cancelledEventId, run);
+        ++cancelledCount;
+    }
+
+    --m_iterationDepth;
+
+    if (m_iterationDepth == 0) RemoveDoneRuns(nullptr);
+    return cancelledCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ScriptRunner::IsRunning(int const runId) const
+{
+    for (std::unique_ptr<sScriptRun> const& run : m_runs)
+    {
+        if (run->m_id == runId) return !run->m_isDone;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Once per frame, after the game has updated. Every waiting script counts down first, then scripts
+/// fire in order until the budget is spent; the one cut off goes first next frame.
+void ScriptRunner::Update(Clock const& clock)
+{
+    PROFILE_SCOPE("ScriptRunner::Update");
+
+    m_stats.m_commandsLastFrame = 0;
+    m_stats.m_secondsLastFrame  = 0.0;
+
+    if (m_runs.empty()) return;
+
+    double const deltaSeconds     = clock.GetDeltaSeconds();
+    bool const   hasClockAdvanced = deltaSeconds > 0.0;
+
+    for (std::unique_ptr<sScriptRun> const& run : m_runs)
+    {
+        if (run->m_waitFrames > 0 && hasClockAdvanced) --run->m_waitFrames;
+        if (run->m_waitSeconds > 0.0) run->m_waitSeconds -= deltaSeconds;
+    }
+
+    double const      startSeconds = GetCurrentTimeSeconds();
+    double const      endSeconds   = startSeconds + static_cast<double>(m_config.m_budgetSeconds);
+    size_t const      runCount     = m_runs.size();     // Scripts started from here on wait for the next frame
+    sScriptRun const* cutOffRun    = nullptr;
+
+    ++m_iterationDepth;
+
+    for (size_t index = 0; index < runCount && cutOffRun == nullptr; ++index)
+    {
+        sScriptRun& run = *m_runs[index];
+        if (run.m_isDone || run.m_waitFrames > 0 || run.m_waitSeconds > 0.0) continue;
+
+        if (RunSlice(run, endSeconds)) cutOffRun = &run;
+    }
+
+    --m_iterationDepth;
+
+    m_stats.m_secondsLastFrame = GetCurrentTimeSeconds() - startSeconds;
+
+    if (m_iterationDepth == 0) RemoveDoneRuns(cutOffRun);
+}
+
+//----------------------------------------------------------------------------------------------------
+sScriptRunnerConfig const& ScriptRunner::GetConfig() const
+{
+    return m_config;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptRunner::SetConfig(sScriptRunnerConfig const& config)
+{
+    m_config = config;
+}
+
+//----------------------------------------------------------------------------------------------------
+sScriptRunnerStats const& ScriptRunner::GetStats() const
+{
+    return m_stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Fires run's commands from its cursor until it ends, reaches a wait, or the frame's budget is spent.
+/// The first command of a frame always fires, so a budget shorter than one command still makes progress.
+/// @return true if the budget ran out before the script reached a wait or its end.
+bool ScriptRunner::RunSlice(sScriptRun& run, double const endSeconds)
+{
+    int const commandCount = run.m_script.GetCommandCount();
+    int       firedCount   = 0;
+    bool      isCutOff     = false;
+
+    while (run.m_cursor < commandCount && !run.m_isDone)
+    {
+        if (m_stats.m_commandsLastFrame > 0 && GetCurrentTimeSeconds() >= endSeconds)
+        {
+            isCutOff = true;
+            break;
+        }
+
+        int const           commandIndex = run.m_cursor++;
+        sCommandWait const& wait         = run.m_script.GetWait(commandIndex);
+
+        if (wait.m_isWait)
+        {
+            run.m_waitFrames  = wait.m_frames;
+            run.m_waitSeconds = static_cast<double>(wait.m_seconds);
+            break;
+        }
+
+        run.m_script.ExecuteCommand(commandIndex);
+        ++firedCount;
+        ++m_stats.m_commandsLastFrame;
+    }
+
+    // A command may have cancelled its own script, which has then already reported
+    if (run.m_isDone) return false;
+
+    if (firedCount > 0) FireRunEvent(m_progressEventId, run);
+
+    // A trailing wait still holds the script open until it expires
+    if (run.m_cursor == commandCount && run.m_waitFrames <= 0 && run.m_waitSeconds <= 0.0)
+    {
+        run.m_isDone = true;
+        FireRunEvent(m_completedEventId, run);
+    }
+
+    return isCutOff;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptRunner::FireRunEvent(EventId const id, sScriptRun const& run) const
+{
+    FlatProperties args;
+    args.SetValue("run"_hcis, run.m_id);
+    args.SetValue("script"_hcis, run.m_label);
+    args.SetValue("command"_hcis, run.m_cursor);
+    args.SetValue("count"_hcis, run.m_script.GetCommandCount());
+
+    g_eventDispatcher->FireEvent(id, args);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Drops completed and cancelled scripts, then rotates firstRun, if it is still running, to the front.
+void ScriptRunner::RemoveDoneRuns(sScriptRun const* firstRun)
+{
+    m_runs.erase(std::remove_if(m_runs.begin(), m_runs.end(), [](std::unique_ptr<sScriptRun> const& run) { return run->m_isDone; }), m_runs.end());
+
+    auto const first = std::find_if(m_runs.begin(), m_runs.end(), [firstRun](std::unique_ptr<sScriptRun> const& run) { return run.get() == firstRun; });
+    if (first != m_runs.end()) std::rotate(m_runs.begin(), first, m_runs.end());
+
+    m_stats.m_runningCount = static_cast<int>(m_runs.size());
+}
@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptRunner.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/CommandScript.hpp"
+#include "Game/Framework/EventDispatcher.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <memory>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Clock;
+
+//----------------------------------------------------------------------------------------------------
+// Loaded from the <ScriptRunner> element of Data/GameConfig.xml.
+//
+struct sScriptRunnerConfig
+{
+    float m_budgetSeconds = 0.002f;     // Wall time all running scripts share per frame; at least one command still runs
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sScriptRunnerStats
+{
+    int    m_runningCount      = 0;
+    int    m_commandsLastFrame = 0;     // Commands fired by the last Update, across every script
+    double m_secondsLastFrame  = 0.0;   // Wall time the last Update spent firing them
+};
+
+//----------------------------------------------------------------------------------------------------
+// Runs compiled command scripts a slice per frame, so a script with hundreds of commands spreads
+// over as many frames as its commands need instead of landing in one.
+//
+// Update(), called once per frame with the game Clock, fires commands from each script's cursor
+// until the frame's budget is spent, then stops; the next frame resumes from the same cursor,
+// starting with the script that was cut off. Scripts started by those commands begin next frame.
+//
+// <Wait frames="N"/> parks a script for N frames and <WaitSeconds seconds="S"/> for S seconds of the
+// clock; frames only count while the clock advances, so pausing the game pauses both. Either one
+// ends the script's slice, so a wait always lasts at least until the next frame.
+//
+// Progress is reported on g_eventDispatcher, with args run (id), script (label), command (cursor)
+// and count (commands in the script):
+//   ScriptProgress   once per frame per script that fired commands
+//   ScriptCompleted  when a script's cursor reaches its end
+//   ScriptCancelled  when Cancel() stops a script before that
+// Everything is main thread only.
+//
+class ScriptRunner
+{
+public:
+    explicit ScriptRunner(sScriptRunnerConfig const& config);
+
+    ScriptRunner(ScriptRunner const&)            = delete;
+    ScriptRunner& operator=(ScriptRunner const&) = delete;
+
+    // Returns the run id, never 0
+    int  Start(CommandScript&& script, String const& label);
+    bool Cancel(int runId);
+    int  CancelAll();
+    bool IsRunning(int runId) const;
+
+    void Update(Clock const& clock);
+
+    sScriptRunnerConfig const& GetConfig() const;
+    void                       SetConfig(sScriptRunnerConfig const& config);
+    sScriptRunnerStats const&  GetStats() const;
+
+private:
+    struct sScriptRun
+    {
+        CommandScript m_script;
+        String        m_label;
+        int           m_id          = 0;
+        int           m_cursor      = 0;        // Next command to fire
+        int           m_waitFrames  = 0;        // Left on the current <Wait>
+        double        m_waitSeconds = 0.0;      // Left on the current <WaitSeconds>
+        bool          m_isDone      = false;    // Completed or cancelled; removed once m_runs is not being walked
+    };
+
+    bool RunSlice(sScriptRun& run, double endSeconds);
+    void FireRunEvent(EventId id, sScriptRun const& run) const;
+    void RemoveDoneRuns(sScriptRun const* firstRun);
+
+    sScriptRunnerConfig                      m_config;
+    sScriptRunnerStats                       m_stats;
+    std::vector<std::unique_ptr<sScriptRun>> m_runs;          // Boxed, so a run stays put while its commands start others
+    int                                      m_nextRunId      = 1;
+    int                                      m_iterationDepth = 0;     // While above 0, done runs stay in m_runs
+    EventId                                  m_progressEventId;
+    EventId                                  m_completedEventId;
+    EventId                                  m_cancelledEventId;
+};
@@ -0,0 +1,539 @@
+//----------------------------------------------------------------------------------------------------
+// ShaderCache.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ShaderCache.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/AssetPack.hpp"
+#include "Game/Framework/BinaryLog.hpp"
+#include "Game/Framework/FrameProfiler.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/JobScheduler.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    uint32_t constexpr CACHE_MAGIC       = 0x43485347;     // "GSHC"
+    uint32_t constexpr CACHE_VERSION     = 1;
+    int constexpr      MAX_INCLUDE_DEPTH = 16;
+
+    //------------------------------------------------------------------------------------------------
+    struct sShaderCacheHeader
+    {
+        uint32_t m_magic         = 0;
+        uint32_t m_version       = 0;
+        uint64_t m_key           = 0;
+        uint64_t m_byteCodeBytes = 0;
+        uint64_t m_byteCodeHash  = 0;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    // FNV-1a; every field is followed by its length so adjacent fields cannot run into each other
+    //
+    struct sKeyHasher
+    {
+        uint64_t m_hash = 14695981039346656037ull;
+
+        void Mix(void const* data, size_t const size)
+        {
+            uint8_t const* bytes = static_cast<uint8_t const*>(data);
+
+            for (size_t index = 0; index < size; ++index)
+            {
+                m_hash ^= bytes[index];
+                m_hash *= 1099511628211ull;
+            }
+
+            for (int shift = 0; shift < 64; shift += 8)
+            {
+                m_hash ^= (static_cast<uint64_t>(size) >> shift) & 0xFF;
+                m_hash *= 1099511628211ull;
+            }
+        }
+
+        void Mix(std::string_view const text) { Mix(text.data(), text.size()); }
+    };
+
+    //------------------------------------------------------------------------------------------------
+    uint64_t HashBytes(std::vector<uint8_t> const& bytes)
+    {
+        sKeyHasher hasher;
+        hasher.Mix(bytes.data(), bytes.size());
+
+        return hasher.m_hash;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // The quoted or bracketed name of an #include line, or empty
+    //
+    std::string_view GetIncludeName(std::string_view line)
+    {
+        size_t const first = line.find_first_not_of(" \t");
+        if (first == std::string_view::npos || line[first] != '#') return {};
+
+        line.remove_prefix(first + 1);
+        line.remove_prefix(std::min(line.find_first_not_of(" \t"), line.size()));
+
+        if (line.substr(0, 7) != "include") return {};
+
+        size_t const open = line.find_first_of("\"<", 7);
+        if (open == std::string_view::npos) return {};
+
+        size_t const close = line.find(line[open] == '"' ? '"' : '>', open + 1);
+        if (close == std::string_view::npos) return {};
+
+        return line.substr(open + 1, close - open - 1);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Mixes path's contents and, depth first, those of every file it includes; false if path itself is
+    // missing. A missing include is mixed as missing: the compile fails, and the key changes once the
+    // file appears.
+    //
+    bool MixSourceFile(sKeyHasher& hasher, std::filesystem::path const& path, int const depth)
+    {
+        sAssetFileData file;
+        bool const     isFound = depth <= MAX_INCLUDE_DEPTH && ReadAssetFile(path.generic_string(), file);
+
+        hasher.Mix(path.filename().generic_string());
+        hasher.Mix(isFound ? file.GetText() : std::string_view("<missing>"));
+
+        if (!isFound) return false;
+
+        std::string_view text = file.GetText();
+
+        while (!text.empty())
+        {
+            size_t const           lineEnd = std::min(text.find('\n'), text.size());
+            std::string_view const include = GetIncludeName(text.substr(0, lineEnd));
+
+            if (!include.empty())
+            {
+                MixSourceFile(hasher, (path.parent_path() / std::filesystem::path(include)).lexically_normal(), depth + 1);
+            }
+
+            text.remove_prefix(std::min(lineEnd + 1, text.size()));
+        }
+
+        return true;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// The vertex and pixel stage of path, with the entry points and targets the Engine's shaders use.
+void AddShaderStages(std::vector<sShaderVariant>& variants, String const& path, eVertexType const vertexType, std::vector<String> const& defines)
+{
+    sShaderVariant variant;
+    variant.m_path       = path;
+    variant.m_vertexType = vertexType;
+    variant.m_defines    = defines;
+
+    variant.m_entryPoint = "VertexMain";
+    variant.m_target     = "vs_5_0";
+    variants.push_back(variant);
+
+    variant.m_entryPoint = "PixelMain";
+    variant.m_target     = "ps_5_0";
+    variants.push_back(variant);
+}
+
+//----------------------------------------------------------------------------------------------------
+ShaderCache::ShaderCache(sShaderCacheConfig const& config, sShaderCompiler compiler)
+    : m_config(config),
+      m_compiler(std::move(compiler))
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return false when the variant's source cannot be read.
+bool ShaderCache::ComputeKey(sShaderVariant const& variant, uint64_t& outKey) const
+{
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    std::vector<String> defines = variant.m_defines;
+    std::sort(defines.begin(), defines.end());
+
+    sKeyHasher hasher;
+    hasher.Mix(&CACHE_VERSION, sizeof(CACHE_VERSION));
+    hasher.Mix(m_compiler.m_id);
+
+    if (!MixSourceFile(hasher, std::filesystem::path(variant.m_path + ".hlsl"), 0)) return false;
+
+    for (String const& define : defines)
+    {
+        hasher.Mix(define);
+    }
+
+    uint32_t const vertexType = static_cast<uint32_t>(variant.m_vertexType);
+
+    hasher.Mix(variant.m_entryPoint);
+    hasher.Mix(variant.m_target);
+    hasher.Mix(&vertexType, sizeof(vertexType));
+
+    outKey = hasher.m_hash;
+
+    std::scoped_lock lock(m_mutex);
+    m_stats.m_keySeconds += GetCurrentTimeSeconds() - startSeconds;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ShaderCache::GetByteCode(sShaderVariant const& variant, std::vector<uint8_t>& outByteCode)
+{
+    uint64_t key = 0;
+
+    if (!ComputeKey(variant, key))
+    {
+        GAME_LOG(eLogVerbosity::Warning, "(ShaderCache) %s.hlsl not found", variant.m_path.c_str());
+
+        std::scoped_lock lock(m_mutex);
+        ++m_stats.m_failedCount;
+
+        return false;
+    }
+
+    return GetByteCode(variant, key, outByteCode);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Keys every variant, then fetches or compiles each distinct key once, in parallel on
+/// g_jobScheduler when it exists.
+/// @return the number of variants without bytecode.
+int ShaderCache::Precompile(std::vector<sShaderVariant> const& variants)
+{
+    PROFILE_SCOPE("ShaderCache::Precompile");
+
+    int const             count = static_cast<int>(variants.size());
+    std::vector<uint64_t> keys(variants.size(), 0);
+    std::vector<uint8_t>  isKeyed(variants.size(), 0);
+
+    auto const runParallel = [](int const taskCount, std::function<void(int)> const& body)
+    {
+        if (g_jobScheduler != nullptr)
+        {
+            g_jobScheduler->ParallelFor(taskCount, body);
+        }
+        else
+        {
+            for (int index = 0; index < taskCount; ++index) body(index);
+        }
+    };
+
+    runParallel(count, [&](int const index)
+    {
+        isKeyed[index] = ComputeKey(variants[index], keys[index]) ? 1 : 0;
+    });
+
+    // The first variant of each key stands for the others
+    std::vector<int>                     distinct;
+    std::unordered_map<uint64_t, size_t> taskOfKey;
+    int                                  notFoundCount = 0;
+
+    for (int index = 0; index < count; ++index)
+    {
+        if (isKeyed[index] == 0)
+        {
+            GAME_LOG(eLogVerbosity::Warning, "(ShaderCache) %s.hlsl not found", variants[index].m_path.c_str());
+            ++notFoundCount;
+        }
+        else if (taskOfKey.emplace(keys[index], distinct.size()).second)
+        {
+            distinct.push_back(index);
+        }
+    }
+
+    std::vector<uint8_t> isCompiled(distinct.size(), 0);
+
+    runParallel(static_cast<int>(distinct.size()), [&](int const task)
+    {
+        std::vector<uint8_t> byteCode;
+        int const            index = distinct[task];
+
+        isCompiled[task] = GetByteCode(variants[index], keys[index], byteCode) ? 1 : 0;
+    });
+
+    int failedCount = notFoundCount;
+
+    for (int index = 0; index < count; ++index)
+    {
+        if (isKeyed[index] != 0 && isCompiled[taskOfKey[keys[index]]] == 0) ++failedCount;
+    }
+
+    std::scoped_lock lock(m_mutex);
+    m_stats.m_failedCount += notFoundCount;
+
+    return failedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Forgets the bytecode held in memory, so the next lookups read the cache files again.
+void ShaderCache::ClearMemory()
+{
+    std::scoped_lock lock(m_mutex);
+    m_byteCodes.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+String ShaderCache::GetCachePath(uint64_t const key) const
+{
+    return Stringf("%s/%016llx.cso", m_config.m_directory.c_str(), static_cast<unsigned long long>(key));
+}
+
+//----------------------------------------------------------------------------------------------------
+sShaderCacheConfig const& ShaderCache::GetConfig() const
+{
+    return m_config;
+}
+
+//----------------------------------------------------------------------------------------------------
+sShaderCacheStats ShaderCache::GetStats() const
+{
+    std::scoped_lock lock(m_mutex);
+    return m_stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ShaderCache::GetByteCode(sShaderVariant const& variant, uint64_t const key, std::vector<uint8_t>& outByteCode)
+{
+    {
+        std::scoped_lock lock(m_mutex);
+        auto const       found = m_byteCodes.find(key);
+
+        if (found != m_byteCodes.end())
+        {
+            outByteCode = found->second;
+            ++m_stats.m_memoryHitCount;
+            return true;
+        }
+    }
+
+    bool const isOnDisk = ReadCacheFile(key, outByteCode);
+
+    if (!isOnDisk)
+    {
+        PROFILE_SCOPE("ShaderCache::Compile");
+
+        double const startSeconds = GetCurrentTimeSeconds();
+
+        sShaderCompileInput input;
+        input.m_sourcePath = variant.m_path + ".hlsl";
+        input.m_variant    = &variant;
+
+        sAssetFileData source;
+        String         errors;
+        bool           isCompiled = false;
+
+        if (m_compiler.m_compile && ReadAssetFile(input.m_sourcePath, source))
+        {
+            input.m_source = source.GetText();
+            isCompiled     = m_compiler.m_compile(input, outByteCode, errors) && !outByteCode.empty();
+        }
+
+        {
+            std::scoped_lock lock(m_mutex);
+            m_stats.m_compileSeconds += GetCurrentTimeSeconds() - startSeconds;
+            ++(isCompiled ? m_stats.m_compileCount : m_stats.m_failedCount);
+        }
+
+        if (!isCompiled)
+        {
+            GAME_LOG(eLogVerbosity::Warning, "(ShaderCache) %s %s %s failed: %s", input.m_sourcePath.c_str(), variant.m_entryPoint.c_str(),
+                     variant.m_target.c_str(), m_compiler.m_compile ? errors.c_str() : "no compiler");
+            outByteCode.clear();
+            return false;
+        }
+
+        WriteCacheFile(key, outByteCode);
+    }
+
+    std::scoped_lock lock(m_mutex);
+    m_byteCodes.emplace(key, outByteCode);
+    m_stats.m_diskHitCount += isOnDisk ? 1 : 0;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ShaderCache::ReadCacheFile(uint64_t const key, std::vector<uint8_t>& outByteCode) const
+{
+    sAssetFileData file;
+    if (!ReadAssetFile(GetCachePath(key), file) || file.m_bytes.size() < sizeof(sShaderCacheHeader)) return false;
+
+    sShaderCacheHeader header;
+    std::memcpy(&header, file.m_bytes.data(), sizeof(header));
+
+    if (header.m_magic != CACHE_MAGIC || header.m_version != CACHE_VERSION || header.m_key != key) return false;
+    if (header.m_byteCodeBytes == 0 || header.m_byteCodeBytes != file.m_bytes.size() - sizeof(header)) return false;
+
+    outByteCode.assign(file.m_bytes.begin() + sizeof(header), file.m_bytes.end());
+
+    return HashBytes(outByteCode) == header.m_byteCodeHash;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Written to a temporary file and renamed, so a reader on another thread or process never sees half
+/// of one. A cache that cannot be written is not an error.
+void ShaderCache::WriteCacheFile(uint64_t const key, std::vector<uint8_t> const& byteCode) const
+{
+    std::error_code errorCode;
+    std::filesystem::create_directories(m_config.m_directory, errorCode);
+
+    String const path          = GetCachePath(key);
+    String const temporaryPath = Stringf("%s.%zx.tmp", path.c_str(), std::hash<std::thread::id>()(std::this_thread::get_id()));     // Two threads may compile one key
+
+    {
+        std::ofstream file(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return;
+
+        sShaderCacheHeader header;
+        header.m_magic         = CACHE_MAGIC;
+        header.m_version       = CACHE_VERSION;
+        header.m_key           = key;
+        header.m_byteCodeBytes = byteCode.size();
+        header.m_byteCodeHash  = HashBytes(byteCode);
+
+        file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        file.write(reinterpret_cast<char const*>(byteCode.data()), static_cast<std::streamsize>(byteCode.size()));
+
+        if (!file) return;
+    }
+
+    std::filesystem::rename(temporaryPath, path, errorCode);
+
+    if (errorCode)
+    {
+        std::filesystem::remove(temporaryPath, errorCode);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int RunShaderCacheTest(String const& scratchDirectory, std::vector<sShaderCacheCheck>& outChecks)
+{
+    outChecks.clear();
+
+    std::error_code errorCode;
+    std::filesystem::remove_all(scratchDirectory, errorCode);
+    std::filesystem::create_directories(scratchDirectory, errorCode);
+
+    auto const writeText = [](String const& path, char const* text)
+    {
+        std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        file << text;
+    };
+
+    String const shaderPath  = scratchDirectory + "/Test";
+    String const includePath = scratchDirectory + "/TestCommon.hlsli";
+
+    writeText(shaderPath + ".hlsl", "#include \"TestCommon.hlsli\"\nfloat4 VertexMain() : SV_Position { return TINT * SCALE; }\n");
+    writeText(includePath, "#define TINT float4(1, 1, 1, 1)\n");
+
+    // Stand-in bytecode: everything the fake compiler was given, so different inputs give different bytes
+    std::atomic<int> compileCount{0};
+    sShaderCompiler  compiler;
+
+    compiler.m_id      = "ShaderCacheTest fake compiler";
+    compiler.m_compile = [&compileCount](sShaderCompileInput const& input, std::vector<uint8_t>& outByteCode, String& outErrors)
+    {
+        UNUSED(outErrors)
+
+        compileCount.fetch_add(1, std::memory_order_relaxed);
+
+        String text = String(input.m_source) + input.m_variant->m_entryPoint + input.m_variant->m_target;
+
+        for (String const& define : input.m_variant->m_defines)
+        {
+            text += define;
+        }
+
+        outByteCode.assign(text.begin(), text.end());
+
+        return true;
+    };
+
+    sShaderCacheConfig config;
+    config.m_directory = scratchDirectory + "/Cache";
+
+    sShaderVariant variant;
+    variant.m_path    = shaderPath;
+    variant.m_defines = { "SCALE=2", "USE_TINT" };
+
+    auto const check = [&](char const* name, sShaderVariant const& checkedVariant, int const expectedCompileCount, std::vector<uint8_t> const* expectedByteCode)
+    {
+        ShaderCache          cache(config, compiler);
+        std::vector<uint8_t> byteCode;
+        int const            countBefore = compileCount.load(std::memory_order_relaxed);
+        bool const           isFound     = cache.GetByteCode(checkedVariant, byteCode);
+
+        sShaderCacheCheck result;
+        result.m_name                 = name;
+        result.m_compileCount         = compileCount.load(std::memory_order_relaxed) - countBefore;
+        result.m_expectedCompileCount = expectedCompileCount;
+        result.m_isPassed             = isFound && !byteCode.empty() && result.m_compileCount == expectedCompileCount &&
+                                        (expectedByteCode == nullptr || byteCode == *expectedByteCode);
+
+        outChecks.push_back(result);
+
+        return byteCode;
+    };
+
+    auto const getCachePath = [&](sShaderVariant const& keyedVariant)
+    {
+        ShaderCache cache(config, compiler);
+        uint64_t    key = 0;
+        cache.ComputeKey(keyedVariant, key);
+
+        return cache.GetCachePath(key);
+    };
+
+    std::vector<uint8_t> const coldByteCode = check("Cold run compiles", variant, 1, nullptr);
+    check("Warm run reads the cache", variant, 0, &coldByteCode);
+
+    writeText(includePath, "#define TINT float4(1, 0, 0, 1)\n");
+    std::vector<uint8_t> const editedByteCode = check("Edited include recompiles", variant, 1, nullptr);
+
+    sShaderVariant reordered = variant;
+    std::reverse(reordered.m_defines.begin(), reordered.m_defines.end());
+    check("Reordered defines read the cache", reordered, 0, &editedByteCode);
+
+    sShaderVariant redefined = variant;
+    redefined.m_defines[0]   = "SCALE=3";
+    check("Changed define recompiles", redefined, 1, nullptr);
+
+    String const   cachePath = getCachePath(variant);
+    uint64_t const fileBytes = static_cast<uint64_t>(std::filesystem::file_size(cachePath, errorCode));
+
+    std::filesystem::resize_file(cachePath, fileBytes / 2, errorCode);
+    check("Truncated .cso is rebuilt", variant, 1, &editedByteCode);
+
+    {
+        std::fstream file(cachePath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-1, std::ios::end);
+
+        char const last = static_cast<char>(file.get());
+        file.seekp(-1, std::ios::end);
+        file.put(static_cast<char>(last ^ 0x10));
+    }
+
+    check("Bit-flipped .cso is rebuilt", variant, 1, &editedByteCode);
+    check("Rebuilt .cso reads back", variant, 0, &editedByteCode);
+
+    std::filesystem::remove_all(scratchDirectory, errorCode);
+
+    return static_cast<int>(std::count_if(outChecks.begin(), outChecks.end(), [](sShaderCacheCheck const& result) { return !result.m_isPassed; }));
+}
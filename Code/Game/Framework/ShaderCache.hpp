@@ -0,0 +1,137 @@
+//----------------------------------------------------------------------------------------------------
+// ShaderCache.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// One compiled stage of one shader: what goes into its cache key.
+//
+struct sShaderVariant
+{
+    String              m_path;                                     // Without extension, as the ResourceSubsystem takes it ("Data/Shaders/Font")
+    eVertexType         m_vertexType = eVertexType::VERTEX_PCU;
+    String              m_entryPoint = "VertexMain";
+    String              m_target     = "vs_5_0";
+    std::vector<String> m_defines;                                  // "NAME" or "NAME=VALUE"
+};
+
+//----------------------------------------------------------------------------------------------------
+// Loaded from the <ShaderCache> element of Data/GameConfig.xml; each <Shader path vertexType defines>
+// child adds its vertex and pixel stage to m_variants.
+//
+struct sShaderCacheConfig
+{
+    String                      m_directory = "Data/Shaders/Cache";
+    std::vector<sShaderVariant> m_variants;                         // What ShaderCache prebake=true compiles
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sShaderCompileInput
+{
+    String                m_sourcePath;           // "Data/Shaders/Font.hlsl"; includes resolve next to it
+    std::string_view      m_source;
+    sShaderVariant const* m_variant = nullptr;
+};
+
+//----------------------------------------------------------------------------------------------------
+using ShaderCompileFunction = std::function<bool(sShaderCompileInput const& input, std::vector<uint8_t>& outByteCode, String& outErrors)>;
+
+//----------------------------------------------------------------------------------------------------
+// m_id names the compiler, its build and every flag that changes its output, and is part of each
+// key, so bytecode from another compiler or build configuration is never picked up. m_compile may be
+// called from several threads at once.
+//
+struct sShaderCompiler
+{
+    String                m_id;
+    ShaderCompileFunction m_compile;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sShaderCacheStats
+{
+    int    m_memoryHitCount = 0;
+    int    m_diskHitCount   = 0;          // Includes cache files found in g_assetPack
+    int    m_compileCount   = 0;
+    int    m_failedCount    = 0;
+    double m_keySeconds     = 0.0;        // Reading sources and includes and hashing them, summed over threads
+    double m_compileSeconds = 0.0;        // Summed over threads
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sShaderCacheCheck
+{
+    String m_name;
+    int    m_compileCount         = 0;
+    int    m_expectedCompileCount = 0;
+    bool   m_isPassed             = false;     // Bytecode found, as expected, after the expected number of compiles
+};
+
+//----------------------------------------------------------------------------------------------------
+void AddShaderStages(std::vector<sShaderVariant>& variants, String const& path, eVertexType vertexType, std::vector<String> const& defines = {});
+
+//----------------------------------------------------------------------------------------------------
+// Content-addressed shader bytecode.
+//
+// A variant's key is a 64-bit FNV-1a of its .hlsl source, every file it #includes (recursively,
+// resolved next to the including file), its sorted defines, entry point, target and vertex type,
+// and the compiler's id. The bytecode lives in <directory>/<key>.cso, so an edited source, include
+// or define simply misses and compiles to a new file; stale files are never read back. Sources and
+// cache files are read through ReadAssetFile(), so a shipped Data.gpak can carry a prebaked cache.
+//
+// GetByteCode() looks in memory, then on disk, then compiles and writes the file; it may run on any
+// thread. Precompile() does that for a list of variants in parallel on g_jobScheduler. The compiler
+// is a parameter, so the cache runs, and is tested, without a GPU or the Windows SDK.
+//
+class ShaderCache
+{
+public:
+    ShaderCache(sShaderCacheConfig const& config, sShaderCompiler compiler);
+
+    ShaderCache(ShaderCache const&)            = delete;
+    ShaderCache& operator=(ShaderCache const&) = delete;
+
+    bool ComputeKey(sShaderVariant const& variant, uint64_t& outKey) const;
+    bool GetByteCode(sShaderVariant const& variant, std::vector<uint8_t>& outByteCode);
+    int  Precompile(std::vector<sShaderVariant> const& variants);
+    void ClearMemory();
+
+    String                    GetCachePath(uint64_t key) const;
+    sShaderCacheConfig const& GetConfig() const;
+    sShaderCacheStats         GetStats() const;
+
+private:
+    bool GetByteCode(sShaderVariant const& variant, uint64_t key, std::vector<uint8_t>& outByteCode);
+    bool ReadCacheFile(uint64_t key, std::vector<uint8_t>& outByteCode) const;
+    void WriteCacheFile(uint64_t key, std::vector<uint8_t> const& byteCode) const;
+
+    sShaderCacheConfig m_config;
+    sShaderCompiler    m_compiler;
+
+    mutable std::mutex                                  m_mutex;          // Guards everything below
+    std::unordered_map<uint64_t, std::vector<uint8_t>> m_byteCodes;
+    mutable sShaderCacheStats                           m_stats;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Self-test of ShaderCache with a counting fake compiler, on a shader and include written into
+// scratchDirectory and removed afterwards; needs no GPU and no Windows SDK. Each step opens a fresh
+// cache, as a new run of the game would, so only the .cso files carry over between steps. Checks a
+// cold run compiles once and a warm one not at all, that editing the include or changing a define
+// recompiles while reordering the defines does not, and that a truncated or bit-flipped .cso is
+// rejected and rebuilt with the right bytecode.
+// @return the number of failed checks.
+//
+int RunShaderCacheTest(String const& scratchDirectory, std::vector<sShaderCacheCheck>& outChecks);
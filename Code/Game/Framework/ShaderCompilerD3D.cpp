@@ -0,0 +1,100 @@
+//----------------------------------------------------------------------------------------------------
+// ShaderCompilerD3D.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ShaderCompilerD3D.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
+#include <windows.h>			// #include this (massive, platform-specific) header in VERY few places (and .CPPs only)
+#include <d3dcompiler.h>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+#if defined(_DEBUG)
+    UINT constexpr COMPILE_FLAGS = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION | D3DCOMPILE_ENABLE_STRICTNESS;
+#else
+    UINT constexpr COMPILE_FLAGS = D3DCOMPILE_OPTIMIZATION_LEVEL3 | D3DCOMPILE_ENABLE_STRICTNESS;
+#endif
+
+    //------------------------------------------------------------------------------------------------
+    bool CompileWithD3D(sShaderCompileInput const& input, std::vector<uint8_t>& outByteCode, String& outErrors)
+    {
+        sShaderVariant const& variant = *input.m_variant;
+
+        // "NAME=VALUE" split in place into NAME and VALUE; the last macro is the null terminator
+        std::vector<String>           defines = variant.m_defines;
+        std::vector<D3D_SHADER_MACRO> macros;
+
+        for (String& define : defines)
+        {
+            size_t const equals = define.find('=');
+
+            if (equals == String::npos)
+            {
+                macros.push_back({ define.c_str(), "1" });
+            }
+            else
+            {
+                define[equals] = '\0';
+                macros.push_back({ define.c_str(), define.c_str() + equals + 1 });
+            }
+        }
+
+        macros.push_back({ nullptr, nullptr });
+
+        ID3DBlob*     byteCode = nullptr;
+        ID3DBlob*     errors   = nullptr;
+        HRESULT const result   = D3DCompile(input.m_source.data(), input.m_source.size(), input.m_sourcePath.c_str(), macros.data(),
+                                            D3D_COMPILE_STANDARD_FILE_INCLUDE, variant.m_entryPoint.c_str(), variant.m_target.c_str(),
+                                            COMPILE_FLAGS, 0, &byteCode, &errors);
+
+        if (errors != nullptr)
+        {
+            outErrors.assign(static_cast<char const*>(errors->GetBufferPointer()), errors->GetBufferSize());
+            errors->Release();
+        }
+
+        if (FAILED(result) || byteCode == nullptr)
+        {
+            if (byteCode != nullptr) byteCode->Release();
+            return false;
+        }
+
+        uint8_t const* const bytes = static_cast<uint8_t const*>(byteCode->GetBufferPointer());
+        outByteCode.assign(bytes, bytes + byteCode->GetBufferSize());
+        byteCode->Release();
+
+        return true;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Size and write time of the d3dcompiler DLL the process loaded, so a different build of it (a
+    // Windows update, or another copy next to the exe) makes new keys; empty if it cannot be found.
+    String GetCompilerDllStamp()
+    {
+        HMODULE const module = GetModuleHandleA(D3DCOMPILER_DLL_A);
+        char          path[MAX_PATH];
+
+        if (module == nullptr || GetModuleFileNameA(module, path, MAX_PATH) == 0) return String();
+
+        WIN32_FILE_ATTRIBUTE_DATA attributes;
+        if (!GetFileAttributesExA(path, GetFileExInfoStandard, &attributes)) return String();
+
+        return Stringf(" size=%lu:%lu time=%lu:%lu", attributes.nFileSizeHigh, attributes.nFileSizeLow,
+                       attributes.ftLastWriteTime.dwHighDateTime, attributes.ftLastWriteTime.dwLowDateTime);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+sShaderCompiler GetD3DShaderCompiler()
+{
+    sShaderCompiler compiler;
+    compiler.m_id      = Stringf("%s%s flags=0x%x", D3DCOMPILER_DLL_A, GetCompilerDllStamp().c_str(), COMPILE_FLAGS);
+    compiler.m_compile = CompileWithD3D;
+
+    return compiler;
+}
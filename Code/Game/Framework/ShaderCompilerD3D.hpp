@@ -0,0 +1,16 @@
+//----------------------------------------------------------------------------------------------------
+// ShaderCompilerD3D.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ShaderCache.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// The ShaderCache's compiler for the game: D3DCompile from d3dcompiler_47.dll, which needs no device
+// and may run on several threads at once. Debug builds compile with debug info and no optimization,
+// release builds at optimization level 3. The flags, and the size and write time of the loaded DLL,
+// are part of the compiler id, and so of every key.
+//
+sShaderCompiler GetD3DShaderCompiler();
@@ -0,0 +1,312 @@
+//----------------------------------------------------------------------------------------------------
+// TextBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/TextBenchmark.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FontGlyphTable.hpp"
+#include "Game/Framework/FrameArena.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Renderer/BitmapFont.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstdlib>
+#include <fstream>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    // Layout parameters every corpus string is run at
+    //
+    struct sTextStyle
+    {
+        float m_cellHeight;
+        float m_cellAspect;
+    };
+
+    sTextStyle constexpr TEXT_STYLES[] = { { 8.f, 1.f }, { 16.f, 1.f }, { 24.f, 0.7f }, { 80.f, 1.f } };
+
+    //------------------------------------------------------------------------------------------------
+    // FNV-1a over the fields every vertex format shares; floats are hashed bit for bit
+    //
+    void HashBytes(uint64_t& hash, void const* bytes, size_t const count)
+    {
+        unsigned char const* data = static_cast<unsigned char const*>(bytes);
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            hash ^= data[index];
+            hash *= 1099511628211ull;
+        }
+    }
+
+    template <typename VertexList>
+    void HashVerts(uint64_t& hash, VertexList const& verts)
+    {
+        for (auto const& vertex : verts)
+        {
+            HashBytes(hash, &vertex.m_position.x, sizeof(float));
+            HashBytes(hash, &vertex.m_position.y, sizeof(float));
+            HashBytes(hash, &vertex.m_position.z, sizeof(float));
+            HashBytes(hash, &vertex.m_color.r, 1);
+            HashBytes(hash, &vertex.m_color.g, 1);
+            HashBytes(hash, &vertex.m_color.b, 1);
+            HashBytes(hash, &vertex.m_color.a, 1);
+            HashBytes(hash, &vertex.m_uvTexCoords.x, sizeof(float));
+            HashBytes(hash, &vertex.m_uvTexCoords.y, sizeof(float));
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // One vertex format: hash of the output, best seconds per pass, heap allocations per string
+    //
+    template <typename VertexList, typename Font>
+    void MeasureLayout(Font const& font, int const passes, uint64_t& outHash, double& outBestSeconds, double& outAllocationsPerString)
+    {
+        std::vector<String> const& corpus = TextBenchmark::GetCorpus();
+
+        VertexList verts;
+        uint64_t   hash        = 14695981039346656037ull;
+        uint64_t   allocations = 0;
+        int        layouts     = 0;
+
+        // Correctness pass: hash every layout. It also grows the list to the largest string, so the
+        // allocation pass below counts the font's own allocations, not the list's
+        for (sTextStyle const& style : TEXT_STYLES)
+        {
+            for (String const& text : corpus)
+            {
+                verts.clear();
+                font.AddVertsForText2D(verts, text, Vec2(0.f, 0.f), style.m_cellHeight, Rgba8::WHITE, style.m_cellAspect);
+                HashVerts(hash, verts);
+            }
+        }
+
+        for (sTextStyle const& style : TEXT_STYLES)
+        {
+            for (String const& text : corpus)
+            {
+                verts.clear();
+
+                uint64_t const before = FrameArena::GetHeapAllocationCount();
+                font.AddVertsForText2D(verts, text, Vec2(0.f, 0.f), style.m_cellHeight, Rgba8::WHITE, style.m_cellAspect);
+                allocations += FrameArena::GetHeapAllocationCount() - before;
+                ++layouts;
+            }
+        }
+
+        double bestSeconds = 1.0e30;
+
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            double const start = GetCurrentTimeSeconds();
+
+            for (sTextStyle const& style : TEXT_STYLES)
+            {
+                for (String const& text : corpus)
+                {
+                    verts.clear();
+                    font.AddVertsForText2D(verts, text, Vec2(0.f, 0.f), style.m_cellHeight, Rgba8::WHITE, style.m_cellAspect);
+                }
+            }
+
+            double const seconds = GetCurrentTimeSeconds() - start;
+            if (seconds < bestSeconds) bestSeconds = seconds;
+        }
+
+        outHash                 = hash;
+        outBestSeconds          = bestSeconds;
+        outAllocationsPerString = layouts > 0 ? static_cast<double>(allocations) / static_cast<double>(layouts) : 0.0;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    String GetGoldenKey(sTextBenchmarkResult const& result)
+    {
+        return result.m_fontTier > 0 ? Stringf("%s/tier%d", result.m_name.c_str(), result.m_fontTier) : result.m_name;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void TextBenchmark::AddFont(char const* name, BitmapFont const* font)
+{
+    if (font == nullptr) return;
+
+    m_fonts.push_back({ name, font, nullptr });
+}
+
+//----------------------------------------------------------------------------------------------------
+void TextBenchmark::AddGlyphTable(char const* name, FontGlyphTable const* table)
+{
+    if (table == nullptr || !table->IsLoaded()) return;
+
+    m_fonts.push_back({ name, nullptr, table });
+}
+
+//----------------------------------------------------------------------------------------------------
+void TextBenchmark::Run(int const passes)
+{
+    m_results.clear();
+
+    int glyphCount = 0;
+
+    for (String const& text : GetCorpus())
+    {
+        glyphCount += static_cast<int>(text.size());
+    }
+
+    int const stylesCount = static_cast<int>(sizeof(TEXT_STYLES) / sizeof(TEXT_STYLES[0]));
+
+    for (sFontEntry const& entry : m_fonts)
+    {
+        sTextBenchmarkResult result;
+        result.m_name        = entry.m_name;
+        result.m_fontTier    = entry.m_font != nullptr ? static_cast<int>(entry.m_font->GetFontTier()) : 0;
+        result.m_stringCount = static_cast<int>(GetCorpus().size()) * stylesCount;
+        result.m_glyphCount  = glyphCount * stylesCount;
+
+        double pcuSeconds  = 0.0;
+        double fontSeconds = 0.0;
+
+        if (entry.m_font != nullptr)
+        {
+            MeasureLayout<VertexList_PCU>(*entry.m_font, passes > 0 ? passes : 1, result.m_pcuHash, pcuSeconds, result.m_pcuAllocationsPerString);
+            MeasureLayout<VertexList_Font>(*entry.m_font, passes > 0 ? passes : 1, result.m_fontHash, fontSeconds, result.m_fontAllocationsPerString);
+        }
+        else
+        {
+            MeasureLayout<VertexList_PCU>(*entry.m_glyphTable, passes > 0 ? passes : 1, result.m_pcuHash, pcuSeconds, result.m_pcuAllocationsPerString);
+        }
+
+        result.m_pcuGlyphsPerSecond  = pcuSeconds > 0.0 ? static_cast<double>(result.m_glyphCount) / pcuSeconds : 0.0;
+        result.m_fontGlyphsPerSecond = fontSeconds > 0.0 ? static_cast<double>(result.m_glyphCount) / fontSeconds : 0.0;
+
+        m_results.push_back(result);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sTextBenchmarkResult> const& TextBenchmark::GetResults() const
+{
+    return m_results;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Record the current hashes as the reference for later CompareWithGolden() calls.
+bool TextBenchmark::WriteGolden(String const& filePath) const
+{
+    std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open()) return false;
+
+    file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    file << "<!-- Written by 'BenchText record=true'; hashes of BitmapFont and FontGlyphTable AddVertsForText2D output over TextBenchmark's corpus -->\n";
+    file << "<TextLayoutGolden>\n";
+
+    for (sTextBenchmarkResult const& result : m_results)
+    {
+        file << Stringf("    <Font key=\"%s\" glyphs=\"%d\" pcuHash=\"%016llx\" fontHash=\"%016llx\"/>\n",
+                        GetGoldenKey(result).c_str(),
+                        result.m_glyphCount,
+                        static_cast<unsigned long long>(result.m_pcuHash),
+                        static_cast<unsigned long long>(result.m_fontHash));
+    }
+
+    file << "</TextLayoutGolden>\n";
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return Number of fonts whose output no longer matches or has no golden entry; -1 when the golden
+/// file cannot be read.
+/// One line per font is appended to outReport.
+int TextBenchmark::CompareWithGolden(String const& filePath, std::vector<String>& outReport) const
+{
+    XmlDocument document;
+
+    if (document.LoadFile(filePath.c_str()) != tinyxml2::XML_SUCCESS || document.RootElement() == nullptr)
+    {
+        outReport.push_back(Stringf("no golden file at %s (run BenchText record=true first)", filePath.c_str()));
+        return -1;
+    }
+
+    int mismatchCount = 0;
+
+    for (sTextBenchmarkResult const& result : m_results)
+    {
+        String const      key     = GetGoldenKey(result);
+        XmlElement const* element = document.RootElement()->FirstChildElement("Font");
+
+        while (element != nullptr && ParseXmlAttribute(*element, "key", String()) != key)
+        {
+            element = element->NextSiblingElement("Font");
+        }
+
+        if (element == nullptr)
+        {
+            ++mismatchCount;
+            outReport.push_back(Stringf("%s: not in golden file (run BenchText record=true to add it)", key.c_str()));
+            continue;
+        }
+
+        uint64_t const pcuHash  = std::strtoull(ParseXmlAttribute(*element, "pcuHash", String()).c_str(), nullptr, 16);
+        uint64_t const fontHash = std::strtoull(ParseXmlAttribute(*element, "fontHash", String()).c_str(), nullptr, 16);
+        bool const     isMatch  = pcuHash == result.m_pcuHash && fontHash == result.m_fontHash;
+
+        if (!isMatch) ++mismatchCount;
+
+        outReport.push_back(Stringf("%s: %s%s%s",
+                                    key.c_str(),
+                                    isMatch ? "matches golden" : "MISMATCH",
+                                    pcuHash != result.m_pcuHash ? " (PCU vertices)" : "",
+                                    fontHash != result.m_fontHash ? " (Font vertices)" : ""));
+    }
+
+    return mismatchCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC std::vector<String> const& TextBenchmark::GetCorpus()
+{
+    static std::vector<String> const s_corpus = []
+    {
+        std::vector<String> corpus =
+        {
+            "The quick brown fox jumps over the lazy dog",
+            "AV To WAR 0123456789 !@#$%",
+            "AVAVAV LTLTLT Ty Yo Te Wa Vo P. F, r. y. ff fi fl",
+            "0123456789 3.14159 -42 +7 1,000,000 $19.99 100%",
+            "",
+            "a",
+            "Pack my box with five dozen liquor jugs. Sphinx of black quartz, judge my vow.",
+        };
+
+        String printable;
+
+        for (char character = ' '; character <= '~'; ++character)
+        {
+            printable.push_back(character);
+        }
+
+        corpus.push_back(printable);
+
+        // A long label, as a text-heavy UI screen would have
+        String paragraph;
+
+        for (int repeat = 0; repeat < 8; ++repeat)
+        {
+            paragraph += "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt. ";
+        }
+
+        corpus.push_back(paragraph);
+
+        return corpus;
+    }();
+
+    return s_corpus;
+}
@@ -0,0 +1,66 @@
+//----------------------------------------------------------------------------------------------------
+// TextBenchmark.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class BitmapFont;
+class FontGlyphTable;
+
+//----------------------------------------------------------------------------------------------------
+struct sTextBenchmarkResult
+{
+    String   m_name;
+    int      m_fontTier                 = 0;
+    int      m_stringCount              = 0;
+    int      m_glyphCount               = 0;      // Per pass over the corpus
+    double   m_pcuGlyphsPerSecond       = 0.0;
+    double   m_fontGlyphsPerSecond      = 0.0;
+    double   m_pcuAllocationsPerString  = 0.0;
+    double   m_fontAllocationsPerString = 0.0;
+    uint64_t m_pcuHash                  = 0;      // Over every vertex the corpus produced
+    uint64_t m_fontHash                 = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// CPU-only throughput and regression check for BitmapFont::AddVertsForText2D.
+//
+// Every font added is run over the same fixed corpus (pangrams, the printable ASCII range, kerning
+// pairs, digits, a long paragraph) at several heights and aspects, into both VertexList_PCU and
+// VertexList_Font. Layout speed is the best of the requested passes; heap allocations per string come
+// from FrameArena's counter. The vertex output is hashed per font and tier so a later layout change
+// can be checked against a golden file recorded before it. Game-side FontGlyphTables can be added
+// alongside for comparison; they only produce VertexList_PCU.
+//
+class TextBenchmark
+{
+public:
+    void AddFont(char const* name, BitmapFont const* font);
+    void AddGlyphTable(char const* name, FontGlyphTable const* table);
+    void Run(int passes);
+
+    std::vector<sTextBenchmarkResult> const& GetResults() const;
+
+    bool WriteGolden(String const& filePath) const;
+    int  CompareWithGolden(String const& filePath, std::vector<String>& outReport) const;
+
+    static std::vector<String> const& GetCorpus();
+
+private:
+    struct sFontEntry
+    {
+        char const*           m_name       = nullptr;
+        BitmapFont const*     m_font       = nullptr;
+        FontGlyphTable const* m_glyphTable = nullptr;
+    };
+
+    std::vector<sFontEntry>           m_fonts;
+    std::vector<sTextBenchmarkResult> m_results;
+};
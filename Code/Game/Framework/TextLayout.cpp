@@ -0,0 +1,275 @@
+//----------------------------------------------------------------------------------------------------
+// TextLayout.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/TextLayout.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FontGlyphTable.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Renderer/BitmapFont.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <iterator>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    bool AreKeysEqual(sTextLayoutKey const& a, sTextLayoutKey const& b)
+    {
+        return a.m_font == b.m_font &&
+               a.m_glyphTable == b.m_glyphTable &&
+               a.m_cellHeight == b.m_cellHeight &&
+               a.m_cellAspect == b.m_cellAspect &&
+               a.m_tint.r == b.m_tint.r &&
+               a.m_tint.g == b.m_tint.g &&
+               a.m_tint.b == b.m_tint.b &&
+               a.m_tint.a == b.m_tint.a;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // FNV-1a
+    void HashBytes(uint64_t& hash, void const* bytes, size_t const count)
+    {
+        unsigned char const* data = static_cast<unsigned char const*>(bytes);
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            hash ^= data[index];
+            hash *= 1099511628211ull;
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Appends layout, laid out at the origin, moved to textMins
+    template <typename T_Vertex>
+    void AppendTranslated(std::vector<T_Vertex>& verts, std::vector<T_Vertex> const& layout, Vec2 const& textMins)
+    {
+        size_t const first = verts.size();
+        verts.insert(verts.end(), layout.begin(), layout.end());
+
+        for (size_t index = first; index < verts.size(); ++index)
+        {
+            verts[index].m_position.x += textMins.x;
+            verts[index].m_position.y += textMins.y;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void TextLayout::Set(sTextLayoutKey const& key, String const& text)
+{
+    if (Matches(key, text)) return;
+
+    m_key         = key;
+    m_text        = text;      // Reuses the string's capacity
+    m_isPCUDirty  = true;
+    m_isFontDirty = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TextLayout::Matches(sTextLayoutKey const& key, String const& text) const
+{
+    return AreKeysEqual(m_key, key) && m_text == text;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TextLayout::AppendTo(VertexList_PCU& verts, Vec2 const& textMins) const
+{
+    if (m_key.m_font == nullptr) return;
+
+    if (m_isPCUDirty)
+    {
+        m_pcuVerts.clear();
+        if (m_key.m_glyphTable != nullptr)
+        {
+            m_key.m_glyphTable->AddVertsForText2D(m_pcuVerts, m_text, Vec2(0.f, 0.f), m_key.m_cellHeight, m_key.m_tint, m_key.m_cellAspect);
+        }
+        else
+        {
+            m_key.m_font->AddVertsForText2D(m_pcuVerts, m_text, Vec2(0.f, 0.f), m_key.m_cellHeight, m_key.m_tint, m_key.m_cellAspect);
+        }
+        m_isPCUDirty = false;
+        ++m_rebuildCount;
+    }
+
+    AppendTranslated(verts, m_pcuVerts, textMins);
+}
+
+//----------------------------------------------------------------------------------------------------
+void TextLayout::AppendTo(VertexList_Font& verts, Vec2 const& textMins) const
+{
+    if (m_key.m_font == nullptr) return;
+
+    if (m_isFontDirty)
+    {
+        m_fontVerts.clear();
+        m_key.m_font->AddVertsForText2D(m_fontVerts, m_text, Vec2(0.f, 0.f), m_key.m_cellHeight, m_key.m_tint, m_key.m_cellAspect);
+        m_isFontDirty = false;
+        ++m_rebuildCount;
+    }
+
+    AppendTranslated(verts, m_fontVerts, textMins);
+}
+
+//----------------------------------------------------------------------------------------------------
+String const& TextLayout::GetText() const
+{
+    return m_text;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TextLayout::GetRebuildCount() const
+{
+    return m_rebuildCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+TextLayoutCache::TextLayoutCache(sTextLayoutCacheConfig const& config)
+    : m_config(config)
+{
+    if (m_config.m_capacity < 1)
+    {
+        m_config.m_capacity = 1;
+    }
+
+    m_index.reserve(static_cast<size_t>(m_config.m_capacity));
+}
+
+//----------------------------------------------------------------------------------------------------
+void TextLayoutCache::AddVertsForText2D(VertexList_PCU& verts, BitmapFont const& font, String const& text, Vec2 const& textMins, float const cellHeight, Rgba8 const& tint, float const cellAspect)
+{
+    FindOrCreate({ &font, FindGlyphTable(font), cellHeight, cellAspect, tint }, text).AppendTo(verts, textMins);
+}
+
+//----------------------------------------------------------------------------------------------------
+void TextLayoutCache::AddVertsForText2D(VertexList_Font& verts, BitmapFont const& font, String const& text, Vec2 const& textMins, float const cellHeight, Rgba8 const& tint, float const cellAspect)
+{
+    FindOrCreate({ &font, FindGlyphTable(font), cellHeight, cellAspect, tint }, text).AppendTo(verts, textMins);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Lay font's PCU text out with table from now on, or with the font again for nullptr. The table is
+/// part of each layout's key, so layouts made the other way are simply no longer hit.
+void TextLayoutCache::SetGlyphTable(BitmapFont const& font, FontGlyphTable const* table)
+{
+    for (std::pair<BitmapFont const*, FontGlyphTable const*>& entry : m_glyphTables)
+    {
+        if (entry.first == &font)
+        {
+            entry.second = table;
+            return;
+        }
+    }
+
+    m_glyphTables.emplace_back(&font, table);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Drop every layout, e.g. after fonts are reloaded (layouts hold font pointers).
+void TextLayoutCache::Clear()
+{
+    m_entries.clear();
+    m_index.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+int TextLayoutCache::GetSize() const
+{
+    return static_cast<int>(m_entries.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int TextLayoutCache::GetHitCount() const
+{
+    return m_hitCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TextLayoutCache::GetMissCount() const
+{
+    return m_missCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+TextLayout const& TextLayoutCache::FindOrCreate(sTextLayoutKey const& key, String const& text)
+{
+    uint64_t const hash  = HashKey(key, text);
+    auto const     range = m_index.equal_range(hash);
+
+    for (auto found = range.first; found != range.second; ++found)
+    {
+        EntryList::iterator const entry = found->second;
+
+        if (entry->m_layout.Matches(key, text))
+        {
+            ++m_hitCount;
+            m_entries.splice(m_entries.begin(), m_entries, entry);
+            return entry->m_layout;
+        }
+    }
+
+    ++m_missCount;
+
+    if (static_cast<int>(m_entries.size()) >= m_config.m_capacity)
+    {
+        // Recycle the least recently used entry so its string and vertex storage are reused
+        EntryList::iterator const oldest   = std::prev(m_entries.end());
+        auto const                oldRange = m_index.equal_range(oldest->m_hash);
+
+        for (auto found = oldRange.first; found != oldRange.second; ++found)
+        {
+            if (found->second == oldest)
+            {
+                m_index.erase(found);
+                break;
+            }
+        }
+
+        m_entries.splice(m_entries.begin(), m_entries, oldest);
+    }
+    else
+    {
+        m_entries.emplace_front();
+    }
+
+    sEntry& entry = m_entries.front();
+    entry.m_hash  = hash;
+    entry.m_layout.Set(key, text);
+    m_index.emplace(hash, m_entries.begin());
+
+    return entry.m_layout;
+}
+
+//----------------------------------------------------------------------------------------------------
+FontGlyphTable const* TextLayoutCache::FindGlyphTable(BitmapFont const& font) const
+{
+    for (std::pair<BitmapFont const*, FontGlyphTable const*> const& entry : m_glyphTables)
+    {
+        if (entry.first == &font) return entry.second;
+    }
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC uint64_t TextLayoutCache::HashKey(sTextLayoutKey const& key, String const& text)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    HashBytes(hash, &key.m_font, sizeof(key.m_font));
+    HashBytes(hash, &key.m_glyphTable, sizeof(key.m_glyphTable));
+    HashBytes(hash, &key.m_cellHeight, sizeof(float));
+    HashBytes(hash, &key.m_cellAspect, sizeof(float));
+    HashBytes(hash, &key.m_tint.r, 1);
+    HashBytes(hash, &key.m_tint.g, 1);
+    HashBytes(hash, &key.m_tint.b, 1);
+    HashBytes(hash, &key.m_tint.a, 1);
+    HashBytes(hash, text.data(), text.size());
+
+    return hash;
+}
@@ -0,0 +1,120 @@
+//----------------------------------------------------------------------------------------------------
+// TextLayout.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Renderer/Vertex_Font.hpp"
+#include "Engine/Renderer/Vertex_PCU.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class BitmapFont;
+class FontGlyphTable;
+
+//----------------------------------------------------------------------------------------------------
+// Everything BitmapFont::AddVertsForText2D depends on except the position, which only translates
+// the vertices and is applied when they are appended.
+//
+struct sTextLayoutKey
+{
+    BitmapFont const*     m_font       = nullptr;
+    FontGlyphTable const* m_glyphTable = nullptr;     // Lays out the PCU vertices instead of m_font when set
+    float                 m_cellHeight = 0.f;
+    float                 m_cellAspect = 1.f;
+    Rgba8                 m_tint       = Rgba8::WHITE;
+};
+
+//----------------------------------------------------------------------------------------------------
+// One piece of text laid out once and kept as vertices.
+//
+// Set() is cheap to call every frame: it only marks the layout dirty when the font, string, height,
+// tint or aspect actually differ. AppendTo() runs BitmapFont::AddVertsForText2D (glyph lookup,
+// kerning, auto widths) at the origin only for a dirty layout, and otherwise appends the stored
+// vertices moved to textMins, so text that moves is not laid out again. PCU and Font vertices are
+// cached separately, each built the first time it is asked for. With a glyph table in the key the PCU
+// vertices come from FontGlyphTable::AddVertsForText2D; Font vertices always come from BitmapFont,
+// since the table only writes VertexList_PCU.
+//
+class TextLayout
+{
+public:
+    void Set(sTextLayoutKey const& key, String const& text);
+    bool Matches(sTextLayoutKey const& key, String const& text) const;
+
+    void AppendTo(VertexList_PCU& verts, Vec2 const& textMins) const;
+    void AppendTo(VertexList_Font& verts, Vec2 const& textMins) const;
+
+    String const& GetText() const;
+    int           GetRebuildCount() const;
+
+private:
+    sTextLayoutKey          m_key;
+    String                  m_text;
+    mutable VertexList_PCU  m_pcuVerts;
+    mutable VertexList_Font m_fontVerts;
+    mutable bool            m_isPCUDirty   = true;
+    mutable bool            m_isFontDirty  = true;
+    mutable int             m_rebuildCount = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Loaded from the <TextLayoutCache> element of Data/GameConfig.xml.
+//
+struct sTextLayoutCacheConfig
+{
+    int m_capacity = 256;       // Layouts kept; the least recently used one is recycled beyond this
+};
+
+//----------------------------------------------------------------------------------------------------
+// Least-recently-used cache of TextLayouts for immediate-mode callers that re-submit the same text
+// every frame. AddVertsForText2D() takes the same arguments as BitmapFont's; textMins is not part of
+// the key, so a hit costs a hash of the string and a translated copy of its vertices wherever the text
+// is drawn. A miss recycles the oldest entry, reusing its storage. SetGlyphTable() routes a font's
+// PCU layout through a FontGlyphTable loaded from the same .fnt.
+//
+class TextLayoutCache
+{
+public:
+    explicit TextLayoutCache(sTextLayoutCacheConfig const& config);
+
+    void AddVertsForText2D(VertexList_PCU& verts, BitmapFont const& font, String const& text, Vec2 const& textMins, float cellHeight, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f);
+    void AddVertsForText2D(VertexList_Font& verts, BitmapFont const& font, String const& text, Vec2 const& textMins, float cellHeight, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f);
+
+    void SetGlyphTable(BitmapFont const& font, FontGlyphTable const* table);
+    void Clear();
+
+    int GetSize() const;
+    int GetHitCount() const;
+    int GetMissCount() const;
+
+private:
+    struct sEntry
+    {
+        uint64_t   m_hash = 0;
+        TextLayout m_layout;
+    };
+
+    using EntryList = std::list<sEntry>;
+
+    TextLayout const&     FindOrCreate(sTextLayoutKey const& key, String const& text);
+    FontGlyphTable const* FindGlyphTable(BitmapFont const& font) const;
+
+    static uint64_t HashKey(sTextLayoutKey const& key, String const& text);
+
+    sTextLayoutCacheConfig                                           m_config;
+    EntryList                                                        m_entries;     // Front is the most recently used
+    std::unordered_multimap<uint64_t, EntryList::iterator>           m_index;
+    std::vector<std::pair<BitmapFont const*, FontGlyphTable const*>> m_glyphTables; // Fonts laid out by a FontGlyphTable, see SetGlyphTable()
+    int                                                              m_hitCount  = 0;
+    int                                                              m_missCount = 0;
+};
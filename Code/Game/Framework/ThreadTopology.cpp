@@ -0,0 +1,371 @@
+//----------------------------------------------------------------------------------------------------
+// ThreadTopology.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ThreadTopology.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Time.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <bit>
+#include <cstdlib>
+#include <thread>
+//----------------------------------------------------------------------------------------------------
+#define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
+#include <windows.h>			// #include this (massive, platform-specific) header in VERY few places (and .CPPs only)
+#include <process.h>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    /// @brief
+    /// Physical cores and NUMA nodes from GetLogicalProcessorInformationEx, across every processor
+    /// group. Falls back to one core per logical processor, all on one node.
+    sCpuTopology DetectCpuTopology()
+    {
+        sCpuTopology topology;
+        DWORD        length = 0;
+
+        GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+
+        std::vector<uint8_t> buffer(length);
+
+        if (length > 0 && GetLogicalProcessorInformationEx(RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &length))
+        {
+            int logicalCount = 0;
+
+            for (DWORD offset = 0; offset < length;)
+            {
+                SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX const* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX const*>(buffer.data() + offset);
+
+                if (info->Relationship == RelationProcessorCore)
+                {
+                    // A core never spans groups, so its first mask is all of it
+                    GROUP_AFFINITY const& cpus = info->Processor.GroupMask[0];
+
+                    topology.m_cores.push_back(sCpuSet{ cpus.Group, static_cast<uint64_t>(cpus.Mask) });
+                    logicalCount += std::popcount(static_cast<uint64_t>(cpus.Mask));
+                }
+                else if (info->Relationship == RelationNumaNode)
+                {
+                    GROUP_AFFINITY const& cpus = info->NumaNode.GroupMask;
+
+                    topology.m_nodes.push_back(sCpuSet{ cpus.Group, static_cast<uint64_t>(cpus.Mask) });
+                }
+
+                offset += info->Size;
+            }
+
+            topology.m_logicalCount = logicalCount;
+        }
+
+        if (topology.m_cores.empty())
+        {
+            int const logicalCount = std::thread::hardware_concurrency() > 0 ? static_cast<int>(std::thread::hardware_concurrency()) : 1;
+
+            for (int logical = 0; logical < logicalCount; ++logical)
+            {
+                topology.m_cores.push_back(sCpuSet{ static_cast<uint16_t>(logical / 64), uint64_t{1} << (logical % 64) });
+            }
+
+            topology.m_logicalCount = logicalCount;
+        }
+
+        if (topology.m_nodes.empty())
+        {
+            sCpuSet allCpus;
+
+            for (sCpuSet const& core : topology.m_cores)
+            {
+                if (core.m_group == 0) allCpus.m_mask |= core.m_mask;
+            }
+
+            topology.m_nodes.push_back(allCpus);
+        }
+
+        topology.m_physicalCount = static_cast<int>(topology.m_cores.size());
+        topology.m_numaNodeCount = static_cast<int>(topology.m_nodes.size());
+
+        return topology;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    unsigned __stdcall PoolThreadEntry(void* argument)
+    {
+        std::unique_ptr<std::function<void()>> const body(static_cast<std::function<void()>*>(argument));
+
+        (*body)();
+
+        return 0;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Detected on first use; the topology does not change while the game runs.
+sCpuTopology const& GetCpuTopology()
+{
+    static sCpuTopology const s_topology = DetectCpuTopology();
+
+    return s_topology;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// The CPUs thread threadIndex of a pool is pinned to.
+/// @return false when the affinity leaves the thread to the OS.
+bool ResolveThreadAffinity(sThreadPoolConfig const& config, int const threadIndex, sCpuSet& outCpus)
+{
+    sCpuTopology const& topology = GetCpuTopology();
+    String const&       affinity = config.m_affinity;
+
+    if (affinity == "physical")
+    {
+        int const coreCount = static_cast<int>(topology.m_cores.size());
+        int const core      = ((config.m_firstCore + threadIndex) % coreCount + coreCount) % coreCount;
+
+        outCpus = topology.m_cores[static_cast<size_t>(core)];
+        return true;
+    }
+
+    if (affinity == "nodes")
+    {
+        outCpus = topology.m_nodes[static_cast<size_t>(threadIndex) % topology.m_nodes.size()];
+        return true;
+    }
+
+    if (affinity.rfind("node:", 0) == 0)
+    {
+        int const node = std::atoi(affinity.c_str() + 5);
+        if (node < 0 || node >= topology.m_numaNodeCount) return false;
+
+        outCpus = topology.m_nodes[static_cast<size_t>(node)];
+        return true;
+    }
+
+    if (affinity.rfind("0x", 0) == 0)
+    {
+        uint64_t const mask = std::strtoull(affinity.c_str() + 2, nullptr, 16);
+        if (mask == 0) return false;
+
+        outCpus = sCpuSet{ 0, mask };
+        return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+ThreadPoolUsage::ThreadPoolUsage(int const threadCount)
+    : m_slots(std::make_unique<sSlot[]>(static_cast<size_t>(threadCount > 0 ? threadCount : 1)))
+    , m_threadCount(threadCount > 0 ? threadCount : 1)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadPoolUsage::BeginBusy(int const threadIndex)
+{
+    m_slots[threadIndex].m_busySince.store(GetCurrentTimeSeconds(), std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadPoolUsage::EndBusy(int const threadIndex)
+{
+    sSlot&       slot  = m_slots[threadIndex];
+    double const since = slot.m_busySince.load(std::memory_order_relaxed);
+
+    if (since < 0.0) return;
+
+    // Only this thread writes its slot
+    slot.m_busySeconds.store(slot.m_busySeconds.load(std::memory_order_relaxed) + (GetCurrentTimeSeconds() - since), std::memory_order_relaxed);
+    slot.m_busySince.store(-1.0, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+int ThreadPoolUsage::GetThreadCount() const
+{
+    return m_threadCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Approximate while a run is ending; the monitor clamps the result.
+double ThreadPoolUsage::GetBusySeconds() const
+{
+    double const now         = GetCurrentTimeSeconds();
+    double       busySeconds = 0.0;
+
+    for (int threadIndex = 0; threadIndex < m_threadCount; ++threadIndex)
+    {
+        sSlot const& slot  = m_slots[threadIndex];
+        double const since = slot.m_busySince.load(std::memory_order_relaxed);
+
+        busySeconds += slot.m_busySeconds.load(std::memory_order_relaxed);
+        if (since >= 0.0) busySeconds += now - since;
+    }
+
+    return busySeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+PoolThread::~PoolThread()
+{
+    Join();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Starts body on a new thread placed per config for threadIndex.
+/// @return false if the thread could not be created.
+bool PoolThread::Start(std::function<void()> body, sThreadPoolConfig const& config, int const threadIndex)
+{
+    Join();
+
+    std::function<void()>* const argument   = new std::function<void()>(std::move(body));
+    unsigned const               stackBytes = config.m_stackKiB > 0 ? static_cast<unsigned>(config.m_stackKiB) * 1024u : 0u;
+    unsigned                     threadId   = 0;
+
+    uintptr_t const handle = _beginthreadex(nullptr, stackBytes, &PoolThreadEntry, argument, CREATE_SUSPENDED | STACK_SIZE_PARAM_IS_A_RESERVATION, &threadId);
+
+    if (handle == 0)
+    {
+        delete argument;
+        return false;
+    }
+
+    m_handle   = reinterpret_cast<void*>(handle);
+    m_threadId = threadId;
+
+    sCpuSet cpus;
+
+    if (ResolveThreadAffinity(config, threadIndex, cpus))
+    {
+        GROUP_AFFINITY affinity = {};
+        affinity.Group          = cpus.m_group;
+        affinity.Mask           = static_cast<KAFFINITY>(cpus.m_mask);
+
+        SetThreadGroupAffinity(static_cast<HANDLE>(m_handle), &affinity, nullptr);
+    }
+
+    String const       name = Stringf("%s %d", config.m_name.c_str(), threadIndex);
+    std::wstring const wideName(name.begin(), name.end());
+
+    SetThreadDescription(static_cast<HANDLE>(m_handle), wideName.c_str());
+    ResumeThread(static_cast<HANDLE>(m_handle));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void PoolThread::Join()
+{
+    if (m_handle == nullptr) return;
+
+    WaitForSingleObject(static_cast<HANDLE>(m_handle), INFINITE);
+    CloseHandle(static_cast<HANDLE>(m_handle));
+
+    m_handle   = nullptr;
+    m_threadId = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PoolThread::IsRunning() const
+{
+    return m_handle != nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PoolThread::IsCurrentThread() const
+{
+    return m_handle != nullptr && GetCurrentThreadId() == m_threadId;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadUsageMonitor::AddSource(String const& poolName, ThreadPoolUsage const* usage)
+{
+    if (usage == nullptr) return;
+
+    for (sPool& pool : m_pools)
+    {
+        if (pool.m_name == poolName)
+        {
+            pool.m_sources.push_back(usage);
+            pool.m_lastBusySeconds = GetBusySeconds(pool);
+            return;
+        }
+    }
+
+    sPool& pool = m_pools.emplace_back();
+    pool.m_name = poolName;
+    pool.m_sources.push_back(usage);
+    pool.m_lastBusySeconds = GetBusySeconds(pool);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Recomputes each pool's utilization, and the summary, once intervalSeconds have passed.
+void ThreadUsageMonitor::Update(double const nowSeconds, double const intervalSeconds)
+{
+    if (m_lastSeconds < 0.0)
+    {
+        m_lastSeconds = nowSeconds;
+        return;
+    }
+
+    double const elapsedSeconds = nowSeconds - m_lastSeconds;
+    if (elapsedSeconds < intervalSeconds) return;
+
+    m_lastSeconds = nowSeconds;
+    m_summary.clear();
+
+    for (sPool& pool : m_pools)
+    {
+        double const busySeconds = GetBusySeconds(pool);
+        int const    threadCount = GetThreadCount(pool);
+        double const utilization = (busySeconds - pool.m_lastBusySeconds) / (elapsedSeconds * threadCount);
+
+        pool.m_lastBusySeconds = busySeconds;
+        pool.m_utilization     = static_cast<float>(utilization < 0.0 ? 0.0 : utilization > 1.0 ? 1.0 : utilization);
+
+        m_summary += Stringf("%s%s %dx %3.0f%%", m_summary.empty() ? "" : " | ", pool.m_name.c_str(), threadCount, pool.m_utilization * 100.f);
+    }
+
+    sCpuTopology const& topology = GetCpuTopology();
+
+    m_summary += Stringf(" | %d cores, %d threads, %d node%s", topology.m_physicalCount, topology.m_logicalCount, topology.m_numaNodeCount, topology.m_numaNodeCount == 1 ? "" : "s");
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Empty until the first interval has passed.
+String const& ThreadUsageMonitor::GetSummary() const
+{
+    return m_summary;
+}
+
+//----------------------------------------------------------------------------------------------------
+double ThreadUsageMonitor::GetBusySeconds(sPool const& pool) const
+{
+    double busySeconds = 0.0;
+
+    for (ThreadPoolUsage const* usage : pool.m_sources)
+    {
+        busySeconds += usage->GetBusySeconds();
+    }
+
+    return busySeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ThreadUsageMonitor::GetThreadCount(sPool const& pool) const
+{
+    int threadCount = 0;
+
+    for (ThreadPoolUsage const* usage : pool.m_sources)
+    {
+        threadCount += usage->GetThreadCount();
+    }
+
+    return threadCount;
+}
@@ -0,0 +1,135 @@
+//----------------------------------------------------------------------------------------------------
+// ThreadTopology.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Loaded from a <Pool> element of the <Threading> block in Data/GameConfig.xml. Affinity is one of:
+//   auto       left to the OS
+//   physical   thread i on physical core firstCore + i (wrapping), on all of that core's SMT siblings
+//   node:N     every thread on NUMA node N
+//   nodes      thread i on NUMA node i (wrapping)
+//   0x...      an explicit mask of logical processors in processor group 0
+// Anything else is treated as auto.
+//
+struct sThreadPoolConfig
+{
+    String m_name             = "Pool";     // Thread names in debuggers and profilers, and the HUD label
+    int    m_threadCount      = 0;          // 0 = sized by the pool's owner from the detected topology
+    String m_affinity         = "auto";
+    int    m_firstCore        = 0;
+    int    m_stackKiB         = 0;          // Stack reserved per thread; 0 = the executable's default (1 MiB)
+    float  m_spinMicroseconds = 50.f;       // Job pools: how long an idle worker keeps looking for work before it sleeps
+};
+
+//----------------------------------------------------------------------------------------------------
+// Logical processors of one physical core or NUMA node, within one processor group.
+//
+struct sCpuSet
+{
+    uint16_t m_group = 0;
+    uint64_t m_mask  = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sCpuTopology
+{
+    int                  m_logicalCount  = 1;
+    int                  m_physicalCount = 1;
+    int                  m_numaNodeCount = 1;
+    std::vector<sCpuSet> m_cores;               // Per physical core: its SMT siblings
+    std::vector<sCpuSet> m_nodes;               // Per NUMA node
+};
+
+sCpuTopology const& GetCpuTopology();
+bool                ResolveThreadAffinity(sThreadPoolConfig const& config, int threadIndex, sCpuSet& outCpus);
+
+//----------------------------------------------------------------------------------------------------
+// Busy time of a pool's threads, for utilization. Each thread marks the start and end of its runs of
+// work in its own slot; readers add the run still in progress, so a thread that never idles still
+// shows as busy.
+//
+class ThreadPoolUsage
+{
+public:
+    explicit ThreadPoolUsage(int threadCount);
+
+    void BeginBusy(int threadIndex);
+    void EndBusy(int threadIndex);
+
+    int    GetThreadCount() const;
+    double GetBusySeconds() const;
+
+private:
+    struct alignas(64) sSlot
+    {
+        std::atomic<double> m_busySeconds{0.0};
+        std::atomic<double> m_busySince{-1.0};     // Negative while idle
+    };
+
+    std::unique_ptr<sSlot[]> m_slots;
+    int                      m_threadCount = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// A game-side thread placed by a sThreadPoolConfig: started suspended with the pool's stack size,
+// pinned to the CPUs its affinity resolves to for its index, named, then resumed.
+//
+class PoolThread
+{
+public:
+    PoolThread() = default;
+    ~PoolThread();
+
+    PoolThread(PoolThread const&)            = delete;
+    PoolThread& operator=(PoolThread const&) = delete;
+
+    bool Start(std::function<void()> body, sThreadPoolConfig const& config, int threadIndex);
+    void Join();
+
+    bool IsRunning() const;
+    bool IsCurrentThread() const;
+
+private:
+    void*    m_handle   = nullptr;
+    uint32_t m_threadId = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Per-pool utilization over the last interval, for the debug HUD. Sources with the same pool name
+// (the logging thread and the log compressor) are summed into one entry.
+//
+class ThreadUsageMonitor
+{
+public:
+    void AddSource(String const& poolName, ThreadPoolUsage const* usage);
+    void Update(double nowSeconds, double intervalSeconds = 0.5);
+
+    String const& GetSummary() const;
+
+private:
+    struct sPool
+    {
+        String                              m_name;
+        std::vector<ThreadPoolUsage const*> m_sources;
+        double                              m_lastBusySeconds = 0.0;
+        float                               m_utilization     = 0.f;
+    };
+
+    double GetBusySeconds(sPool const& pool) const;
+    int    GetThreadCount(sPool const& pool) const;
+
+    std::vector<sPool> m_pools;
+    double             m_lastSeconds = -1.0;
+    String             m_summary;
+};
@@ -0,0 +1,424 @@
+//----------------------------------------------------------------------------------------------------
+// VertexBuilder2D.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/VertexBuilder2D.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/MathUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VERTEX_BUILDER_SIMD_WIDTH 8
+#elif defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define VERTEX_BUILDER_SIMD_WIDTH 4
+#else
+#define VERTEX_BUILDER_SIMD_WIDTH 1
+#endif
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    // Lane abstraction so one SIMD implementation covers both SSE2 and AVX2
+    //
+#if VERTEX_BUILDER_SIMD_WIDTH == 8
+    int constexpr LANES = 8;
+    using Lanes         = __m256;
+
+    Lanes Load(float const* p) { return _mm256_loadu_ps(p); }
+    void  Store(float* p, Lanes v) { _mm256_storeu_ps(p, v); }
+    Lanes Set1(float f) { return _mm256_set1_ps(f); }
+    Lanes Add(Lanes a, Lanes b) { return _mm256_add_ps(a, b); }
+    Lanes Sub(Lanes a, Lanes b) { return _mm256_sub_ps(a, b); }
+    Lanes Mul(Lanes a, Lanes b) { return _mm256_mul_ps(a, b); }
+    Lanes Div(Lanes a, Lanes b) { return _mm256_div_ps(a, b); }
+    Lanes Sqrt(Lanes a) { return _mm256_sqrt_ps(a); }
+    Lanes Max(Lanes a, Lanes b) { return _mm256_max_ps(a, b); }
+#elif VERTEX_BUILDER_SIMD_WIDTH == 4
+    int constexpr LANES = 4;
+    using Lanes         = __m128;
+
+    Lanes Load(float const* p) { return _mm_loadu_ps(p); }
+    void  Store(float* p, Lanes v) { _mm_storeu_ps(p, v); }
+    Lanes Set1(float f) { return _mm_set1_ps(f); }
+    Lanes Add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+    Lanes Sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+    Lanes Mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+    Lanes Div(Lanes a, Lanes b) { return _mm_div_ps(a, b); }
+    Lanes Sqrt(Lanes a) { return _mm_sqrt_ps(a); }
+    Lanes Max(Lanes a, Lanes b) { return _mm_max_ps(a, b); }
+#else
+    int constexpr LANES = 1;
+#endif
+
+    int constexpr SIDE_MULTIPLE = 8;      // Keeps every table a whole number of lanes at either width
+    int constexpr MAX_SIDES     = 1024;
+
+    //------------------------------------------------------------------------------------------------
+    // cos/sin of the start angle of every side, plus the closing entry, padded by one lane
+    //
+    struct sSinCosTable
+    {
+        std::vector<float> m_cos;
+        std::vector<float> m_sin;
+    };
+
+    sSinCosTable const& GetSinCosTable(int const numSides)
+    {
+        static std::mutex        s_tablesMutex;
+        static sSinCosTable      s_tables[MAX_SIDES / SIDE_MULTIPLE + 1];
+        static std::atomic<bool> s_isBuilt[MAX_SIDES / SIDE_MULTIPLE + 1];
+
+        int const     level = numSides / SIDE_MULTIPLE;
+        sSinCosTable& table = s_tables[level];
+
+        if (!s_isBuilt[level].load(std::memory_order_acquire))
+        {
+            std::lock_guard lock(s_tablesMutex);
+
+            if (!s_isBuilt[level].load(std::memory_order_relaxed))
+            {
+                float const degreesPerSide = 360.f / static_cast<float>(numSides);
+
+                table.m_cos.resize(static_cast<size_t>(numSides + 1 + LANES));
+                table.m_sin.resize(static_cast<size_t>(numSides + 1 + LANES));
+
+                for (int sideNum = 0; sideNum < numSides + 1 + LANES; ++sideNum)
+                {
+                    float const degrees = degreesPerSide * static_cast<float>(sideNum % numSides);
+
+                    table.m_cos[sideNum] = CosDegrees(degrees);
+                    table.m_sin[sideNum] = SinDegrees(degrees);
+                }
+
+                s_isBuilt[level].store(true, std::memory_order_release);
+            }
+        }
+
+        return table;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    Vertex_PCU* GrowBy(VertexList_PCU& verts, size_t const vertexCount)
+    {
+        size_t const firstVertex = verts.size();
+        verts.resize(firstVertex + vertexCount);
+
+        return verts.data() + firstVertex;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void WriteVertex(Vertex_PCU*& out, float const x, float const y, Rgba8 const& color)
+    {
+        out->m_position    = Vec3(x, y, 0.f);
+        out->m_color       = color;
+        out->m_uvTexCoords = Vec2(0.f, 0.f);
+        ++out;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Counter-clockwise quad a-b-c-d as triangles abc, acd
+    void WriteQuad(Vertex_PCU*& out, float const ax, float const ay, float const bx, float const by,
+                   float const cx, float const cy, float const dx, float const dy, Rgba8 const& color)
+    {
+        WriteVertex(out, ax, ay, color);
+        WriteVertex(out, bx, by, color);
+        WriteVertex(out, cx, cy, color);
+        WriteVertex(out, ax, ay, color);
+        WriteVertex(out, cx, cy, color);
+        WriteVertex(out, dx, dy, color);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Scalar kernels; also used for the tail that does not fill a whole set of lanes
+    //
+    void BuildLineSegmentsScalar(Vertex_PCU*& out, sLineSegmentsSoA2D const& segments, int const first, int const last)
+    {
+        for (int index = first; index < last; ++index)
+        {
+            float const dx         = segments.m_endX[index] - segments.m_startX[index];
+            float const dy         = segments.m_endY[index] - segments.m_startY[index];
+            float const length     = std::sqrt(dx * dx + dy * dy);
+            float const halfScale  = 0.5f * segments.m_thickness[index] / (length > 1e-20f ? length : 1e-20f);
+            float const offsetX    = -dy * halfScale;
+            float const offsetY    = dx * halfScale;
+
+            WriteQuad(out,
+                      segments.m_startX[index] - offsetX, segments.m_startY[index] - offsetY,
+                      segments.m_endX[index] - offsetX, segments.m_endY[index] - offsetY,
+                      segments.m_endX[index] + offsetX, segments.m_endY[index] + offsetY,
+                      segments.m_startX[index] + offsetX, segments.m_startY[index] + offsetY,
+                      segments.m_color[index]);
+        }
+    }
+
+    void BuildRingScalar(Vertex_PCU*& out, sSinCosTable const& table, int const numSides, float const centerX, float const centerY,
+                         float const innerRadius, float const outerRadius, Rgba8 const& color, int const firstSide)
+    {
+        for (int sideNum = firstSide; sideNum < numSides; ++sideNum)
+        {
+            float const cosStart = table.m_cos[sideNum];
+            float const sinStart = table.m_sin[sideNum];
+            float const cosEnd   = table.m_cos[sideNum + 1];
+            float const sinEnd   = table.m_sin[sideNum + 1];
+
+            WriteQuad(out,
+                      centerX + innerRadius * cosEnd, centerY + innerRadius * sinEnd,
+                      centerX + innerRadius * cosStart, centerY + innerRadius * sinStart,
+                      centerX + outerRadius * cosStart, centerY + outerRadius * sinStart,
+                      centerX + outerRadius * cosEnd, centerY + outerRadius * sinEnd,
+                      color);
+        }
+    }
+
+    void BuildDiscScalar(Vertex_PCU*& out, sSinCosTable const& table, int const numSides, float const centerX, float const centerY,
+                         float const radius, Rgba8 const& color, int const firstSide)
+    {
+        for (int sideNum = firstSide; sideNum < numSides; ++sideNum)
+        {
+            WriteVertex(out, centerX, centerY, color);
+            WriteVertex(out, centerX + radius * table.m_cos[sideNum], centerY + radius * table.m_sin[sideNum], color);
+            WriteVertex(out, centerX + radius * table.m_cos[sideNum + 1], centerY + radius * table.m_sin[sideNum + 1], color);
+        }
+    }
+
+    void BuildAABBsScalar(Vertex_PCU*& out, sAABBsSoA2D const& boxes, int const first, int const last)
+    {
+        for (int index = first; index < last; ++index)
+        {
+            WriteQuad(out,
+                      boxes.m_minX[index], boxes.m_minY[index],
+                      boxes.m_maxX[index], boxes.m_minY[index],
+                      boxes.m_maxX[index], boxes.m_maxY[index],
+                      boxes.m_minX[index], boxes.m_maxY[index],
+                      boxes.m_color[index]);
+        }
+    }
+
+#if VERTEX_BUILDER_SIMD_WIDTH > 1
+    //------------------------------------------------------------------------------------------------
+    // SIMD kernels: positions for LANES elements are computed together, then scattered into the
+    // interleaved Vertex_PCU stream. Return the first element they did not handle.
+    //
+    int BuildLineSegmentsSIMD(Vertex_PCU*& out, sLineSegmentsSoA2D const& segments)
+    {
+        Lanes const half    = Set1(0.5f);
+        Lanes const epsilon = Set1(1e-20f);
+        int         index   = 0;
+
+        alignas(32) float ax[LANES], ay[LANES], bx[LANES], by[LANES], cx[LANES], cy[LANES], dx[LANES], dy[LANES];
+
+        for (; index + LANES <= segments.m_count; index += LANES)
+        {
+            Lanes const startX    = Load(segments.m_startX + index);
+            Lanes const startY    = Load(segments.m_startY + index);
+            Lanes const endX      = Load(segments.m_endX + index);
+            Lanes const endY      = Load(segments.m_endY + index);
+            Lanes const forwardX  = Sub(endX, startX);
+            Lanes const forwardY  = Sub(endY, startY);
+            Lanes const length    = Max(Sqrt(Add(Mul(forwardX, forwardX), Mul(forwardY, forwardY))), epsilon);
+            Lanes const halfScale = Div(Mul(half, Load(segments.m_thickness + index)), length);
+            Lanes const offsetX   = Mul(Sub(Set1(0.f), forwardY), halfScale);
+            Lanes const offsetY   = Mul(forwardX, halfScale);
+
+            Store(ax, Sub(startX, offsetX)); Store(ay, Sub(startY, offsetY));
+            Store(bx, Sub(endX, offsetX));   Store(by, Sub(endY, offsetY));
+            Store(cx, Add(endX, offsetX));   Store(cy, Add(endY, offsetY));
+            Store(dx, Add(startX, offsetX)); Store(dy, Add(startY, offsetY));
+
+            for (int lane = 0; lane < LANES; ++lane)
+            {
+                WriteQuad(out, ax[lane], ay[lane], bx[lane], by[lane], cx[lane], cy[lane], dx[lane], dy[lane], segments.m_color[index + lane]);
+            }
+        }
+
+        return index;
+    }
+
+    void BuildRingSIMD(Vertex_PCU*& out, sSinCosTable const& table, int const numSides, float const centerX, float const centerY,
+                       float const innerRadius, float const outerRadius, Rgba8 const& color)
+    {
+        Lanes const centerXs = Set1(centerX);
+        Lanes const centerYs = Set1(centerY);
+        Lanes const inners   = Set1(innerRadius);
+        Lanes const outers   = Set1(outerRadius);
+
+        // LANES + 1 points per block: side k uses point k (start) and k + 1 (end)
+        alignas(32) float innerX[LANES + 1], innerY[LANES + 1], outerX[LANES + 1], outerY[LANES + 1];
+
+        for (int sideNum = 0; sideNum < numSides; sideNum += LANES)
+        {
+            Lanes const cosines = Load(table.m_cos.data() + sideNum);
+            Lanes const sines   = Load(table.m_sin.data() + sideNum);
+
+            Store(innerX, Add(centerXs, Mul(inners, cosines)));
+            Store(innerY, Add(centerYs, Mul(inners, sines)));
+            Store(outerX, Add(centerXs, Mul(outers, cosines)));
+            Store(outerY, Add(centerYs, Mul(outers, sines)));
+
+            float const cosNext = table.m_cos[sideNum + LANES];
+            float const sinNext = table.m_sin[sideNum + LANES];
+            innerX[LANES] = centerX + innerRadius * cosNext;
+            innerY[LANES] = centerY + innerRadius * sinNext;
+            outerX[LANES] = centerX + outerRadius * cosNext;
+            outerY[LANES] = centerY + outerRadius * sinNext;
+
+            for (int lane = 0; lane < LANES; ++lane)
+            {
+                WriteQuad(out,
+                          innerX[lane + 1], innerY[lane + 1],
+                          innerX[lane], innerY[lane],
+                          outerX[lane], outerY[lane],
+                          outerX[lane + 1], outerY[lane + 1],
+                          color);
+            }
+        }
+    }
+
+    void BuildDiscSIMD(Vertex_PCU*& out, sSinCosTable const& table, int const numSides, float const centerX, float const centerY,
+                       float const radius, Rgba8 const& color)
+    {
+        Lanes const centerXs = Set1(centerX);
+        Lanes const centerYs = Set1(centerY);
+        Lanes const radii    = Set1(radius);
+
+        alignas(32) float rimX[LANES + 1], rimY[LANES + 1];
+
+        for (int sideNum = 0; sideNum < numSides; sideNum += LANES)
+        {
+            Store(rimX, Add(centerXs, Mul(radii, Load(table.m_cos.data() + sideNum))));
+            Store(rimY, Add(centerYs, Mul(radii, Load(table.m_sin.data() + sideNum))));
+            rimX[LANES] = centerX + radius * table.m_cos[sideNum + LANES];
+            rimY[LANES] = centerY + radius * table.m_sin[sideNum + LANES];
+
+            for (int lane = 0; lane < LANES; ++lane)
+            {
+                WriteVertex(out, centerX, centerY, color);
+                WriteVertex(out, rimX[lane], rimY[lane], color);
+                WriteVertex(out, rimX[lane + 1], rimY[lane + 1], color);
+            }
+        }
+    }
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+void AddVertsForLineSegments2D(VertexList_PCU& verts, sLineSegmentsSoA2D const& segments, eVertexBuilderPath const path)
+{
+    if (segments.m_count <= 0) return;
+
+    Vertex_PCU* out   = GrowBy(verts, static_cast<size_t>(segments.m_count) * 6);
+    int         first = 0;
+
+#if VERTEX_BUILDER_SIMD_WIDTH > 1
+    if (path == eVertexBuilderPath::SIMD)
+    {
+        first = BuildLineSegmentsSIMD(out, segments);
+    }
+#else
+    (void)path;
+#endif
+
+    BuildLineSegmentsScalar(out, segments, first, segments.m_count);
+}
+
+//----------------------------------------------------------------------------------------------------
+void AddVertsForRings2D(VertexList_PCU& verts, sCirclesSoA2D const& rings, int numSides, eVertexBuilderPath const path)
+{
+    if (rings.m_count <= 0) return;
+
+    numSides = GetVertexBuilderSides(numSides);
+
+    sSinCosTable const& table = GetSinCosTable(numSides);
+    Vertex_PCU*         out   = GrowBy(verts, static_cast<size_t>(rings.m_count) * static_cast<size_t>(numSides) * 6);
+
+    for (int index = 0; index < rings.m_count; ++index)
+    {
+        float const halfThickness = 0.5f * rings.m_thickness[index];
+        float const innerRadius   = rings.m_radius[index] - halfThickness;
+        float const outerRadius   = rings.m_radius[index] + halfThickness;
+
+#if VERTEX_BUILDER_SIMD_WIDTH > 1
+        if (path == eVertexBuilderPath::SIMD)
+        {
+            BuildRingSIMD(out, table, numSides, rings.m_centerX[index], rings.m_centerY[index], innerRadius, outerRadius, rings.m_color[index]);
+            continue;
+        }
+#else
+        (void)path;
+#endif
+
+        BuildRingScalar(out, table, numSides, rings.m_centerX[index], rings.m_centerY[index], innerRadius, outerRadius, rings.m_color[index], 0);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void AddVertsForDiscs2D(VertexList_PCU& verts, sCirclesSoA2D const& discs, int numSides, eVertexBuilderPath const path)
+{
+    if (discs.m_count <= 0) return;
+
+    numSides = GetVertexBuilderSides(numSides);
+
+    sSinCosTable const& table = GetSinCosTable(numSides);
+    Vertex_PCU*         out   = GrowBy(verts, static_cast<size_t>(discs.m_count) * static_cast<size_t>(numSides) * 3);
+
+    for (int index = 0; index < discs.m_count; ++index)
+    {
+#if VERTEX_BUILDER_SIMD_WIDTH > 1
+        if (path == eVertexBuilderPath::SIMD)
+        {
+            BuildDiscSIMD(out, table, numSides, discs.m_centerX[index], discs.m_centerY[index], discs.m_radius[index], discs.m_color[index]);
+            continue;
+        }
+#else
+        (void)path;
+#endif
+
+        BuildDiscScalar(out, table, numSides, discs.m_centerX[index], discs.m_centerY[index], discs.m_radius[index], discs.m_color[index], 0);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Boxes need no arithmetic, only the scatter, so both paths share the scalar kernel.
+void AddVertsForAABBs2D(VertexList_PCU& verts, sAABBsSoA2D const& boxes, eVertexBuilderPath const path)
+{
+    (void)path;
+
+    if (boxes.m_count <= 0) return;
+
+    Vertex_PCU* out = GrowBy(verts, static_cast<size_t>(boxes.m_count) * 6);
+
+    BuildAABBsScalar(out, boxes, 0, boxes.m_count);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return numSides clamped to [8, 1024] and rounded up to a multiple of 8, as the builders use it.
+int GetVertexBuilderSides(int const numSides)
+{
+    int sides = (numSides + SIDE_MULTIPLE - 1) / SIDE_MULTIPLE * SIDE_MULTIPLE;
+
+    if (sides < SIDE_MULTIPLE) sides = SIDE_MULTIPLE;
+    if (sides > MAX_SIDES) sides = MAX_SIDES;
+
+    return sides;
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* GetVertexBuilderSIMDName()
+{
+#if VERTEX_BUILDER_SIMD_WIDTH == 8
+    return "AVX2 x8";
+#elif VERTEX_BUILDER_SIMD_WIDTH == 4
+    return "SSE2 x4";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,63 @@
+//----------------------------------------------------------------------------------------------------
+// VertexBuilder2D.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Renderer/Vertex_PCU.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Structure-of-arrays inputs for the batch builders. Every array holds m_count entries.
+//
+struct sLineSegmentsSoA2D
+{
+    float const* m_startX    = nullptr;
+    float const* m_startY    = nullptr;
+    float const* m_endX      = nullptr;
+    float const* m_endY      = nullptr;
+    float const* m_thickness = nullptr;
+    Rgba8 const* m_color     = nullptr;
+    int          m_count     = 0;
+};
+
+struct sCirclesSoA2D
+{
+    float const* m_centerX   = nullptr;
+    float const* m_centerY   = nullptr;
+    float const* m_radius    = nullptr;
+    float const* m_thickness = nullptr;     // Rings only; ignored for discs
+    Rgba8 const* m_color     = nullptr;
+    int          m_count     = 0;
+};
+
+struct sAABBsSoA2D
+{
+    float const* m_minX  = nullptr;
+    float const* m_minY  = nullptr;
+    float const* m_maxX  = nullptr;
+    float const* m_maxY  = nullptr;
+    Rgba8 const* m_color = nullptr;
+    int          m_count = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eVertexBuilderPath : int8_t
+{
+    SCALAR,     // One vertex at a time; the reference the SIMD path is checked against
+    SIMD        // AVX2 (8 lanes) when built with /arch:AVX2, otherwise SSE2 (4 lanes); scalar on other CPUs
+};
+
+//----------------------------------------------------------------------------------------------------
+// Batch builders: append counter-clockwise triangles for every element to verts, written straight
+// into the list's storage (one resize per call). Ring and disc tessellation reads a sin/cos table
+// built once per side count; numSides is rounded up to a multiple of 8.
+//
+void AddVertsForLineSegments2D(VertexList_PCU& verts, sLineSegmentsSoA2D const& segments, eVertexBuilderPath path = eVertexBuilderPath::SIMD);
+void AddVertsForRings2D(VertexList_PCU& verts, sCirclesSoA2D const& rings, int numSides, eVertexBuilderPath path = eVertexBuilderPath::SIMD);
+void AddVertsForDiscs2D(VertexList_PCU& verts, sCirclesSoA2D const& discs, int numSides, eVertexBuilderPath path = eVertexBuilderPath::SIMD);
+void AddVertsForAABBs2D(VertexList_PCU& verts, sAABBsSoA2D const& boxes, eVertexBuilderPath path = eVertexBuilderPath::SIMD);
+
+int  GetVertexBuilderSides(int numSides);
+char const* GetVertexBuilderSIMDName();
@@ -6,6 +6,9 @@
 #include "Game/Gameplay/Game.hpp"
 //----------------------------------------------------------------------------------------------------
 #include "Game/Framework/App.hpp"
+#include "Game/Framework/DrawList2D.hpp"
+#include "Game/Framework/EventDispatcher.hpp"
+#include "Game/Framework/FrameProfiler.hpp"
 #include "Game/Framework/GameCommon.hpp"
 //----------------------------------------------------------------------------------------------------
 #include "Engine/Audio/AudioSystem.hpp"
@@ -21,17 +24,22 @@ Game::Game()
 {
     DAEMON_LOG(LogGame, eLogVerbosity::Display, "(Game)(start)");
 
-    g_eventSystem->SubscribeEventCallbackFunction("OnGameStateChanged", OnGameStateChanged);
+    m_stateEventId = g_eventDispatcher->Intern("OnGameStateChanged"_hcis);
+    g_eventDispatcher->Subscribe(m_stateEventId, OnGameStateChanged);
 
     m_screenCamera = new Camera();
 
+    // Headless runs have no window; keep the camera at the default 2:1 client size so gameplay code sees the same space.
     Vec2 const bottomLeft     = Vec2::ZERO;
-    Vec2 const screenTopRight = Window::s_mainWindow->GetClientDimensions();
+    Vec2 const screenTopRight = Window::s_mainWindow != nullptr ? Window::s_mainWindow->GetClientDimensions() : Vec2(1600.f, 800.f);
 
     m_screenCamera->SetOrthoGraphicView(bottomLeft, screenTopRight);
     m_screenCamera->SetNormalizedViewport(AABB2::ZERO_TO_ONE);
 
-    m_gameClock = new Clock(Clock::GetSystemClock());
+    // Headless runs step the game clock by a fixed delta per simulation step, not by wall time
+    Clock* simulationClock = g_app->GetSimulationClock();
+
+    m_gameClock = new Clock(simulationClock != nullptr ? *simulationClock : Clock::GetSystemClock());
 
     DAEMON_LOG(LogGame, eLogVerbosity::Display, "(Game)(end)");
 }
@@ -41,9 +49,10 @@ Game::~Game()
 {
     DAEMON_LOG(LogGame, eLogVerbosity::Display, "(~Game)(start)");
 
+    GAME_SAFE_RELEASE(m_gameClock);
     GAME_SAFE_RELEASE(m_screenCamera);
 
-    g_eventSystem->UnsubscribeEventCallbackFunction("OnGameStateChanged", OnGameStateChanged);
+    g_eventDispatcher->Unsubscribe(m_stateEventId, OnGameStateChanged);
 
     DAEMON_LOG(LogGame, eLogVerbosity::Display, "(~Game)(end)");
 }
@@ -51,10 +60,27 @@ Game::~Game()
 //----------------------------------------------------------------------------------------------------
 void Game::Update()
 {
-    Vec2 const      screenTopLeft = m_screenCamera->GetOrthographicTopLeft();
-    float constexpr textHeight    = 20.f;
+    PROFILE_SCOPE("Game::Update");
+
+    if (!g_app->IsHeadless())
+    {
+        Vec2 const      screenTopLeft = m_screenCamera->GetOrthographicTopLeft();
+        float constexpr textHeight    = 20.f;
+
+        // FPS comes from the unscaled system clock; the game clock reads 0 when paused and 10x at 0.1 time scale
+        float const frameSeconds = static_cast<float>(Clock::GetSystemClock().GetDeltaSeconds());
+
+        DebugAddScreenText(Stringf("Time: %.2f FPS: %.2f (%.2f ms) Scale: %.1f", m_gameClock->GetTotalSeconds(), 1.f / frameSeconds, frameSeconds * 1000.f, m_gameClock->GetTimeScale()), screenTopLeft - Vec2(0.f, textHeight), textHeight, Vec2(1, 1), 0.f);
+
+        // Busy share of each game thread pool, to tune <Threading> in GameConfig.xml
+        String const& threadUsage = g_app->GetThreadUsageSummary();
+
+        if (!threadUsage.empty())
+        {
+            DebugAddScreenText(threadUsage, screenTopLeft - Vec2(0.f, textHeight * 1.75f), textHeight * 0.75f, Vec2(1, 1), 0.f);
+        }
+    }
 
-    DebugAddScreenText(Stringf("Time: %.2f FPS: %.2f Scale: %.1f", m_gameClock->GetTotalSeconds(), 1.f / m_gameClock->GetDeltaSeconds(), m_gameClock->GetTimeScale()), screenTopLeft - Vec2(0.f, textHeight), textHeight, Vec2(1, 1), 0.f);
     UpdateGame();
     UpdateTime();
     UpdateWindow();
@@ -63,6 +89,8 @@ void Game::Update()
 //----------------------------------------------------------------------------------------------------
 void Game::Render() const
 {
+    PROFILE_SCOPE("Game::Render");
+
     //-Start-of-Screen-Camera-------------------------------------------------------------------------
     g_renderer->BeginCamera(*m_screenCamera);
 
@@ -73,6 +101,13 @@ void Game::Render() const
     else if (IsGameState())
     {
         RenderGame();
+    }
+
+    // Everything queued for this camera goes out in one sorted submission
+    g_drawList->Flush();
+
+    if (IsGameState())
+    {
         DebugRenderScreen(*m_screenCamera);
     }
 
@@ -92,7 +127,7 @@ eGameState Game::GetGameState() const
 //----------------------------------------------------------------------------------------------------
 ///
 /// 1. Set current game state to new game state.
-/// 2. Fire the OnGameStateChanged event to all subscribers.
+/// 2. Fire the OnGameStateChanged event to all subscribers, with the new eGameState as an int.
 ///
 /// @param newState new game state for current game state to change to.
 ///
@@ -100,14 +135,12 @@ void Game::SetGameState(eGameState const newState)
 {
     if (newState == m_gameState) return;
 
-    EventArgs args;
-
-    if (newState == eGameState::ATTRACT) args.SetValue("OnGameStateChanged", "ATTRACT");
-    else if (newState == eGameState::GAME) args.SetValue("OnGameStateChanged", "GAME");
+    FlatProperties args;
+    args.SetValue("OnGameStateChanged"_hcis, static_cast<int>(newState));
 
     m_gameState = newState;
 
-    g_eventSystem->FireEvent("OnGameStateChanged", args);
+    g_eventDispatcher->FireEvent(m_stateEventId, args);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -128,33 +161,43 @@ bool Game::IsGameState() const
     return m_gameState == eGameState::GAME;
 }
 
+//----------------------------------------------------------------------------------------------------
+Clock const& Game::GetClock() const
+{
+    return *m_gameClock;
+}
+
 //----------------------------------------------------------------------------------------------------
 /// @brief Event call back handler when changing game state.
 /// @param args Event arguments.
 /// 1. ATTRACT
 /// 2. GAME
-/// @return true to allow event propagation to other subscribers, false to stop propagation.
-STATIC bool Game::OnGameStateChanged(EventArgs& args)
+/// @return true to consume the event (later subscribers are skipped), false to let it propagate.
+STATIC bool Game::OnGameStateChanged(FlatProperties& args)
 {
-    String const newState = args.GetValue("OnGameStateChanged", "DEFAULT");
+    if (g_audio == nullptr) return false;
+
+    eGameState const newState = static_cast<eGameState>(args.GetValue("OnGameStateChanged"_hcis, -1));
 
-    if (newState == "ATTRACT")
+    if (newState == eGameState::ATTRACT)
     {
         SoundID const clickSound = g_audio->CreateOrGetSound("Data/Audio/TestSound.mp3", eAudioSystemSoundDimension::Sound2D);
         g_audio->StartSound(clickSound);
     }
-    else if (newState == "GAME")
+    else if (newState == eGameState::GAME)
     {
         SoundID const clickSound = g_audio->CreateOrGetSound("Data/Audio/TestSound.mp3", eAudioSystemSoundDimension::Sound2D);
         g_audio->StartSound(clickSound, false, 1.f, 0.f, 0.5f);
     }
 
-    return true;
+    return false;
 }
 
 //----------------------------------------------------------------------------------------------------
 void Game::UpdateGame()
 {
+    if (g_input == nullptr) return;
+
     if (IsAttractState())
     {
         if (g_input->WasKeyJustPressed(KEYCODE_ESC))
@@ -182,6 +225,8 @@ void Game::UpdateGame()
 //----------------------------------------------------------------------------------------------------
 void Game::UpdateTime() const
 {
+    if (g_input == nullptr) return;
+
     if (g_input->WasKeyJustPressed(KEYCODE_P))
     {
         m_gameClock->TogglePause();
@@ -203,6 +248,8 @@ void Game::UpdateTime() const
 //----------------------------------------------------------------------------------------------------
 void Game::UpdateWindow() const
 {
+    if (g_input == nullptr || Window::s_mainWindow == nullptr) return;
+
     if (IsAttractState())
     {
         if (g_input->WasKeyJustPressed(KEYCODE_R))
@@ -213,6 +260,19 @@ void Game::UpdateWindow() const
     }
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief Render state shared by the ATTRACT and GAME geometry.
+STATIC sDrawState2D Game::GetWorldDrawState()
+{
+    sDrawState2D state;
+    state.m_blendMode      = eBlendMode::OPAQUE;
+    state.m_rasterizerMode = eRasterizerMode::SOLID_CULL_BACK;
+    state.m_samplerMode    = eSamplerMode::BILINEAR_CLAMP;
+    state.m_depthMode      = eDepthMode::DISABLED;
+
+    return state;
+}
+
 //----------------------------------------------------------------------------------------------------
 ///
 /// @brief Render a simple outlined disc 2D in ATTRACT state.
@@ -221,18 +281,7 @@ void Game::RenderAttract() const
 {
     Vec2 const clientDimensions = Window::s_mainWindow->GetClientDimensions();
 
-    VertexList_PCU verts;
-
-    AddVertsForDisc2D(verts, Vec2(clientDimensions.x * 0.5f, clientDimensions.y * 0.5f), 300.f, 10.f, Rgba8::YELLOW);
-
-    g_renderer->SetModelConstants();
-    g_renderer->SetBlendMode(eBlendMode::OPAQUE);
-    g_renderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-    g_renderer->SetSamplerMode(eSamplerMode::BILINEAR_CLAMP);
-    g_renderer->SetDepthMode(eDepthMode::DISABLED);
-    g_renderer->BindTexture(nullptr);
-    g_renderer->BindShader(nullptr);
-    g_renderer->DrawVertexArray(verts);
+    g_drawList->AddRing(GetWorldDrawState(), Vec2(clientDimensions.x * 0.5f, clientDimensions.y * 0.5f), 300.f, 10.f, Rgba8::YELLOW);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -248,17 +297,6 @@ void Game::RenderGame() const
     Vec2 const topLeft          = Vec2(offsetFromCorner.x, clientDimensions.y - offsetFromCorner.y);
     Vec2 const bottomRight      = Vec2(clientDimensions.x - offsetFromCorner.x, offsetFromCorner.y);
 
-    VertexList_PCU verts;
-
-    AddVertsForLineSegment2D(verts, topRight, bottomLeft, 10.f, false, Rgba8::GREEN);
-    AddVertsForLineSegment2D(verts, topLeft, bottomRight, 10.f, false, Rgba8::GREEN);
-
-    g_renderer->SetModelConstants();
-    g_renderer->SetBlendMode(eBlendMode::OPAQUE);
-    g_renderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-    g_renderer->SetSamplerMode(eSamplerMode::BILINEAR_CLAMP);
-    g_renderer->SetDepthMode(eDepthMode::DISABLED);
-    g_renderer->BindTexture(nullptr);
-    g_renderer->BindShader(nullptr);
-    g_renderer->DrawVertexArray(verts);
+    g_drawList->AddLine(GetWorldDrawState(), topRight, bottomLeft, 10.f, Rgba8::GREEN);
+    g_drawList->AddLine(GetWorldDrawState(), topLeft, bottomRight, 10.f, Rgba8::GREEN);
 }
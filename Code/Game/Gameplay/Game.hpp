@@ -5,11 +5,14 @@
 //----------------------------------------------------------------------------------------------------
 #pragma once
 //----------------------------------------------------------------------------------------------------
+#include "Game/Framework/EventDispatcher.hpp"
+//----------------------------------------------------------------------------------------------------
 #include "Engine/Core/EventSystem.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
 class Camera;
 class Clock;
+struct sDrawState2D;
 
 //----------------------------------------------------------------------------------------------------
 enum class eGameState : int8_t
@@ -42,11 +45,16 @@ public:
     bool       IsAttractState() const;
     bool       IsGameState() const;
 
+    //------------------------------------------------------------------------------------------------
+    // Time
+    //------------------------------------------------------------------------------------------------
+    Clock const& GetClock() const;
+
 private:
     //------------------------------------------------------------------------------------------------
     // Game state
     //------------------------------------------------------------------------------------------------
-    static bool OnGameStateChanged(EventArgs& args);
+    static bool OnGameStateChanged(FlatProperties& args);
 
     //------------------------------------------------------------------------------------------------
     // Update
@@ -61,7 +69,10 @@ private:
     void RenderAttract() const;
     void RenderGame() const;
 
+    static sDrawState2D GetWorldDrawState();
+
     eGameState m_gameState    = eGameState::ATTRACT;
+    EventId    m_stateEventId;                  // "OnGameStateChanged", interned on g_eventDispatcher
     Camera*    m_screenCamera = nullptr;
     Clock*     m_gameClock    = nullptr;
 };